@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+// Host-only benchmark of the forward convolution reference algorithms: direct loop, implicit
+// GEMM and Winograd F(2x2, 3x3) / F(4x4, 3x3), on a GNHWC/GKYXC/GNHWK problem.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd.hpp"
+
+using InDataType  = float;
+using WeiDataType = float;
+using OutDataType = float;
+
+using InLayout  = ck::tensor_layout::convolution::GNHWC;
+using WeiLayout = ck::tensor_layout::convolution::GKYXC;
+using OutLayout = ck::tensor_layout::convolution::GNHWK;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+using ReferenceConvFwdInstance = ck::tensor_operation::host::ReferenceConvFwd<2,
+                                                                             InDataType,
+                                                                             WeiDataType,
+                                                                             OutDataType,
+                                                                             PassThrough,
+                                                                             PassThrough,
+                                                                             PassThrough>;
+
+using ck::tensor_operation::host::ReferenceConvFwdAlgorithm;
+
+void print_helper_msg()
+{
+    std::cout << "arg1: verification against the direct loop (0=no, 1=yes)\n"
+              << "arg2: number of timed repetitions\n"
+              << ck::utils::conv::get_conv_param_parser_helper_msg() << std::endl;
+}
+
+template <typename F>
+double time_ms(F f, int nrepeat)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < nrepeat; ++i)
+    {
+        f();
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(stop - start).count() / nrepeat;
+}
+
+int main(int argc, char* argv[])
+{
+    print_helper_msg();
+
+    bool do_verification = true;
+    int nrepeat          = 1;
+
+    ck::utils::conv::ConvParam conv_param{
+        2, 1, 32, 128, 128, {3, 3}, {56, 56}, {1, 1}, {1, 1}, {1, 1}, {1, 1}};
+
+    if(argc == 1)
+    {
+        // use default
+    }
+    else if(argc == 3)
+    {
+        do_verification = std::stoi(argv[1]);
+        nrepeat         = std::stoi(argv[2]);
+    }
+    else
+    {
+        do_verification                   = std::stoi(argv[1]);
+        nrepeat                           = std::stoi(argv[2]);
+        const ck::index_t num_dim_spatial = std::stoi(argv[3]);
+
+        if(num_dim_spatial != 2)
+        {
+            std::cerr << "only 2D convolutions are supported" << std::endl;
+            return 1;
+        }
+
+        conv_param = ck::utils::conv::parse_conv_param(num_dim_spatial, 4, argv);
+    }
+
+    Tensor<InDataType> in(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(conv_param));
+    Tensor<WeiDataType> wei(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(
+            conv_param));
+
+    const auto out_desc =
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+            conv_param);
+
+    Tensor<OutDataType> out_direct(out_desc);
+    Tensor<OutDataType> out(out_desc);
+
+    std::cout << "in: " << in.mDesc << std::endl;
+    std::cout << "wei: " << wei.mDesc << std::endl;
+    std::cout << "out: " << out.mDesc << std::endl;
+    std::cout << "threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    in.GenerateTensorValue(GeneratorTensor_3<InDataType>{0.0, 1.0});
+    wei.GenerateTensorValue(GeneratorTensor_3<WeiDataType>{-0.5, 0.5});
+
+    const std::size_t flop = conv_param.GetFlops();
+
+    auto ref_conv    = ReferenceConvFwdInstance{};
+    auto ref_invoker = ref_conv.MakeInvoker();
+
+    auto make_argument = [&](Tensor<OutDataType>& output, ReferenceConvFwdAlgorithm algorithm) {
+        return ref_conv.MakeArgument(in,
+                                     wei,
+                                     output,
+                                     conv_param.conv_filter_strides_,
+                                     conv_param.conv_filter_dilations_,
+                                     conv_param.input_left_pads_,
+                                     conv_param.input_right_pads_,
+                                     PassThrough{},
+                                     PassThrough{},
+                                     PassThrough{},
+                                     algorithm);
+    };
+
+    auto report = [&](const char* name, double ave_time) {
+        std::cout << name << ": " << ave_time << " ms, " << flop / 1.E6 / ave_time << " GFlops"
+                  << std::endl;
+    };
+
+    bool pass = true;
+
+    // the direct loop is the baseline of the timings, and the reference of the verification
+    {
+        auto argument = make_argument(out_direct, ReferenceConvFwdAlgorithm::Direct);
+
+        report("direct", time_ms([&] { ref_invoker.Run(argument); }, nrepeat));
+    }
+
+    const std::pair<const char*, ReferenceConvFwdAlgorithm> algorithms[] = {
+        {"implicit gemm", ReferenceConvFwdAlgorithm::Default},
+        {"winograd F(2x2, 3x3)", ReferenceConvFwdAlgorithm::WinogradF2x2},
+        {"winograd F(4x4, 3x3)", ReferenceConvFwdAlgorithm::WinogradF4x4}};
+
+    for(const auto& [name, algorithm] : algorithms)
+    {
+        auto argument = make_argument(out, algorithm);
+
+        if(algorithm != ReferenceConvFwdAlgorithm::Default &&
+           !ReferenceConvFwdInstance::Invoker::IsWinogradApplicable(argument))
+        {
+            std::cout << name << ": not applicable, skipped" << std::endl;
+            continue;
+        }
+
+        report(name, time_ms([&] { ref_invoker.Run(argument); }, nrepeat));
+
+        if(do_verification)
+        {
+            pass &= ck::utils::check_err(
+                out, out_direct, std::string(name) + ": incorrect results!", 1e-3, 1e-3);
+        }
+    }
+
+    return pass ? 0 : 1;
+}
@@ -16,7 +16,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
-#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm_multiple_d.hpp"
 #include "ck/library/utility/check_err.hpp"
 
 template <ck::index_t... Is>
@@ -94,13 +94,14 @@ using DeviceGemmInstance = ck::tensor_operation::device::DeviceGemmMultipleD_Xdl
      8>;                         // index_t CShuffleBlockTransferScalarPerVector_NPerBlock>
 // clang-format on
 
-using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
-                                                                        BDataType,
-                                                                        AccDataType,
-                                                                        AccDataType,
-                                                                        PassThrough,
-                                                                        PassThrough,
-                                                                        PassThrough>;
+using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemmMultipleD<ADataType,
+                                                                                 BDataType,
+                                                                                 DsDataType,
+                                                                                 EDataType,
+                                                                                 AccDataType,
+                                                                                 PassThrough,
+                                                                                 PassThrough,
+                                                                                 CDEElementOp>;
 
 int main()
 {
@@ -135,34 +136,30 @@ int main()
             }
         };
 
-    auto f_host_tensor_descriptor1d = [](std::size_t len, std::size_t stride) {
-        return HostTensorDescriptor(std::vector<std::size_t>({len}),
-                                    std::vector<std::size_t>({stride}));
-    };
-
     Tensor<ADataType> a_m_k(f_host_tensor_descriptor2d(M, K, StrideA, ALayout{}));
     Tensor<BDataType> b_k_n(f_host_tensor_descriptor2d(K, N, StrideB, BLayout{}));
-    Tensor<BiasDataType> bias_n(f_host_tensor_descriptor1d(N, 1));
+    // the bias is broadcast over M through a zero row stride
+    Tensor<BiasDataType> bias_m_n(f_host_tensor_descriptor2d(M, N, StrideBias, BiasLayout{}));
     Tensor<EDataType> e_m_n_host_result(f_host_tensor_descriptor2d(M, N, StrideE, ELayout{}));
     Tensor<EDataType> e_m_n_device_result(f_host_tensor_descriptor2d(M, N, StrideE, ELayout{}));
 
     std::cout << "a_m_k: " << a_m_k.mDesc << std::endl;
     std::cout << "b_k_n: " << b_k_n.mDesc << std::endl;
-    std::cout << "bias_n: " << bias_n.mDesc << std::endl;
+    std::cout << "bias_m_n: " << bias_m_n.mDesc << std::endl;
     std::cout << "e_m_n: " << e_m_n_host_result.mDesc << std::endl;
 
     a_m_k.GenerateTensorValue(GeneratorTensor_2<ADataType>{-128, 127});
     b_k_n.GenerateTensorValue(GeneratorTensor_2<BDataType>{-128, 127});
-    bias_n.GenerateTensorValue(GeneratorTensor_2<BiasDataType>{-128, 127});
+    bias_m_n.GenerateTensorValue(GeneratorTensor_2<BiasDataType>{-128, 127});
 
     DeviceMem a_device_buf(sizeof(ADataType) * a_m_k.mDesc.GetElementSpaceSize());
     DeviceMem b_device_buf(sizeof(BDataType) * b_k_n.mDesc.GetElementSpaceSize());
-    DeviceMem bias_device_buf(sizeof(BiasDataType) * bias_n.mDesc.GetElementSpaceSize());
+    DeviceMem bias_device_buf(sizeof(BiasDataType) * bias_m_n.mDesc.GetElementSpaceSize());
     DeviceMem e_device_buf(sizeof(EDataType) * e_m_n_device_result.mDesc.GetElementSpaceSize());
 
     a_device_buf.ToDevice(a_m_k.mData.data());
     b_device_buf.ToDevice(b_k_n.mData.data());
-    bias_device_buf.ToDevice(bias_n.mData.data());
+    bias_device_buf.ToDevice(bias_m_n.mData.data());
 
     auto a_element_op   = PassThrough{};
     auto b_element_op   = PassThrough{};
@@ -210,24 +207,19 @@ int main()
 
     if(do_verification)
     {
-        Tensor<AccDataType> c_m_n(HostTensorDescriptor{M, N});
-
         auto ref_gemm    = ReferenceGemmInstance{};
         auto ref_invoker = ref_gemm.MakeInvoker();
 
-        auto ref_argument =
-            ref_gemm.MakeArgument(a_m_k, b_k_n, c_m_n, a_element_op, b_element_op, PassThrough{});
+        auto ref_argument = ref_gemm.MakeArgument(a_m_k,
+                                                  b_k_n,
+                                                  {bias_m_n},
+                                                  e_m_n_host_result,
+                                                  a_element_op,
+                                                  b_element_op,
+                                                  cde_element_op);
 
         ref_invoker.Run(ref_argument);
 
-        for(int m = 0; m < M; ++m)
-        {
-            for(int n = 0; n < N; ++n)
-            {
-                cde_element_op(e_m_n_host_result(m, n), c_m_n(m, n), bias_n(n));
-            }
-        }
-
         return ck::utils::check_err(e_m_n_device_result, e_m_n_host_result) ? 0 : 1;
     }
 
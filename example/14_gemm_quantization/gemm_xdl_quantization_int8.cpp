@@ -16,7 +16,7 @@
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/literals.hpp"
-#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm_multiple_d.hpp"
 #include "ck/library/utility/check_err.hpp"
 
 template <ck::index_t... Is>
@@ -92,8 +92,14 @@ using DeviceGemmInstance = ck::tensor_operation::device::DeviceGemmMultipleD_Xdl
      16>;                        // index_t CShuffleBlockTransferScalarPerVector_NPerBlock>
 // clang-format on
 
-using ReferenceGemmInstance = ck::tensor_operation::host::
-    ReferenceGemm<ADataType, BDataType, EDataType, float, PassThrough, PassThrough, CDEElementOp>;
+using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemmMultipleD<ADataType,
+                                                                                 BDataType,
+                                                                                 DsDataType,
+                                                                                 EDataType,
+                                                                                 AccDataType,
+                                                                                 PassThrough,
+                                                                                 PassThrough,
+                                                                                 CDEElementOp>;
 
 int main()
 {
@@ -196,7 +202,7 @@ int main()
         auto ref_invoker = ref_gemm.MakeInvoker();
 
         auto ref_argument = ref_gemm.MakeArgument(
-            a_m_k, b_k_n, e_m_n_host_result, a_element_op, b_element_op, cde_element_op);
+            a_m_k, b_k_n, {}, e_m_n_host_result, a_element_op, b_element_op, cde_element_op);
 
         ref_invoker.Run(ref_argument);
 
@@ -108,25 +108,7 @@ static void mean_meansquare_host(const Tensor<InDataType>& in,
         meansquare_ref(iN) = ck::type_convert<OutDataType2>(meansquare);
     };
 
-    std::size_t num_thread      = std::thread::hardware_concurrency();
-    std::size_t work_per_thread = (n + num_thread - 1) / num_thread;
-
-    std::vector<joinable_thread> threads(num_thread);
-
-    for(std::size_t it = 0; it < num_thread; it++)
-    {
-        std::size_t iN_begin = it * work_per_thread;
-        std::size_t iN_end   = std::min(static_cast<size_t>((it + 1) * work_per_thread), n);
-
-        auto f = [=] {
-            for(std::size_t iN = iN_begin; iN < iN_end; iN++)
-            {
-                thread_reduce_func(iN);
-            }
-        };
-
-        threads[it] = joinable_thread(f);
-    }
+    make_ParallelTensorFunctor(thread_reduce_func, n)(std::thread::hardware_concurrency());
 };
 
 using ReduceOperation = ck::reduce::Add;
@@ -167,9 +167,6 @@ int main()
                                                  index_c,
                                                  gamma,
                                                  beta,
-                                                 num_rows,
-                                                 current_dim,
-                                                 index_length,
                                                  epsilon);
             auto ref_invoker  = ref.MakeInvoker();
             ref_invoker.Run(ref_argument);
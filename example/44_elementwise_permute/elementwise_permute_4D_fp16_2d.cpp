@@ -9,6 +9,7 @@
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_permute.hpp"
 
 using F16 = ck::half_t;
 
@@ -27,22 +28,6 @@ using DeviceElementwisePermuteInstance =
                                                     ck::Sequence<8>,
                                                     ck::Sequence<8>>;
 
-template <typename HostTensorA, typename HostTensorB, typename Functor>
-void host_elementwise4D(HostTensorB& B_nhwc,
-                        const HostTensorA& A_nchw,
-                        const std::vector<std::size_t>& shape_nchw,
-                        Functor functor)
-{
-    for(std::size_t n = 0; n < shape_nchw[0]; ++n)
-        for(std::size_t c = 0; c < shape_nchw[1]; ++c)
-            for(std::size_t h = 0; h < shape_nchw[2]; ++h)
-                for(std::size_t w = 0; w < shape_nchw[3]; ++w)
-                {
-                    auto a_val = A_nchw(n, c, h, w);
-                    functor(B_nhwc(n, h, w, c), a_val);
-                }
-}
-
 int main()
 {
     bool do_verification = true;
@@ -118,8 +103,14 @@ int main()
         // LogRangeAsType<float>(std::cout << "Tensor b  : ", b.mData, ",") << std::endl;
 
         Tensor<BDataType> host_b(nhwc);
-        host_elementwise4D<Tensor<ADataType>, Tensor<BDataType>, PassThrough>(
-            host_b, a, nchw, PassThrough{});
+
+        using ReferencePermuteInstance =
+            ck::tensor_operation::host::ReferencePermute<ADataType, BDataType, PassThrough>;
+
+        auto ref_permute  = ReferencePermuteInstance{};
+        auto ref_argument = ref_permute.MakeArgument(a, host_b, {0, 2, 3, 1}, PassThrough{});
+
+        ref_permute.MakeInvoker().Run(ref_argument);
 
         // LogRangeAsType<float>(std::cout << "Host b  : ", host_b.mData, ",") << std::endl;
         pass &=
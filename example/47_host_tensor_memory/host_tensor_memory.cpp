@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+// Host-only benchmark of the page placement policies of host tensor storage: allocation and
+// first touch, a multi-threaded layernorm reference over a large tensor, and the random row
+// gather of the sparse embedding reference, for every HostMemoryPolicy and std::allocator,
+// with the host thread pool floating or pinned.
+//
+// Aligned and HugePage show up on any host. NumaInterleave, the node placement part of
+// ParallelFirstTouch and thread pinning only change where pages and threads live relative to
+// each other, so they need a host with several NUMA nodes to differ from HugePage / floating
+// threads; the benchmark says so when it runs on a single node.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/host_allocator.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_layernorm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_sparse_embeddings_forward_layernorm.hpp"
+
+using DataType  = float;
+using IndexType = int;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+using ReferenceLayernormInstance = ck::tensor_operation::host::
+    ReferenceLayernorm<DataType, DataType, DataType, DataType, DataType, PassThrough, 2, 1>;
+
+using ReferenceEmbeddingInstance =
+    ck::tensor_operation::host::ReferenceSparseEmbeddingsForwardLayernorm<DataType,
+                                                                          IndexType,
+                                                                          DataType,
+                                                                          DataType,
+                                                                          DataType,
+                                                                          DataType,
+                                                                          PassThrough,
+                                                                          1>;
+
+using ck::utils::HostAllocator;
+using ck::utils::HostMemoryPolicy;
+
+struct ProblemSize
+{
+    // layernorm over [M, N]
+    ck::index_t M = 16384;
+    ck::index_t N = 4096;
+
+    // L lookups into a [R, D] embedding table
+    ck::index_t R = 262144;
+    ck::index_t D = 1024;
+    ck::index_t L = 65536;
+};
+
+void print_helper_msg()
+{
+    std::cout << "arg1: number of timed repetitions\n"
+              << "arg2: thread pinning (0=floating, 1=pinned, 2=both)\n"
+              << "arg3 to 7: M, N of the layernorm, R, D, L of the embedding gather" << std::endl;
+}
+
+template <typename F>
+double time_ms(F f, int nrepeat)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for(int i = 0; i < nrepeat; ++i)
+    {
+        f();
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(stop - start).count() / nrepeat;
+}
+
+template <template <typename> class Allocator>
+void run_policy(const std::string& name, const ProblemSize& size, int nrepeat)
+{
+    using HostTensor      = Tensor<DataType, HostTensorDynamicRank, Allocator<DataType>>;
+    using HostIndexTensor = Tensor<IndexType, HostTensorDynamicRank, Allocator<IndexType>>;
+
+    const std::size_t num_thread = std::thread::hardware_concurrency();
+
+    // allocation, first touch and zeroing of the layernorm input
+    double alloc_ms = 0;
+
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        HostTensor x({size.M, size.N});
+
+        const auto stop = std::chrono::steady_clock::now();
+
+        alloc_ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+
+    HostTensor x({size.M, size.N});
+    HostTensor y({size.M, size.N});
+    Tensor<DataType> gamma({size.N});
+    Tensor<DataType> beta({size.N});
+
+    x.GenerateTensorValue(GeneratorTensor_3<DataType>{-1.f, 1.f}, num_thread);
+    gamma.GenerateTensorValue(GeneratorTensor_3<DataType>{-1.f, 1.f});
+    beta.GenerateTensorValue(GeneratorTensor_3<DataType>{-1.f, 1.f});
+
+    auto layernorm_argument = ReferenceLayernormInstance::MakeArgument(
+        x, gamma, beta, y, PassThrough{}, {size.M, size.N}, {1}, 1e-4);
+
+    auto layernorm_invoker = ReferenceLayernormInstance::MakeInvoker();
+
+    const double layernorm_ms =
+        time_ms([&] { layernorm_invoker.Run(layernorm_argument); }, nrepeat);
+
+    // random rows of a large table: bound by the latency of TLB and cache misses
+    HostTensor table({size.R, size.D});
+    HostIndexTensor indexes({size.L});
+    Tensor<DataType> emb_gamma({size.D});
+    Tensor<DataType> emb_beta({size.D});
+    HostTensor out({size.L, size.D});
+
+    table.GenerateTensorValue(GeneratorTensor_3<DataType>{-1.f, 1.f}, num_thread);
+    emb_gamma.GenerateTensorValue(GeneratorTensor_3<DataType>{-1.f, 1.f});
+    emb_beta.GenerateTensorValue(GeneratorTensor_3<DataType>{-1.f, 1.f});
+
+    std::mt19937 gen(11939);
+    std::uniform_int_distribution<IndexType> row_dis(0, size.R - 1);
+
+    for(auto& index : indexes.mData)
+    {
+        index = row_dis(gen);
+    }
+
+    auto embedding_argument = ReferenceEmbeddingInstance::MakeArgument(
+        out, {table}, {indexes}, emb_gamma, emb_beta, 1e-5f, PassThrough{});
+
+    auto embedding_invoker = ReferenceEmbeddingInstance::MakeInvoker();
+
+    const double embedding_ms =
+        time_ms([&] { embedding_invoker.Run(embedding_argument); }, nrepeat);
+
+    const double layernorm_gb = 2. * sizeof(DataType) * size.M * size.N / 1.e9;
+
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(12) << alloc_ms << std::setw(16)
+              << layernorm_ms << std::setw(10) << layernorm_gb / (layernorm_ms / 1.e3)
+              << std::setw(16) << embedding_ms << std::endl;
+}
+
+template <HostMemoryPolicy Policy>
+struct PolicyAllocator
+{
+    template <typename T>
+    using type = HostAllocator<T, Policy>;
+};
+
+void run_all_policies(const ProblemSize& size, int nrepeat)
+{
+    std::cout << std::left << std::setw(20) << "policy" << std::right << std::setw(12)
+              << "alloc [ms]" << std::setw(16) << "layernorm [ms]" << std::setw(10) << "[GB/s]"
+              << std::setw(16) << "gather [ms]" << std::endl;
+
+    run_policy<std::allocator>("std::allocator", size, nrepeat);
+    run_policy<PolicyAllocator<HostMemoryPolicy::Aligned>::type>("Aligned", size, nrepeat);
+    run_policy<PolicyAllocator<HostMemoryPolicy::HugePage>::type>("HugePage", size, nrepeat);
+    run_policy<PolicyAllocator<HostMemoryPolicy::NumaInterleave>::type>(
+        "NumaInterleave", size, nrepeat);
+    run_policy<PolicyAllocator<HostMemoryPolicy::ParallelFirstTouch>::type>(
+        "ParallelFirstTouch", size, nrepeat);
+}
+
+int main(int argc, char* argv[])
+{
+    print_helper_msg();
+
+    int nrepeat = 5;
+    int pinning = 2;
+
+    ProblemSize size;
+
+    if(argc == 1)
+    {
+        // use default
+    }
+    else if(argc == 3 || argc == 8)
+    {
+        nrepeat = std::stoi(argv[1]);
+        pinning = std::stoi(argv[2]);
+
+        if(argc == 8)
+        {
+            size.M = std::stoi(argv[3]);
+            size.N = std::stoi(argv[4]);
+            size.R = std::stoi(argv[5]);
+            size.D = std::stoi(argv[6]);
+            size.L = std::stoi(argv[7]);
+        }
+    }
+    else
+    {
+        return 1;
+    }
+
+    std::cout << "layernorm [" << size.M << ", " << size.N << "], gather of " << size.L
+              << " rows of [" << size.R << ", " << size.D << "], "
+              << std::thread::hardware_concurrency() << " threads" << std::endl;
+
+    const std::size_t num_numa_node = ck::utils::get_host_num_numa_node();
+
+    std::cout << num_numa_node << " NUMA node(s)" << std::endl;
+
+    if(num_numa_node == 1)
+    {
+        std::cout << "single NUMA node: NumaInterleave and pinning are expected to match "
+                     "HugePage and floating threads"
+                  << std::endl;
+    }
+
+    auto& pool = ck::utils::HostThreadPool::GetInstance();
+
+    if(pinning != 1)
+    {
+        std::cout << "\nthreads floating" << std::endl;
+
+        run_all_policies(size, nrepeat);
+    }
+
+    if(pinning != 0)
+    {
+        std::cout << "\nthreads pinned" << std::endl;
+
+        if(!pool.PinThreads())
+        {
+            std::cout << "could not pin the threads" << std::endl;
+        }
+
+        run_all_policies(size, nrepeat);
+
+        pool.UnpinThreads();
+    }
+
+    return 0;
+}
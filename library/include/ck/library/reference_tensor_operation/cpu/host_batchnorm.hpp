@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_reduction.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Channel-last (NHWC) engine of the batchnorm references.
+//
+// @paragraph
+//             When the single invariant dimension C has unit stride, every reduce index addresses
+//             one contiguous row of C channels. The helpers below walk the rows and treat the
+//             channels as vector lanes: all channels of a row take the same step, so the channel
+//             loops carry no per-element offset arithmetic and vectorize. Rows are split with a
+//             HostReductionPartition over (1 output, num_row rows of C elements), the partials of
+//             the splits are merged in its fixed tree.
+//
+
+// Welford states of C channels over the same rows. As all channels share the count, the 1 / count
+// of a step is computed once per row.
+template <typename AccDataType>
+struct HostChannelWelford
+{
+    HostChannelWelford() = default;
+
+    explicit HostChannelWelford(std::size_t num_channel) : mean_(num_channel), m2_(num_channel) {}
+
+    // folds one row p_x[0 .. C) into the states
+    template <typename XDataType>
+    void Update(const XDataType* p_x)
+    {
+        const std::size_t num_channel = mean_.size();
+
+        const AccDataType inv_count = AccDataType{1} / static_cast<AccDataType>(++count_);
+
+        for(std::size_t c = 0; c < num_channel; ++c)
+        {
+            const AccDataType x     = ck::type_convert<AccDataType>(p_x[c]);
+            const AccDataType delta = x - mean_[c];
+
+            mean_[c] += delta * inv_count;
+            m2_[c] += delta * (x - mean_[c]);
+        }
+    }
+
+    // Chan's formula, other holds the states of a disjoint set of rows
+    void Merge(const HostChannelWelford& other)
+    {
+        if(other.count_ == 0)
+            return;
+
+        if(count_ == 0)
+        {
+            *this = other;
+            return;
+        }
+
+        const std::size_t num_channel = mean_.size();
+
+        const long_index_t count = count_ + other.count_;
+
+        const AccDataType count_a = static_cast<AccDataType>(count_);
+        const AccDataType count_b = static_cast<AccDataType>(other.count_);
+        const AccDataType count_r = static_cast<AccDataType>(count);
+
+        const AccDataType weight_b  = count_b / count_r;
+        const AccDataType weight_m2 = count_a * count_b / count_r;
+
+        for(std::size_t c = 0; c < num_channel; ++c)
+        {
+            const AccDataType delta = other.mean_[c] - mean_[c];
+
+            mean_[c] += delta * weight_b;
+            m2_[c] += other.m2_[c] + delta * delta * weight_m2;
+        }
+
+        count_ = count;
+    }
+
+    AccDataType GetMean(std::size_t c) const { return mean_[c]; }
+
+    AccDataType GetVariance(std::size_t c) const
+    {
+        return count_ > 0 ? m2_[c] / static_cast<AccDataType>(count_) : AccDataType{0};
+    }
+
+    std::vector<AccDataType> mean_;
+    std::vector<AccDataType> m2_;
+    long_index_t count_ = 0;
+};
+
+// Per-channel statistics of rows get_x_row(0), ..., get_x_row(num_row - 1), each a pointer to C
+// contiguous channels.
+template <typename AccDataType, typename GetXRow>
+HostChannelWelford<AccDataType> host_batchnorm_channel_last_welford(
+    const HostReductionPartition& partition, std::size_t num_channel, GetXRow get_x_row)
+{
+    HostChannelWelford<AccDataType> result(num_channel);
+
+    auto reduce_split = [&](std::size_t, std::size_t begin, std::size_t end) {
+        HostChannelWelford<AccDataType> welford(num_channel);
+
+        for(std::size_t i = begin; i < end; ++i)
+            welford.Update(get_x_row(i));
+
+        return welford;
+    };
+
+    auto merge_partial = [](HostChannelWelford<AccDataType>& left,
+                            const HostChannelWelford<AccDataType>& right) { left.Merge(right); };
+
+    auto finalize = [&](std::size_t, const HostChannelWelford<AccDataType>& welford) {
+        result = welford;
+    };
+
+    host_reduction_run<HostChannelWelford<AccDataType>>(
+        partition, reduce_split, merge_partial, finalize);
+
+    return result;
+}
+
+// y = y_elementwise_op(scale * (x - mean) * invVariance + bias), row by row, with the per-channel
+// parameters already converted to AccDataType
+template <typename AccDataType,
+          typename YDataType,
+          typename YElementwiseOp,
+          typename GetXRow,
+          typename GetYRow>
+void host_batchnorm_channel_last_normalize(const HostReductionPartition& partition,
+                                           const std::vector<AccDataType>& means,
+                                           const std::vector<AccDataType>& invVariances,
+                                           const std::vector<AccDataType>& scales,
+                                           const std::vector<AccDataType>& biases,
+                                           const YElementwiseOp& y_elementwise_op,
+                                           GetXRow get_x_row,
+                                           GetYRow get_y_row)
+{
+    const std::size_t num_channel = means.size();
+
+    auto normalize_split = [&](std::size_t, std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            const auto* p_x = get_x_row(i);
+            YDataType* p_y  = get_y_row(i);
+
+            for(std::size_t c = 0; c < num_channel; ++c)
+            {
+                AccDataType x = ck::type_convert<AccDataType>(p_x[c]);
+
+                AccDataType norm_x = (x - means[c]) * invVariances[c];
+
+                AccDataType y = scales[c] * norm_x + biases[c];
+
+                y_elementwise_op(y, y);
+
+                p_y[c] = ck::type_convert<YDataType>(y);
+            }
+        }
+    };
+
+    host_reduction_for_each(partition, normalize_split);
+}
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,451 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/math.hpp"
+#include "ck/library/utility/host_simd.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Cache-blocked, packed GEMM engine for host reference operators.
+//
+// @paragraph
+//             C[M, N] = A[M, K] * B[K, N], computed BLIS style:
+//             - B is packed once into K x NR micro-panels, A is packed per MC row block into
+//               K x MR micro-panels. Packing reads elements through user getters, so element
+//               operations and the conversion to AccDataType are applied once per element.
+//             - An MC x KC block of packed A stays in L2, a KC x NR micro-panel of packed B stays
+//               in L1, and an MR x NR register-blocked micro-kernel updates an MC x NC accumulator
+//               tile owned by one task.
+//             - Every C element is accumulated in increasing k order in AccDataType, starting
+//               from zero, exactly like the naive reference loop. The SIMD micro-kernels use a
+//               fused multiply-add only when the translation unit itself targets FMA (i.e. when
+//               the compiler would also contract the scalar loop), so results are bit-identical
+//               to the scalar reference.
+//
+struct HostGemmBlocking
+{
+    static constexpr index_t MC = 96;
+    static constexpr index_t KC = 256;
+    static constexpr index_t NC = 256;
+};
+
+// C[MR, NR] += A[MR, kc] * B[kc, NR]
+// a: packed micro-panel, kc x MR, k-major
+// b: packed micro-panel, kc x NR, k-major
+// c: row-major with leading dimension ldc
+template <typename AccDataType>
+struct HostGemmMicroKernel
+{
+    using Func = void (*)(index_t, const AccDataType*, const AccDataType*, AccDataType*, index_t);
+
+    index_t MR;
+    index_t NR;
+    Func Run;
+};
+
+namespace detail {
+
+template <typename AccDataType, index_t MR, index_t NR>
+void host_gemm_micro_kernel_generic(
+    index_t kc, const AccDataType* a, const AccDataType* b, AccDataType* c, index_t ldc)
+{
+    AccDataType acc[MR][NR];
+
+    for(index_t i = 0; i < MR; ++i)
+        for(index_t j = 0; j < NR; ++j)
+            acc[i][j] = c[i * ldc + j];
+
+    for(index_t k = 0; k < kc; ++k)
+    {
+        for(index_t i = 0; i < MR; ++i)
+        {
+            const AccDataType v_a = a[k * MR + i];
+
+            for(index_t j = 0; j < NR; ++j)
+            {
+                acc[i][j] += v_a * b[k * NR + j];
+            }
+        }
+    }
+
+    for(index_t i = 0; i < MR; ++i)
+        for(index_t j = 0; j < NR; ++j)
+            c[i * ldc + j] = acc[i][j];
+}
+
+#if CK_HOST_X86_SIMD
+// 6 x 16 fp32 micro-kernel, 12 ymm accumulators
+__attribute__((target("avx2"))) inline void
+host_gemm_micro_kernel_f32_avx2(index_t kc, const float* a, const float* b, float* c, index_t ldc)
+{
+    constexpr index_t MR = 6;
+    constexpr index_t NR = 16;
+
+    __m256 acc[MR][2];
+
+    for(index_t i = 0; i < MR; ++i)
+    {
+        acc[i][0] = _mm256_loadu_ps(c + i * ldc);
+        acc[i][1] = _mm256_loadu_ps(c + i * ldc + 8);
+    }
+
+    for(index_t k = 0; k < kc; ++k)
+    {
+        const __m256 b0 = _mm256_loadu_ps(b + k * NR);
+        const __m256 b1 = _mm256_loadu_ps(b + k * NR + 8);
+
+        for(index_t i = 0; i < MR; ++i)
+        {
+            const __m256 a_i = _mm256_broadcast_ss(a + k * MR + i);
+#if defined(__FMA__)
+            acc[i][0] = _mm256_fmadd_ps(a_i, b0, acc[i][0]);
+            acc[i][1] = _mm256_fmadd_ps(a_i, b1, acc[i][1]);
+#else
+            acc[i][0] = _mm256_add_ps(acc[i][0], _mm256_mul_ps(a_i, b0));
+            acc[i][1] = _mm256_add_ps(acc[i][1], _mm256_mul_ps(a_i, b1));
+#endif
+        }
+    }
+
+    for(index_t i = 0; i < MR; ++i)
+    {
+        _mm256_storeu_ps(c + i * ldc, acc[i][0]);
+        _mm256_storeu_ps(c + i * ldc + 8, acc[i][1]);
+    }
+}
+
+// 6 x 32 fp32 micro-kernel, 12 zmm accumulators
+__attribute__((target("avx512f"))) inline void
+host_gemm_micro_kernel_f32_avx512(index_t kc, const float* a, const float* b, float* c, index_t ldc)
+{
+    constexpr index_t MR = 6;
+    constexpr index_t NR = 32;
+
+    __m512 acc[MR][2];
+
+    for(index_t i = 0; i < MR; ++i)
+    {
+        acc[i][0] = _mm512_loadu_ps(c + i * ldc);
+        acc[i][1] = _mm512_loadu_ps(c + i * ldc + 16);
+    }
+
+    for(index_t k = 0; k < kc; ++k)
+    {
+        const __m512 b0 = _mm512_loadu_ps(b + k * NR);
+        const __m512 b1 = _mm512_loadu_ps(b + k * NR + 16);
+
+        for(index_t i = 0; i < MR; ++i)
+        {
+            const __m512 a_i = _mm512_set1_ps(a[k * MR + i]);
+#if defined(__FMA__)
+            acc[i][0] = _mm512_fmadd_ps(a_i, b0, acc[i][0]);
+            acc[i][1] = _mm512_fmadd_ps(a_i, b1, acc[i][1]);
+#else
+            // explicitly rounded ops so that the compiler cannot contract them into an FMA
+            constexpr int rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+
+            acc[i][0] = _mm512_add_round_ps(
+                acc[i][0], _mm512_mul_round_ps(a_i, b0, rounding), rounding);
+            acc[i][1] = _mm512_add_round_ps(
+                acc[i][1], _mm512_mul_round_ps(a_i, b1, rounding), rounding);
+#endif
+        }
+    }
+
+    for(index_t i = 0; i < MR; ++i)
+    {
+        _mm512_storeu_ps(c + i * ldc, acc[i][0]);
+        _mm512_storeu_ps(c + i * ldc + 16, acc[i][1]);
+    }
+}
+#endif // CK_HOST_X86_SIMD
+
+} // namespace detail
+
+template <typename AccDataType>
+HostGemmMicroKernel<AccDataType> get_host_gemm_micro_kernel()
+{
+#if CK_HOST_X86_SIMD
+    if constexpr(is_same_v<AccDataType, float>)
+    {
+        if(__builtin_cpu_supports("avx512f"))
+            return {6, 32, &detail::host_gemm_micro_kernel_f32_avx512};
+
+        if(__builtin_cpu_supports("avx2"))
+            return {6, 16, &detail::host_gemm_micro_kernel_f32_avx2};
+    }
+#endif
+
+    return {4, 16, &detail::host_gemm_micro_kernel_generic<AccDataType, 4, 16>};
+}
+
+template <typename AccDataType>
+struct HostBlockedGemm
+{
+    using Blocking = HostGemmBlocking;
+
+    HostBlockedGemm(index_t M, index_t N, index_t K)
+        : M_{M}, N_{N}, K_{K}, kernel_{get_host_gemm_micro_kernel<AccDataType>()}
+    {
+    }
+
+    // b_getter(k, n) returns B[k, n] as AccDataType
+    template <typename BGetter>
+    void PackB(BGetter b_getter, std::size_t num_thread)
+    {
+        AllocateB();
+
+        auto f_pack = [&](auto q) { PackBPanel(q, b_getter); };
+
+        make_ParallelTensorFunctor(f_pack, GetNumBPanel())(num_thread);
+    }
+
+    // PackB() split into its serial and parallel parts, for callers that pack several GEMMs
+    // in one parallel loop: AllocateB() once, then PackBPanel() for every panel
+    void AllocateB()
+    {
+        b_packed_.resize(static_cast<std::size_t>(GetNumBPanel()) * kernel_.NR * K_);
+    }
+
+    template <typename BGetter>
+    void PackBPanel(index_t q, BGetter& b_getter)
+    {
+        const index_t NR = kernel_.NR;
+
+        // data() + offset rather than operator[]: the buffer is empty when K_ == 0
+        AccDataType* p_dst = b_packed_.data() + static_cast<std::size_t>(q) * NR * K_;
+
+        for(index_t k = 0; k < K_; ++k)
+        {
+            for(index_t j = 0; j < NR; ++j)
+            {
+                const index_t n = q * NR + j;
+
+                p_dst[k * NR + j] = n < N_ ? b_getter(k, n) : AccDataType{0};
+            }
+        }
+    }
+
+    // a_getter(m, k) returns A[m, k] as AccDataType
+    // c_epilogue(m, n, acc) consumes the accumulated C[m, n]
+    // PackB() must have been called before
+    template <typename AGetter, typename CEpilogue>
+    void Run(AGetter a_getter, CEpilogue c_epilogue, std::size_t num_thread) const
+    {
+        const index_t num_m_tile = GetNumMTile();
+        const index_t num_n_tile = GetNumNTile();
+
+        const index_t num_n_tile_per_task = GetNumNTilePerTask(num_m_tile, num_n_tile, num_thread);
+        const index_t num_n_task =
+            num_n_tile_per_task > 0 ? math::integer_divide_ceil(num_n_tile, num_n_tile_per_task)
+                                    : 0;
+
+        auto f_task = [&](auto im, auto in) {
+            const index_t n_tile_begin = in * num_n_tile_per_task;
+            const index_t n_tile_end   = std::min(n_tile_begin + num_n_tile_per_task, num_n_tile);
+
+            RunTile(im, n_tile_begin, n_tile_end, a_getter, c_epilogue);
+        };
+
+        make_ParallelTensorFunctor(f_task, num_m_tile, num_n_task)(num_thread);
+    }
+
+    // A row block is packed once per task; only split N when there are not enough row blocks
+    // to keep every thread busy
+    static index_t
+    GetNumNTilePerTask(index_t num_row_block, index_t num_n_tile, std::size_t num_thread)
+    {
+        if(num_row_block > 0 && num_n_tile > 0 &&
+           static_cast<std::size_t>(num_row_block) < num_thread)
+        {
+            const index_t num_n_split = std::min<index_t>(
+                num_n_tile, math::integer_divide_ceil(num_thread, num_row_block));
+
+            return math::integer_divide_ceil(num_n_tile, num_n_split);
+        }
+
+        return num_n_tile;
+    }
+
+    // computes rows [im * MC, im * MC + MC) against N tiles [n_tile_begin, n_tile_end) on the
+    // calling thread
+    template <typename AGetter, typename CEpilogue>
+    void RunTile(index_t im,
+                 index_t n_tile_begin,
+                 index_t n_tile_end,
+                 AGetter& a_getter,
+                 CEpilogue& c_epilogue) const
+    {
+        const index_t MR = kernel_.MR;
+        const index_t NR = kernel_.NR;
+
+        const index_t m0     = im * Blocking::MC;
+        const index_t mc     = std::min(Blocking::MC, M_ - m0);
+        const index_t mc_pad = math::integer_divide_ceil(mc, MR) * MR;
+
+        // pack A row block into K x MR micro-panels
+        std::vector<AccDataType> a_packed(static_cast<std::size_t>(mc_pad) * K_);
+
+        for(index_t ir = 0; ir < mc_pad; ir += MR)
+        {
+            AccDataType* p_dst = a_packed.data() + static_cast<std::size_t>(ir) * K_;
+
+            for(index_t k = 0; k < K_; ++k)
+            {
+                for(index_t i = 0; i < MR; ++i)
+                {
+                    const index_t m = m0 + ir + i;
+
+                    p_dst[k * MR + i] = m < M_ ? a_getter(m, k) : AccDataType{0};
+                }
+            }
+        }
+
+        std::vector<AccDataType> c_tile(static_cast<std::size_t>(mc_pad) * Blocking::NC);
+
+        for(index_t in = n_tile_begin; in < n_tile_end; ++in)
+        {
+            const index_t n0     = in * Blocking::NC;
+            const index_t nc     = std::min(Blocking::NC, N_ - n0);
+            const index_t nc_pad = math::integer_divide_ceil(nc, NR) * NR;
+            const index_t ldc    = nc_pad;
+
+            std::fill(c_tile.begin(), c_tile.end(), AccDataType{0});
+
+            for(index_t pc = 0; pc < K_; pc += Blocking::KC)
+            {
+                const index_t kc = std::min(Blocking::KC, K_ - pc);
+
+                for(index_t jr = 0; jr < nc_pad; jr += NR)
+                {
+                    const AccDataType* p_b =
+                        b_packed_.data() + static_cast<std::size_t>(n0 + jr) * K_ + pc * NR;
+
+                    for(index_t ir = 0; ir < mc_pad; ir += MR)
+                    {
+                        const AccDataType* p_a =
+                            a_packed.data() + static_cast<std::size_t>(ir) * K_ + pc * MR;
+
+                        kernel_.Run(kc, p_a, p_b, &c_tile[ir * ldc + jr], ldc);
+                    }
+                }
+            }
+
+            for(index_t i = 0; i < mc; ++i)
+            {
+                for(index_t j = 0; j < nc; ++j)
+                {
+                    c_epilogue(m0 + i, n0 + j, c_tile[i * ldc + j]);
+                }
+            }
+        }
+    }
+
+    index_t GetNumMTile() const { return math::integer_divide_ceil(M_, Blocking::MC); }
+
+    index_t GetNumNTile() const { return math::integer_divide_ceil(N_, Blocking::NC); }
+
+    index_t GetNumBPanel() const { return math::integer_divide_ceil(N_, kernel_.NR); }
+
+    index_t M_;
+    index_t N_;
+    index_t K_;
+
+    HostGemmMicroKernel<AccDataType> kernel_;
+
+    std::vector<AccDataType> b_packed_;
+};
+
+//
+// @brief      Batched / strided-batched GEMM on top of HostBlockedGemm.
+//
+// @paragraph
+//             C[g] = A[g] * B[g] for g in [0, G). All batches are scheduled as (batch, M tile,
+//             N tile range) work units of a single parallel loop, so a long batch of small
+//             GEMMs (e.g. one per attention head) keeps every thread busy without a parallel
+//             launch per batch. A B that is broadcast over the batch (batch stride 0) is packed
+//             once and shared by all batches. Each C element is computed exactly as by
+//             HostBlockedGemm.
+//
+template <typename AccDataType>
+struct HostBatchedBlockedGemm
+{
+    HostBatchedBlockedGemm(index_t G, index_t M, index_t N, index_t K, bool is_b_broadcast)
+        : G_{G}, gemms_(is_b_broadcast || G <= 1 ? 1 : G, HostBlockedGemm<AccDataType>{M, N, K})
+    {
+    }
+
+    // b_getter(g, k, n) returns B[g][k, n] as AccDataType; a broadcast B is only read at g = 0
+    template <typename BGetter>
+    void PackB(BGetter b_getter, std::size_t num_thread)
+    {
+        if(G_ == 0)
+            return;
+
+        for(auto& gemm : gemms_)
+        {
+            gemm.AllocateB();
+        }
+
+        auto f_pack = [&](auto g, auto q) {
+            auto b_getter_g = [&](index_t k, index_t n) { return b_getter(g, k, n); };
+
+            gemms_[g].PackBPanel(q, b_getter_g);
+        };
+
+        make_ParallelTensorFunctor(f_pack, gemms_.size(), gemms_[0].GetNumBPanel())(num_thread);
+    }
+
+    // a_getter(g, m, k) returns A[g][m, k] as AccDataType
+    // c_epilogue(g, m, n, acc) consumes the accumulated C[g][m, n]
+    // PackB() must have been called before
+    template <typename AGetter, typename CEpilogue>
+    void Run(AGetter a_getter, CEpilogue c_epilogue, std::size_t num_thread) const
+    {
+        const index_t num_m_tile = gemms_[0].GetNumMTile();
+        const index_t num_n_tile = gemms_[0].GetNumNTile();
+
+        const index_t num_n_tile_per_task = HostBlockedGemm<AccDataType>::GetNumNTilePerTask(
+            G_ * num_m_tile, num_n_tile, num_thread);
+        const index_t num_n_task =
+            num_n_tile_per_task > 0 ? math::integer_divide_ceil(num_n_tile, num_n_tile_per_task)
+                                    : 0;
+
+        auto f_task = [&](auto g, auto im, auto in) {
+            const auto& gemm = gemms_.size() == 1 ? gemms_[0] : gemms_[g];
+
+            const index_t n_tile_begin = in * num_n_tile_per_task;
+            const index_t n_tile_end   = std::min(n_tile_begin + num_n_tile_per_task, num_n_tile);
+
+            auto a_getter_g = [&](index_t m, index_t k) { return a_getter(g, m, k); };
+
+            auto c_epilogue_g = [&](index_t m, index_t n, AccDataType v_acc) {
+                c_epilogue(g, m, n, v_acc);
+            };
+
+            gemm.RunTile(im, n_tile_begin, n_tile_end, a_getter_g, c_epilogue_g);
+        };
+
+        make_ParallelTensorFunctor(f_task, G_, num_m_tile, num_n_task)(num_thread);
+    }
+
+    index_t G_;
+
+    // one GEMM per batch, or a single one when B is shared by all batches
+    std::vector<HostBlockedGemm<AccDataType>> gemms_;
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "ck/ck.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      One mode (the M, N or K dimensions) of a tensor contraction, flattened to a GEMM
+//             dimension.
+//
+// @paragraph
+//             The dimensions of the mode are shared by several tensors, e.g. the M dimensions by A
+//             and E. Unit dimensions are dropped, the others are ordered so that the one with the
+//             smallest strides is innermost, and adjacent dimensions that are contiguous in every
+//             tensor are merged. The linear GEMM index then walks the tensors in the cheapest order
+//             this mode allows.
+//
+// @paragraph
+//             GetOffsets(t)[i] is the offset of linear index i into the t-th tensor, so a GEMM
+//             getter addresses an element as two table lookups, whatever the number of dimensions
+//             and their strides.
+//
+struct HostContractionMode
+{
+    // strides[t][d] is the stride of dimension d in the t-th tensor carrying the mode
+    HostContractionMode(const std::vector<index_t>& lengths,
+                        const std::vector<std::vector<std::size_t>>& strides)
+        : strides_(strides.size())
+    {
+        const std::size_t num_tensor = strides.size();
+
+        std::vector<std::size_t> dims;
+
+        for(std::size_t d = 0; d < lengths.size(); ++d)
+        {
+            if(lengths[d] != 1)
+                dims.push_back(d);
+        }
+
+        auto get_stride_sum = [&](std::size_t d) {
+            std::size_t sum = 0;
+
+            for(std::size_t t = 0; t < num_tensor; ++t)
+                sum += strides[t][d];
+
+            return sum;
+        };
+
+        std::stable_sort(dims.begin(), dims.end(), [&](std::size_t d0, std::size_t d1) {
+            return get_stride_sum(d0) > get_stride_sum(d1);
+        });
+
+        for(std::size_t d : dims)
+        {
+            bool is_mergeable = !lengths_.empty();
+
+            for(std::size_t t = 0; t < num_tensor && is_mergeable; ++t)
+                is_mergeable = strides_[t].back() == strides[t][d] * lengths[d];
+
+            if(is_mergeable)
+            {
+                lengths_.back() *= lengths[d];
+
+                for(std::size_t t = 0; t < num_tensor; ++t)
+                    strides_[t].back() = strides[t][d];
+            }
+            else
+            {
+                lengths_.push_back(lengths[d]);
+
+                for(std::size_t t = 0; t < num_tensor; ++t)
+                    strides_[t].push_back(strides[t][d]);
+            }
+        }
+
+        length_ =
+            std::accumulate(lengths_.begin(), lengths_.end(), index_t{1}, std::multiplies<>{});
+
+        MakeOffsets();
+    }
+
+    index_t GetLength() const { return length_; }
+
+    index_t GetNumOfDimension() const { return static_cast<index_t>(lengths_.size()); }
+
+    // stride of the innermost dimension in the t-th tensor, the largest possible value when all
+    // dimensions are unit
+    std::size_t GetInnerStride(std::size_t t) const
+    {
+        return lengths_.empty() ? std::numeric_limits<std::size_t>::max() : strides_[t].back();
+    }
+
+    const std::vector<std::size_t>& GetOffsets(std::size_t t) const { return offsets_[t]; }
+
+    private:
+    void MakeOffsets()
+    {
+        const std::size_t num_tensor = strides_.size();
+        const index_t num_dim        = GetNumOfDimension();
+
+        offsets_.assign(num_tensor, std::vector<std::size_t>(length_));
+
+        std::vector<index_t> idx(num_dim, 0);
+        std::vector<std::size_t> offset(num_tensor, 0);
+
+        for(index_t i = 0; i < length_; ++i)
+        {
+            for(std::size_t t = 0; t < num_tensor; ++t)
+                offsets_[t][i] = offset[t];
+
+            for(index_t d = num_dim - 1; d >= 0; --d)
+            {
+                for(std::size_t t = 0; t < num_tensor; ++t)
+                    offset[t] += strides_[t][d];
+
+                if(++idx[d] < lengths_[d])
+                    break;
+
+                for(std::size_t t = 0; t < num_tensor; ++t)
+                    offset[t] -= strides_[t][d] * lengths_[d];
+
+                idx[d] = 0;
+            }
+        }
+    }
+
+    std::vector<index_t> lengths_;
+    std::vector<std::vector<std::size_t>> strides_;
+
+    index_t length_;
+
+    std::vector<std::vector<std::size_t>> offsets_;
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,455 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/math.hpp"
+#include "ck/library/utility/host_simd.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Cache-blocked int8 x int8 -> int32 GEMM engine for host reference operators.
+//
+// @paragraph
+//             Same blocking and interface as HostBlockedGemm<int32_t>, but the operands stay in
+//             int8 after packing: K is split into groups of 4 consecutive k, and the packed
+//             micro-panels store the 4 bytes of a group next to each other (kq x MR x 4 for A,
+//             kq x NR x 4 for B). One 32-bit lane then holds a 4-element dot-product operand,
+//             which the micro-kernels reduce with VNNI vpdpbusd or, on plain AVX2, with
+//             vpmaddwd on sign-extended bytes. The AVX-VNNI kernel is only built by compilers
+//             that know the ISA (CK_HOST_X86_AVXVNNI).
+//
+// @paragraph
+//             vpdpbusd multiplies unsigned by signed bytes. The VNNI kernels therefore read A
+//             packed as a + 128 and the engine subtracts 128 * sum_k B[k, n] from every C[m, n]
+//             before the epilogue. Everything is exact int32 arithmetic, so the result equals the
+//             naive int32 loop whatever the kernel.
+//
+// C[MR, NR] += A[MR, 4 * kq] * B[4 * kq, NR]
+// a: packed micro-panel, kq x MR x 4
+// b: packed micro-panel, kq x NR x 4
+// c: row-major with leading dimension ldc
+struct HostInt8GemmMicroKernel
+{
+    using Func = void (*)(index_t, const int8_t*, const int8_t*, int32_t*, index_t);
+
+    index_t MR;
+    index_t NR;
+
+    // A is packed as a + 128, i.e. as uint8
+    bool IsAUnsigned;
+
+    Func Run;
+};
+
+namespace detail {
+
+template <index_t MR, index_t NR>
+void host_int8_gemm_micro_kernel_generic(
+    index_t kq, const int8_t* a, const int8_t* b, int32_t* c, index_t ldc)
+{
+    int32_t acc[MR][NR];
+
+    for(index_t i = 0; i < MR; ++i)
+        for(index_t j = 0; j < NR; ++j)
+            acc[i][j] = c[i * ldc + j];
+
+    for(index_t q = 0; q < kq; ++q)
+    {
+        for(index_t i = 0; i < MR; ++i)
+        {
+            const int8_t* p_a = a + (q * MR + i) * 4;
+
+            for(index_t j = 0; j < NR; ++j)
+            {
+                const int8_t* p_b = b + (q * NR + j) * 4;
+
+                acc[i][j] += p_a[0] * p_b[0] + p_a[1] * p_b[1] + p_a[2] * p_b[2] + p_a[3] * p_b[3];
+            }
+        }
+    }
+
+    for(index_t i = 0; i < MR; ++i)
+        for(index_t j = 0; j < NR; ++j)
+            c[i * ldc + j] = acc[i][j];
+}
+
+#if CK_HOST_X86_SIMD
+inline int32_t host_int8_gemm_load_quad(const int8_t* p)
+{
+    int32_t quad;
+
+    std::memcpy(&quad, p, sizeof(quad));
+
+    return quad;
+}
+
+// 6 x 8 micro-kernel on sign-extended int16 pairs; each accumulator lane holds the partial sum
+// of two k of a column, reduced once at the end
+__attribute__((target("avx2"))) inline void host_int8_gemm_micro_kernel_avx2(
+    index_t kq, const int8_t* a, const int8_t* b, int32_t* c, index_t ldc)
+{
+    constexpr index_t MR = 6;
+    constexpr index_t NR = 8;
+
+    // acc[i][0]: columns 0 - 3, acc[i][1]: columns 4 - 7, two lanes per column
+    __m256i acc[MR][2];
+
+    for(index_t i = 0; i < MR; ++i)
+    {
+        acc[i][0] = _mm256_setzero_si256();
+        acc[i][1] = _mm256_setzero_si256();
+    }
+
+    for(index_t q = 0; q < kq; ++q)
+    {
+        const __m256i b_q =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + q * NR * 4));
+
+        const __m256i b0 = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(b_q));
+        const __m256i b1 = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(b_q, 1));
+
+        for(index_t i = 0; i < MR; ++i)
+        {
+            const __m256i a_i = _mm256_cvtepi8_epi16(
+                _mm_set1_epi32(host_int8_gemm_load_quad(a + (q * MR + i) * 4)));
+
+            acc[i][0] = _mm256_add_epi32(acc[i][0], _mm256_madd_epi16(a_i, b0));
+            acc[i][1] = _mm256_add_epi32(acc[i][1], _mm256_madd_epi16(a_i, b1));
+        }
+    }
+
+    for(index_t i = 0; i < MR; ++i)
+    {
+        // [c0 c1 c4 c5 | c2 c3 c6 c7] -> [c0 ... c7]
+        const __m256i sum =
+            _mm256_permute4x64_epi64(_mm256_hadd_epi32(acc[i][0], acc[i][1]), 0xD8);
+
+        __m256i* p_c = reinterpret_cast<__m256i*>(c + i * ldc);
+
+        _mm256_storeu_si256(p_c, _mm256_add_epi32(_mm256_loadu_si256(p_c), sum));
+    }
+}
+
+#if CK_HOST_X86_AVXVNNI
+// 6 x 16 micro-kernel, AVX-VNNI; A is packed as uint8
+__attribute__((target("avx2,avxvnni"))) inline void host_int8_gemm_micro_kernel_avxvnni(
+    index_t kq, const int8_t* a, const int8_t* b, int32_t* c, index_t ldc)
+{
+    constexpr index_t MR = 6;
+    constexpr index_t NR = 16;
+
+    __m256i acc[MR][2];
+
+    for(index_t i = 0; i < MR; ++i)
+    {
+        acc[i][0] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + i * ldc));
+        acc[i][1] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + i * ldc + 8));
+    }
+
+    for(index_t q = 0; q < kq; ++q)
+    {
+        const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + q * NR * 4));
+        const __m256i b1 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + q * NR * 4 + 32));
+
+        for(index_t i = 0; i < MR; ++i)
+        {
+            const __m256i a_i =
+                _mm256_set1_epi32(host_int8_gemm_load_quad(a + (q * MR + i) * 4));
+
+            acc[i][0] = _mm256_dpbusd_avx_epi32(acc[i][0], a_i, b0);
+            acc[i][1] = _mm256_dpbusd_avx_epi32(acc[i][1], a_i, b1);
+        }
+    }
+
+    for(index_t i = 0; i < MR; ++i)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + i * ldc), acc[i][0]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + i * ldc + 8), acc[i][1]);
+    }
+}
+#endif // CK_HOST_X86_AVXVNNI
+
+// 6 x 32 micro-kernel, AVX-512 VNNI; A is packed as uint8
+__attribute__((target("avx512f,avx512vnni"))) inline void host_int8_gemm_micro_kernel_avx512vnni(
+    index_t kq, const int8_t* a, const int8_t* b, int32_t* c, index_t ldc)
+{
+    constexpr index_t MR = 6;
+    constexpr index_t NR = 32;
+
+    __m512i acc[MR][2];
+
+    for(index_t i = 0; i < MR; ++i)
+    {
+        acc[i][0] = _mm512_loadu_si512(c + i * ldc);
+        acc[i][1] = _mm512_loadu_si512(c + i * ldc + 16);
+    }
+
+    for(index_t q = 0; q < kq; ++q)
+    {
+        const __m512i b0 = _mm512_loadu_si512(b + q * NR * 4);
+        const __m512i b1 = _mm512_loadu_si512(b + q * NR * 4 + 64);
+
+        for(index_t i = 0; i < MR; ++i)
+        {
+            const __m512i a_i =
+                _mm512_set1_epi32(host_int8_gemm_load_quad(a + (q * MR + i) * 4));
+
+            acc[i][0] = _mm512_dpbusd_epi32(acc[i][0], a_i, b0);
+            acc[i][1] = _mm512_dpbusd_epi32(acc[i][1], a_i, b1);
+        }
+    }
+
+    for(index_t i = 0; i < MR; ++i)
+    {
+        _mm512_storeu_si512(c + i * ldc, acc[i][0]);
+        _mm512_storeu_si512(c + i * ldc + 16, acc[i][1]);
+    }
+}
+#endif // CK_HOST_X86_SIMD
+
+} // namespace detail
+
+// every micro-kernel the running CPU supports, fastest first
+inline std::vector<HostInt8GemmMicroKernel> get_host_int8_gemm_micro_kernels()
+{
+    std::vector<HostInt8GemmMicroKernel> kernels;
+
+#if CK_HOST_X86_SIMD
+    if(__builtin_cpu_supports("avx512vnni"))
+        kernels.push_back({6, 32, true, &detail::host_int8_gemm_micro_kernel_avx512vnni});
+
+#if CK_HOST_X86_AVXVNNI
+    if(__builtin_cpu_supports("avxvnni"))
+        kernels.push_back({6, 16, true, &detail::host_int8_gemm_micro_kernel_avxvnni});
+#endif
+
+    if(__builtin_cpu_supports("avx2"))
+        kernels.push_back({6, 8, false, &detail::host_int8_gemm_micro_kernel_avx2});
+#endif
+
+    kernels.push_back({4, 16, false, &detail::host_int8_gemm_micro_kernel_generic<4, 16>});
+
+    return kernels;
+}
+
+inline HostInt8GemmMicroKernel get_host_int8_gemm_micro_kernel()
+{
+    return get_host_int8_gemm_micro_kernels().front();
+}
+
+// operand types HostInt8Gemm computes exactly
+template <typename ADataType, typename BDataType, typename AccDataType>
+inline constexpr bool is_host_int8_gemm_v = is_same_v<ADataType, int8_t> &&
+                                            is_same_v<BDataType, int8_t> &&
+                                            is_same_v<AccDataType, int32_t>;
+
+struct HostInt8Gemm
+{
+    using Blocking = HostGemmBlocking;
+
+    // K is blocked in groups of 4
+    static constexpr index_t KPack = 4;
+
+    HostInt8Gemm(index_t M,
+                 index_t N,
+                 index_t K,
+                 HostInt8GemmMicroKernel kernel = get_host_int8_gemm_micro_kernel())
+        : M_{M}, N_{N}, K_{K}, KQ_{math::integer_divide_ceil(K, KPack)}, kernel_{kernel}
+    {
+    }
+
+    // b_getter(k, n) returns B[k, n] as int8_t
+    template <typename BGetter>
+    void PackB(BGetter b_getter, std::size_t num_thread)
+    {
+        const index_t NR = kernel_.NR;
+
+        b_packed_.resize(static_cast<std::size_t>(GetNumBPanel()) * NR * KQ_ * KPack);
+        b_comp_.assign(kernel_.IsAUnsigned ? static_cast<std::size_t>(GetNumBPanel()) * NR : 0,
+                       0);
+
+        auto f_pack = [&](auto q) {
+            // data() + offset rather than operator[]: the buffer is empty when K_ == 0
+            int8_t* p_dst = b_packed_.data() + static_cast<std::size_t>(q) * NR * KQ_ * KPack;
+
+            for(index_t kq = 0; kq < KQ_; ++kq)
+            {
+                for(index_t j = 0; j < NR; ++j)
+                {
+                    const index_t n = q * NR + j;
+
+                    for(index_t t = 0; t < KPack; ++t)
+                    {
+                        const index_t k = kq * KPack + t;
+
+                        p_dst[(kq * NR + j) * KPack + t] =
+                            n < N_ && k < K_ ? b_getter(k, n) : int8_t{0};
+                    }
+                }
+            }
+
+            if(kernel_.IsAUnsigned)
+            {
+                for(index_t j = 0; j < NR; ++j)
+                {
+                    int32_t sum = 0;
+
+                    for(index_t kq = 0; kq < KQ_; ++kq)
+                        for(index_t t = 0; t < KPack; ++t)
+                            sum += p_dst[(kq * NR + j) * KPack + t];
+
+                    b_comp_[q * NR + j] = 128 * sum;
+                }
+            }
+        };
+
+        make_ParallelTensorFunctor(f_pack, GetNumBPanel())(num_thread);
+    }
+
+    // a_getter(m, k) returns A[m, k] as int8_t
+    // c_epilogue(m, n, acc) consumes the accumulated C[m, n] as int32_t
+    // PackB() must have been called before
+    template <typename AGetter, typename CEpilogue>
+    void Run(AGetter a_getter, CEpilogue c_epilogue, std::size_t num_thread) const
+    {
+        const index_t num_m_tile = math::integer_divide_ceil(M_, Blocking::MC);
+        const index_t num_n_tile = math::integer_divide_ceil(N_, Blocking::NC);
+
+        const index_t num_n_tile_per_task =
+            HostBlockedGemm<int32_t>::GetNumNTilePerTask(num_m_tile, num_n_tile, num_thread);
+        const index_t num_n_task =
+            num_n_tile_per_task > 0 ? math::integer_divide_ceil(num_n_tile, num_n_tile_per_task)
+                                    : 0;
+
+        auto f_task = [&](auto im, auto in) {
+            const index_t n_tile_begin = in * num_n_tile_per_task;
+            const index_t n_tile_end   = std::min(n_tile_begin + num_n_tile_per_task, num_n_tile);
+
+            RunTile(im, n_tile_begin, n_tile_end, a_getter, c_epilogue);
+        };
+
+        make_ParallelTensorFunctor(f_task, num_m_tile, num_n_task)(num_thread);
+    }
+
+    private:
+    template <typename AGetter, typename CEpilogue>
+    void RunTile(index_t im,
+                 index_t n_tile_begin,
+                 index_t n_tile_end,
+                 AGetter& a_getter,
+                 CEpilogue& c_epilogue) const
+    {
+        const index_t MR = kernel_.MR;
+        const index_t NR = kernel_.NR;
+        const index_t KC = Blocking::KC / KPack;
+
+        const index_t m0     = im * Blocking::MC;
+        const index_t mc     = std::min(Blocking::MC, M_ - m0);
+        const index_t mc_pad = math::integer_divide_ceil(mc, MR) * MR;
+
+        // flips the sign bit, i.e. adds 128 to the byte read as uint8
+        const int8_t a_bias = kernel_.IsAUnsigned ? static_cast<int8_t>(0x80) : int8_t{0};
+
+        // pack A row block into kq x MR x 4 micro-panels
+        std::vector<int8_t> a_packed(static_cast<std::size_t>(mc_pad) * KQ_ * KPack);
+
+        for(index_t ir = 0; ir < mc_pad; ir += MR)
+        {
+            int8_t* p_dst = a_packed.data() + static_cast<std::size_t>(ir) * KQ_ * KPack;
+
+            for(index_t kq = 0; kq < KQ_; ++kq)
+            {
+                for(index_t i = 0; i < MR; ++i)
+                {
+                    const index_t m = m0 + ir + i;
+
+                    for(index_t t = 0; t < KPack; ++t)
+                    {
+                        const index_t k = kq * KPack + t;
+
+                        const int8_t v_a = m < M_ && k < K_ ? a_getter(m, k) : int8_t{0};
+
+                        p_dst[(kq * MR + i) * KPack + t] = static_cast<int8_t>(v_a ^ a_bias);
+                    }
+                }
+            }
+        }
+
+        std::vector<int32_t> c_tile(static_cast<std::size_t>(mc_pad) * Blocking::NC);
+
+        for(index_t in = n_tile_begin; in < n_tile_end; ++in)
+        {
+            const index_t n0     = in * Blocking::NC;
+            const index_t nc     = std::min(Blocking::NC, N_ - n0);
+            const index_t nc_pad = math::integer_divide_ceil(nc, NR) * NR;
+            const index_t ldc    = nc_pad;
+
+            std::fill(c_tile.begin(), c_tile.end(), 0);
+
+            for(index_t pc = 0; pc < KQ_; pc += KC)
+            {
+                const index_t kc = std::min(KC, KQ_ - pc);
+
+                for(index_t jr = 0; jr < nc_pad; jr += NR)
+                {
+                    const int8_t* p_b = b_packed_.data() +
+                                        (static_cast<std::size_t>(n0 + jr) * KQ_ + pc * NR) * KPack;
+
+                    for(index_t ir = 0; ir < mc_pad; ir += MR)
+                    {
+                        const int8_t* p_a =
+                            a_packed.data() +
+                            (static_cast<std::size_t>(ir) * KQ_ + pc * MR) * KPack;
+
+                        kernel_.Run(kc, p_a, p_b, &c_tile[ir * ldc + jr], ldc);
+                    }
+                }
+            }
+
+            for(index_t i = 0; i < mc; ++i)
+            {
+                for(index_t j = 0; j < nc; ++j)
+                {
+                    int32_t v_acc = c_tile[i * ldc + j];
+
+                    if(kernel_.IsAUnsigned)
+                        v_acc -= b_comp_[n0 + j];
+
+                    c_epilogue(m0 + i, n0 + j, v_acc);
+                }
+            }
+        }
+    }
+
+    index_t GetNumBPanel() const { return math::integer_divide_ceil(N_, kernel_.NR); }
+
+    index_t M_;
+    index_t N_;
+    index_t K_;
+    index_t KQ_;
+
+    HostInt8GemmMicroKernel kernel_;
+
+    std::vector<int8_t> b_packed_;
+
+    // 128 * sum_k B[k, n], for kernels that read A as uint8
+    std::vector<int32_t> b_comp_;
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
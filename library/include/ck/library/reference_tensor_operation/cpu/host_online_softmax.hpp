@@ -0,0 +1,302 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+#include "ck/library/utility/host_simd.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Running max and sum of exp(x - max) of a softmax reduction.
+//
+// @paragraph
+//             Online softmax recurrence (Milakov & Gimelshein): when a new maximum m' shows up
+//             the sum is rescaled by exp(m - m'), so max and sum are obtained in one streaming
+//             pass. Two states over disjoint parts of a reduction combine with Merge().
+//
+// @paragraph
+//             Special values come out as in the two-pass softmax: a +inf is the maximum and its
+//             own term exp(inf - inf) is NaN, so a row holding +inf, like one holding a NaN, is
+//             NaN throughout.
+//
+template <typename AccDataType>
+struct HostSoftmaxState
+{
+    AccDataType max_ = std::numeric_limits<AccDataType>::lowest();
+    AccDataType sum_ = 0;
+
+    void Update(AccDataType x)
+    {
+        if(x > max_)
+        {
+            // x's own term exp(x - x) is 1, or NaN for x = +inf
+            sum_ = sum_ * std::exp(max_ - x) + std::exp(x - x);
+            max_ = x;
+        }
+        else
+        {
+            sum_ += std::exp(x - max_);
+        }
+    }
+
+    void Merge(AccDataType max, AccDataType sum)
+    {
+        const AccDataType new_max = std::max(max_, max);
+
+        sum_ = sum_ * std::exp(max_ - new_max) + sum * std::exp(max - new_max);
+        max_ = new_max;
+    }
+};
+
+namespace detail {
+
+#if CK_HOST_X86_SIMD
+
+// Lane-wise online recurrence over blocks of 4 vectors: one rescale per block, one exp per
+// element. Returns the number of elements consumed; the caller handles the tail.
+__attribute__((target("avx2"))) inline index_t
+host_softmax_accumulate_f32_avx2(HostSoftmaxState<float>& state, const float* p_in, index_t n)
+{
+    constexpr index_t Block = 4 * 8;
+
+    __m256 v_max = _mm256_set1_ps(std::numeric_limits<float>::lowest());
+    __m256 v_sum = _mm256_setzero_ps();
+
+    index_t i = 0;
+
+    for(; i + Block <= n; i += Block)
+    {
+        const __m256 x0 = _mm256_loadu_ps(p_in + i);
+        const __m256 x1 = _mm256_loadu_ps(p_in + i + 8);
+        const __m256 x2 = _mm256_loadu_ps(p_in + i + 16);
+        const __m256 x3 = _mm256_loadu_ps(p_in + i + 24);
+
+        const __m256 v_block_max = _mm256_max_ps(_mm256_max_ps(x0, x1), _mm256_max_ps(x2, x3));
+        const __m256 v_new_max   = _mm256_max_ps(v_max, v_block_max);
+
+        __m256 v_block_sum = host_simd::exp_f32x8(_mm256_sub_ps(x0, v_new_max));
+        v_block_sum =
+            _mm256_add_ps(v_block_sum, host_simd::exp_f32x8(_mm256_sub_ps(x1, v_new_max)));
+        v_block_sum =
+            _mm256_add_ps(v_block_sum, host_simd::exp_f32x8(_mm256_sub_ps(x2, v_new_max)));
+        v_block_sum =
+            _mm256_add_ps(v_block_sum, host_simd::exp_f32x8(_mm256_sub_ps(x3, v_new_max)));
+
+        v_sum = _mm256_add_ps(
+            _mm256_mul_ps(v_sum, host_simd::exp_f32x8(_mm256_sub_ps(v_max, v_new_max))),
+            v_block_sum);
+        v_max = v_new_max;
+    }
+
+    if(i > 0)
+    {
+        alignas(32) float lane_max[8];
+        alignas(32) float lane_sum[8];
+
+        _mm256_store_ps(lane_max, v_max);
+        _mm256_store_ps(lane_sum, v_sum);
+
+        for(index_t l = 0; l < 8; ++l)
+        {
+            state.Merge(lane_max[l], lane_sum[l]);
+        }
+    }
+
+    return i;
+}
+
+__attribute__((target("avx512f"))) inline index_t
+host_softmax_accumulate_f32_avx512(HostSoftmaxState<float>& state, const float* p_in, index_t n)
+{
+    constexpr index_t Block = 4 * 16;
+
+    __m512 v_max = _mm512_set1_ps(std::numeric_limits<float>::lowest());
+    __m512 v_sum = _mm512_setzero_ps();
+
+    index_t i = 0;
+
+    for(; i + Block <= n; i += Block)
+    {
+        const __m512 x0 = _mm512_loadu_ps(p_in + i);
+        const __m512 x1 = _mm512_loadu_ps(p_in + i + 16);
+        const __m512 x2 = _mm512_loadu_ps(p_in + i + 32);
+        const __m512 x3 = _mm512_loadu_ps(p_in + i + 48);
+
+        const __m512 v_block_max = _mm512_max_ps(_mm512_max_ps(x0, x1), _mm512_max_ps(x2, x3));
+        const __m512 v_new_max   = _mm512_max_ps(v_max, v_block_max);
+
+        __m512 v_block_sum = host_simd::exp_f32x16(_mm512_sub_ps(x0, v_new_max));
+        v_block_sum =
+            _mm512_add_ps(v_block_sum, host_simd::exp_f32x16(_mm512_sub_ps(x1, v_new_max)));
+        v_block_sum =
+            _mm512_add_ps(v_block_sum, host_simd::exp_f32x16(_mm512_sub_ps(x2, v_new_max)));
+        v_block_sum =
+            _mm512_add_ps(v_block_sum, host_simd::exp_f32x16(_mm512_sub_ps(x3, v_new_max)));
+
+        v_sum = _mm512_add_ps(
+            _mm512_mul_ps(v_sum, host_simd::exp_f32x16(_mm512_sub_ps(v_max, v_new_max))),
+            v_block_sum);
+        v_max = v_new_max;
+    }
+
+    if(i > 0)
+    {
+        alignas(64) float lane_max[16];
+        alignas(64) float lane_sum[16];
+
+        _mm512_store_ps(lane_max, v_max);
+        _mm512_store_ps(lane_sum, v_sum);
+
+        for(index_t l = 0; l < 16; ++l)
+        {
+            state.Merge(lane_max[l], lane_sum[l]);
+        }
+    }
+
+    return i;
+}
+
+// out[i] = alpha * exp(in[i] - max) / sum + beta * out[i]; returns the number of elements done
+__attribute__((target("avx2"))) inline index_t
+host_softmax_normalize_f32_avx2(const HostSoftmaxState<float>& state,
+                                const float* p_in,
+                                float* p_out,
+                                index_t n,
+                                float alpha,
+                                float beta)
+{
+    const __m256 v_max   = _mm256_set1_ps(state.max_);
+    const __m256 v_sum   = _mm256_set1_ps(state.sum_);
+    const __m256 v_alpha = _mm256_set1_ps(alpha);
+    const __m256 v_beta  = _mm256_set1_ps(beta);
+
+    index_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m256 v_exp = host_simd::exp_f32x8(_mm256_sub_ps(_mm256_loadu_ps(p_in + i), v_max));
+
+        _mm256_storeu_ps(p_out + i,
+                         _mm256_add_ps(_mm256_div_ps(_mm256_mul_ps(v_alpha, v_exp), v_sum),
+                                       _mm256_mul_ps(v_beta, _mm256_loadu_ps(p_out + i))));
+    }
+
+    return i;
+}
+
+__attribute__((target("avx512f"))) inline index_t
+host_softmax_normalize_f32_avx512(const HostSoftmaxState<float>& state,
+                                  const float* p_in,
+                                  float* p_out,
+                                  index_t n,
+                                  float alpha,
+                                  float beta)
+{
+    const __m512 v_max   = _mm512_set1_ps(state.max_);
+    const __m512 v_sum   = _mm512_set1_ps(state.sum_);
+    const __m512 v_alpha = _mm512_set1_ps(alpha);
+    const __m512 v_beta  = _mm512_set1_ps(beta);
+
+    index_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+    {
+        const __m512 v_exp =
+            host_simd::exp_f32x16(_mm512_sub_ps(_mm512_loadu_ps(p_in + i), v_max));
+
+        _mm512_storeu_ps(p_out + i,
+                         _mm512_add_ps(_mm512_div_ps(_mm512_mul_ps(v_alpha, v_exp), v_sum),
+                                       _mm512_mul_ps(v_beta, _mm512_loadu_ps(p_out + i))));
+    }
+
+    return i;
+}
+
+#endif // CK_HOST_X86_SIMD
+
+} // namespace detail
+
+// folds in[0], in[stride], ..., in[(n - 1) * stride] into the state
+template <typename AccDataType, typename InDataType>
+void host_softmax_accumulate(HostSoftmaxState<AccDataType>& state,
+                             const InDataType* p_in,
+                             index_t n,
+                             index_t stride)
+{
+    index_t i = 0;
+
+#if CK_HOST_X86_SIMD
+    if constexpr(is_same_v<AccDataType, float> && is_same_v<InDataType, float>)
+    {
+        if(stride == 1)
+        {
+            HostSoftmaxState<float> simd_state;
+
+            if(__builtin_cpu_supports("avx512f"))
+                i = detail::host_softmax_accumulate_f32_avx512(simd_state, p_in, n);
+            else if(__builtin_cpu_supports("avx2"))
+                i = detail::host_softmax_accumulate_f32_avx2(simd_state, p_in, n);
+
+            if(i > 0)
+                state.Merge(simd_state.max_, simd_state.sum_);
+        }
+    }
+#endif
+
+    for(; i < n; ++i)
+    {
+        state.Update(ck::type_convert<AccDataType>(p_in[i * stride]));
+    }
+}
+
+// out[i * out_stride] = alpha * exp(in[i * in_stride] - max) / sum + beta * out[i * out_stride]
+template <typename AccDataType, typename InDataType, typename OutDataType>
+void host_softmax_normalize(const HostSoftmaxState<AccDataType>& state,
+                            const InDataType* p_in,
+                            OutDataType* p_out,
+                            index_t n,
+                            index_t in_stride,
+                            index_t out_stride,
+                            AccDataType alpha,
+                            AccDataType beta)
+{
+    index_t i = 0;
+
+#if CK_HOST_X86_SIMD
+    if constexpr(is_same_v<AccDataType, float> && is_same_v<InDataType, float> &&
+                 is_same_v<OutDataType, float>)
+    {
+        if(in_stride == 1 && out_stride == 1)
+        {
+            if(__builtin_cpu_supports("avx512f"))
+                i = detail::host_softmax_normalize_f32_avx512(state, p_in, p_out, n, alpha, beta);
+            else if(__builtin_cpu_supports("avx2"))
+                i = detail::host_softmax_normalize_f32_avx2(state, p_in, p_out, n, alpha, beta);
+        }
+    }
+#endif
+
+    for(; i < n; ++i)
+    {
+        const AccDataType v_exp =
+            std::exp(ck::type_convert<AccDataType>(p_in[i * in_stride]) - state.max_);
+
+        const AccDataType v_out = alpha * v_exp / state.sum_ +
+                                  beta * ck::type_convert<AccDataType>(p_out[i * out_stride]);
+
+        p_out[i * out_stride] = ck::type_convert<OutDataType>(v_out);
+    }
+}
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,424 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/math.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "ck/library/utility/host_simd.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Host permute / layout conversion engine.
+//
+// @paragraph
+//             out[i0, i1, ...] = element_op(in[i0, i1, ...]) for an input and an output sharing
+//             the same lengths but with different strides. The dimensions are ordered by output
+//             stride and those contiguous in both tensors are merged, then the problem is split
+//             into:
+//             - a bundle: the innermost run of elements contiguous in both tensors (e.g. the 4
+//               halves of an HxWx4 bundle), moved as one unit;
+//             - a 2D transpose between the dimension contiguous in the input (R) and the one
+//               contiguous in the output (C), over bundles;
+//             - the outer dimensions.
+//
+// @paragraph
+//             Each task transposes one Tile x Tile block of one outer index, recursively halving
+//             the longer side down to BaseTile x BaseTile, so the reads and the writes of a leaf
+//             both stay in L1 whatever the strides. For a plain copy (PassThrough between equal
+//             types) of 2, 4 or 8 byte units, leaves are transposed in SSE2 registers.
+//
+struct HostPermuteBlocking
+{
+    static constexpr index_t Tile     = 256;
+    static constexpr index_t BaseTile = 32;
+};
+
+struct HostPermuteDescriptor
+{
+    struct Dim
+    {
+        index_t length         = 1;
+        std::size_t in_stride  = 0;
+        std::size_t out_stride = 0;
+    };
+
+    // lengths and strides in the same (input) dimension order
+    HostPermuteDescriptor(const std::vector<index_t>& lengths,
+                          const std::vector<std::size_t>& in_strides,
+                          const std::vector<std::size_t>& out_strides)
+    {
+        num_element_ =
+            std::accumulate(lengths.begin(), lengths.end(), std::size_t{1}, std::multiplies<>{});
+
+        std::vector<Dim> dims;
+
+        for(std::size_t d = 0; d < lengths.size(); ++d)
+        {
+            if(lengths[d] != 1)
+                dims.push_back({lengths[d], in_strides[d], out_strides[d]});
+        }
+
+        // output order, outermost first
+        std::stable_sort(dims.begin(), dims.end(), [](const Dim& x, const Dim& y) {
+            return x.out_stride > y.out_stride ||
+                   (x.out_stride == y.out_stride && x.in_stride > y.in_stride);
+        });
+
+        std::vector<Dim> merged_dims;
+
+        for(const auto& dim : dims)
+        {
+            if(!merged_dims.empty() &&
+               merged_dims.back().in_stride == dim.in_stride * dim.length &&
+               merged_dims.back().out_stride == dim.out_stride * dim.length)
+            {
+                merged_dims.back().length *= dim.length;
+                merged_dims.back().in_stride  = dim.in_stride;
+                merged_dims.back().out_stride = dim.out_stride;
+            }
+            else
+            {
+                merged_dims.push_back(dim);
+            }
+        }
+
+        // a pure copy keeps its only dimension as C, so it is still split into tasks
+        if(merged_dims.size() > 1 && merged_dims.back().in_stride == 1 &&
+           merged_dims.back().out_stride == 1)
+        {
+            bundle_length_ = merged_dims.back().length;
+            merged_dims.pop_back();
+        }
+
+        if(!merged_dims.empty())
+        {
+            c_ = merged_dims.back();
+            merged_dims.pop_back();
+        }
+
+        // R is worth transposing with C only if it is read more contiguously
+        auto r_iter = std::min_element(
+            merged_dims.begin(), merged_dims.end(), [](const Dim& x, const Dim& y) {
+                return x.in_stride < y.in_stride;
+            });
+
+        if(r_iter != merged_dims.end() && r_iter->in_stride < c_.in_stride)
+        {
+            r_ = *r_iter;
+            merged_dims.erase(r_iter);
+        }
+
+        for(const auto& dim : merged_dims)
+        {
+            outer_lengths_.push_back(dim.length);
+            outer_in_strides_.push_back(dim.in_stride);
+            outer_out_strides_.push_back(dim.out_stride);
+        }
+    }
+
+    index_t GetNumOuter() const
+    {
+        return std::accumulate(
+            outer_lengths_.begin(), outer_lengths_.end(), index_t{1}, std::multiplies<>{});
+    }
+
+    // offsets of the outer index i into the input and the output
+    void GetOuterOffsets(index_t i, std::size_t& in_offset, std::size_t& out_offset) const
+    {
+        in_offset  = 0;
+        out_offset = 0;
+
+        for(std::size_t d = outer_lengths_.size(); d-- > 0;)
+        {
+            const index_t idx = i % outer_lengths_[d];
+
+            i /= outer_lengths_[d];
+
+            in_offset += idx * outer_in_strides_[d];
+            out_offset += idx * outer_out_strides_[d];
+        }
+    }
+
+    std::size_t num_element_;
+
+    index_t bundle_length_ = 1;
+
+    // R and C of length 1 when there is nothing to transpose
+    Dim r_;
+    Dim c_;
+
+    std::vector<index_t> outer_lengths_;
+    std::vector<std::size_t> outer_in_strides_;
+    std::vector<std::size_t> outer_out_strides_;
+};
+
+namespace detail {
+
+#if CK_HOST_X86_SIMD
+// out[r * ld_out + c] = in[c * ld_in + r] for a V x V tile of UnitBytes units, V = 16 / UnitBytes;
+// SSE2 is part of x86-64, no run-time dispatch is needed
+template <index_t UnitBytes>
+inline void host_transpose_tile_sse2(const char* p_in,
+                                     std::size_t ld_in,
+                                     char* p_out,
+                                     std::size_t ld_out)
+{
+    constexpr index_t V = 16 / UnitBytes;
+
+    __m128i x[V];
+
+    for(index_t i = 0; i < V; ++i)
+        x[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_in + i * ld_in * UnitBytes));
+
+    if constexpr(UnitBytes == 2)
+    {
+        __m128i a[8];
+        __m128i b[8];
+
+        for(index_t i = 0; i < 8; i += 2)
+        {
+            a[i / 2]     = _mm_unpacklo_epi16(x[i], x[i + 1]);
+            a[i / 2 + 4] = _mm_unpackhi_epi16(x[i], x[i + 1]);
+        }
+
+        // a[0..3]: columns 0-3 of row pairs (0, 1) .. (6, 7), a[4..7]: columns 4-7
+        for(index_t h = 0; h < 8; h += 4)
+        {
+            b[h + 0] = _mm_unpacklo_epi32(a[h + 0], a[h + 1]);
+            b[h + 1] = _mm_unpackhi_epi32(a[h + 0], a[h + 1]);
+            b[h + 2] = _mm_unpacklo_epi32(a[h + 2], a[h + 3]);
+            b[h + 3] = _mm_unpackhi_epi32(a[h + 2], a[h + 3]);
+        }
+
+        for(index_t h = 0; h < 8; h += 4)
+        {
+            x[h + 0] = _mm_unpacklo_epi64(b[h + 0], b[h + 2]);
+            x[h + 1] = _mm_unpackhi_epi64(b[h + 0], b[h + 2]);
+            x[h + 2] = _mm_unpacklo_epi64(b[h + 1], b[h + 3]);
+            x[h + 3] = _mm_unpackhi_epi64(b[h + 1], b[h + 3]);
+        }
+    }
+    else if constexpr(UnitBytes == 4)
+    {
+        const __m128i a0 = _mm_unpacklo_epi32(x[0], x[1]);
+        const __m128i a1 = _mm_unpackhi_epi32(x[0], x[1]);
+        const __m128i a2 = _mm_unpacklo_epi32(x[2], x[3]);
+        const __m128i a3 = _mm_unpackhi_epi32(x[2], x[3]);
+
+        x[0] = _mm_unpacklo_epi64(a0, a2);
+        x[1] = _mm_unpackhi_epi64(a0, a2);
+        x[2] = _mm_unpacklo_epi64(a1, a3);
+        x[3] = _mm_unpackhi_epi64(a1, a3);
+    }
+    else
+    {
+        const __m128i a0 = _mm_unpacklo_epi64(x[0], x[1]);
+        const __m128i a1 = _mm_unpackhi_epi64(x[0], x[1]);
+
+        x[0] = a0;
+        x[1] = a1;
+    }
+
+    for(index_t i = 0; i < V; ++i)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p_out + i * ld_out * UnitBytes), x[i]);
+}
+#endif // CK_HOST_X86_SIMD
+
+template <typename InDataType, typename OutDataType, typename ElementwiseOperation>
+struct HostPermuteTask
+{
+    static constexpr bool IsCopy =
+        is_same_v<InDataType, OutDataType> &&
+        is_same_v<ElementwiseOperation, element_wise::PassThrough>;
+
+    // bytes of the unit moved by the SSE2 kernels, 0 if they do not apply
+    static index_t GetSimdUnitBytes(const HostPermuteDescriptor& desc)
+    {
+#if CK_HOST_X86_SIMD
+        if constexpr(IsCopy)
+        {
+            const std::size_t bundle   = desc.bundle_length_;
+            const std::size_t unit     = bundle * sizeof(InDataType);
+            const bool is_unit_strided = desc.r_.in_stride == bundle &&
+                                         desc.c_.out_stride == bundle &&
+                                         desc.c_.in_stride % bundle == 0 &&
+                                         desc.r_.out_stride % bundle == 0;
+
+            if(is_unit_strided && (unit == 2 || unit == 4 || unit == 8))
+                return static_cast<index_t>(unit);
+        }
+#endif
+        (void)desc;
+
+        return 0;
+    }
+
+    void RunLeaf(index_t r0, index_t r1, index_t c0, index_t c1) const
+    {
+        const index_t bundle = desc_.bundle_length_;
+
+        const InDataType* p_in = p_in_ + r0 * desc_.r_.in_stride + c0 * desc_.c_.in_stride;
+        OutDataType* p_out     = p_out_ + r0 * desc_.r_.out_stride + c0 * desc_.c_.out_stride;
+
+#if CK_HOST_X86_SIMD
+        if constexpr(IsCopy)
+        {
+            if(simd_unit_bytes_ != 0)
+            {
+                const index_t V = 16 / simd_unit_bytes_;
+
+                const std::size_t ld_in  = desc_.c_.in_stride / bundle;
+                const std::size_t ld_out = desc_.r_.out_stride / bundle;
+
+                const index_t r_end = r0 + (r1 - r0) / V * V;
+                const index_t c_end = c0 + (c1 - c0) / V * V;
+
+                for(index_t r = r0; r < r_end; r += V)
+                {
+                    for(index_t c = c0; c < c_end; c += V)
+                    {
+                        const auto* p_in_tile = reinterpret_cast<const char*>(
+                            p_in + (r - r0) * desc_.r_.in_stride + (c - c0) * desc_.c_.in_stride);
+                        auto* p_out_tile = reinterpret_cast<char*>(
+                            p_out + (r - r0) * desc_.r_.out_stride +
+                            (c - c0) * desc_.c_.out_stride);
+
+                        switch(simd_unit_bytes_)
+                        {
+                        case 2:
+                            host_transpose_tile_sse2<2>(p_in_tile, ld_in, p_out_tile, ld_out);
+                            break;
+                        case 4:
+                            host_transpose_tile_sse2<4>(p_in_tile, ld_in, p_out_tile, ld_out);
+                            break;
+                        default:
+                            host_transpose_tile_sse2<8>(p_in_tile, ld_in, p_out_tile, ld_out);
+                            break;
+                        }
+                    }
+                }
+
+                // the remainders, as the scalar path
+                RunScalar(r_end, r1, c0, c1);
+                RunScalar(r0, r_end, c_end, c1);
+
+                return;
+            }
+        }
+#endif
+        (void)p_in;
+        (void)p_out;
+
+        RunScalar(r0, r1, c0, c1);
+    }
+
+    void RunScalar(index_t r0, index_t r1, index_t c0, index_t c1) const
+    {
+        const index_t bundle = desc_.bundle_length_;
+
+        for(index_t r = r0; r < r1; ++r)
+        {
+            const InDataType* p_in = p_in_ + r * desc_.r_.in_stride;
+            OutDataType* p_out     = p_out_ + r * desc_.r_.out_stride;
+
+            for(index_t c = c0; c < c1; ++c)
+            {
+                const InDataType* p_in_c = p_in + c * desc_.c_.in_stride;
+                OutDataType* p_out_c     = p_out + c * desc_.c_.out_stride;
+
+                for(index_t b = 0; b < bundle; ++b)
+                    element_op_(p_out_c[b], p_in_c[b]);
+            }
+        }
+    }
+
+    // cache-oblivious: halve the longer side, at a multiple of BaseTile, down to a leaf
+    void Run(index_t r0, index_t r1, index_t c0, index_t c1) const
+    {
+        constexpr index_t BaseTile = HostPermuteBlocking::BaseTile;
+
+        const index_t r_length = r1 - r0;
+        const index_t c_length = c1 - c0;
+
+        if(r_length <= BaseTile && c_length <= BaseTile)
+        {
+            RunLeaf(r0, r1, c0, c1);
+        }
+        else if(r_length >= c_length)
+        {
+            const index_t r_mid = r0 + math::integer_divide_ceil(r_length, BaseTile) / 2 * BaseTile;
+
+            Run(r0, r_mid, c0, c1);
+            Run(r_mid, r1, c0, c1);
+        }
+        else
+        {
+            const index_t c_mid = c0 + math::integer_divide_ceil(c_length, BaseTile) / 2 * BaseTile;
+
+            Run(r0, r1, c0, c_mid);
+            Run(r0, r1, c_mid, c1);
+        }
+    }
+
+    const HostPermuteDescriptor& desc_;
+    const InDataType* p_in_;
+    OutDataType* p_out_;
+    ElementwiseOperation element_op_;
+    index_t simd_unit_bytes_;
+};
+
+} // namespace detail
+
+template <typename InDataType, typename OutDataType, typename ElementwiseOperation>
+void host_permute(const HostPermuteDescriptor& desc,
+                  const InDataType* p_in,
+                  OutDataType* p_out,
+                  ElementwiseOperation element_op,
+                  std::size_t num_thread)
+{
+    using Task = detail::HostPermuteTask<InDataType, OutDataType, ElementwiseOperation>;
+
+    constexpr index_t Tile = HostPermuteBlocking::Tile;
+
+    if(desc.num_element_ == 0)
+        return;
+
+    const index_t simd_unit_bytes = Task::GetSimdUnitBytes(desc);
+
+    const index_t num_r_tile = math::integer_divide_ceil(desc.r_.length, Tile);
+    const index_t num_c_tile = math::integer_divide_ceil(desc.c_.length, Tile);
+
+    auto f_task = [&](auto i_outer, auto i_r_tile, auto i_c_tile) {
+        std::size_t in_offset;
+        std::size_t out_offset;
+
+        desc.GetOuterOffsets(i_outer, in_offset, out_offset);
+
+        const Task task{desc, p_in + in_offset, p_out + out_offset, element_op, simd_unit_bytes};
+
+        const index_t r0 = i_r_tile * Tile;
+        const index_t c0 = i_c_tile * Tile;
+
+        task.Run(
+            r0, std::min(r0 + Tile, desc.r_.length), c0, std::min(c0 + Tile, desc.c_.length));
+    };
+
+    make_ParallelTensorFunctor(f_task, desc.GetNumOuter(), num_r_tile, num_c_tile)(num_thread);
+}
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
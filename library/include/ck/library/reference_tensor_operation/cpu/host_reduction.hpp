@@ -0,0 +1,530 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/math.hpp"
+#include "ck/utility/math_v2.hpp"
+#include "ck/utility/reduction_functions_accumulate.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "ck/library/utility/host_simd.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+// Number of interleaved accumulators of the contiguous reduction kernels: element i goes to
+// lane i % NumLane and every lane is a sequential reduction of its own elements, so the lane
+// results, and everything combined from them, do not depend on whether the lanes were advanced
+// by the x86 kernels or by the portable loop.
+inline constexpr index_t HostReductionNumLane = 16;
+
+namespace detail {
+
+// the reductions / input element-wise operations the x86 lane kernels implement
+template <typename ReduceOperation, typename InElementwiseOperation>
+inline constexpr bool is_host_simd_reduction_v =
+    (is_same_v<ReduceOperation, reduce::Add> || is_same_v<ReduceOperation, reduce::Max> ||
+     is_same_v<ReduceOperation, reduce::Min> || is_same_v<ReduceOperation, reduce::AMax>) &&
+    (is_same_v<InElementwiseOperation, element_wise::PassThrough> ||
+     is_same_v<InElementwiseOperation, element_wise::UnaryAbs> ||
+     is_same_v<InElementwiseOperation, element_wise::UnarySquare>);
+
+#if CK_HOST_X86_SIMD
+
+template <typename InElementwiseOperation>
+__attribute__((target("avx2"))) inline __m256 host_reduce_in_op_f32x8(__m256 v)
+{
+    if constexpr(is_same_v<InElementwiseOperation, element_wise::UnaryAbs>)
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v);
+    else if constexpr(is_same_v<InElementwiseOperation, element_wise::UnarySquare>)
+        return _mm256_mul_ps(v, v);
+    else
+        return v;
+}
+
+// lanes to update for Max / Min / AMax: the compare is strict and ordered, like the operators,
+// so a NaN never wins and a tie keeps the earlier element
+template <typename ReduceOperation>
+__attribute__((target("avx2"))) inline __m256 host_reduce_update_mask_f32x8(__m256 v_acc,
+                                                                            __m256 v)
+{
+    if constexpr(is_same_v<ReduceOperation, reduce::Min>)
+        return _mm256_cmp_ps(v, v_acc, _CMP_LT_OQ);
+    else
+        return _mm256_cmp_ps(v_acc, v, _CMP_LT_OQ);
+}
+
+// Advances the 16 lanes over the full blocks of p_in[0, n) exactly like the portable lane loop;
+// returns the number of elements consumed
+template <typename ReduceOperation, bool OutputIndex, typename InElementwiseOperation>
+__attribute__((target("avx2"))) inline std::size_t
+host_reduce_lanes_f32_avx2(const float* p_in,
+                           std::size_t n,
+                           float* p_lanes,
+                           int32_t* p_lane_indices,
+                           bool& has_nan)
+{
+    __m256 v_acc0 = _mm256_loadu_ps(p_lanes);
+    __m256 v_acc1 = _mm256_loadu_ps(p_lanes + 8);
+
+    __m256i v_index0 = _mm256_setzero_si256();
+    __m256i v_index1 = _mm256_setzero_si256();
+
+    __m256i v_cur_index0 = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i v_cur_index1 = _mm256_setr_epi32(8, 9, 10, 11, 12, 13, 14, 15);
+
+    const __m256i v_index_step = _mm256_set1_epi32(16);
+
+    __m256 v_nan = _mm256_setzero_ps();
+
+    std::size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+    {
+        const __m256 v0 =
+            host_reduce_in_op_f32x8<InElementwiseOperation>(_mm256_loadu_ps(p_in + i));
+        const __m256 v1 =
+            host_reduce_in_op_f32x8<InElementwiseOperation>(_mm256_loadu_ps(p_in + i + 8));
+
+        // unordered as soon as either operand is a NaN
+        v_nan = _mm256_or_ps(v_nan, _mm256_cmp_ps(v0, v1, _CMP_UNORD_Q));
+
+        if constexpr(is_same_v<ReduceOperation, reduce::Add>)
+        {
+            v_acc0 = _mm256_add_ps(v_acc0, v0);
+            v_acc1 = _mm256_add_ps(v_acc1, v1);
+        }
+        else
+        {
+            const __m256 m0 = host_reduce_update_mask_f32x8<ReduceOperation>(v_acc0, v0);
+            const __m256 m1 = host_reduce_update_mask_f32x8<ReduceOperation>(v_acc1, v1);
+
+            v_acc0 = _mm256_blendv_ps(v_acc0, v0, m0);
+            v_acc1 = _mm256_blendv_ps(v_acc1, v1, m1);
+
+            if constexpr(OutputIndex)
+            {
+                v_index0 = _mm256_blendv_epi8(v_index0, v_cur_index0, _mm256_castps_si256(m0));
+                v_index1 = _mm256_blendv_epi8(v_index1, v_cur_index1, _mm256_castps_si256(m1));
+
+                v_cur_index0 = _mm256_add_epi32(v_cur_index0, v_index_step);
+                v_cur_index1 = _mm256_add_epi32(v_cur_index1, v_index_step);
+            }
+        }
+    }
+
+    _mm256_storeu_ps(p_lanes, v_acc0);
+    _mm256_storeu_ps(p_lanes + 8, v_acc1);
+
+    if constexpr(OutputIndex)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_lane_indices), v_index0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_lane_indices + 8), v_index1);
+    }
+
+    has_nan = _mm256_movemask_ps(v_nan) != 0;
+
+    return i;
+}
+
+template <typename ReduceOperation, bool OutputIndex, typename InElementwiseOperation>
+__attribute__((target("avx512f"))) inline std::size_t
+host_reduce_lanes_f32_avx512(const float* p_in,
+                             std::size_t n,
+                             float* p_lanes,
+                             int32_t* p_lane_indices,
+                             bool& has_nan)
+{
+    __m512 v_acc = _mm512_loadu_ps(p_lanes);
+
+    __m512i v_index     = _mm512_setzero_si512();
+    __m512i v_cur_index = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    const __m512i v_index_step = _mm512_set1_epi32(16);
+
+    __mmask16 nan_mask = 0;
+
+    std::size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+    {
+        __m512 v = _mm512_loadu_ps(p_in + i);
+
+        if constexpr(is_same_v<InElementwiseOperation, element_wise::UnaryAbs>)
+            v = _mm512_abs_ps(v);
+        else if constexpr(is_same_v<InElementwiseOperation, element_wise::UnarySquare>)
+            v = _mm512_mul_ps(v, v);
+
+        nan_mask |= _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+
+        if constexpr(is_same_v<ReduceOperation, reduce::Add>)
+        {
+            v_acc = _mm512_add_ps(v_acc, v);
+        }
+        else
+        {
+            const __mmask16 m = is_same_v<ReduceOperation, reduce::Min>
+                                    ? _mm512_cmp_ps_mask(v, v_acc, _CMP_LT_OQ)
+                                    : _mm512_cmp_ps_mask(v_acc, v, _CMP_LT_OQ);
+
+            v_acc = _mm512_mask_blend_ps(m, v_acc, v);
+
+            if constexpr(OutputIndex)
+            {
+                v_index     = _mm512_mask_blend_epi32(m, v_index, v_cur_index);
+                v_cur_index = _mm512_add_epi32(v_cur_index, v_index_step);
+            }
+        }
+    }
+
+    _mm512_storeu_ps(p_lanes, v_acc);
+
+    if constexpr(OutputIndex)
+        _mm512_storeu_si512(p_lane_indices, v_index);
+
+    has_nan = nan_mask != 0;
+
+    return i;
+}
+
+#endif // CK_HOST_X86_SIMD
+
+// Advances lanes[] (and lane_indices[] with OutputIndex) over the full NumLane blocks of
+// p_in[0, n); returns the number of elements consumed. Lane l only sees elements l, l + NumLane,
+// ... and folds them with the bare ReduceOperation; has_nan reports whether a NaN was seen.
+template <typename ReduceOperation,
+          bool OutputIndex,
+          typename AccDataType,
+          typename IndexDataType,
+          typename InDataType,
+          typename InElementwiseOperation>
+std::size_t host_reduce_lanes(const InDataType* p_in,
+                              std::size_t n,
+                              const InElementwiseOperation& in_elementwise_op,
+                              AccDataType* lanes,
+                              IndexDataType* lane_indices,
+                              bool& has_nan)
+{
+    constexpr index_t NumLane = HostReductionNumLane;
+
+    std::size_t i = 0;
+
+    has_nan = false;
+
+#if CK_HOST_X86_SIMD
+    if constexpr(is_same_v<InDataType, float> && is_same_v<AccDataType, float> &&
+                 is_same_v<IndexDataType, int32_t> &&
+                 is_host_simd_reduction_v<ReduceOperation, InElementwiseOperation>)
+    {
+        if(__builtin_cpu_supports("avx512f"))
+            i = host_reduce_lanes_f32_avx512<ReduceOperation, OutputIndex, InElementwiseOperation>(
+                p_in, n, lanes, lane_indices, has_nan);
+        else if(__builtin_cpu_supports("avx2"))
+            i = host_reduce_lanes_f32_avx2<ReduceOperation, OutputIndex, InElementwiseOperation>(
+                p_in, n, lanes, lane_indices, has_nan);
+    }
+#endif
+
+    for(; i + NumLane <= n; i += NumLane)
+    {
+        for(index_t l = 0; l < NumLane; ++l)
+        {
+            AccDataType v = type_convert<AccDataType>(p_in[i + l]);
+
+            in_elementwise_op(v, v);
+
+            has_nan = has_nan || ck::math::isnan(v);
+
+            if constexpr(OutputIndex)
+            {
+                bool changed = false;
+
+                ReduceOperation{}(lanes[l], v, changed);
+
+                if(changed)
+                    lane_indices[l] = static_cast<IndexDataType>(i + l);
+            }
+            else
+            {
+                ReduceOperation{}(lanes[l], v);
+            }
+        }
+    }
+
+    return i;
+}
+
+} // namespace detail
+
+// Reduces in_op(p_in[0]), ..., in_op(p_in[n - 1]) with the semantics of a sequential
+// ck::detail::AccumulateWithNanCheck loop. The lanes are combined with a fixed pairwise tree, so
+// the result does not depend on the machine; for Add it is more accurate than, but not
+// bit-identical to, the sequential sum. With PropagateNan, input holding a NaN is rerun through
+// the sequential loop, which decides which NaN is returned.
+template <bool PropagateNan,
+          typename ReduceOperation,
+          typename AccDataType,
+          typename InDataType,
+          typename InElementwiseOperation>
+AccDataType host_reduce_contiguous(const InDataType* p_in,
+                                   std::size_t n,
+                                   const InElementwiseOperation& in_elementwise_op)
+{
+    using Accumulation =
+        ck::detail::AccumulateWithNanCheck<PropagateNan, ReduceOperation, AccDataType>;
+
+    constexpr index_t NumLane = HostReductionNumLane;
+
+    AccDataType acc = ReduceOperation::template GetIdentityValue<AccDataType>();
+
+    std::size_t i = 0;
+
+    bool has_nan = false;
+
+    if(n >= 2 * static_cast<std::size_t>(NumLane))
+    {
+        AccDataType lanes[NumLane];
+
+        for(index_t l = 0; l < NumLane; ++l)
+            lanes[l] = ReduceOperation::template GetIdentityValue<AccDataType>();
+
+        i = detail::host_reduce_lanes<ReduceOperation, false, AccDataType, int32_t>(
+            p_in, n, in_elementwise_op, lanes, nullptr, has_nan);
+
+        for(index_t width = NumLane / 2; width > 0; width /= 2)
+            for(index_t l = 0; l < width; ++l)
+                ReduceOperation{}(lanes[l], lanes[l + width]);
+
+        acc = lanes[0];
+    }
+
+    if(PropagateNan && has_nan)
+    {
+        acc = ReduceOperation::template GetIdentityValue<AccDataType>();
+        i   = 0;
+    }
+
+    for(; i < n; ++i)
+    {
+        AccDataType v = type_convert<AccDataType>(p_in[i]);
+
+        in_elementwise_op(v, v);
+
+        Accumulation::Calculate(acc, v);
+    }
+
+    return acc;
+}
+
+// Indexed counterpart for MAX / MIN / AMAX: acc and index of the first occurrence of the
+// extremum, i.e. exactly what the sequential ck::detail::AccumulateWithIndexAndNanCheck loop
+// returns. Ties between lanes go to the smallest index.
+template <bool PropagateNan,
+          typename ReduceOperation,
+          typename AccDataType,
+          typename IndexDataType,
+          typename InDataType,
+          typename InElementwiseOperation>
+void host_reduce_contiguous_with_index(const InDataType* p_in,
+                                       std::size_t n,
+                                       const InElementwiseOperation& in_elementwise_op,
+                                       AccDataType& acc,
+                                       IndexDataType& acc_index)
+{
+    using Accumulation = ck::detail::
+        AccumulateWithIndexAndNanCheck<PropagateNan, ReduceOperation, AccDataType, IndexDataType>;
+
+    constexpr index_t NumLane = HostReductionNumLane;
+
+    acc       = ReduceOperation::template GetIdentityValue<AccDataType>();
+    acc_index = 0;
+
+    std::size_t i = 0;
+
+    bool has_nan = false;
+
+    if(n >= 2 * static_cast<std::size_t>(NumLane))
+    {
+        AccDataType lanes[NumLane];
+        IndexDataType lane_indices[NumLane];
+
+        for(index_t l = 0; l < NumLane; ++l)
+        {
+            lanes[l]        = ReduceOperation::template GetIdentityValue<AccDataType>();
+            lane_indices[l] = 0;
+        }
+
+        i = detail::host_reduce_lanes<ReduceOperation, true>(
+            p_in, n, in_elementwise_op, lanes, lane_indices, has_nan);
+
+        for(index_t l = 0; l < NumLane; ++l)
+        {
+            bool changed = false;
+
+            ReduceOperation{}(acc, lanes[l], changed);
+
+            if(changed || (lanes[l] == acc && lane_indices[l] < acc_index))
+                acc_index = lane_indices[l];
+        }
+    }
+
+    // the lanes compare NaNs away, only the sequential loop knows which one is reported
+    if(PropagateNan && has_nan)
+    {
+        acc       = ReduceOperation::template GetIdentityValue<AccDataType>();
+        acc_index = 0;
+        i         = 0;
+    }
+
+    for(; i < n; ++i)
+    {
+        AccDataType v = type_convert<AccDataType>(p_in[i]);
+
+        in_elementwise_op(v, v);
+
+        Accumulation::Calculate(acc, v, acc_index, static_cast<IndexDataType>(i));
+    }
+}
+
+//
+// @brief      Fixed partition of a reduction with num_invariant outputs of reduce_length elements
+//             each into num_invariant x num_split tasks.
+//
+// @paragraph
+//             The reduce space is only split when there are too few outputs to keep a host busy
+//             (reduce-all, batchnorm over a handful of channels). The split depends on the problem
+//             shape alone, never on the thread count, so results merged from it are reproducible
+//             from one machine to the next.
+//
+struct HostReductionPartition
+{
+    // enough tasks for any host, and enough elements per split to amortize its partial result
+    static constexpr std::size_t TargetNumTask  = 256;
+    static constexpr std::size_t MinSplitLength = 16384;
+
+    // reduce_element_size is the number of elements behind one reduce index, e.g. the row of C
+    // channels that a channel-last batchnorm handles per index
+    HostReductionPartition(std::size_t num_invariant,
+                           std::size_t reduce_length,
+                           std::size_t reduce_element_size = 1)
+        : num_invariant_(num_invariant),
+          reduce_length_(reduce_length),
+          num_split_(1),
+          split_length_(reduce_length)
+    {
+        const std::size_t reduce_size = reduce_length_ * reduce_element_size;
+
+        if(num_invariant_ > 0 && num_invariant_ < TargetNumTask &&
+           reduce_size >= 2 * MinSplitLength &&
+           reduce_length_ >= 2 * static_cast<std::size_t>(HostReductionNumLane))
+        {
+            const std::size_t num_split =
+                std::min(math::integer_divide_ceil(TargetNumTask, num_invariant_),
+                         reduce_size / MinSplitLength);
+
+            // splits start on a lane block of the contiguous reduction kernels
+            split_length_ =
+                math::integer_least_multiple(math::integer_divide_ceil(reduce_length_, num_split),
+                                             static_cast<std::size_t>(HostReductionNumLane));
+            num_split_ = math::integer_divide_ceil(reduce_length_, split_length_);
+        }
+    }
+
+    std::size_t GetNumInvariant() const { return num_invariant_; }
+    std::size_t GetReduceLength() const { return reduce_length_; }
+    std::size_t GetNumSplit() const { return num_split_; }
+
+    std::size_t GetSplitBegin(std::size_t isplit) const { return isplit * split_length_; }
+
+    std::size_t GetSplitEnd(std::size_t isplit) const
+    {
+        return std::min((isplit + 1) * split_length_, reduce_length_);
+    }
+
+    std::size_t num_invariant_;
+    std::size_t reduce_length_;
+    std::size_t num_split_;
+    std::size_t split_length_;
+};
+
+// Runs reduce_split(iinv, begin, end), which returns the Partial of elements [begin, end) of
+// output iinv, for every task of the partition in parallel. The partials of an output are then
+// merged with merge_partial(left, right) in a fixed pairwise tree, the earlier split always on
+// the left, and the result is passed to finalize(iinv, partial).
+template <typename Partial, typename ReduceSplit, typename MergePartial, typename Finalize>
+void host_reduction_run(const HostReductionPartition& partition,
+                        ReduceSplit reduce_split,
+                        MergePartial merge_partial,
+                        Finalize finalize)
+{
+    const std::size_t num_invariant = partition.GetNumInvariant();
+    const std::size_t num_split     = partition.GetNumSplit();
+
+    const std::size_t num_thread = std::thread::hardware_concurrency();
+
+    if(num_invariant == 0)
+        return;
+
+    if(num_split == 1)
+    {
+        auto f_invariant = [&](std::size_t iinv) {
+            Partial partial = reduce_split(iinv, std::size_t{0}, partition.GetReduceLength());
+
+            finalize(iinv, partial);
+        };
+
+        make_ParallelTensorFunctor(f_invariant, num_invariant)(num_thread);
+
+        return;
+    }
+
+    std::vector<Partial> partials(num_invariant * num_split);
+
+    auto f_split = [&](std::size_t iinv, std::size_t isplit) {
+        partials[iinv * num_split + isplit] =
+            reduce_split(iinv, partition.GetSplitBegin(isplit), partition.GetSplitEnd(isplit));
+    };
+
+    make_ParallelTensorFunctor(f_split, num_invariant, num_split)(num_thread);
+
+    auto f_merge = [&](std::size_t iinv) {
+        Partial* p_partial = &partials[iinv * num_split];
+
+        for(std::size_t stride = 1; stride < num_split; stride *= 2)
+            for(std::size_t isplit = 0; isplit + stride < num_split; isplit += 2 * stride)
+                merge_partial(p_partial[isplit], p_partial[isplit + stride]);
+
+        finalize(iinv, p_partial[0]);
+    };
+
+    make_ParallelTensorFunctor(f_merge, num_invariant)(num_thread);
+}
+
+// runs f(iinv, begin, end) for every task of the partition in parallel, for the element-wise
+// passes that follow a reduction
+template <typename F>
+void host_reduction_for_each(const HostReductionPartition& partition, F f)
+{
+    if(partition.GetNumInvariant() == 0)
+        return;
+
+    auto f_split = [&](std::size_t iinv, std::size_t isplit) {
+        f(iinv, partition.GetSplitBegin(isplit), partition.GetSplitEnd(isplit));
+    };
+
+    make_ParallelTensorFunctor(f_split, partition.GetNumInvariant(), partition.GetNumSplit())(
+        std::thread::hardware_concurrency());
+}
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/math_v2.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      1D sliding-window kernels of the pooling references.
+//
+// @paragraph
+//             A window pass reduces one axis of a line: output o covers the input elements
+//             [o * window_stride - left_pad, o * window_stride - left_pad + window_length),
+//             clamped to [0, in_length), so padding elements take no part. A pooling window of
+//             any rank is reduced as one pass per spatial axis, and each pass costs O(1) per
+//             element whatever the window length.
+//
+// @paragraph
+//             Elements of a line are addressed through a stride, in[i * in_stride] and
+//             out[o * out_stride], so any axis of a packed buffer can be passed over.
+//
+
+// clamped input range [begin, end) of window o
+struct HostSlidingWindow
+{
+    index_t in_length_;
+    index_t out_length_;
+    index_t window_length_;
+    index_t window_stride_;
+    index_t left_pad_;
+
+    index_t GetBegin(index_t o) const { return std::max(o * window_stride_ - left_pad_, 0); }
+
+    index_t GetEnd(index_t o) const
+    {
+        return std::min(o * window_stride_ - left_pad_ + window_length_, in_length_);
+    }
+
+    // window-local position of input element i in window o
+    index_t GetLocal(index_t o, index_t i) const { return i - (o * window_stride_ - left_pad_); }
+};
+
+//
+// Sliding-window selection for the ordered reductions (Max, Min, AMax), with a monotonic deque.
+//
+// The deque holds the positions that no later element of the window beats, the winner of a window
+// is its front. An element beats another when ReduceOperation would replace the latter with it,
+// so on ties the earlier element stays in front; with PropagateNan a NaN beats everything and the
+// last NaN wins, otherwise NaNs are skipped. This reproduces the winner and index of a sequential
+// scan through AccumulateWithIndexAndNanCheck.
+//
+// index_scale scales the window-local position into the index of the output, and the index of
+// the winning input element, p_in_index[i], is added to it. So a first pass over W, then one over
+// H with index_scale X, yield y * X + x. Windows without any eligible element give the identity
+// value and index -1, and an input with a negative index is not eligible in the next pass.
+//
+template <typename ReduceOperation, bool PropagateNan, typename AccDataType>
+void host_sliding_window_select(const HostSlidingWindow& window,
+                                const AccDataType* p_in,
+                                const index_t* p_in_index,
+                                index_t in_stride,
+                                AccDataType* p_out,
+                                index_t* p_out_index,
+                                index_t out_stride,
+                                index_t index_scale,
+                                std::vector<index_t>& deque)
+{
+    const AccDataType identity = ReduceOperation::template GetIdentityValue<AccDataType>();
+
+    deque.resize(window.in_length_);
+
+    auto beats = [&](index_t i, index_t j) {
+        const AccDataType vi = p_in[i * in_stride];
+        const AccDataType vj = p_in[j * in_stride];
+
+        if constexpr(PropagateNan)
+        {
+            if(ck::math::isnan(vi))
+                return true;
+
+            if(ck::math::isnan(vj))
+                return false;
+        }
+
+        AccDataType v = vj;
+        bool changed  = false;
+
+        ReduceOperation{}(v, vi, changed);
+
+        return changed;
+    };
+
+    // deque[head, tail) are the candidate positions, in increasing order
+    index_t head = 0;
+    index_t tail = 0;
+    index_t next = 0;
+
+    for(index_t o = 0; o < window.out_length_; ++o)
+    {
+        const index_t begin = window.GetBegin(o);
+        const index_t end   = window.GetEnd(o);
+
+        for(next = std::max(next, begin); next < end; ++next)
+        {
+            if(p_in_index != nullptr && p_in_index[next * in_stride] < 0)
+                continue;
+
+            if constexpr(!PropagateNan)
+            {
+                if(ck::math::isnan(p_in[next * in_stride]))
+                    continue;
+            }
+
+            while(tail > head && beats(next, deque[tail - 1]))
+                --tail;
+
+            deque[tail++] = next;
+        }
+
+        while(head < tail && deque[head] < begin)
+            ++head;
+
+        if(head < tail)
+        {
+            const index_t i = deque[head];
+
+            p_out[o * out_stride]       = p_in[i * in_stride];
+            p_out_index[o * out_stride] = window.GetLocal(o, i) * index_scale +
+                                          (p_in_index != nullptr ? p_in_index[i * in_stride] : 0);
+        }
+        else
+        {
+            p_out[o * out_stride]       = identity;
+            p_out_index[o * out_stride] = -1;
+        }
+    }
+}
+
+//
+// Sliding-window sum, for the average pooling.
+//
+// The line is cut into blocks of window_length elements and running sums restart at every block:
+// prefix[i] adds up its block from the start to i, suffix[i] from i to the end. A window spans at
+// most two blocks and is suffix[begin] + prefix[end - 1], or a single prefix / suffix. So every
+// output is one addition, and every term is a sum over at most window_length elements, as
+// accurate as the direct sum rather than the difference of two long running sums.
+//
+template <typename AccDataType>
+void host_sliding_window_sum(const HostSlidingWindow& window,
+                             const AccDataType* p_in,
+                             index_t in_stride,
+                             AccDataType* p_out,
+                             index_t out_stride,
+                             std::vector<AccDataType>& prefix,
+                             std::vector<AccDataType>& suffix)
+{
+    const index_t in_length = window.in_length_;
+    const index_t block     = window.window_length_;
+
+    prefix.resize(in_length);
+    suffix.resize(in_length);
+
+    for(index_t block_begin = 0; block_begin < in_length; block_begin += block)
+    {
+        const index_t block_end = std::min(block_begin + block, in_length);
+
+        AccDataType sum = 0;
+
+        for(index_t i = block_begin; i < block_end; ++i)
+        {
+            sum += p_in[i * in_stride];
+            prefix[i] = sum;
+        }
+
+        sum = 0;
+
+        for(index_t i = block_end - 1; i >= block_begin; --i)
+        {
+            sum += p_in[i * in_stride];
+            suffix[i] = sum;
+        }
+    }
+
+    for(index_t o = 0; o < window.out_length_; ++o)
+    {
+        const index_t begin = window.GetBegin(o);
+        const index_t end   = window.GetEnd(o);
+
+        AccDataType sum = 0;
+
+        if(begin < end)
+        {
+            const index_t block_begin = begin / block * block;
+
+            if(end - 1 >= block_begin + block)
+            {
+                // the window straddles two blocks
+                sum = suffix[begin] + prefix[end - 1];
+            }
+            else if(begin == block_begin)
+            {
+                sum = prefix[end - 1];
+            }
+            else if(end == std::min(block_begin + block, in_length))
+            {
+                sum = suffix[begin];
+            }
+            else
+            {
+                for(index_t i = begin; i < end; ++i)
+                    sum += p_in[i * in_stride];
+            }
+        }
+
+        p_out[o * out_stride] = sum;
+    }
+}
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Running mean / M2 (sum of squared deviations) of a variance reduction.
+//
+// @paragraph
+//             Update() is Welford's single-pass recurrence, Merge() combines the states of two
+//             disjoint parts with Chan's formula. Variance is the biased (population) one,
+//             M2 / count, as used by the normalization operators.
+//
+template <typename AccDataType>
+struct HostWelford
+{
+    AccDataType mean_    = 0;
+    AccDataType m2_      = 0;
+    long_index_t count_ = 0;
+
+    void Update(AccDataType x)
+    {
+        ++count_;
+
+        const AccDataType delta = x - mean_;
+
+        mean_ += delta / static_cast<AccDataType>(count_);
+        m2_ += delta * (x - mean_);
+    }
+
+    void Merge(const HostWelford& other)
+    {
+        if(other.count_ == 0)
+            return;
+
+        if(count_ == 0)
+        {
+            *this = other;
+            return;
+        }
+
+        const long_index_t count = count_ + other.count_;
+
+        const AccDataType delta   = other.mean_ - mean_;
+        const AccDataType count_a = static_cast<AccDataType>(count_);
+        const AccDataType count_b = static_cast<AccDataType>(other.count_);
+        const AccDataType count_r = static_cast<AccDataType>(count);
+
+        mean_ += delta * count_b / count_r;
+        m2_ += other.m2_ + delta * delta * count_a * count_b / count_r;
+        count_ = count;
+    }
+
+    AccDataType GetMean() const { return mean_; }
+
+    AccDataType GetVariance() const
+    {
+        return count_ > 0 ? m2_ / static_cast<AccDataType>(count_) : AccDataType{0};
+    }
+};
+
+// Folds x[0], x[stride], ..., x[(n - 1) * stride] into the state. Contiguous input is processed
+// as NumLane interleaved Welford streams that advance in lockstep (the per-step 1 / count is
+// shared, so the lane loop vectorizes) and are combined with Chan's formula at the end.
+template <typename AccDataType, typename XDataType>
+void host_welford_accumulate(HostWelford<AccDataType>& state,
+                             const XDataType* p_x,
+                             index_t n,
+                             index_t stride)
+{
+    constexpr index_t NumLane = 16;
+
+    index_t i = 0;
+
+    if(stride == 1 && n >= 2 * NumLane)
+    {
+        AccDataType mean[NumLane] = {};
+        AccDataType m2[NumLane]   = {};
+
+        index_t step = 0;
+
+        for(; i + NumLane <= n; i += NumLane)
+        {
+            const AccDataType inv_count = AccDataType{1} / static_cast<AccDataType>(++step);
+
+            for(index_t l = 0; l < NumLane; ++l)
+            {
+                const AccDataType x     = ck::type_convert<AccDataType>(p_x[i + l]);
+                const AccDataType delta = x - mean[l];
+
+                mean[l] += delta * inv_count;
+                m2[l] += delta * (x - mean[l]);
+            }
+        }
+
+        // pairwise tree over the lanes, all of them hold `step` elements
+        for(index_t width = NumLane / 2; width > 0; width /= 2)
+        {
+            const AccDataType count = static_cast<AccDataType>(step);
+
+            for(index_t l = 0; l < width; ++l)
+            {
+                const AccDataType delta = mean[l + width] - mean[l];
+
+                mean[l] += delta / AccDataType{2};
+                m2[l] += m2[l + width] + delta * delta * count / AccDataType{2};
+            }
+
+            step *= 2;
+        }
+
+        HostWelford<AccDataType> lanes;
+
+        lanes.mean_  = mean[0];
+        lanes.m2_    = m2[0];
+        lanes.count_ = step;
+
+        state.Merge(lanes);
+    }
+
+    for(; i < n; ++i)
+    {
+        state.Update(ck::type_convert<AccDataType>(p_x[i * stride]));
+    }
+}
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,352 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/math.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+// Winograd minimal filtering F(m x m, 3 x 3) transforms (Lavin & Gray):
+//   Y = A^T [ (G g G^T) .* (B^T d B) ] A
+// with an Alpha x Alpha input tile d (Alpha = m + 2) producing an m x m output tile Y.
+template <index_t OutTileSize>
+struct HostWinogradTransform;
+
+template <>
+struct HostWinogradTransform<2>
+{
+    static constexpr index_t Alpha = 4;
+
+    static constexpr std::array<std::array<float, 4>, 4> BT{{{1.f, 0.f, -1.f, 0.f},
+                                                            {0.f, 1.f, 1.f, 0.f},
+                                                            {0.f, -1.f, 1.f, 0.f},
+                                                            {0.f, 1.f, 0.f, -1.f}}};
+
+    static constexpr std::array<std::array<double, 3>, 4> G{
+        {{1., 0., 0.}, {.5, .5, .5}, {.5, -.5, .5}, {0., 0., 1.}}};
+
+    static constexpr std::array<std::array<float, 4>, 2> AT{
+        {{1.f, 1.f, 1.f, 0.f}, {0.f, 1.f, -1.f, -1.f}}};
+};
+
+template <>
+struct HostWinogradTransform<4>
+{
+    static constexpr index_t Alpha = 6;
+
+    static constexpr std::array<std::array<float, 6>, 6> BT{{{4.f, 0.f, -5.f, 0.f, 1.f, 0.f},
+                                                            {0.f, -4.f, -4.f, 1.f, 1.f, 0.f},
+                                                            {0.f, 4.f, -4.f, -1.f, 1.f, 0.f},
+                                                            {0.f, -2.f, -1.f, 2.f, 1.f, 0.f},
+                                                            {0.f, 2.f, -1.f, -2.f, 1.f, 0.f},
+                                                            {0.f, 4.f, 0.f, -5.f, 0.f, 1.f}}};
+
+    static constexpr std::array<std::array<double, 3>, 6> G{{{1. / 4, 0., 0.},
+                                                             {-1. / 6, -1. / 6, -1. / 6},
+                                                             {-1. / 6, 1. / 6, -1. / 6},
+                                                             {1. / 24, 1. / 12, 1. / 6},
+                                                             {1. / 24, -1. / 12, 1. / 6},
+                                                             {0., 0., 1.}}};
+
+    static constexpr std::array<std::array<float, 6>, 4> AT{
+        {{1.f, 1.f, 1.f, 1.f, 1.f, 0.f},
+         {0.f, 1.f, -1.f, 2.f, -2.f, 0.f},
+         {0.f, 1.f, 1.f, 4.f, 4.f, 0.f},
+         {0.f, 1.f, -1.f, 8.f, -8.f, 1.f}}};
+};
+
+//
+// @brief      Winograd F(m x m, 3 x 3) forward convolution for host reference operators.
+//
+// @paragraph
+//             Handles grouped 2D convolutions with a 3 x 3 filter, unit strides and unit
+//             dilations, any padding and any physical layout (tensors are accessed through
+//             getters in [G, N, C, Hi, Wi] / [G, K, C, Y, X] / [G, N, K, Ho, Wo] order).
+//
+// @paragraph
+//             Output tiles of all images are enumerated as the rows of Alpha * Alpha GEMMs
+//               M[xi, nu][tile, k] = sum_c V[xi, nu][tile, c] * U[xi, nu][c, k]
+//             TransformFilter() computes U = G g G^T once and keeps it packed inside the blocked
+//             GEMM engine, so it can be reused by any number of Run() calls. Run() processes
+//             one GEMM row block (HostGemmBlocking::MC tiles) per task: input transform into
+//             a per-task buffer, Alpha * Alpha GEMM row blocks, then the output transform.
+//
+// @paragraph
+//             The result is not bit-identical to a direct convolution; the transforms trade
+//             multiplications for additions and increase the rounding error, more so for
+//             m = 4 than for m = 2.
+//
+template <index_t OutTileSize>
+struct HostWinogradConv2dFwd
+{
+    using Transform = HostWinogradTransform<OutTileSize>;
+
+    static constexpr index_t R     = 3;
+    static constexpr index_t M     = OutTileSize;
+    static constexpr index_t Alpha = Transform::Alpha;
+
+    HostWinogradConv2dFwd(index_t G,
+                          index_t N,
+                          index_t K,
+                          index_t C,
+                          index_t Hi,
+                          index_t Wi,
+                          index_t Ho,
+                          index_t Wo,
+                          index_t left_pad_h,
+                          index_t left_pad_w)
+        : G_{G},
+          N_{N},
+          K_{K},
+          C_{C},
+          Hi_{Hi},
+          Wi_{Wi},
+          Ho_{Ho},
+          Wo_{Wo},
+          left_pad_h_{left_pad_h},
+          left_pad_w_{left_pad_w},
+          num_tile_h_{math::integer_divide_ceil(Ho, M)},
+          num_tile_w_{math::integer_divide_ceil(Wo, M)}
+    {
+    }
+
+    // wei_getter(g, k, c, y, x) returns the (element-op applied) weight as float
+    template <typename WeiGetter>
+    void TransformFilter(WeiGetter wei_getter, std::size_t num_thread)
+    {
+        const index_t num_tile = N_ * num_tile_h_ * num_tile_w_;
+
+        gemms_.clear();
+        gemms_.reserve(static_cast<std::size_t>(G_) * Alpha * Alpha);
+
+        is_filter_finite_ = true;
+
+        for(index_t g = 0; g < G_; ++g)
+        {
+            // U[xi, nu][k, c], transformed in double and rounded once
+            std::vector<float> u(static_cast<std::size_t>(Alpha) * Alpha * K_ * C_);
+
+            auto f_filter = [&](index_t k, index_t c) {
+                double v_wei[R][R];
+                double v_tmp[Alpha][R];
+
+                for(index_t y = 0; y < R; ++y)
+                    for(index_t x = 0; x < R; ++x)
+                        v_wei[y][x] = wei_getter(g, k, c, y, x);
+
+                for(index_t i = 0; i < Alpha; ++i)
+                    for(index_t x = 0; x < R; ++x)
+                    {
+                        v_tmp[i][x] = 0;
+
+                        for(index_t y = 0; y < R; ++y)
+                            v_tmp[i][x] += Transform::G[i][y] * v_wei[y][x];
+                    }
+
+                for(index_t i = 0; i < Alpha; ++i)
+                    for(index_t j = 0; j < Alpha; ++j)
+                    {
+                        double v_u = 0;
+
+                        for(index_t x = 0; x < R; ++x)
+                            v_u += v_tmp[i][x] * Transform::G[j][x];
+
+                        u[((static_cast<std::size_t>(i) * Alpha + j) * K_ + k) * C_ + c] =
+                            static_cast<float>(v_u);
+                    }
+            };
+
+            make_ParallelTensorFunctor(f_filter, K_, C_)(num_thread);
+
+            if(!std::all_of(u.begin(), u.end(), [](float v) { return std::isfinite(v); }))
+            {
+                is_filter_finite_ = false;
+            }
+
+            for(index_t xi_nu = 0; xi_nu < Alpha * Alpha; ++xi_nu)
+            {
+                const float* p_u = &u[static_cast<std::size_t>(xi_nu) * K_ * C_];
+
+                gemms_.emplace_back(num_tile, K_, C_);
+
+                gemms_.back().PackB(
+                    [&](index_t c, index_t k) { return p_u[static_cast<std::size_t>(k) * C_ + c]; },
+                    num_thread);
+            }
+        }
+    }
+
+    // false when the transformed filter holds an Inf or a NaN: Run() then multiplies it by the
+    // zero padding of border tiles too, which gives NaN where a direct convolution skips the
+    // padding taps
+    bool IsFilterFinite() const { return is_filter_finite_; }
+
+    // in_getter(g, n, c, hi, wi) returns the (element-op applied) input as float; it is only
+    // called for in-bounds coordinates, padding reads as zero
+    // out_setter(g, n, k, ho, wo, v) consumes the convolution result
+    // TransformFilter() must have been called before
+    template <typename InGetter, typename OutSetter>
+    void Run(InGetter in_getter, OutSetter out_setter, std::size_t num_thread) const
+    {
+        constexpr index_t MC = HostGemmBlocking::MC;
+
+        const index_t num_tile   = N_ * num_tile_h_ * num_tile_w_;
+        const index_t num_m_tile = math::integer_divide_ceil(num_tile, MC);
+
+        for(index_t g = 0; g < G_; ++g)
+        {
+            auto f_block = [&](index_t im) {
+                const index_t tile_begin = im * MC;
+                const index_t tile_end   = std::min(tile_begin + MC, num_tile);
+
+                // V[xi, nu][tile, c] and M[xi, nu][tile, k] of this row block
+                std::vector<float> v(static_cast<std::size_t>(Alpha) * Alpha * MC * C_);
+                std::vector<float> m(static_cast<std::size_t>(Alpha) * Alpha * MC * K_);
+
+                const std::size_t v_stride = static_cast<std::size_t>(MC) * C_;
+                const std::size_t m_stride = static_cast<std::size_t>(MC) * K_;
+
+                for(index_t tile = tile_begin; tile < tile_end; ++tile)
+                {
+                    const index_t n   = tile / (num_tile_h_ * num_tile_w_);
+                    const index_t hi0 = (tile / num_tile_w_ % num_tile_h_) * M - left_pad_h_;
+                    const index_t wi0 = (tile % num_tile_w_) * M - left_pad_w_;
+
+                    float* p_v = &v[static_cast<std::size_t>(tile - tile_begin) * C_];
+
+                    for(index_t c = 0; c < C_; ++c)
+                    {
+                        float v_in[Alpha][Alpha];
+                        float v_tmp[Alpha][Alpha];
+
+                        for(index_t i = 0; i < Alpha; ++i)
+                            for(index_t j = 0; j < Alpha; ++j)
+                            {
+                                const index_t hi = hi0 + i;
+                                const index_t wi = wi0 + j;
+
+                                v_in[i][j] = hi >= 0 && hi < Hi_ && wi >= 0 && wi < Wi_
+                                                 ? in_getter(g, n, c, hi, wi)
+                                                 : 0.f;
+                            }
+
+                        // B^T d B
+                        for(index_t i = 0; i < Alpha; ++i)
+                            for(index_t j = 0; j < Alpha; ++j)
+                            {
+                                float v_acc = 0;
+
+                                for(index_t l = 0; l < Alpha; ++l)
+                                    v_acc += Transform::BT[i][l] * v_in[l][j];
+
+                                v_tmp[i][j] = v_acc;
+                            }
+
+                        for(index_t i = 0; i < Alpha; ++i)
+                            for(index_t j = 0; j < Alpha; ++j)
+                            {
+                                float v_acc = 0;
+
+                                for(index_t l = 0; l < Alpha; ++l)
+                                    v_acc += v_tmp[i][l] * Transform::BT[j][l];
+
+                                p_v[(i * Alpha + j) * v_stride + c] = v_acc;
+                            }
+                    }
+                }
+
+                for(index_t xi_nu = 0; xi_nu < Alpha * Alpha; ++xi_nu)
+                {
+                    const auto& gemm = gemms_[static_cast<std::size_t>(g) * Alpha * Alpha + xi_nu];
+
+                    const float* p_v = &v[xi_nu * v_stride];
+                    float* p_m       = &m[xi_nu * m_stride];
+
+                    auto a_getter = [&](index_t tile, index_t c) {
+                        return p_v[static_cast<std::size_t>(tile - tile_begin) * C_ + c];
+                    };
+
+                    auto c_epilogue = [&](index_t tile, index_t k, float v_acc) {
+                        p_m[static_cast<std::size_t>(tile - tile_begin) * K_ + k] = v_acc;
+                    };
+
+                    gemm.RunTile(im, 0, gemm.GetNumNTile(), a_getter, c_epilogue);
+                }
+
+                for(index_t tile = tile_begin; tile < tile_end; ++tile)
+                {
+                    const index_t n   = tile / (num_tile_h_ * num_tile_w_);
+                    const index_t ho0 = (tile / num_tile_w_ % num_tile_h_) * M;
+                    const index_t wo0 = (tile % num_tile_w_) * M;
+
+                    const float* p_m = &m[static_cast<std::size_t>(tile - tile_begin) * K_];
+
+                    for(index_t k = 0; k < K_; ++k)
+                    {
+                        float v_tmp[M][Alpha];
+
+                        // A^T M A
+                        for(index_t i = 0; i < M; ++i)
+                            for(index_t j = 0; j < Alpha; ++j)
+                            {
+                                float v_acc = 0;
+
+                                for(index_t l = 0; l < Alpha; ++l)
+                                    v_acc +=
+                                        Transform::AT[i][l] * p_m[(l * Alpha + j) * m_stride + k];
+
+                                v_tmp[i][j] = v_acc;
+                            }
+
+                        for(index_t i = 0; i < M && ho0 + i < Ho_; ++i)
+                            for(index_t j = 0; j < M && wo0 + j < Wo_; ++j)
+                            {
+                                float v_acc = 0;
+
+                                for(index_t l = 0; l < Alpha; ++l)
+                                    v_acc += v_tmp[i][l] * Transform::AT[j][l];
+
+                                out_setter(g, n, k, ho0 + i, wo0 + j, v_acc);
+                            }
+                    }
+                }
+            };
+
+            make_ParallelTensorFunctor(f_block, num_m_tile)(num_thread);
+        }
+    }
+
+    index_t G_;
+    index_t N_;
+    index_t K_;
+    index_t C_;
+    index_t Hi_;
+    index_t Wi_;
+    index_t Ho_;
+    index_t Wo_;
+    index_t left_pad_h_;
+    index_t left_pad_w_;
+    index_t num_tile_h_;
+    index_t num_tile_w_;
+
+    // Alpha * Alpha GEMMs per group, each holding its packed transformed filter
+    std::vector<HostBlockedGemm<float>> gemms_;
+
+    bool is_filter_finite_ = true;
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -8,6 +8,7 @@
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -25,9 +26,9 @@ struct ReferenceBatchedGemm : public device::BaseOperator
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const Tensor<ADataType>& a_g_m_k,
-                 const Tensor<BDataType>& b_g_k_n,
-                 Tensor<CDataType>& c_g_m_n,
+        Argument(TensorView<const ADataType> a_g_m_k,
+                 TensorView<const BDataType> b_g_k_n,
+                 TensorView<CDataType> c_g_m_n,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
                  CElementwiseOperation c_element_op)
@@ -40,9 +41,9 @@ struct ReferenceBatchedGemm : public device::BaseOperator
         {
         }
 
-        const Tensor<ADataType>& a_g_m_k_;
-        const Tensor<BDataType>& b_g_k_n_;
-        Tensor<CDataType>& c_g_m_n_;
+        TensorView<const ADataType> a_g_m_k_;
+        TensorView<const BDataType> b_g_k_n_;
+        TensorView<CDataType> c_g_m_n_;
 
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
@@ -56,35 +57,55 @@ struct ReferenceBatchedGemm : public device::BaseOperator
 
         float Run(const Argument& arg)
         {
-            auto f_gmk_gkn_gmn = [&](auto g, auto m, auto n) {
-                const int K = arg.a_g_m_k_.mDesc.GetLengths()[2];
+            const index_t G = arg.c_g_m_n_.mDesc.GetLengths()[0];
+            const index_t M = arg.c_g_m_n_.mDesc.GetLengths()[1];
+            const index_t N = arg.c_g_m_n_.mDesc.GetLengths()[2];
+            const index_t K = arg.a_g_m_k_.mDesc.GetLengths()[2];
 
-                AccDataType v_acc = 0;
+            const auto& a_strides = arg.a_g_m_k_.mDesc.GetStrides();
+            const auto& b_strides = arg.b_g_k_n_.mDesc.GetStrides();
+            const auto& c_strides = arg.c_g_m_n_.mDesc.GetStrides();
 
-                for(int k = 0; k < K; ++k)
-                {
-                    ADataType v_a;
-                    BDataType v_b;
+            // element ops and conversion to AccDataType are applied once per element, at pack time
+            auto a_getter = [&](index_t g, index_t m, index_t k) {
+                ADataType v_a;
 
-                    arg.a_element_op_(v_a, arg.a_g_m_k_(g, m, k));
-                    arg.b_element_op_(v_b, arg.b_g_k_n_(g, k, n));
+                arg.a_element_op_(
+                    v_a,
+                    arg.a_g_m_k_.mData[g * a_strides[0] + m * a_strides[1] + k * a_strides[2]]);
 
-                    v_acc +=
-                        ck::type_convert<AccDataType>(v_a) * ck::type_convert<AccDataType>(v_b);
-                }
+                return ck::type_convert<AccDataType>(v_a);
+            };
+
+            auto b_getter = [&](index_t g, index_t k, index_t n) {
+                BDataType v_b;
+
+                arg.b_element_op_(
+                    v_b,
+                    arg.b_g_k_n_.mData[g * b_strides[0] + k * b_strides[1] + n * b_strides[2]]);
+
+                return ck::type_convert<AccDataType>(v_b);
+            };
 
+            auto c_epilogue = [&](index_t g, index_t m, index_t n, AccDataType v_acc) {
                 AccDataType v_c;
 
                 arg.c_element_op_(v_c, v_acc);
 
-                arg.c_g_m_n_(g, m, n) = ck::type_convert<CDataType>(v_c);
+                arg.c_g_m_n_.mData[g * c_strides[0] + m * c_strides[1] + n * c_strides[2]] =
+                    ck::type_convert<CDataType>(v_c);
             };
 
-            make_ParallelTensorFunctor(f_gmk_gkn_gmn,
-                                       arg.c_g_m_n_.mDesc.GetLengths()[0],
-                                       arg.c_g_m_n_.mDesc.GetLengths()[1],
-                                       arg.c_g_m_n_.mDesc.GetLengths()[2])(
-                std::thread::hardware_concurrency());
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+
+            // B with batch stride 0 holds the same weights for every batch, pack it only once
+            const bool is_b_broadcast = b_strides[0] == 0;
+
+            HostBatchedBlockedGemm<AccDataType> gemm{G, M, N, K, is_b_broadcast};
+
+            gemm.PackB(b_getter, num_thread);
+            gemm.Run(a_getter, c_epilogue, num_thread);
+
             return 0;
         }
 
@@ -103,9 +124,9 @@ struct ReferenceBatchedGemm : public device::BaseOperator
 
     bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
 
-    static auto MakeArgument(const Tensor<ADataType>& a_g_m_k,
-                             const Tensor<BDataType>& b_g_k_n,
-                             Tensor<CDataType>& c_g_m_n,
+    static auto MakeArgument(TensorView<const ADataType> a_g_m_k,
+                             TensorView<const BDataType> b_g_k_n,
+                             TensorView<CDataType> c_g_m_n,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
                              CElementwiseOperation c_element_op)
@@ -0,0 +1,440 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/tensor_operation/gpu/device/masking_specialization.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Fused host reference of DeviceBatchedGemmSoftmaxGemmPermute.
+//
+// @paragraph
+//             C = softmax(acc0_op(A * B0^T), masked) * B1 per batch, computed flash-attention
+//             style: for a block of MC rows the score matrix is produced one NC wide column tile
+//             at a time, the running row max / sum are updated and the output accumulator is
+//             rescaled, so the full [G, M, N] score tensor is never allocated. As on the device,
+//             the normalized probabilities are rounded to ADataType before the second GEMM.
+//
+// @paragraph
+//             Results differ from the unfused chain (gemm, softmax, gemm) by rounding only. The
+//             probabilities of a tile are normalized by the running row sum, not the final one,
+//             and the earlier tiles are rescaled in AccDataType, so with a low-precision
+//             ADataType the rounding to ADataType happens at a different point. A row whose
+//             scores are all masked out or -inf gives NaN, as the unfused softmax does.
+//
+// @paragraph
+//             Tensors are [G..., M, K] (A), [G..., N, K] (B0), [G..., O, N] (B1) and
+//             [G..., M, O] (C), with NumDimG leading batch dimensions and arbitrary strides,
+//             i.e. the gs_ms_ks layouts of the device operation, including permuted output.
+//
+template <index_t NumDimG,
+          typename ADataType,
+          typename B0DataType,
+          typename B1DataType,
+          typename CDataType,
+          typename AccDataType,
+          typename AElementwiseOperation,
+          typename B0ElementwiseOperation,
+          typename Acc0ElementwiseOperation,
+          typename B1ElementwiseOperation,
+          typename CElementwiseOperation,
+          device::MaskingSpecialization MaskingSpec>
+struct ReferenceBatchedGemmSoftmaxGemmPermute : public device::BaseOperator
+{
+    using MaskOutPredicate =
+        std::conditional_t<MaskingSpec == device::MaskingSpecialization::MaskOutUpperTriangle,
+                           device::MaskOutUpperTrianglePredicate,
+                           device::MaskDisabledPredicate>;
+
+    // Argument
+    struct Argument : public device::BaseArgument
+    {
+        Argument(const Tensor<ADataType>& a_gs_ms_ks,
+                 const Tensor<B0DataType>& b0_gs_ns_ks,
+                 const Tensor<B1DataType>& b1_gs_os_ns,
+                 Tensor<CDataType>& c_gs_ms_os,
+                 AElementwiseOperation a_element_op,
+                 B0ElementwiseOperation b0_element_op,
+                 Acc0ElementwiseOperation acc0_element_op,
+                 B1ElementwiseOperation b1_element_op,
+                 CElementwiseOperation c_element_op)
+            : a_gs_ms_ks_{a_gs_ms_ks},
+              b0_gs_ns_ks_{b0_gs_ns_ks},
+              b1_gs_os_ns_{b1_gs_os_ns},
+              c_gs_ms_os_{c_gs_ms_os},
+              a_element_op_{a_element_op},
+              b0_element_op_{b0_element_op},
+              acc0_element_op_{acc0_element_op},
+              b1_element_op_{b1_element_op},
+              c_element_op_{c_element_op}
+        {
+        }
+
+        const Tensor<ADataType>& a_gs_ms_ks_;
+        const Tensor<B0DataType>& b0_gs_ns_ks_;
+        const Tensor<B1DataType>& b1_gs_os_ns_;
+        Tensor<CDataType>& c_gs_ms_os_;
+
+        AElementwiseOperation a_element_op_;
+        B0ElementwiseOperation b0_element_op_;
+        Acc0ElementwiseOperation acc0_element_op_;
+        B1ElementwiseOperation b1_element_op_;
+        CElementwiseOperation c_element_op_;
+    };
+
+    // Invoker
+    struct Invoker : public device::BaseInvoker
+    {
+        using Argument = ReferenceBatchedGemmSoftmaxGemmPermute::Argument;
+        using Blocking = HostGemmBlocking;
+
+        // offset of every flattened batch index into a tensor whose leading NumDimG dims are
+        // the batch dims
+        template <typename T>
+        static std::vector<std::size_t> GetBatchOffsets(const Tensor<T>& t)
+        {
+            const auto& lengths = t.mDesc.GetLengths();
+            const auto& strides = t.mDesc.GetStrides();
+
+            std::vector<std::size_t> offsets{0};
+
+            for(index_t d = 0; d < NumDimG; ++d)
+            {
+                std::vector<std::size_t> next;
+
+                next.reserve(offsets.size() * lengths[d]);
+
+                for(std::size_t offset : offsets)
+                    for(std::size_t i = 0; i < lengths[d]; ++i)
+                        next.push_back(offset + i * strides[d]);
+
+                offsets = std::move(next);
+            }
+
+            return offsets;
+        }
+
+        float Run(const Argument& arg)
+        {
+            const auto& a_lengths  = arg.a_gs_ms_ks_.mDesc.GetLengths();
+            const auto& b1_lengths = arg.b1_gs_os_ns_.mDesc.GetLengths();
+
+            const index_t M = a_lengths[NumDimG];
+            const index_t K = a_lengths[NumDimG + 1];
+            const index_t O = b1_lengths[NumDimG];
+            const index_t N = b1_lengths[NumDimG + 1];
+
+            const auto a_offsets  = GetBatchOffsets(arg.a_gs_ms_ks_);
+            const auto b0_offsets = GetBatchOffsets(arg.b0_gs_ns_ks_);
+            const auto b1_offsets = GetBatchOffsets(arg.b1_gs_os_ns_);
+            const auto c_offsets  = GetBatchOffsets(arg.c_gs_ms_os_);
+
+            const index_t G = a_offsets.size();
+
+            const auto& a_strides  = arg.a_gs_ms_ks_.mDesc.GetStrides();
+            const auto& b0_strides = arg.b0_gs_ns_ks_.mDesc.GetStrides();
+            const auto& b1_strides = arg.b1_gs_os_ns_.mDesc.GetStrides();
+            const auto& c_strides  = arg.c_gs_ms_os_.mDesc.GetStrides();
+
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+
+            const index_t num_m_tile = math::integer_divide_ceil(M, Blocking::MC);
+            const index_t num_n_tile = math::integer_divide_ceil(N, Blocking::NC);
+
+            // Gemm0 (S = A * B0^T) has the whole B0 of a batch packed; Gemm1 (C += P * B1) is
+            // run per score column tile, so B1 is packed as one GEMM per (batch, N tile) whose
+            // reduction covers that tile only
+            std::vector<HostBlockedGemm<AccDataType>> gemm0s;
+            std::vector<HostBlockedGemm<AccDataType>> gemm1s;
+
+            gemm0s.reserve(G);
+            gemm1s.reserve(static_cast<std::size_t>(G) * num_n_tile);
+
+            for(index_t g = 0; g < G; ++g)
+            {
+                gemm0s.emplace_back(M, N, K);
+                gemm0s.back().AllocateB();
+
+                for(index_t in = 0; in < num_n_tile; ++in)
+                {
+                    gemm1s.emplace_back(M, O, std::min(Blocking::NC, N - in * Blocking::NC));
+                    gemm1s.back().AllocateB();
+                }
+            }
+
+            auto f_pack_b0 = [&](auto g, auto q) {
+                const B0DataType* p_b0 = &arg.b0_gs_ns_ks_.mData[b0_offsets[g]];
+
+                auto b0_getter = [&](index_t k, index_t n) {
+                    B0DataType v_b0;
+
+                    arg.b0_element_op_(
+                        v_b0, p_b0[n * b0_strides[NumDimG] + k * b0_strides[NumDimG + 1]]);
+
+                    return ck::type_convert<AccDataType>(v_b0);
+                };
+
+                gemm0s[g].PackBPanel(q, b0_getter);
+            };
+
+            auto f_pack_b1 = [&](auto g, auto in, auto q) {
+                const B1DataType* p_b1 = &arg.b1_gs_os_ns_.mData[b1_offsets[g]];
+
+                const index_t n0 = in * Blocking::NC;
+
+                auto b1_getter = [&](index_t n, index_t o) {
+                    B1DataType v_b1;
+
+                    arg.b1_element_op_(
+                        v_b1, p_b1[o * b1_strides[NumDimG] + (n0 + n) * b1_strides[NumDimG + 1]]);
+
+                    return ck::type_convert<AccDataType>(v_b1);
+                };
+
+                gemm1s[static_cast<std::size_t>(g) * num_n_tile + in].PackBPanel(q, b1_getter);
+            };
+
+            if(G > 0)
+            {
+                make_ParallelTensorFunctor(f_pack_b0, G, gemm0s[0].GetNumBPanel())(num_thread);
+
+                if(num_n_tile > 0)
+                {
+                    make_ParallelTensorFunctor(
+                        f_pack_b1, G, num_n_tile, gemm1s[0].GetNumBPanel())(num_thread);
+                }
+            }
+
+            auto f_block = [&](auto g, auto im) {
+                const ADataType* p_a = &arg.a_gs_ms_ks_.mData[a_offsets[g]];
+                CDataType* p_c       = &arg.c_gs_ms_os_.mData[c_offsets[g]];
+
+                const index_t m0 = im * Blocking::MC;
+                const index_t mc = std::min(Blocking::MC, M - m0);
+
+                // one score / probability tile, and the output rows of this block
+                std::vector<AccDataType> s(static_cast<std::size_t>(mc) * Blocking::NC);
+                std::vector<AccDataType> c(static_cast<std::size_t>(mc) * O, AccDataType{0});
+
+                std::vector<AccDataType> row_max(mc, -std::numeric_limits<AccDataType>::infinity());
+                std::vector<AccDataType> row_sum(mc, AccDataType{0});
+
+                const auto mask = MaskOutPredicate{};
+
+                auto a_getter = [&](index_t m, index_t k) {
+                    ADataType v_a;
+
+                    arg.a_element_op_(
+                        v_a, p_a[m * a_strides[NumDimG] + k * a_strides[NumDimG + 1]]);
+
+                    return ck::type_convert<AccDataType>(v_a);
+                };
+
+                for(index_t in = 0; in < num_n_tile; ++in)
+                {
+                    const index_t n0 = in * Blocking::NC;
+                    const index_t nc = std::min(Blocking::NC, N - n0);
+
+                    // every score of the tile is masked out, it contributes nothing
+                    if(mask.IsTileSkippable(m0, n0, mc, nc))
+                        continue;
+
+                    auto s_epilogue = [&](index_t m, index_t n, AccDataType v_acc) {
+                        AccDataType v_s;
+
+                        arg.acc0_element_op_(v_s, v_acc);
+
+                        s[(m - m0) * Blocking::NC + (n - n0)] =
+                            mask(m, n) ? -std::numeric_limits<AccDataType>::infinity() : v_s;
+                    };
+
+                    gemm0s[g].RunTile(im, in, in + 1, a_getter, s_epilogue);
+
+                    for(index_t i = 0; i < mc; ++i)
+                    {
+                        AccDataType* p_s = &s[i * Blocking::NC];
+
+                        const AccDataType new_max =
+                            std::max(row_max[i], *std::max_element(p_s, p_s + nc));
+
+                        // nothing unmasked seen in this row yet
+                        if(new_max == -std::numeric_limits<AccDataType>::infinity())
+                        {
+                            std::fill(p_s, p_s + nc, AccDataType{0});
+                            continue;
+                        }
+
+                        const AccDataType old_sum = row_sum[i] * std::exp(row_max[i] - new_max);
+
+                        AccDataType new_sum = old_sum;
+
+                        for(index_t j = 0; j < nc; ++j)
+                        {
+                            p_s[j] = std::exp(p_s[j] - new_max);
+                            new_sum += p_s[j];
+                        }
+
+                        for(index_t j = 0; j < nc; ++j)
+                        {
+                            p_s[j] = ck::type_convert<AccDataType>(
+                                ck::type_convert<ADataType>(p_s[j] / new_sum));
+                        }
+
+                        const AccDataType rescale = old_sum / new_sum;
+
+                        for(index_t o = 0; o < O; ++o)
+                        {
+                            c[i * O + o] *= rescale;
+                        }
+
+                        row_max[i] = new_max;
+                        row_sum[i] = new_sum;
+                    }
+
+                    auto p_getter = [&](index_t m, index_t n) {
+                        return s[(m - m0) * Blocking::NC + n];
+                    };
+
+                    auto c_epilogue = [&](index_t m, index_t o, AccDataType v_acc) {
+                        c[(m - m0) * O + o] += v_acc;
+                    };
+
+                    const auto& gemm1 = gemm1s[static_cast<std::size_t>(g) * num_n_tile + in];
+
+                    gemm1.RunTile(im, 0, gemm1.GetNumNTile(), p_getter, c_epilogue);
+                }
+
+                for(index_t i = 0; i < mc; ++i)
+                {
+                    // exp(-inf - -inf) of the unfused softmax
+                    if(row_max[i] == -std::numeric_limits<AccDataType>::infinity())
+                    {
+                        std::fill(&c[i * O],
+                                  &c[i * O] + O,
+                                  std::numeric_limits<AccDataType>::quiet_NaN());
+                    }
+
+                    for(index_t o = 0; o < O; ++o)
+                    {
+                        AccDataType v_c;
+
+                        arg.c_element_op_(v_c, c[i * O + o]);
+
+                        p_c[(m0 + i) * c_strides[NumDimG] + o * c_strides[NumDimG + 1]] =
+                            ck::type_convert<CDataType>(v_c);
+                    }
+                }
+            };
+
+            make_ParallelTensorFunctor(f_block, G, num_m_tile)(num_thread);
+
+            return 0;
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter()
+    {
+        // TODO: properly implement this check
+        return true;
+    }
+
+    bool IsSupportedArgument(const device::BaseArgument* p_arg) override
+    {
+        const Argument& arg = *dynamic_cast<const Argument*>(p_arg);
+
+        const auto& a_lengths  = arg.a_gs_ms_ks_.mDesc.GetLengths();
+        const auto& b0_lengths = arg.b0_gs_ns_ks_.mDesc.GetLengths();
+        const auto& b1_lengths = arg.b1_gs_os_ns_.mDesc.GetLengths();
+        const auto& c_lengths  = arg.c_gs_ms_os_.mDesc.GetLengths();
+
+        if(a_lengths.size() != NumDimG + 2 || b0_lengths.size() != NumDimG + 2 ||
+           b1_lengths.size() != NumDimG + 2 || c_lengths.size() != NumDimG + 2)
+        {
+            return false;
+        }
+
+        if(!std::equal(a_lengths.begin(), a_lengths.begin() + NumDimG, b0_lengths.begin()) ||
+           !std::equal(a_lengths.begin(), a_lengths.begin() + NumDimG, b1_lengths.begin()) ||
+           !std::equal(a_lengths.begin(), a_lengths.begin() + NumDimG, c_lengths.begin()))
+        {
+            return false;
+        }
+
+        // M, N, K, O
+        return a_lengths[NumDimG] == c_lengths[NumDimG] &&
+               b0_lengths[NumDimG] == b1_lengths[NumDimG + 1] &&
+               a_lengths[NumDimG + 1] == b0_lengths[NumDimG + 1] &&
+               b1_lengths[NumDimG] == c_lengths[NumDimG + 1];
+    }
+
+    static auto MakeArgument(const Tensor<ADataType>& a_gs_ms_ks,
+                             const Tensor<B0DataType>& b0_gs_ns_ks,
+                             const Tensor<B1DataType>& b1_gs_os_ns,
+                             Tensor<CDataType>& c_gs_ms_os,
+                             AElementwiseOperation a_element_op,
+                             B0ElementwiseOperation b0_element_op,
+                             Acc0ElementwiseOperation acc0_element_op,
+                             B1ElementwiseOperation b1_element_op,
+                             CElementwiseOperation c_element_op)
+    {
+        return Argument{a_gs_ms_ks,
+                        b0_gs_ns_ks,
+                        b1_gs_os_ns,
+                        c_gs_ms_os,
+                        a_element_op,
+                        b0_element_op,
+                        acc0_element_op,
+                        b1_element_op,
+                        c_element_op};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferenceBatchedGemmSoftmaxGemmPermute"
+            << "<"
+            << NumDimG << ", "
+            << device::getMaskingSpecializationString(MaskingSpec)
+            << ">"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
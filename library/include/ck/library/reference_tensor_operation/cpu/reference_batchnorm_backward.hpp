@@ -11,6 +11,9 @@
 #include "ck/utility/math_v2.hpp"
 #include "ck/utility/ignore.hpp"
 #include "ck/library/utility/host_common_util.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_batchnorm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_reduction.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_welford.hpp"
 #include "ck/tensor_operation/gpu/device/device_batchnorm_backward.hpp"
 
 namespace ck {
@@ -173,74 +176,289 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
 
     struct Invoker : public device::BaseInvoker
     {
-        float Run(const Argument& arg)
+        // NHWC and alike: the channels of a reduce index are one contiguous row of x, dy and dx,
+        // both sweeps process them as vector lanes
+        static bool IsChannelLast(const Argument& arg)
+        {
+            if constexpr(NumInvariantDim == 1)
+                return arg.x_invariant_strides_[0] == 1 && arg.dy_invariant_strides_[0] == 1 &&
+                       arg.dx_invariant_strides_[0] == 1;
+            else
+                return false;
+        };
+
+        static void RunChannelLast(const Argument& arg)
         {
             using ck::host_common::get_offset_from_index;
 
-            auto thread_reduce_func = [&](auto invariant_index) {
-                size_t x_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.x_invariant_strides_, invariant_index);
-                size_t dy_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.dy_invariant_strides_, invariant_index);
-                size_t dx_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.dx_invariant_strides_, invariant_index);
+            const std::size_t num_channel = arg.invariant_lengths_[0];
+            const std::size_t num_row     = arg.reduce_index_set_.size();
+
+            const HostReductionPartition partition(1, num_row, num_channel);
 
-                AccDataType mean     = type_convert<AccDataType>(0.0f);
-                AccDataType variance = type_convert<AccDataType>(0.0f);
-                AccDataType invVar;
-                int32_t curr_count = 0;
+            auto get_x_row = [&](std::size_t i) {
+                return arg.p_x_ + get_offset_from_index<NumBatchNormReduceDim>(
+                                      arg.x_reduce_strides_, arg.reduce_index_set_[i]);
+            };
+
+            auto get_dy_row = [&](std::size_t i) {
+                return arg.p_dy_ + get_offset_from_index<NumBatchNormReduceDim>(
+                                       arg.dy_reduce_strides_, arg.reduce_index_set_[i]);
+            };
+
+            auto get_dx_row = [&](std::size_t i) {
+                return arg.p_dx_ + get_offset_from_index<NumBatchNormReduceDim>(
+                                       arg.dx_reduce_strides_, arg.reduce_index_set_[i]);
+            };
+
+            std::vector<AccDataType> means(num_channel);
+            std::vector<AccDataType> invVars(num_channel);
+            std::vector<AccDataType> scales(num_channel);
+            std::vector<AccDataType> dscales(num_channel);
+            std::vector<AccDataType> dbiases(num_channel);
+
+            // sum(dy * (x - shift)) is taken around a per-channel shift close to the mean, so the
+            // statistics and the sums share the first sweep without the cancellation of
+            // sum(dy * x) - mean * sum(dy); the shift is the saved mean, else the first row of x
+            std::vector<AccDataType> shifts(num_channel);
+
+            for(std::size_t c = 0; c < num_channel; ++c)
+            {
+                scales[c] = type_convert<AccDataType>(arg.p_scale_[c * arg.bnScaleStrides_[0]]);
 
                 if(arg.haveSavedMeanInvVar_)
+                {
+                    const std::size_t offset = c * arg.bnMeanVarStrides_[0];
+
+                    means[c]   = type_convert<AccDataType>(arg.p_savedMean_[offset]);
+                    invVars[c] = type_convert<AccDataType>(arg.p_savedInvVar_[offset]);
+                    shifts[c]  = means[c];
+                }
+                else if(num_row > 0)
+                {
+                    shifts[c] = type_convert<AccDataType>(get_x_row(0)[c]);
+                };
+            }
+
+            struct Partial
+            {
+                HostChannelWelford<AccDataType> welford_;
+                std::vector<AccDataType> sum_dy_;
+                std::vector<AccDataType> sum_dy_x_;
+            };
+
+            // 1) calculate mean, variance using welford method, unless they are saved
+            // 2) calculate sum(dy) and sum(dy * (x - shift)) on reduced dimensions
+            auto reduce_split = [&](std::size_t, std::size_t begin, std::size_t end) {
+                Partial partial{
+                    HostChannelWelford<AccDataType>(arg.haveSavedMeanInvVar_ ? 0 : num_channel),
+                    std::vector<AccDataType>(num_channel),
+                    std::vector<AccDataType>(num_channel)};
+
+                for(std::size_t i = begin; i < end; ++i)
+                {
+                    const XDataType* p_x   = get_x_row(i);
+                    const DyDataType* p_dy = get_dy_row(i);
+
+                    if(!arg.haveSavedMeanInvVar_)
+                        partial.welford_.Update(p_x);
+
+                    for(std::size_t c = 0; c < num_channel; ++c)
+                    {
+                        AccDataType x  = type_convert<AccDataType>(p_x[c]);
+                        AccDataType dy = type_convert<AccDataType>(p_dy[c]);
+
+                        arg.dy_elementwise_op_(dy, dy);
+
+                        partial.sum_dy_[c] += dy;
+                        partial.sum_dy_x_[c] += dy * (x - shifts[c]);
+                    }
+                };
+
+                return partial;
+            };
+
+            auto merge_partial = [&](Partial& left, const Partial& right) {
+                left.welford_.Merge(right.welford_);
+
+                for(std::size_t c = 0; c < num_channel; ++c)
+                {
+                    left.sum_dy_[c] += right.sum_dy_[c];
+                    left.sum_dy_x_[c] += right.sum_dy_x_[c];
+                }
+            };
+
+            // dbias = sum(dy), dscale = sum(dy * norm_x) = invVar * (sum(dy * (x - shift)) -
+            // (mean - shift) * sum(dy))
+            auto finalize = [&](std::size_t, const Partial& sums) {
+                for(std::size_t c = 0; c < num_channel; ++c)
+                {
+                    if(!arg.haveSavedMeanInvVar_)
+                    {
+                        means[c] = sums.welford_.GetMean(c);
+
+                        // inv-variance defined as 1/sqrt(epsilon+variance)
+                        invVars[c] = type_convert<AccDataType>(1.0f) /
+                                     ck::math::sqrt(arg.epsilon_ + sums.welford_.GetVariance(c));
+                    };
+
+                    dbiases[c] = sums.sum_dy_[c];
+                    dscales[c] = invVars[c] * (sums.sum_dy_x_[c] -
+                                               (means[c] - shifts[c]) * dbiases[c]);
+
+                    const std::size_t offset = c * arg.bnDscaleDbiasStrides_[0];
+
+                    arg.p_dscale_[offset] = type_convert<DscaleDbiasDataType>(dscales[c]);
+                    arg.p_dbias_[offset]  = type_convert<DscaleDbiasDataType>(dbiases[c]);
+                }
+            };
+
+            host_reduction_run<Partial>(partition, reduce_split, merge_partial, finalize);
+
+            const AccDataType reduceSize = type_convert<AccDataType>(arg.reduceSize_);
+
+            std::vector<AccDataType> multipliers(num_channel);
+
+            for(std::size_t c = 0; c < num_channel; ++c)
+            {
+                multipliers[c] =
+                    type_convert<AccDataType>(1.0f) / reduceSize * invVars[c] * scales[c];
+            }
+
+            // dx = 1/reduceSize * inv-variance * scale * (reduceSize * dy - dbias - dscale *
+            // norm_x)
+            auto dx_split = [&](std::size_t, std::size_t begin, std::size_t end) {
+                for(std::size_t i = begin; i < end; ++i)
+                {
+                    const XDataType* p_x   = get_x_row(i);
+                    const DyDataType* p_dy = get_dy_row(i);
+                    DxDataType* p_dx       = get_dx_row(i);
+
+                    for(std::size_t c = 0; c < num_channel; ++c)
+                    {
+                        AccDataType x = type_convert<AccDataType>(p_x[c]);
+
+                        AccDataType norm_x = (x - means[c]) * invVars[c];
+                        AccDataType dy     = type_convert<AccDataType>(p_dy[c]);
+
+                        arg.dy_elementwise_op_(dy, dy);
+
+                        AccDataType dx = multipliers[c] * (reduceSize * dy - dbiases[c] -
+                                                           norm_x * dscales[c]);
+
+                        p_dx[c] = type_convert<DxDataType>(dx);
+                    }
+                };
+            };
+
+            host_reduction_for_each(partition, dx_split);
+        };
+
+        float Run(const Argument& arg)
+        {
+            using ck::host_common::get_offset_from_index;
+
+            if(IsChannelLast(arg))
+            {
+                RunChannelLast(arg);
+
+                return (0.0f);
+            };
+
+            const std::size_t num_invariant = arg.invariant_index_set_.size();
+
+            // the reduce space is also split when there are few channels
+            const HostReductionPartition partition(num_invariant, arg.reduce_index_set_.size());
+
+            std::vector<AccDataType> means(num_invariant);
+            std::vector<AccDataType> invVars(num_invariant);
+
+            auto get_x_invariant_offset = [&](std::size_t iinv) {
+                return get_offset_from_index<NumInvariantDim>(arg.x_invariant_strides_,
+                                                              arg.invariant_index_set_[iinv]);
+            };
+
+            auto get_dy_invariant_offset = [&](std::size_t iinv) {
+                return get_offset_from_index<NumInvariantDim>(arg.dy_invariant_strides_,
+                                                              arg.invariant_index_set_[iinv]);
+            };
+
+            if(arg.haveSavedMeanInvVar_)
+            {
+                for(std::size_t iinv = 0; iinv < num_invariant; ++iinv)
                 {
                     size_t mean_invVar_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                        arg.bnMeanVarStrides_, invariant_index);
+                        arg.bnMeanVarStrides_, arg.invariant_index_set_[iinv]);
 
-                    mean =
+                    means[iinv] =
                         type_convert<AccDataType>(arg.p_savedMean_[mean_invVar_invariant_offset]);
-                    invVar =
+                    invVars[iinv] =
                         type_convert<AccDataType>(arg.p_savedInvVar_[mean_invVar_invariant_offset]);
                 }
-                else
-                {
-                    // compute mean, variance using welford method
-                    for(const auto& reduce_index : arg.reduce_index_set_)
+            }
+            else
+            {
+                // compute mean, variance using welford method, splits merged with Chan's formula
+                auto reduce_split = [&](std::size_t iinv, std::size_t begin, std::size_t end) {
+                    size_t x_invariant_offset = get_x_invariant_offset(iinv);
+
+                    HostWelford<AccDataType> welford;
+
+                    for(std::size_t i = begin; i < end; ++i)
                     {
                         size_t x_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
-                            arg.x_reduce_strides_, reduce_index);
+                            arg.x_reduce_strides_, arg.reduce_index_set_[i]);
 
                         auto x_offset = x_invariant_offset + x_reduce_offset;
 
-                        curr_count++;
+                        welford.Update(type_convert<AccDataType>(arg.p_x_[x_offset]));
+                    };
 
-                        AccDataType x = type_convert<AccDataType>(arg.p_x_[x_offset]);
+                    return welford;
+                };
 
-                        AccDataType delta = x - mean;
+                auto merge_partial = [](HostWelford<AccDataType>& left,
+                                        const HostWelford<AccDataType>& right) {
+                    left.Merge(right);
+                };
 
-                        mean += delta / curr_count;
+                auto finalize = [&](std::size_t iinv, const HostWelford<AccDataType>& welford) {
+                    means[iinv] = welford.GetMean();
 
-                        AccDataType delta2 = x - mean;
+                    // inv-variance defined as 1/sqrt(epsilon+variance)
+                    invVars[iinv] = type_convert<AccDataType>(1.0f) /
+                                    ck::math::sqrt(arg.epsilon_ + welford.GetVariance());
+                };
 
-                        variance += delta * delta2;
-                    };
+                host_reduction_run<HostWelford<AccDataType>>(
+                    partition, reduce_split, merge_partial, finalize);
+            };
+
+            // Sum on reduced dimensions of dy and of dy * norm_x
+            struct DscaleDbias
+            {
+                AccDataType dscale_ = 0;
+                AccDataType dbias_  = 0;
+            };
 
-                    // actual variance
-                    variance = variance / curr_count;
+            std::vector<DscaleDbias> dscaleDbiases(num_invariant);
 
-                    // inv-variance defined as 1/sqrt(epsilon+variance)
-                    invVar =
-                        type_convert<AccDataType>(1.0f) / ck::math::sqrt(arg.epsilon_ + variance);
-                };
+            // 1) calculate dy * (x - mean) * inv-variance
+            // 2) calculate sum(dy) on reduced dimensions
+            // 3) calculate sum(dy * norm_x) on reduced dimensions
+            auto reduce_split = [&](std::size_t iinv, std::size_t begin, std::size_t end) {
+                size_t x_invariant_offset  = get_x_invariant_offset(iinv);
+                size_t dy_invariant_offset = get_dy_invariant_offset(iinv);
+
+                AccDataType mean   = means[iinv];
+                AccDataType invVar = invVars[iinv];
 
-                AccDataType dbias =
-                    type_convert<AccDataType>(0.0f); // Sum on reduced dimensions of dy
-                AccDataType dscale =
-                    type_convert<AccDataType>(0.0f); // Sum on reduced dimensions of dy * norm_x
+                DscaleDbias partial;
 
-                // 1) calculate dy * (x - mean) * inv-variance
-                // 2) calculate sum(dy) on reduced dimensions
-                // 3) calculate sum(dy * norm_x) on reduced dimensions
-                for(const auto& reduce_index : arg.reduce_index_set_)
+                for(std::size_t i = begin; i < end; ++i)
                 {
+                    const auto& reduce_index = arg.reduce_index_set_[i];
+
                     size_t x_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
                         arg.x_reduce_strides_, reduce_index);
                     size_t dy_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
@@ -256,32 +474,63 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
 
                     arg.dy_elementwise_op_(dy, dy);
 
-                    dbias += dy;
-                    dscale += norm_x * dy;
+                    partial.dbias_ += dy;
+                    partial.dscale_ += norm_x * dy;
                 };
 
+                return partial;
+            };
+
+            auto merge_partial = [](DscaleDbias& left, const DscaleDbias& right) {
+                left.dscale_ += right.dscale_;
+                left.dbias_ += right.dbias_;
+            };
+
+            auto finalize = [&](std::size_t iinv, const DscaleDbias& sums) {
+                const auto& invariant_index = arg.invariant_index_set_[iinv];
+
                 size_t dscale_offset = get_offset_from_index<NumInvariantDim>(
                     arg.bnDscaleDbiasStrides_, invariant_index);
                 size_t dbias_offset = get_offset_from_index<NumInvariantDim>(
                     arg.bnDscaleDbiasStrides_, invariant_index);
 
-                arg.p_dscale_[dscale_offset] = type_convert<DscaleDbiasDataType>(dscale);
-                arg.p_dbias_[dbias_offset]   = type_convert<DscaleDbiasDataType>(dbias);
+                arg.p_dscale_[dscale_offset] = type_convert<DscaleDbiasDataType>(sums.dscale_);
+                arg.p_dbias_[dbias_offset]   = type_convert<DscaleDbiasDataType>(sums.dbias_);
+
+                dscaleDbiases[iinv] = sums;
+            };
+
+            host_reduction_run<DscaleDbias>(partition, reduce_split, merge_partial, finalize);
+
+            // 1) calculate tmp = dscale * (x - mean) * inv-variance
+            // 2) calculate dx = 1/reduceSize * inv-variance * scale * (reduceSize * dy - dbias
+            // - tmp)
+            auto dx_split = [&](std::size_t iinv, std::size_t begin, std::size_t end) {
+                const auto& invariant_index = arg.invariant_index_set_[iinv];
+
+                size_t x_invariant_offset  = get_x_invariant_offset(iinv);
+                size_t dy_invariant_offset = get_dy_invariant_offset(iinv);
+                size_t dx_invariant_offset = get_offset_from_index<NumInvariantDim>(
+                    arg.dx_invariant_strides_, invariant_index);
 
                 size_t scale_offset =
                     get_offset_from_index<NumInvariantDim>(arg.bnScaleStrides_, invariant_index);
 
+                AccDataType mean   = means[iinv];
+                AccDataType invVar = invVars[iinv];
+                AccDataType dscale = dscaleDbiases[iinv].dscale_;
+                AccDataType dbias  = dscaleDbiases[iinv].dbias_;
+
                 AccDataType scale = type_convert<AccDataType>(arg.p_scale_[scale_offset]);
 
                 AccDataType multiplier = type_convert<AccDataType>(1.0f) /
                                          type_convert<AccDataType>(arg.reduceSize_) * invVar *
                                          scale;
 
-                // 1) calculate tmp = dscale * (x - mean) * inv-variance
-                // 2) calculate dx = 1/reduceSize * inv-variance * scale * (reduceSize * dy - dbias
-                // - tmp)
-                for(const auto& reduce_index : arg.reduce_index_set_)
+                for(std::size_t i = begin; i < end; ++i)
                 {
+                    const auto& reduce_index = arg.reduce_index_set_[i];
+
                     size_t x_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
                         arg.x_reduce_strides_, reduce_index);
                     size_t dy_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
@@ -309,27 +558,7 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
                 };
             };
 
-            std::size_t num_thread = std::thread::hardware_concurrency();
-            std::size_t work_per_thread =
-                (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
-
-            std::vector<joinable_thread> threads(num_thread);
-
-            for(std::size_t it = 0; it < num_thread; ++it)
-            {
-                std::size_t i_begin = it * work_per_thread;
-                std::size_t i_end   = std::min(static_cast<size_t>((it + 1) * work_per_thread),
-                                             arg.invariant_index_set_.size());
-
-                auto f = [=] {
-                    for(std::size_t i = i_begin; i < i_end; ++i)
-                    {
-                        thread_reduce_func(arg.invariant_index_set_[i]);
-                    }
-                };
-
-                threads[it] = joinable_thread(f);
-            }
+            host_reduction_for_each(partition, dx_split);
 
             return (0.0f);
         };
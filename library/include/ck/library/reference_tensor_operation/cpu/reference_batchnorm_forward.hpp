@@ -11,6 +11,9 @@
 #include "ck/utility/math_v2.hpp"
 #include "ck/utility/ignore.hpp"
 #include "ck/library/utility/host_common_util.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_batchnorm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_reduction.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_welford.hpp"
 #include "ck/tensor_operation/gpu/device/device_batchnorm_forward.hpp"
 
 namespace ck {
@@ -166,47 +169,145 @@ struct ReferenceBatchNormFwd : public device::DeviceBatchNormFwd<XDataType,
 
     struct Invoker : public device::BaseInvoker
     {
+        // NHWC and alike: the channels of a reduce index are one contiguous row of x and of y,
+        // statistics and normalization process them as vector lanes
+        static bool IsChannelLast(const Argument& arg)
+        {
+            if constexpr(NumInvariantDim == 1)
+                return arg.x_invariant_strides_[0] == 1 && arg.y_invariant_strides_[0] == 1;
+            else
+                return false;
+        };
+
+        static void RunChannelLast(const Argument& arg)
+        {
+            using ck::host_common::get_offset_from_index;
+
+            const std::size_t num_channel = arg.invariant_lengths_[0];
+
+            const HostReductionPartition partition(1, arg.reduce_index_set_.size(), num_channel);
+
+            auto get_x_row = [&](std::size_t i) {
+                return arg.p_x_ + get_offset_from_index<NumBatchNormReduceDim>(
+                                      arg.x_reduce_strides_, arg.reduce_index_set_[i]);
+            };
+
+            auto get_y_row = [&](std::size_t i) {
+                return arg.p_y_ + get_offset_from_index<NumBatchNormReduceDim>(
+                                      arg.y_reduce_strides_, arg.reduce_index_set_[i]);
+            };
+
+            // one pass over x for the statistics of all channels
+            const auto welford = host_batchnorm_channel_last_welford<AccDataType>(
+                partition, num_channel, get_x_row);
+
+            std::vector<AccDataType> means(num_channel);
+            std::vector<AccDataType> invVariances(num_channel);
+            std::vector<AccDataType> scales(num_channel);
+            std::vector<AccDataType> biases(num_channel);
+
+            const AccDataType oneMinusAverageFactor =
+                type_convert<AccDataType>(1.0) - arg.averageFactor_;
+
+            for(std::size_t c = 0; c < num_channel; ++c)
+            {
+                const std::size_t offset = c * arg.bnMeanVarStrides_[0];
+
+                AccDataType mean     = welford.GetMean(c);
+                AccDataType variance = welford.GetVariance(c);
+
+                // inv-variance defined as 1/sqrt(epsilon+variance)
+                AccDataType invVariance =
+                    type_convert<AccDataType>(1.0f) / ck::math::sqrt(arg.epsilon_ + variance);
+
+                means[c]        = mean;
+                invVariances[c] = invVariance;
+                scales[c] = type_convert<AccDataType>(arg.bnScale_[c * arg.bnScaleStrides_[0]]);
+                biases[c] = type_convert<AccDataType>(arg.bnBias_[c * arg.bnBiasStrides_[0]]);
+
+                if(arg.resultSave)
+                {
+                    arg.resultSaveMean_[offset]        = type_convert<MeanVarDataType>(mean);
+                    arg.resultSaveInvVariance_[offset] = type_convert<MeanVarDataType>(invVariance);
+                };
+
+                if(arg.resultRunning)
+                {
+                    arg.resultRunningMean_[offset] = type_convert<MeanVarDataType>(
+                        type_convert<AccDataType>(arg.resultRunningMean_[offset]) *
+                            oneMinusAverageFactor +
+                        mean * arg.averageFactor_);
+                    arg.resultRunningVariance_[offset] = type_convert<MeanVarDataType>(
+                        arg.resultRunningVariance_[offset] * oneMinusAverageFactor +
+                        variance * arg.averageFactor_);
+                };
+            }
+
+            host_batchnorm_channel_last_normalize<AccDataType, YDataType>(partition,
+                                                                          means,
+                                                                          invVariances,
+                                                                          scales,
+                                                                          biases,
+                                                                          arg.y_elementwise_op_,
+                                                                          get_x_row,
+                                                                          get_y_row);
+        };
+
         float Run(const Argument& arg)
         {
             using ck::host_common::get_offset_from_index;
 
-            auto thread_reduce_func = [&](auto invariant_index) {
+            if(IsChannelLast(arg))
+            {
+                RunChannelLast(arg);
+
+                return (0.0f);
+            };
+
+            const std::size_t num_invariant = arg.invariant_index_set_.size();
+
+            // the reduce space is also split when there are few channels
+            const HostReductionPartition partition(num_invariant, arg.reduce_index_set_.size());
+
+            std::vector<AccDataType> means(num_invariant);
+            std::vector<AccDataType> invVariances(num_invariant);
+
+            // compute mean, variance using welford method, splits merged with Chan's formula
+            auto reduce_split = [&](std::size_t iinv, std::size_t begin, std::size_t end) {
                 size_t x_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.x_invariant_strides_, invariant_index);
-                size_t y_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                    arg.y_invariant_strides_, invariant_index);
-                AccDataType mean     = type_convert<AccDataType>(0.0f);
-                AccDataType variance = type_convert<AccDataType>(0.0f);
-                int32_t curr_count   = 0;
+                    arg.x_invariant_strides_, arg.invariant_index_set_[iinv]);
+
+                HostWelford<AccDataType> welford;
 
-                // compute mean, variance using welford method
-                for(const auto& reduce_index : arg.reduce_index_set_)
+                for(std::size_t i = begin; i < end; ++i)
                 {
                     size_t x_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
-                        arg.x_reduce_strides_, reduce_index);
+                        arg.x_reduce_strides_, arg.reduce_index_set_[i]);
 
                     auto x_offset = x_invariant_offset + x_reduce_offset;
 
-                    curr_count++;
-
-                    AccDataType x = type_convert<AccDataType>(arg.p_x_[x_offset]);
-
-                    AccDataType delta = x - mean;
+                    welford.Update(type_convert<AccDataType>(arg.p_x_[x_offset]));
+                };
 
-                    mean += delta / curr_count;
+                return welford;
+            };
 
-                    AccDataType delta2 = x - mean;
+            auto merge_partial = [](HostWelford<AccDataType>& left,
+                                    const HostWelford<AccDataType>& right) { left.Merge(right); };
 
-                    variance += delta * delta2;
-                };
+            auto finalize = [&](std::size_t iinv, const HostWelford<AccDataType>& welford) {
+                const auto& invariant_index = arg.invariant_index_set_[iinv];
 
-                // actual variance
-                variance = variance / curr_count;
+                AccDataType mean     = welford.GetMean();
+                AccDataType variance = welford.GetVariance();
 
                 // inv-variance defined as 1/sqrt(epsilon+variance)
                 AccDataType invVariance =
                     type_convert<AccDataType>(1.0f) / ck::math::sqrt(arg.epsilon_ + variance);
 
+                means[iinv]        = mean;
+                invVariances[iinv] = invVariance;
+
                 // save the mean/inv-variance if required
                 if(arg.resultSave)
                 {
@@ -233,18 +334,35 @@ struct ReferenceBatchNormFwd : public device::DeviceBatchNormFwd<XDataType,
                         arg.resultRunningVariance_[offset] * oneMinusAverageFactor +
                         variance * arg.averageFactor_);
                 };
+            };
+
+            host_reduction_run<HostWelford<AccDataType>>(
+                partition, reduce_split, merge_partial, finalize);
+
+            // Normalization
+            auto normalize_split = [&](std::size_t iinv, std::size_t begin, std::size_t end) {
+                const auto& invariant_index = arg.invariant_index_set_[iinv];
+
+                size_t x_invariant_offset = get_offset_from_index<NumInvariantDim>(
+                    arg.x_invariant_strides_, invariant_index);
+                size_t y_invariant_offset = get_offset_from_index<NumInvariantDim>(
+                    arg.y_invariant_strides_, invariant_index);
 
                 size_t scale_offset =
                     get_offset_from_index<NumInvariantDim>(arg.bnScaleStrides_, invariant_index);
                 size_t bias_offset =
                     get_offset_from_index<NumInvariantDim>(arg.bnBiasStrides_, invariant_index);
 
+                AccDataType mean        = means[iinv];
+                AccDataType invVariance = invVariances[iinv];
+
                 AccDataType scale = type_convert<AccDataType>(arg.bnScale_[scale_offset]);
                 AccDataType bias  = type_convert<AccDataType>(arg.bnBias_[bias_offset]);
 
-                // Normalization
-                for(const auto& reduce_index : arg.reduce_index_set_)
+                for(std::size_t i = begin; i < end; ++i)
                 {
+                    const auto& reduce_index = arg.reduce_index_set_[i];
+
                     size_t x_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
                         arg.x_reduce_strides_, reduce_index);
                     size_t y_reduce_offset = get_offset_from_index<NumBatchNormReduceDim>(
@@ -265,27 +383,7 @@ struct ReferenceBatchNormFwd : public device::DeviceBatchNormFwd<XDataType,
                 };
             };
 
-            std::size_t num_thread = std::thread::hardware_concurrency();
-            std::size_t work_per_thread =
-                (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
-
-            std::vector<joinable_thread> threads(num_thread);
-
-            for(std::size_t it = 0; it < num_thread; ++it)
-            {
-                std::size_t i_begin = it * work_per_thread;
-                std::size_t i_end   = std::min(static_cast<size_t>((it + 1) * work_per_thread),
-                                             arg.invariant_index_set_.size());
-
-                auto f = [=] {
-                    for(std::size_t i = i_begin; i < i_end; ++i)
-                    {
-                        thread_reduce_func(arg.invariant_index_set_[i]);
-                    }
-                };
-
-                threads[it] = joinable_thread(f);
-            }
+            host_reduction_for_each(partition, normalize_split);
 
             return (0.0f);
         };
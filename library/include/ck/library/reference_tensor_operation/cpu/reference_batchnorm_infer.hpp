@@ -9,6 +9,7 @@
 #include <algorithm>
 
 #include "ck/library/utility/host_common_util.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_batchnorm.hpp"
 #include "ck/tensor_operation/gpu/device/device_batchnorm_infer.hpp"
 
 namespace ck {
@@ -152,10 +153,76 @@ struct ReferenceBatchNormInfer : public device::DeviceBatchNormInfer<XDataType,
 
     struct Invoker : public device::BaseInvoker
     {
+        // NHWC and alike: the channels of a reduce index are one contiguous row of x and of y,
+        // normalization processes them as vector lanes
+        static bool IsChannelLast(const Argument& arg)
+        {
+            if constexpr(NumInvariantDim == 1)
+                return arg.x_invariant_strides_[0] == 1 && arg.y_invariant_strides_[0] == 1;
+            else
+                return false;
+        };
+
+        static void RunChannelLast(const Argument& arg)
+        {
+            using ck::host_common::get_offset_from_index;
+
+            const std::size_t num_channel = arg.invariant_lengths_[0];
+
+            const HostReductionPartition partition(1, arg.reduce_index_set_.size(), num_channel);
+
+            std::vector<AccDataType> means(num_channel);
+            std::vector<AccDataType> invVariances(num_channel);
+            std::vector<AccDataType> scales(num_channel);
+            std::vector<AccDataType> biases(num_channel);
+
+            for(std::size_t c = 0; c < num_channel; ++c)
+            {
+                const std::size_t offset = c * arg.bnMeanVarStrides_[0];
+
+                AccDataType variance = arg.estimatedVariance_[offset];
+
+                means[c] = arg.estimatedMean_[offset];
+
+                // inv-variance defined as 1/sqrt(epsilon+variance)
+                invVariances[c] =
+                    type_convert<AccDataType>(1.0f) / std::sqrt(arg.epsilon_ + variance);
+
+                scales[c] = type_convert<AccDataType>(arg.bnScale_[c * arg.bnScaleStrides_[0]]);
+                biases[c] = type_convert<AccDataType>(arg.bnBias_[c * arg.bnBiasStrides_[0]]);
+            }
+
+            auto get_x_row = [&](std::size_t i) {
+                return arg.p_x_ + get_offset_from_index<NumBatchNormReduceDim>(
+                                      arg.x_reduce_strides_, arg.reduce_index_set_[i]);
+            };
+
+            auto get_y_row = [&](std::size_t i) {
+                return arg.p_y_ + get_offset_from_index<NumBatchNormReduceDim>(
+                                      arg.y_reduce_strides_, arg.reduce_index_set_[i]);
+            };
+
+            host_batchnorm_channel_last_normalize<AccDataType, YDataType>(partition,
+                                                                          means,
+                                                                          invVariances,
+                                                                          scales,
+                                                                          biases,
+                                                                          arg.y_elementwise_op_,
+                                                                          get_x_row,
+                                                                          get_y_row);
+        };
+
         float Run(const Argument& arg)
         {
             using ck::host_common::get_offset_from_index;
 
+            if(IsChannelLast(arg))
+            {
+                RunChannelLast(arg);
+
+                return (0.0f);
+            };
+
             auto thread_reduce_func = [&](auto invariant_index) {
                 size_t x_invariant_offset = get_offset_from_index<NumInvariantDim>(
                     arg.x_invariant_strides_, invariant_index);
@@ -204,26 +271,10 @@ struct ReferenceBatchNormInfer : public device::DeviceBatchNormInfer<XDataType,
             };
 
             std::size_t num_thread = std::thread::hardware_concurrency();
-            std::size_t work_per_thread =
-                (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
-
-            std::vector<joinable_thread> threads(num_thread);
 
-            for(std::size_t it = 0; it < num_thread; ++it)
-            {
-                std::size_t i_begin = it * work_per_thread;
-                std::size_t i_end   = std::min(static_cast<size_t>((it + 1) * work_per_thread),
-                                             arg.invariant_index_set_.size());
-
-                auto f = [=] {
-                    for(std::size_t i = i_begin; i < i_end; ++i)
-                    {
-                        thread_reduce_func(arg.invariant_index_set_[i]);
-                    }
-                };
-
-                threads[it] = joinable_thread(f);
-            }
+            make_ParallelTensorFunctor(
+                [&](std::size_t i) { thread_reduce_func(arg.invariant_index_set_[i]); },
+                arg.invariant_index_set_.size())(num_thread);
 
             return (0.0f);
         };
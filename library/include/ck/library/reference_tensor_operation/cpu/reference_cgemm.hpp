@@ -5,8 +5,12 @@
 
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 
@@ -14,6 +18,24 @@ namespace ck {
 namespace tensor_operation {
 namespace host {
 
+enum struct HostCGemmAlgorithm
+{
+    Gemm3M, // 3 real GEMMs: Ar * Br, Ai * Bi, (Ar + Ai) * (Br + Bi)
+    Gemm4M, // 4 real GEMMs, as DeviceCGemm_4Gemm_Xdl_CShuffle
+};
+
+//
+// @brief      Reference implementation for complex GEMM on split real / imaginary tensors.
+//
+// @paragraph
+//             Runs as real GEMMs on HostBlockedGemm, accumulated in float. The default, Gemm3M
+//             (Gauss), computes C_imag as (Ar + Ai) * (Br + Bi) - Ar * Br - Ai * Bi, saving a
+//             quarter of the multiplies; it can lose accuracy to cancellation when the real and
+//             imaginary parts differ widely in magnitude. Gemm4M is opt-in and computes every
+//             product separately, as the device decomposition does, which avoids that
+//             cancellation. Neither is bitwise equal to the device, whose kernels accumulate in a
+//             different order than HostBlockedGemm.
+//
 // FIXME: support arbitrary elementwise operation for A/B/C
 template <
     typename ADataType,
@@ -22,6 +44,7 @@ template <
     typename AElementwiseOperation,
     typename BElementwiseOperation,
     typename CElementwiseOperation,
+    HostCGemmAlgorithm Algorithm = HostCGemmAlgorithm::Gemm3M,
     enable_if_t<
         is_same_v<AElementwiseOperation, ck::tensor_operation::element_wise::PassThrough> &&
             is_same_v<BElementwiseOperation, ck::tensor_operation::element_wise::PassThrough> &&
@@ -72,53 +95,107 @@ struct ReferenceCGemm : public device::BaseOperator
 
         float Run(const Argument& arg)
         {
-            const std::size_t K = arg.a_m_k_real_.mDesc.GetLengths()[1];
+            const index_t M = arg.c_m_n_real_.mDesc.GetLengths()[0];
+            const index_t N = arg.c_m_n_real_.mDesc.GetLengths()[1];
+            const index_t K = arg.a_m_k_real_.mDesc.GetLengths()[1];
 
-            if(K != arg.a_m_k_imag_.mDesc.GetLengths()[1])
+            if(K != static_cast<index_t>(arg.a_m_k_imag_.mDesc.GetLengths()[1]))
             {
                 throw std::runtime_error("wrong! Incompatible real and imag sizes in CGEMM");
             }
 
-            auto f_mk_kn_mn_real = [&](auto m, auto n) {
-                float v_c_real = 0;
+            auto get_a = [&](const Tensor<ADataType>& a_m_k, index_t m, index_t k) {
+                const auto& strides = a_m_k.mDesc.GetStrides();
 
-                for(std::size_t k = 0; k < K; ++k)
-                {
-                    float v_a_real = ck::type_convert<float>(arg.a_m_k_real_(m, k));
-                    float v_a_imag = ck::type_convert<float>(arg.a_m_k_imag_(m, k));
-                    float v_b_real = ck::type_convert<float>(arg.b_k_n_real_(k, n));
-                    float v_b_imag = ck::type_convert<float>(arg.b_k_n_imag_(k, n));
+                return ck::type_convert<float>(a_m_k.mData[m * strides[0] + k * strides[1]]);
+            };
 
-                    v_c_real += v_a_real * v_b_real - v_a_imag * v_b_imag;
-                }
+            auto get_b = [&](const Tensor<BDataType>& b_k_n, index_t k, index_t n) {
+                const auto& strides = b_k_n.mDesc.GetStrides();
 
-                arg.c_m_n_real_(m, n) = ck::type_convert<CDataType>(v_c_real);
+                return ck::type_convert<float>(b_k_n.mData[k * strides[0] + n * strides[1]]);
             };
 
-            auto f_mk_kn_mn_imag = [&](auto m, auto n) {
-                float v_c_imag = 0;
+            auto set_c = [&](Tensor<CDataType>& c_m_n, index_t m, index_t n, float v_c) {
+                const auto& strides = c_m_n.mDesc.GetStrides();
+
+                c_m_n.mData[m * strides[0] + n * strides[1]] = ck::type_convert<CDataType>(v_c);
+            };
 
-                for(std::size_t k = 0; k < K; ++k)
-                {
-                    float v_a_real = ck::type_convert<float>(arg.a_m_k_real_(m, k));
-                    float v_a_imag = ck::type_convert<float>(arg.a_m_k_imag_(m, k));
-                    float v_b_real = ck::type_convert<float>(arg.b_k_n_real_(k, n));
-                    float v_b_imag = ck::type_convert<float>(arg.b_k_n_imag_(k, n));
+            const std::size_t num_thread = std::thread::hardware_concurrency();
 
-                    v_c_imag += v_a_real * v_b_imag + v_a_imag * v_b_real;
-                }
+            // a real GEMM on the blocked engine
+            auto run_gemm = [&](auto a_getter, auto b_getter, auto c_epilogue) {
+                HostBlockedGemm<float> gemm{M, N, K};
 
-                arg.c_m_n_imag_(m, n) = ck::type_convert<CDataType>(v_c_imag);
+                gemm.PackB(b_getter, num_thread);
+                gemm.Run(a_getter, c_epilogue, num_thread);
             };
 
-            make_ParallelTensorFunctor(f_mk_kn_mn_real,
-                                       arg.c_m_n_real_.mDesc.GetLengths()[0],
-                                       arg.c_m_n_real_.mDesc.GetLengths()[1])(
-                std::thread::hardware_concurrency());
-            make_ParallelTensorFunctor(f_mk_kn_mn_imag,
-                                       arg.c_m_n_imag_.mDesc.GetLengths()[0],
-                                       arg.c_m_n_imag_.mDesc.GetLengths()[1])(
-                std::thread::hardware_concurrency());
+            const auto& a_real = arg.a_m_k_real_;
+            const auto& a_imag = arg.a_m_k_imag_;
+            const auto& b_real = arg.b_k_n_real_;
+            const auto& b_imag = arg.b_k_n_imag_;
+
+            // one real M x N product, kept between the GEMMs
+            std::vector<float> aux(static_cast<std::size_t>(M) * N);
+
+            auto store_aux = [&](index_t m, index_t n, float v) { aux[m * N + n] = v; };
+
+            if constexpr(Algorithm == HostCGemmAlgorithm::Gemm3M)
+            {
+                // aux = Ar * Br
+                run_gemm([&](index_t m, index_t k) { return get_a(a_real, m, k); },
+                         [&](index_t k, index_t n) { return get_b(b_real, k, n); },
+                         store_aux);
+
+                // C_real = Ar * Br - Ai * Bi, aux = Ar * Br + Ai * Bi
+                run_gemm([&](index_t m, index_t k) { return get_a(a_imag, m, k); },
+                         [&](index_t k, index_t n) { return get_b(b_imag, k, n); },
+                         [&](index_t m, index_t n, float v) {
+                             float& v_aux = aux[m * N + n];
+
+                             set_c(arg.c_m_n_real_, m, n, v_aux - v);
+
+                             v_aux += v;
+                         });
+
+                // C_imag = (Ar + Ai) * (Br + Bi) - aux
+                run_gemm(
+                    [&](index_t m, index_t k) {
+                        return get_a(a_real, m, k) + get_a(a_imag, m, k);
+                    },
+                    [&](index_t k, index_t n) {
+                        return get_b(b_real, k, n) + get_b(b_imag, k, n);
+                    },
+                    [&](index_t m, index_t n, float v) {
+                        set_c(arg.c_m_n_imag_, m, n, v - aux[m * N + n]);
+                    });
+            }
+            else
+            {
+                // C_real = Ar * Br - Ai * Bi
+                run_gemm([&](index_t m, index_t k) { return get_a(a_real, m, k); },
+                         [&](index_t k, index_t n) { return get_b(b_real, k, n); },
+                         store_aux);
+
+                run_gemm([&](index_t m, index_t k) { return get_a(a_imag, m, k); },
+                         [&](index_t k, index_t n) { return get_b(b_imag, k, n); },
+                         [&](index_t m, index_t n, float v) {
+                             set_c(arg.c_m_n_real_, m, n, aux[m * N + n] - v);
+                         });
+
+                // C_imag = Ar * Bi + Ai * Br
+                run_gemm([&](index_t m, index_t k) { return get_a(a_real, m, k); },
+                         [&](index_t k, index_t n) { return get_b(b_imag, k, n); },
+                         store_aux);
+
+                run_gemm([&](index_t m, index_t k) { return get_a(a_imag, m, k); },
+                         [&](index_t k, index_t n) { return get_b(b_real, k, n); },
+                         [&](index_t m, index_t n, float v) {
+                             set_c(arg.c_m_n_imag_, m, n, aux[m * N + n] + v);
+                         });
+            }
 
             return 0;
         }
@@ -172,6 +249,9 @@ struct ReferenceCGemm : public device::BaseOperator
 
         // clang-format off
         str << "ReferenceCGemm"
+            << "<"
+            << (Algorithm == HostCGemmAlgorithm::Gemm3M ? "3M" : "4M")
+            << ">"
             << std::endl;
         // clang-format on
 
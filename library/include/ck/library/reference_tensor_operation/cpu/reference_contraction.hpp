@@ -0,0 +1,299 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_contraction.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Reference implementation for tensor contraction.
+//
+// @paragraph
+//             E[m0, ..., n0, ...] = cde_op(sum over k0, ... of A[m0, ..., k0, ...] *
+//             B[n0, ..., k0, ...]), with any number of M, N and K dimensions and any strides.
+//             A CDE operation taking (e, c) is a plain epilogue such as Scale; one taking
+//             (e, c, d) such as Bilinear also reads D[m0, ..., n0, ...], which must be given.
+//
+// @paragraph
+//             Each mode is flattened by HostContractionMode and the contraction runs as a single
+//             HostBlockedGemm whose getters address the tensors through per-mode offset tables.
+//             When E is contiguous along M rather than N, the GEMM is run transposed so the
+//             epilogue still writes along the contiguous dimension.
+//
+template <ck::index_t NumDimM,
+          ck::index_t NumDimN,
+          ck::index_t NumDimK,
+          typename ADataType,
+          typename BDataType,
+          typename EDataType,
+          typename AccDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CDEElementwiseOperation,
+          typename DDataType = EDataType,
+          typename std::enable_if<NumDimM >= 1 && NumDimN >= 1 && NumDimK >= 1, bool>::type =
+              false>
+struct ReferenceContraction : public device::BaseOperator
+{
+    static constexpr bool HasD = std::is_invocable_v<const CDEElementwiseOperation&,
+                                                     EDataType&,
+                                                     const AccDataType&,
+                                                     const DDataType&>;
+
+    // Argument
+    struct Argument : public device::BaseArgument
+    {
+        Argument(const Tensor<ADataType>& a_ms_ks,
+                 const Tensor<BDataType>& b_ns_ks,
+                 const Tensor<DDataType>* p_d_ms_ns,
+                 Tensor<EDataType>& e_ms_ns,
+                 AElementwiseOperation a_element_op,
+                 BElementwiseOperation b_element_op,
+                 CDEElementwiseOperation cde_element_op)
+            : a_ms_ks_{a_ms_ks},
+              b_ns_ks_{b_ns_ks},
+              p_d_ms_ns_{p_d_ms_ns},
+              e_ms_ns_{e_ms_ns},
+              a_element_op_{a_element_op},
+              b_element_op_{b_element_op},
+              cde_element_op_{cde_element_op}
+        {
+        }
+
+        const Tensor<ADataType>& a_ms_ks_;
+        const Tensor<BDataType>& b_ns_ks_;
+        const Tensor<DDataType>* p_d_ms_ns_;
+        Tensor<EDataType>& e_ms_ns_;
+
+        AElementwiseOperation a_element_op_;
+        BElementwiseOperation b_element_op_;
+        CDEElementwiseOperation cde_element_op_;
+    };
+
+    static bool IsValidArgument(const Argument& arg)
+    {
+        const auto& a_lengths = arg.a_ms_ks_.mDesc.GetLengths();
+        const auto& b_lengths = arg.b_ns_ks_.mDesc.GetLengths();
+        const auto& e_lengths = arg.e_ms_ns_.mDesc.GetLengths();
+
+        if(a_lengths.size() != NumDimM + NumDimK || b_lengths.size() != NumDimN + NumDimK ||
+           e_lengths.size() != NumDimM + NumDimN)
+            return false;
+
+        if(!std::equal(e_lengths.begin(), e_lengths.begin() + NumDimM, a_lengths.begin()) ||
+           !std::equal(e_lengths.begin() + NumDimM, e_lengths.end(), b_lengths.begin()) ||
+           !std::equal(a_lengths.begin() + NumDimM, a_lengths.end(), b_lengths.begin() + NumDimN))
+            return false;
+
+        if(HasD != (arg.p_d_ms_ns_ != nullptr))
+            return false;
+
+        return arg.p_d_ms_ns_ == nullptr || arg.p_d_ms_ns_->mDesc.GetLengths() == e_lengths;
+    }
+
+    // Invoker
+    struct Invoker : public device::BaseInvoker
+    {
+        using Argument = ReferenceContraction::Argument;
+
+        float Run(const Argument& arg)
+        {
+            if(!IsValidArgument(arg))
+            {
+                throw std::runtime_error("wrong! inconsistent dimension");
+            }
+
+            const auto& e_lengths = arg.e_ms_ns_.mDesc.GetLengths();
+            const auto& a_lengths = arg.a_ms_ks_.mDesc.GetLengths();
+
+            const auto& a_strides = arg.a_ms_ks_.mDesc.GetStrides();
+            const auto& b_strides = arg.b_ns_ks_.mDesc.GetStrides();
+            const auto& e_strides = arg.e_ms_ns_.mDesc.GetStrides();
+
+            auto get_range = [](const auto& v, std::size_t begin, std::size_t num) {
+                return std::vector<std::size_t>(v.begin() + begin, v.begin() + begin + num);
+            };
+
+            // tensors carrying each mode: M in A, E (and D), N in B, E (and D), K in A, B
+            std::vector<std::vector<std::size_t>> m_strides{get_range(a_strides, 0, NumDimM),
+                                                            get_range(e_strides, 0, NumDimM)};
+            std::vector<std::vector<std::size_t>> n_strides{get_range(b_strides, 0, NumDimN),
+                                                            get_range(e_strides, NumDimM, NumDimN)};
+            std::vector<std::vector<std::size_t>> k_strides{get_range(a_strides, NumDimM, NumDimK),
+                                                            get_range(b_strides, NumDimN, NumDimK)};
+
+            if constexpr(HasD)
+            {
+                const auto& d_strides = arg.p_d_ms_ns_->mDesc.GetStrides();
+
+                m_strides.push_back(get_range(d_strides, 0, NumDimM));
+                n_strides.push_back(get_range(d_strides, NumDimM, NumDimN));
+            }
+
+            const HostContractionMode m_mode{
+                std::vector<index_t>(e_lengths.begin(), e_lengths.begin() + NumDimM), m_strides};
+            const HostContractionMode n_mode{
+                std::vector<index_t>(e_lengths.begin() + NumDimM, e_lengths.end()), n_strides};
+            const HostContractionMode k_mode{
+                std::vector<index_t>(a_lengths.begin() + NumDimM, a_lengths.end()), k_strides};
+
+            const index_t M = m_mode.GetLength();
+            const index_t N = n_mode.GetLength();
+            const index_t K = k_mode.GetLength();
+
+            if(M == 0 || N == 0)
+                return 0;
+
+            const auto& a_m_offsets = m_mode.GetOffsets(0);
+            const auto& e_m_offsets = m_mode.GetOffsets(1);
+            const auto& b_n_offsets = n_mode.GetOffsets(0);
+            const auto& e_n_offsets = n_mode.GetOffsets(1);
+            const auto& a_k_offsets = k_mode.GetOffsets(0);
+            const auto& b_k_offsets = k_mode.GetOffsets(1);
+
+            // element ops and conversion to AccDataType are applied once per element, at pack time
+            auto a_getter = [&](index_t m, index_t k) {
+                ADataType v_a;
+
+                arg.a_element_op_(v_a, arg.a_ms_ks_.mData[a_m_offsets[m] + a_k_offsets[k]]);
+
+                return ck::type_convert<AccDataType>(v_a);
+            };
+
+            auto b_getter = [&](index_t n, index_t k) {
+                BDataType v_b;
+
+                arg.b_element_op_(v_b, arg.b_ns_ks_.mData[b_n_offsets[n] + b_k_offsets[k]]);
+
+                return ck::type_convert<AccDataType>(v_b);
+            };
+
+            auto e_epilogue = [&](index_t m, index_t n, AccDataType v_acc) {
+                EDataType& v_e = arg.e_ms_ns_.mData[e_m_offsets[m] + e_n_offsets[n]];
+
+                if constexpr(HasD)
+                {
+                    const auto& d_m_offsets = m_mode.GetOffsets(2);
+                    const auto& d_n_offsets = n_mode.GetOffsets(2);
+
+                    arg.cde_element_op_(
+                        v_e, v_acc, arg.p_d_ms_ns_->mData[d_m_offsets[m] + d_n_offsets[n]]);
+                }
+                else
+                {
+                    AccDataType v_c;
+
+                    arg.cde_element_op_(v_c, v_acc);
+
+                    v_e = ck::type_convert<EDataType>(v_c);
+                }
+            };
+
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+
+            // the epilogue writes along the GEMM N dimension
+            if(m_mode.GetInnerStride(1) < n_mode.GetInnerStride(1))
+            {
+                HostBlockedGemm<AccDataType> gemm{N, M, K};
+
+                gemm.PackB([&](index_t k, index_t m) { return a_getter(m, k); }, num_thread);
+                gemm.Run(b_getter,
+                         [&](index_t n, index_t m, AccDataType v_acc) { e_epilogue(m, n, v_acc); },
+                         num_thread);
+            }
+            else
+            {
+                HostBlockedGemm<AccDataType> gemm{M, N, K};
+
+                gemm.PackB([&](index_t k, index_t n) { return b_getter(n, k); }, num_thread);
+                gemm.Run(a_getter, e_epilogue, num_thread);
+            }
+
+            return 0;
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter()
+    {
+        // TODO: properly implement this check
+        return true;
+    }
+
+    bool IsSupportedArgument(const device::BaseArgument* p_arg) override
+    {
+        return IsValidArgument(*dynamic_cast<const Argument*>(p_arg));
+    }
+
+    static auto MakeArgument(const Tensor<ADataType>& a_ms_ks,
+                             const Tensor<BDataType>& b_ns_ks,
+                             Tensor<EDataType>& e_ms_ns,
+                             AElementwiseOperation a_element_op,
+                             BElementwiseOperation b_element_op,
+                             CDEElementwiseOperation cde_element_op)
+    {
+        return Argument{
+            a_ms_ks, b_ns_ks, nullptr, e_ms_ns, a_element_op, b_element_op, cde_element_op};
+    }
+
+    static auto MakeArgument(const Tensor<ADataType>& a_ms_ks,
+                             const Tensor<BDataType>& b_ns_ks,
+                             const Tensor<DDataType>& d_ms_ns,
+                             Tensor<EDataType>& e_ms_ns,
+                             AElementwiseOperation a_element_op,
+                             BElementwiseOperation b_element_op,
+                             CDEElementwiseOperation cde_element_op)
+    {
+        return Argument{
+            a_ms_ks, b_ns_ks, &d_ms_ns, e_ms_ns, a_element_op, b_element_op, cde_element_op};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferenceContraction"
+            << "<"
+            << NumDimM << ", "
+            << NumDimN << ", "
+            << NumDimK
+            << ">"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
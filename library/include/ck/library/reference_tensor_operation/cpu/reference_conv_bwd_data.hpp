@@ -3,12 +3,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <vector>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -18,6 +23,10 @@ namespace host {
 // weight descriptor in [G, K, C, Z, Y, X] order
 // output descriptor in [G, N, K, Di, Hi, Wi] order
 // phyiscal layout is irrelavent
+//
+// By default the problem is split into stride_d x stride_h x stride_w dense sub-convolutions
+// (see RunStrideDecomposed), so no work is spent on filter taps that do not contribute to an
+// input pixel. RunDirect is the plain per-pixel loop.
 template <ck::index_t NDimSpatial,
           typename InDataType,
           typename WeiDataType,
@@ -82,6 +91,334 @@ struct ReferenceConvBwdData : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
+            if(IsStrideDecomposedApplicable(arg))
+            {
+                return RunStrideDecomposed(arg);
+            }
+
+            return RunDirect(arg);
+        }
+
+        static bool IsStrideDecomposedApplicable(const Argument& arg)
+        {
+            if(arg.conv_strides_.size() != NDimSpatial ||
+               arg.conv_dilations_.size() != NDimSpatial ||
+               arg.in_left_pads_.size() != NDimSpatial)
+            {
+                return false;
+            }
+
+            long_index_t gemm_m = arg.input_.GetLengths()[1];
+            long_index_t gemm_n = arg.input_.GetLengths()[2];
+            long_index_t gemm_k = arg.weight_.GetLengths()[1];
+
+            for(index_t i = 0; i < NDimSpatial; ++i)
+            {
+                if(arg.conv_strides_[i] <= 0 || arg.conv_dilations_[i] <= 0 ||
+                   arg.in_left_pads_[i] < 0)
+                {
+                    return false;
+                }
+
+                gemm_m *= arg.input_.GetLengths()[i + 3];
+                gemm_k *= arg.weight_.GetLengths()[i + 3];
+            }
+
+            constexpr long_index_t max_index = std::numeric_limits<index_t>::max();
+
+            return gemm_m <= max_index && gemm_n <= max_index && gemm_k <= max_index;
+        }
+
+        // Sub-pixel decomposition: input pixels are split by their phase p = (wi + pad) % stride
+        // in every spatial dimension. Within one phase, only the filter taps with
+        // (x * dilation) % stride == p contribute, and they do so at dense output offsets, so
+        // each of the stride_d x stride_h x stride_w phases is a dense convolution executed as
+        //   GemmM = N * <phase input pixels>, GemmN = C, GemmK = <phase taps> * K
+        // on the blocked host GEMM engine. Only the pixels whose taps all fall inside the output
+        // are GEMM rows; the border pixels skip their out-of-bounds taps in a per-pixel loop,
+        // so an Inf or NaN never meets a padding zero. Both keep the (z, y, x, k) order of the
+        // direct loop, hence the accumulation order of every input pixel is unchanged.
+        float RunStrideDecomposed(const Argument& arg)
+        {
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& wei_lengths = arg.weight_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
+
+            const auto& in_strides  = arg.input_.GetStrides();
+            const auto& wei_strides = arg.weight_.GetStrides();
+            const auto& out_strides = arg.output_.GetStrides();
+
+            const index_t G = in_lengths[0];
+            const index_t N = in_lengths[1];
+            const index_t C = in_lengths[2];
+            const index_t K = wei_lengths[1];
+
+            index_t num_phase = 1;
+
+            for(index_t i = 0; i < NDimSpatial; ++i)
+            {
+                num_phase *= arg.conv_strides_[i];
+            }
+
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+
+            for(index_t phase = 0; phase < num_phase; ++phase)
+            {
+                // per dimension: contributing taps, their output offsets, and the range of
+                // input pixels q (wi = q * stride + p - pad) that belong to this phase
+                std::array<std::vector<index_t>, NDimSpatial> taps;
+                std::array<std::vector<index_t>, NDimSpatial> tap_offsets;
+                std::array<index_t, NDimSpatial> p;
+                std::array<index_t, NDimSpatial> q_begin;
+                std::array<index_t, NDimSpatial> q_lengths;
+
+                index_t num_q   = 1;
+                index_t num_tap = 1;
+
+                for(index_t i = NDimSpatial - 1, tmp = phase; i >= 0; --i)
+                {
+                    const index_t stride = arg.conv_strides_[i];
+                    const index_t pad    = arg.in_left_pads_[i];
+                    const index_t Wi     = in_lengths[i + 3];
+
+                    p[i] = tmp % stride;
+                    tmp /= stride;
+
+                    for(index_t x = 0; x < static_cast<index_t>(wei_lengths[i + 3]); ++x)
+                    {
+                        const index_t x_dilated = x * arg.conv_dilations_[i];
+
+                        if(x_dilated % stride == p[i])
+                        {
+                            taps[i].push_back(x);
+                            tap_offsets[i].push_back((x_dilated - p[i]) / stride);
+                        }
+                    }
+
+                    q_begin[i] = pad > p[i] ? math::integer_divide_ceil(pad - p[i], stride) : 0;
+
+                    const index_t q_end = math::integer_divide_ceil(Wi + pad - p[i], stride);
+
+                    q_lengths[i] = std::max(q_end - q_begin[i], 0);
+
+                    num_q *= q_lengths[i];
+                    num_tap *= taps[i].size();
+                }
+
+                if(num_q == 0)
+                {
+                    continue;
+                }
+
+                // the inner pixels q read every tap of the phase inside the output; the border
+                // pixels around them are reduced over their in-bounds taps only, as the direct
+                // loop does, since a GEMM would multiply the weights of the other taps by zero
+                std::array<index_t, NDimSpatial> q_inner_begin;
+                std::array<index_t, NDimSpatial> q_inner_lengths;
+
+                index_t num_inner_q = 1;
+
+                for(index_t i = 0; i < NDimSpatial; ++i)
+                {
+                    index_t q_inner_end = q_begin[i] + q_lengths[i];
+
+                    q_inner_begin[i] = q_begin[i];
+
+                    // the tap offsets are increasing
+                    if(!taps[i].empty())
+                    {
+                        q_inner_begin[i] = std::max(q_inner_begin[i], tap_offsets[i].back());
+                        q_inner_end      = std::min(
+                            q_inner_end,
+                            static_cast<index_t>(out_lengths[i + 3]) + tap_offsets[i].front());
+                    }
+
+                    q_inner_lengths[i] = std::max(q_inner_end - q_inner_begin[i], 0);
+
+                    num_inner_q *= q_inner_lengths[i];
+                }
+
+                const index_t gemm_m = N * num_inner_q;
+                const index_t gemm_n = C;
+                const index_t gemm_k = num_tap * K;
+
+                for(index_t g = 0; g < G; ++g)
+                {
+                    // B[(taps, k), c] = weight(g, k, c, z, y, x)
+                    auto b_getter = [&](index_t igemm_k, index_t c) {
+                        std::size_t offset = g * wei_strides[0] + (igemm_k % K) * wei_strides[1] +
+                                             c * wei_strides[2];
+
+                        igemm_k /= K;
+
+                        for(index_t i = NDimSpatial - 1; i >= 0; --i)
+                        {
+                            offset += taps[i][igemm_k % taps[i].size()] * wei_strides[i + 3];
+                            igemm_k /= taps[i].size();
+                        }
+
+                        float v_wei;
+
+                        arg.wei_element_op_(v_wei,
+                                            ck::type_convert<float>(arg.weight_.mData[offset]));
+
+                        return v_wei;
+                    };
+
+                    // A[(n, q), (taps, k)] = output(g, n, k, do, ho, wo), inner pixels only
+                    auto a_getter = [&](index_t igemm_m, index_t igemm_k) {
+                        std::size_t offset = g * out_strides[0] + (igemm_k % K) * out_strides[2];
+
+                        igemm_k /= K;
+
+                        for(index_t i = NDimSpatial - 1; i >= 0; --i)
+                        {
+                            const index_t q  = q_inner_begin[i] + igemm_m % q_inner_lengths[i];
+                            const index_t wo = q - tap_offsets[i][igemm_k % taps[i].size()];
+
+                            igemm_m /= q_inner_lengths[i];
+                            igemm_k /= taps[i].size();
+
+                            offset += wo * out_strides[i + 3];
+                        }
+
+                        offset += igemm_m * out_strides[1];
+
+                        float v_out;
+
+                        arg.out_element_op_(v_out,
+                                            ck::type_convert<float>(arg.output_.mData[offset]));
+
+                        return v_out;
+                    };
+
+                    auto store_input = [&](index_t n,
+                                           const std::array<index_t, NDimSpatial>& q,
+                                           index_t c,
+                                           float v_acc) {
+                        std::size_t offset =
+                            g * in_strides[0] + n * in_strides[1] + c * in_strides[2];
+
+                        for(index_t i = 0; i < NDimSpatial; ++i)
+                        {
+                            const index_t wi =
+                                q[i] * arg.conv_strides_[i] + p[i] - arg.in_left_pads_[i];
+
+                            offset += wi * in_strides[i + 3];
+                        }
+
+                        float v_in;
+
+                        arg.in_element_op_(v_in, v_acc);
+
+                        arg.input_.mData[offset] = ck::type_convert<InDataType>(v_acc);
+                    };
+
+                    auto c_epilogue = [&](index_t igemm_m, index_t c, float v_acc) {
+                        std::array<index_t, NDimSpatial> q;
+
+                        for(index_t i = NDimSpatial - 1; i >= 0; --i)
+                        {
+                            q[i] = q_inner_begin[i] + igemm_m % q_inner_lengths[i];
+                            igemm_m /= q_inner_lengths[i];
+                        }
+
+                        store_input(igemm_m, q, c, v_acc);
+                    };
+
+                    if(gemm_m > 0)
+                    {
+                        HostBlockedGemm<float> gemm{gemm_m, gemm_n, gemm_k};
+
+                        gemm.PackB(b_getter, num_thread);
+                        gemm.Run(a_getter, c_epilogue, num_thread);
+                    }
+
+                    // border pixels, in the (taps, k) order of the GEMM
+                    auto f_border = [&](index_t n, index_t iq) {
+                        std::array<index_t, NDimSpatial> q;
+
+                        bool is_inner = true;
+
+                        for(index_t i = NDimSpatial - 1; i >= 0; --i)
+                        {
+                            q[i] = q_begin[i] + iq % q_lengths[i];
+                            iq /= q_lengths[i];
+
+                            is_inner = is_inner && q[i] >= q_inner_begin[i] &&
+                                       q[i] < q_inner_begin[i] + q_inner_lengths[i];
+                        }
+
+                        if(is_inner)
+                        {
+                            return;
+                        }
+
+                        for(index_t c = 0; c < C; ++c)
+                        {
+                            float v_acc = 0;
+
+                            for(index_t itap = 0; itap < num_tap; ++itap)
+                            {
+                                std::size_t out_offset = g * out_strides[0] + n * out_strides[1];
+                                std::size_t wei_offset = g * wei_strides[0] + c * wei_strides[2];
+
+                                bool is_in_bounds = true;
+
+                                for(index_t i = NDimSpatial - 1, tmp = itap; i >= 0; --i)
+                                {
+                                    const index_t t  = tmp % taps[i].size();
+                                    const index_t wo = q[i] - tap_offsets[i][t];
+
+                                    tmp /= taps[i].size();
+
+                                    is_in_bounds = is_in_bounds && wo >= 0 &&
+                                                   wo < static_cast<index_t>(out_lengths[i + 3]);
+
+                                    out_offset += wo * out_strides[i + 3];
+                                    wei_offset += taps[i][t] * wei_strides[i + 3];
+                                }
+
+                                if(!is_in_bounds)
+                                {
+                                    continue;
+                                }
+
+                                for(index_t k = 0; k < K; ++k)
+                                {
+                                    float v_out;
+                                    float v_wei;
+
+                                    arg.out_element_op_(
+                                        v_out,
+                                        ck::type_convert<float>(
+                                            arg.output_.mData[out_offset + k * out_strides[2]]));
+
+                                    arg.wei_element_op_(
+                                        v_wei,
+                                        ck::type_convert<float>(
+                                            arg.weight_.mData[wei_offset + k * wei_strides[1]]));
+
+                                    v_acc += v_out * v_wei;
+                                }
+                            }
+
+                            store_input(n, q, c, v_acc);
+                        }
+                    };
+
+                    if(num_inner_q < num_q)
+                    {
+                        make_ParallelTensorFunctor(f_border, N, num_q)(num_thread);
+                    }
+                }
+            }
+
+            return 0;
+        }
+
+        float RunDirect(const Argument& arg)
+        {
             if constexpr(NDimSpatial == 1)
             {
                 auto f_ncw = [&](auto g, auto n, auto c, auto wi) {
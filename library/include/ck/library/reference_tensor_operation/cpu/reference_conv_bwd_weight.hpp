@@ -3,12 +3,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -18,6 +24,10 @@ namespace host {
 // weight descriptor in [G, K, C, Z, Y, X] order
 // output descriptor in [G, N, K, Di, Hi, Wi] order
 // phyiscal layout is irrelavent
+//
+// By default the N x spatial reduction is split into slices that are reduced concurrently as
+// GEMMs and combined in a fixed order (see RunSplitReduce). RunDirect is the plain loop that
+// reduces every weight element serially.
 template <ck::index_t NDimSpatial,
           typename InDataType,
           typename WeiDataType,
@@ -82,6 +92,281 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
+            if(IsSplitReduceApplicable(arg))
+            {
+                return RunSplitReduce(arg, GetNumSplit(arg));
+            }
+
+            return RunDirect(arg);
+        }
+
+        static bool IsSplitReduceApplicable(const Argument& arg)
+        {
+            if(arg.conv_strides_.size() != NDimSpatial ||
+               arg.conv_dilations_.size() != NDimSpatial ||
+               arg.in_left_pads_.size() != NDimSpatial)
+            {
+                return false;
+            }
+
+            long_index_t gemm_m = arg.weight_.GetLengths()[1];
+            long_index_t gemm_n = arg.weight_.GetLengths()[2];
+            long_index_t gemm_k = arg.output_.GetLengths()[1];
+
+            for(index_t i = 0; i < NDimSpatial; ++i)
+            {
+                if(arg.conv_strides_[i] <= 0 || arg.conv_dilations_[i] <= 0)
+                {
+                    return false;
+                }
+
+                gemm_n *= arg.weight_.GetLengths()[i + 3];
+                gemm_k *= arg.output_.GetLengths()[i + 3];
+            }
+
+            constexpr long_index_t max_index = std::numeric_limits<index_t>::max();
+
+            return gemm_m <= max_index && gemm_n <= max_index && gemm_k <= max_index;
+        }
+
+        // Number of slices the N x spatial reduction is cut into. It depends on the problem
+        // shape only (never on the thread count), so results are reproducible across machines.
+        static index_t GetNumSplit(const Argument& arg)
+        {
+            // shortest reduction slice worth a GEMM of its own
+            constexpr long_index_t min_split_length = 1024;
+            constexpr long_index_t max_num_split    = 64;
+            // number of float partial accumulators allowed over all slices
+            constexpr long_index_t max_workspace = long_index_t{1} << 24;
+
+            long_index_t weight_size = 1;
+            long_index_t reduce_size = arg.output_.GetLengths()[1];
+
+            for(std::size_t i = 0; i < arg.weight_.GetNumOfDimension(); ++i)
+            {
+                weight_size *= arg.weight_.GetLengths()[i];
+            }
+
+            for(index_t i = 0; i < NDimSpatial; ++i)
+            {
+                reduce_size *= arg.output_.GetLengths()[i + 3];
+            }
+
+            long_index_t num_split = std::min(reduce_size / min_split_length, max_num_split);
+
+            num_split = std::min(num_split, max_workspace / std::max<long_index_t>(weight_size, 1));
+
+            return static_cast<index_t>(std::max<long_index_t>(num_split, 1));
+        }
+
+        // Split reduction: the weight gradient of group g and filter tap t is the GEMM
+        //   GemmM = K, GemmN = C, GemmK = N * <outputs whose input pixel of tap t is in bounds>
+        // so that a padding tap never takes part, as in the direct loop. The reduction of every
+        // tap is cut into num_split contiguous slices. Every slice is run on the blocked host
+        // GEMM engine into its own partial weight accumulator, then the partials are combined by
+        // a fixed pairwise tree, so the summation order only depends on num_split. With
+        // num_split == 1 the accumulation order is the one of RunDirect.
+        float RunSplitReduce(const Argument& arg, index_t num_split)
+        {
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& wei_lengths = arg.weight_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
+
+            const auto& in_strides  = arg.input_.GetStrides();
+            const auto& wei_strides = arg.weight_.GetStrides();
+            const auto& out_strides = arg.output_.GetStrides();
+
+            const index_t G = wei_lengths[0];
+            const index_t K = wei_lengths[1];
+            const index_t C = wei_lengths[2];
+            const index_t N = out_lengths[1];
+
+            index_t num_tap = 1;
+            index_t gemm_k  = N;
+
+            for(index_t i = 0; i < NDimSpatial; ++i)
+            {
+                num_tap *= wei_lengths[i + 3];
+                gemm_k *= out_lengths[i + 3];
+            }
+
+            const index_t gemm_n = C * num_tap;
+
+            num_split = std::max(std::min(num_split, gemm_k), 1);
+
+            // per tap, the range [o_begin, o_begin + o_length) of every output dimension whose
+            // input pixel is in bounds
+            std::vector<std::array<index_t, NDimSpatial>> o_begins(num_tap);
+            std::vector<std::array<index_t, NDimSpatial>> o_lengths(num_tap);
+            std::vector<index_t> tap_gemm_ks(num_tap);
+
+            for(index_t t = 0; t < num_tap; ++t)
+            {
+                tap_gemm_ks[t] = N;
+
+                for(index_t i = NDimSpatial - 1, tmp = t; i >= 0; --i)
+                {
+                    const index_t x = tmp % wei_lengths[i + 3];
+
+                    tmp /= wei_lengths[i + 3];
+
+                    // wi = o * stride + x * dilation - pad in [0, Wi)
+                    const index_t begin = arg.in_left_pads_[i] - x * arg.conv_dilations_[i];
+                    const index_t end   = begin + static_cast<index_t>(in_lengths[i + 3]);
+
+                    const index_t o_begin =
+                        begin > 0 ? math::integer_divide_ceil(begin, arg.conv_strides_[i]) : 0;
+                    const index_t o_end =
+                        end > 0 ? std::min(math::integer_divide_ceil(end, arg.conv_strides_[i]),
+                                           static_cast<index_t>(out_lengths[i + 3]))
+                                : 0;
+
+                    o_begins[t][i]  = o_begin;
+                    o_lengths[t][i] = std::max(o_end - o_begin, 0);
+
+                    tap_gemm_ks[t] *= o_lengths[t][i];
+                }
+            }
+
+            const std::size_t partial_size = static_cast<std::size_t>(K) * gemm_n;
+
+            std::vector<float> partials(static_cast<std::size_t>(G) * num_split * partial_size);
+
+            auto get_partial = [&](index_t g, index_t isplit) {
+                return &partials[(static_cast<std::size_t>(g) * num_split + isplit) * partial_size];
+            };
+
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+            const std::size_t num_task   = static_cast<std::size_t>(G) * num_split;
+
+            // leftover threads go to the GEMM of each slice
+            const std::size_t num_gemm_thread = std::max<std::size_t>(num_thread / num_task, 1);
+
+            auto f_split = [&](index_t g, index_t isplit) {
+                float* p_partial = get_partial(g, isplit);
+
+                for(index_t t = 0; t < num_tap; ++t)
+                {
+                    const index_t split_length =
+                        math::integer_divide_ceil(tap_gemm_ks[t], num_split);
+
+                    const index_t k_begin = std::min(isplit * split_length, tap_gemm_ks[t]);
+                    const index_t k_end   = std::min(k_begin + split_length, tap_gemm_ks[t]);
+
+                    // the partials start at zero
+                    if(k_begin == k_end)
+                    {
+                        continue;
+                    }
+
+                    // offsets of input(g, n, 0, di, hi, wi) and output(g, n, 0, do, ho, wo) of
+                    // the reduction index igemm_k of tap t
+                    auto get_offsets = [&](index_t igemm_k) {
+                        igemm_k += k_begin;
+
+                        std::size_t in_offset  = g * in_strides[0];
+                        std::size_t out_offset = g * out_strides[0];
+
+                        for(index_t i = NDimSpatial - 1, tmp = t; i >= 0; --i)
+                        {
+                            const index_t x  = tmp % wei_lengths[i + 3];
+                            const index_t wo = o_begins[t][i] + igemm_k % o_lengths[t][i];
+                            const index_t wi = wo * arg.conv_strides_[i] +
+                                               x * arg.conv_dilations_[i] - arg.in_left_pads_[i];
+
+                            tmp /= wei_lengths[i + 3];
+                            igemm_k /= o_lengths[t][i];
+
+                            in_offset += wi * in_strides[i + 3];
+                            out_offset += wo * out_strides[i + 3];
+                        }
+
+                        in_offset += igemm_k * in_strides[1];
+                        out_offset += igemm_k * out_strides[1];
+
+                        return std::make_pair(in_offset, out_offset);
+                    };
+
+                    // B[(n, do, ho, wo), c] = input(g, n, c, di, hi, wi)
+                    auto b_getter = [&](index_t igemm_k, index_t c) {
+                        const std::size_t offset = get_offsets(igemm_k).first + c * in_strides[2];
+
+                        float v_in;
+
+                        arg.in_element_op_(v_in,
+                                           ck::type_convert<float>(arg.input_.mData[offset]));
+
+                        return v_in;
+                    };
+
+                    // A[k, (n, do, ho, wo)] = output(g, n, k, do, ho, wo)
+                    auto a_getter = [&](index_t k, index_t igemm_k) {
+                        const std::size_t offset =
+                            get_offsets(igemm_k).second + k * out_strides[2];
+
+                        float v_out;
+
+                        arg.out_element_op_(v_out,
+                                            ck::type_convert<float>(arg.output_.mData[offset]));
+
+                        return v_out;
+                    };
+
+                    auto c_epilogue = [&](index_t k, index_t c, float v_acc) {
+                        p_partial[static_cast<std::size_t>(k) * gemm_n + c * num_tap + t] = v_acc;
+                    };
+
+                    HostBlockedGemm<float> gemm{K, C, k_end - k_begin};
+
+                    gemm.PackB(b_getter, num_gemm_thread);
+                    gemm.Run(a_getter, c_epilogue, num_gemm_thread);
+                }
+            };
+
+            make_ParallelTensorFunctor(f_split, G, num_split)(num_thread);
+
+            // deterministic pairwise tree over the slices: partial[i] += partial[i + step]
+            for(index_t step = 1; step < num_split; step *= 2)
+            {
+                const index_t num_pair = math::integer_divide_ceil(num_split - step, 2 * step);
+
+                auto f_add = [&](index_t g, index_t ipair, std::size_t i) {
+                    float* p_partial = get_partial(g, ipair * 2 * step) + i;
+
+                    p_partial[0] += p_partial[step * partial_size];
+                };
+
+                make_ParallelTensorFunctor(f_add, G, num_pair, partial_size)(num_thread);
+            }
+
+            auto f_wei = [&](index_t g, index_t k, index_t igemm_n) {
+                const float v_acc = get_partial(g, 0)[static_cast<std::size_t>(k) * gemm_n +
+                                                      igemm_n];
+
+                std::size_t offset = g * wei_strides[0] + k * wei_strides[1];
+
+                for(index_t i = NDimSpatial - 1; i >= 0; --i)
+                {
+                    offset += (igemm_n % wei_lengths[i + 3]) * wei_strides[i + 3];
+                    igemm_n /= wei_lengths[i + 3];
+                }
+
+                offset += igemm_n * wei_strides[2];
+
+                float v_wei;
+
+                arg.wei_element_op_(v_wei, v_acc);
+
+                arg.weight_.mData[offset] = ck::type_convert<WeiDataType>(v_wei);
+            };
+
+            make_ParallelTensorFunctor(f_wei, G, K, gemm_n)(num_thread);
+
+            return 0;
+        }
+
+        float RunDirect(const Argument& arg)
+        {
             if constexpr(NDimSpatial == 1)
             {
                 auto f_kcx = [&](auto g, auto k, auto c, auto x) {
@@ -3,17 +3,37 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_winograd_conv.hpp"
 
 namespace ck {
 namespace tensor_operation {
 namespace host {
 
+enum struct ReferenceConvFwdAlgorithm
+{
+    Default,      // implicit GEMM, direct loop as fallback
+    Direct,       // per-output loop
+    WinogradF2x2, // Winograd F(2x2, 3x3), default algorithm as fallback
+    WinogradF4x4, // Winograd F(4x4, 3x3), default algorithm as fallback
+};
+
 //
 // @brief      Reference implementation for forward convolution.
 //
@@ -22,6 +42,21 @@ namespace host {
 //             Supports both GNCHW/NGCHW as well as GNHWC/NHWGC physical layout
 //             as long as dimensions in tensor descriptor is in GNCHW order
 //
+// @paragraph
+//             Computed as an implicit GEMM on the blocked host GEMM engine. The direct
+//             per-output loop is kept as fallback for problems whose GEMM view does not fit
+//             index_t.
+//
+// @paragraph
+//             Winograd F(2x2, 3x3) / F(4x4, 3x3) can be requested through
+//             ReferenceConvFwdAlgorithm for 2D 3x3 problems with unit strides and dilations;
+//             other problems silently use the default algorithm, and so do weights with a
+//             non-finite transformed filter or a non-finite input: every transformed value mixes
+//             the zero padding with all filter taps and every input of a tile with all its outputs,
+//             where the other algorithms only combine the taps of one output window. The filter
+//             transform of an Argument is reused by the following Run()s as long as the contents
+//             of the weights are unchanged.
+//
 // @tparam     InDataType               Input tensor data type.
 // @tparam     WeiDataType              Weights tensor data type.
 // @tparam     OutDataType              Output tensor data type.
@@ -45,6 +80,45 @@ template <ck::index_t NDimSpatial,
           typename std::enable_if<NDimSpatial >= 1 && NDimSpatial <= 3, bool>::type = false>
 struct ReferenceConvFwd : public device::BaseOperator
 {
+    // transformed filters of the Winograd algorithms, keyed on the contents of the weights they
+    // were computed from, shared by the copies of an Argument
+    struct WinogradFilterCache
+    {
+        template <index_t OutTileSize>
+        struct Entry
+        {
+            std::mutex mutex_;
+            std::size_t weight_size_   = 0;
+            std::uint64_t weight_hash_ = 0;
+            std::shared_ptr<const HostWinogradConv2dFwd<OutTileSize>> conv_;
+        };
+
+        // hash of the weight bytes, 8 bytes per multiply-xorshift step: one read-only pass,
+        // much cheaper than the filter transform it guards
+        static std::uint64_t GetWeightHash(const Tensor<WeiDataType>& weight)
+        {
+            const auto* p_byte = reinterpret_cast<const unsigned char*>(weight.mData.data());
+            const std::size_t num_byte = weight.mData.size() * sizeof(WeiDataType);
+
+            std::uint64_t hash = num_byte;
+
+            for(std::size_t i = 0; i < num_byte; i += sizeof(std::uint64_t))
+            {
+                std::uint64_t word = 0;
+
+                std::memcpy(&word, p_byte + i, std::min(sizeof(std::uint64_t), num_byte - i));
+
+                hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+                hash ^= hash >> 29;
+            }
+
+            return hash;
+        }
+
+        Entry<2> f2x2_;
+        Entry<4> f4x4_;
+    };
+
     // Argument
     struct Argument : public device::BaseArgument
     {
@@ -57,7 +131,8 @@ struct ReferenceConvFwd : public device::BaseOperator
                  std::vector<ck::index_t> input_right_pads,
                  InElementwiseOperation in_element_op,
                  WeiElementwiseOperation wei_element_op,
-                 OutElementwiseOperation out_element_op)
+                 OutElementwiseOperation out_element_op,
+                 ReferenceConvFwdAlgorithm algorithm = ReferenceConvFwdAlgorithm::Default)
             : input_{input},
               weight_{weight},
               output_{output},
@@ -67,7 +142,9 @@ struct ReferenceConvFwd : public device::BaseOperator
               in_right_pads_{input_right_pads},
               in_element_op_{in_element_op},
               wei_element_op_{wei_element_op},
-              out_element_op_{out_element_op}
+              out_element_op_{out_element_op},
+              algorithm_{algorithm},
+              winograd_cache_{std::make_shared<WinogradFilterCache>()}
         {
         }
 
@@ -83,6 +160,10 @@ struct ReferenceConvFwd : public device::BaseOperator
         InElementwiseOperation in_element_op_;
         WeiElementwiseOperation wei_element_op_;
         OutElementwiseOperation out_element_op_;
+
+        ReferenceConvFwdAlgorithm algorithm_;
+
+        std::shared_ptr<WinogradFilterCache> winograd_cache_;
     };
 
     struct Invoker : public device::BaseInvoker
@@ -98,30 +179,516 @@ struct ReferenceConvFwd : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
+            if(arg.algorithm_ == ReferenceConvFwdAlgorithm::WinogradF2x2 &&
+               IsWinogradApplicable(arg))
+            {
+                return RunWinograd<2>(arg);
+            }
+
+            if(arg.algorithm_ == ReferenceConvFwdAlgorithm::WinogradF4x4 &&
+               IsWinogradApplicable(arg))
+            {
+                return RunWinograd<4>(arg);
+            }
+
+            if(arg.algorithm_ != ReferenceConvFwdAlgorithm::Direct &&
+               IsImplicitGemmApplicable(arg))
+            {
+                return RunImplicitGemm(arg);
+            }
+
+            return RunDirect(arg);
+        }
+
+        // 2D, 3x3 filter, unit strides and dilations, any padding
+        static bool IsWinogradApplicable(const Argument& arg)
+        {
+            if constexpr(NDimSpatial != 2)
+            {
+                return false;
+            }
+            else
+            {
+                if(arg.conv_strides_.size() != 2 || arg.conv_dilations_.size() != 2 ||
+                   arg.in_left_pads_.size() != 2)
+                {
+                    return false;
+                }
+
+                const auto& in_lengths  = arg.input_.GetLengths();
+                const auto& wei_lengths = arg.weight_.GetLengths();
+                const auto& out_lengths = arg.output_.GetLengths();
+
+                for(index_t i = 0; i < 2; ++i)
+                {
+                    if(wei_lengths[i + 3] != 3 || arg.conv_strides_[i] != 1 ||
+                       arg.conv_dilations_[i] != 1)
+                    {
+                        return false;
+                    }
+                }
+
+                // the tiles of all images form the rows of the Winograd GEMMs
+                const long_index_t num_tile =
+                    static_cast<long_index_t>(out_lengths[1]) *
+                    math::integer_divide_ceil<long_index_t>(out_lengths[3], 2) *
+                    math::integer_divide_ceil<long_index_t>(out_lengths[4], 2);
+
+                return num_tile <= std::numeric_limits<index_t>::max() &&
+                       in_lengths[2] <= std::numeric_limits<index_t>::max() &&
+                       out_lengths[2] <= std::numeric_limits<index_t>::max();
+            }
+        }
+
+        template <index_t OutTileSize>
+        float RunWinograd(const Argument& arg)
+        {
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
+
+            const auto& in_strides  = arg.input_.GetStrides();
+            const auto& wei_strides = arg.weight_.GetStrides();
+            const auto& out_strides = arg.output_.GetStrides();
+
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+
+            if(!IsInputFinite(arg))
+            {
+                return RunDefault(arg);
+            }
+
+            auto& entry = [&]() -> auto& {
+                if constexpr(OutTileSize == 2)
+                    return arg.winograd_cache_->f2x2_;
+                else
+                    return arg.winograd_cache_->f4x4_;
+            }();
+
+            // the filter transform only depends on the weights: redone whenever their contents
+            // changed since the previous Run(), in place or not
+            const std::size_t weight_size   = arg.weight_.mData.size();
+            const std::uint64_t weight_hash = WinogradFilterCache::GetWeightHash(arg.weight_);
+
+            auto is_cached = [&] {
+                return entry.conv_ != nullptr && entry.weight_size_ == weight_size &&
+                       entry.weight_hash_ == weight_hash;
+            };
+
+            std::shared_ptr<const HostWinogradConv2dFwd<OutTileSize>> p_conv;
+
+            {
+                std::lock_guard<std::mutex> lock{entry.mutex_};
+
+                if(!is_cached())
+                {
+                    auto conv = std::make_shared<HostWinogradConv2dFwd<OutTileSize>>(
+                        static_cast<index_t>(in_lengths[0]),
+                        static_cast<index_t>(in_lengths[1]),
+                        static_cast<index_t>(out_lengths[2]),
+                        static_cast<index_t>(in_lengths[2]),
+                        static_cast<index_t>(in_lengths[3]),
+                        static_cast<index_t>(in_lengths[4]),
+                        static_cast<index_t>(out_lengths[3]),
+                        static_cast<index_t>(out_lengths[4]),
+                        arg.in_left_pads_[0],
+                        arg.in_left_pads_[1]);
+
+                    conv->TransformFilter(
+                        [&](index_t g, index_t k, index_t c, index_t y, index_t x) {
+                            float v_wei;
+
+                            arg.wei_element_op_(
+                                v_wei,
+                                ck::type_convert<float>(
+                                    arg.weight_.mData[g * wei_strides[0] + k * wei_strides[1] +
+                                                      c * wei_strides[2] + y * wei_strides[3] +
+                                                      x * wei_strides[4]]));
+
+                            return v_wei;
+                        },
+                        num_thread);
+
+                    entry.weight_size_ = weight_size;
+                    entry.weight_hash_ = weight_hash;
+                    entry.conv_        = std::move(conv);
+                }
+
+                p_conv = entry.conv_;
+            }
+
+            if(!p_conv->IsFilterFinite())
+            {
+                return RunDefault(arg);
+            }
+
+            const auto& conv = *p_conv;
+
+            conv.Run(
+                [&](index_t g, index_t n, index_t c, index_t hi, index_t wi) {
+                    float v_in;
+
+                    arg.in_element_op_(
+                        v_in,
+                        ck::type_convert<float>(
+                            arg.input_.mData[g * in_strides[0] + n * in_strides[1] +
+                                             c * in_strides[2] + hi * in_strides[3] +
+                                             wi * in_strides[4]]));
+
+                    return v_in;
+                },
+                [&](index_t g, index_t n, index_t k, index_t ho, index_t wo, float v_acc) {
+                    float v_out;
+
+                    arg.out_element_op_(v_out, v_acc);
+
+                    arg.output_.mData[g * out_strides[0] + n * out_strides[1] +
+                                      k * out_strides[2] + ho * out_strides[3] +
+                                      wo * out_strides[4]] = ck::type_convert<OutDataType>(v_out);
+                },
+                num_thread);
+
+            return 0;
+        }
+
+        // Winograd spreads every input of a tile over all outputs of the tile: a single Inf or
+        // NaN would reach outputs whose window never reads it
+        static bool IsInputFinite(const Argument& arg)
+        {
+            return std::all_of(
+                arg.input_.mData.begin(), arg.input_.mData.end(), [&](const InDataType& v) {
+                    float v_in;
+
+                    arg.in_element_op_(v_in, ck::type_convert<float>(v));
+
+                    return std::isfinite(v_in);
+                });
+        }
+
+        // fallback of the Winograd algorithms
+        float RunDefault(const Argument& arg)
+        {
+            return IsImplicitGemmApplicable(arg) ? RunImplicitGemm(arg) : RunDirect(arg);
+        }
+
+        // GEMM view of the convolution, per group:
+        //   GemmM = N * Do * Ho * Wo, GemmN = K, GemmK = C * Z * Y * X
+        // It is usable for positive strides and dilations, as long as the GEMM view can be indexed
+        // with index_t; everything else (padding, physical layout) is handled while packing.
+        static bool IsImplicitGemmApplicable(const Argument& arg)
+        {
+            if(arg.conv_strides_.size() != NDimSpatial ||
+               arg.conv_dilations_.size() != NDimSpatial ||
+               arg.in_left_pads_.size() != NDimSpatial)
+            {
+                return false;
+            }
+
+            // the inner output range divides by the stride
+            for(index_t i = 0; i < NDimSpatial; ++i)
+            {
+                if(arg.conv_strides_[i] <= 0 || arg.conv_dilations_[i] <= 0)
+                {
+                    return false;
+                }
+            }
+
+            long_index_t gemm_m = arg.output_.GetLengths()[1];
+            long_index_t gemm_n = arg.output_.GetLengths()[2];
+            long_index_t gemm_k = arg.weight_.GetLengths()[2];
+
+            for(index_t i = 0; i < NDimSpatial; ++i)
+            {
+                gemm_m *= arg.output_.GetLengths()[i + 3];
+                gemm_k *= arg.weight_.GetLengths()[i + 3];
+            }
+
+            constexpr long_index_t max_index = std::numeric_limits<index_t>::max();
+
+            return gemm_m <= max_index && gemm_n <= max_index && gemm_k <= max_index;
+        }
+
+        // Weights are transformed into packed GEMM panels once per group, the input is gathered
+        // into packed (im2col) panels one MC row block at a time, so the full im2col matrix is
+        // never materialized. The GemmK order (c, z, y, x) matches the direct loop, hence the
+        // accumulation order of every output is unchanged.
+        //
+        // Only the outputs whose taps all fall inside the input are GEMM rows; the border
+        // outputs skip their padding taps in a per-output loop in the same order, so an Inf or
+        // NaN never meets a padding zero.
+        float RunImplicitGemm(const Argument& arg)
+        {
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& wei_lengths = arg.weight_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
+
+            const auto& in_strides  = arg.input_.GetStrides();
+            const auto& wei_strides = arg.weight_.GetStrides();
+            const auto& out_strides = arg.output_.GetStrides();
+
+            const index_t G = out_lengths[0];
+            const index_t N = out_lengths[1];
+            const index_t K = out_lengths[2];
+            const index_t C = wei_lengths[2];
+
+            index_t out_spatial_size = 1;
+            index_t wei_spatial_size = 1;
+
+            // the inner outputs wo read every tap x inside the input:
+            //   wo * stride - left_pad >= 0 and wo * stride + (X - 1) * dilation - left_pad < Wi
+            std::array<index_t, NDimSpatial> out_inner_begin;
+            std::array<index_t, NDimSpatial> out_inner_lengths;
+
+            index_t num_inner_out = 1;
+
+            for(index_t i = 0; i < NDimSpatial; ++i)
+            {
+                out_spatial_size *= out_lengths[i + 3];
+                wei_spatial_size *= wei_lengths[i + 3];
+
+                const long_index_t stride   = arg.conv_strides_[i];
+                const long_index_t left_pad = arg.in_left_pads_[i];
+                const long_index_t end      = static_cast<long_index_t>(in_lengths[i + 3]) +
+                                         left_pad -
+                                         static_cast<long_index_t>(wei_lengths[i + 3] - 1) *
+                                             arg.conv_dilations_[i];
+
+                const long_index_t out_begin =
+                    left_pad > 0 ? math::integer_divide_ceil(left_pad, stride) : 0;
+                const long_index_t out_end =
+                    end > 0 ? std::min<long_index_t>(math::integer_divide_ceil(end, stride),
+                                                     out_lengths[i + 3])
+                            : 0;
+
+                out_inner_begin[i]   = static_cast<index_t>(std::min<long_index_t>(
+                    out_begin, static_cast<long_index_t>(out_lengths[i + 3])));
+                out_inner_lengths[i] = static_cast<index_t>(
+                    std::max<long_index_t>(out_end - out_inner_begin[i], 0));
+
+                num_inner_out *= out_inner_lengths[i];
+            }
+
+            const index_t gemm_m = N * num_inner_out;
+            const index_t gemm_n = K;
+            const index_t gemm_k = C * wei_spatial_size;
+
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+
+            for(index_t g = 0; g < G; ++g)
+            {
+                // B[gemm_k, k] = weight(g, k, c, z, y, x)
+                auto b_getter = [&](index_t igemm_k, index_t k) {
+                    std::size_t offset = g * wei_strides[0] + k * wei_strides[1];
+
+                    for(index_t i = NDimSpatial - 1; i >= 0; --i)
+                    {
+                        offset += (igemm_k % wei_lengths[i + 3]) * wei_strides[i + 3];
+                        igemm_k /= wei_lengths[i + 3];
+                    }
+
+                    offset += igemm_k * wei_strides[2];
+
+                    float v_wei;
+
+                    arg.wei_element_op_(v_wei, ck::type_convert<float>(arg.weight_.mData[offset]));
+
+                    return v_wei;
+                };
+
+                // A[gemm_m, gemm_k] = input(g, n, c, di, hi, wi), inner outputs only
+                auto a_getter = [&](index_t igemm_m, index_t igemm_k) {
+                    std::size_t offset = g * in_strides[0];
+
+                    for(index_t i = NDimSpatial - 1; i >= 0; --i)
+                    {
+                        const auto wo = static_cast<ck::long_index_t>(
+                            out_inner_begin[i] + igemm_m % out_inner_lengths[i]);
+                        const auto x = static_cast<ck::long_index_t>(igemm_k % wei_lengths[i + 3]);
+
+                        igemm_m /= out_inner_lengths[i];
+                        igemm_k /= wei_lengths[i + 3];
+
+                        const auto wi = wo * arg.conv_strides_[i] + x * arg.conv_dilations_[i] -
+                                        arg.in_left_pads_[i];
+
+                        offset += wi * in_strides[i + 3];
+                    }
+
+                    offset += igemm_m * in_strides[1] + igemm_k * in_strides[2];
+
+                    float v_in;
+
+                    arg.in_element_op_(v_in, ck::type_convert<float>(arg.input_.mData[offset]));
+
+                    return v_in;
+                };
+
+                auto store_output = [&](index_t n,
+                                        const std::array<index_t, NDimSpatial>& wo,
+                                        index_t k,
+                                        float v_acc) {
+                    std::size_t offset =
+                        g * out_strides[0] + n * out_strides[1] + k * out_strides[2];
+
+                    for(index_t i = 0; i < NDimSpatial; ++i)
+                    {
+                        offset += wo[i] * out_strides[i + 3];
+                    }
+
+                    float v_out;
+
+                    arg.out_element_op_(v_out, v_acc);
+
+                    arg.output_.mData[offset] = ck::type_convert<OutDataType>(v_out);
+                };
+
+                auto c_epilogue = [&](index_t igemm_m, index_t k, float v_acc) {
+                    std::array<index_t, NDimSpatial> wo;
+
+                    for(index_t i = NDimSpatial - 1; i >= 0; --i)
+                    {
+                        wo[i] = out_inner_begin[i] + igemm_m % out_inner_lengths[i];
+                        igemm_m /= out_inner_lengths[i];
+                    }
+
+                    store_output(igemm_m, wo, k, v_acc);
+                };
+
+                if(gemm_m > 0)
+                {
+                    HostBlockedGemm<float> gemm{gemm_m, gemm_n, gemm_k};
+
+                    gemm.PackB(b_getter, num_thread);
+                    gemm.Run(a_getter, c_epilogue, num_thread);
+                }
+
+                // border outputs, in the (c, z, y, x) order of the GEMM
+                auto f_border = [&](index_t n, index_t iout) {
+                    std::array<index_t, NDimSpatial> wo;
+
+                    bool is_inner = true;
+
+                    for(index_t i = NDimSpatial - 1; i >= 0; --i)
+                    {
+                        wo[i] = iout % out_lengths[i + 3];
+                        iout /= out_lengths[i + 3];
+
+                        is_inner = is_inner && wo[i] >= out_inner_begin[i] &&
+                                   wo[i] < out_inner_begin[i] + out_inner_lengths[i];
+                    }
+
+                    if(is_inner)
+                    {
+                        return;
+                    }
+
+                    for(index_t k = 0; k < K; ++k)
+                    {
+                        float v_acc = 0;
+
+                        for(index_t c = 0; c < C; ++c)
+                        {
+                            for(index_t itap = 0; itap < wei_spatial_size; ++itap)
+                            {
+                                std::size_t in_offset =
+                                    g * in_strides[0] + n * in_strides[1] + c * in_strides[2];
+                                std::size_t wei_offset =
+                                    g * wei_strides[0] + k * wei_strides[1] + c * wei_strides[2];
+
+                                bool is_in_bounds = true;
+
+                                for(index_t i = NDimSpatial - 1, tmp = itap; i >= 0; --i)
+                                {
+                                    const auto x = static_cast<ck::long_index_t>(
+                                        tmp % wei_lengths[i + 3]);
+                                    const auto wi =
+                                        static_cast<ck::long_index_t>(wo[i]) *
+                                            arg.conv_strides_[i] +
+                                        x * arg.conv_dilations_[i] - arg.in_left_pads_[i];
+
+                                    tmp /= wei_lengths[i + 3];
+
+                                    is_in_bounds =
+                                        is_in_bounds && wi >= 0 &&
+                                        ck::type_convert<std::size_t>(wi) < in_lengths[i + 3];
+
+                                    in_offset += wi * in_strides[i + 3];
+                                    wei_offset += x * wei_strides[i + 3];
+                                }
+
+                                if(!is_in_bounds)
+                                {
+                                    continue;
+                                }
+
+                                float v_in;
+                                float v_wei;
+
+                                arg.in_element_op_(
+                                    v_in, ck::type_convert<float>(arg.input_.mData[in_offset]));
+
+                                arg.wei_element_op_(
+                                    v_wei, ck::type_convert<float>(arg.weight_.mData[wei_offset]));
+
+                                v_acc += v_in * v_wei;
+                            }
+                        }
+
+                        store_output(n, wo, k, v_acc);
+                    }
+                };
+
+                if(num_inner_out < out_spatial_size)
+                {
+                    make_ParallelTensorFunctor(f_border, N, out_spatial_size)(num_thread);
+                }
+            }
+
+            return 0;
+        }
+
+        float RunDirect(const Argument& arg)
+        {
+            // the rank is known here: index with unrolled offset math in the innermost loop
+            const StaticRankHostTensorDescriptor<NDimSpatial + 3> in_desc(arg.input_.mDesc);
+            const StaticRankHostTensorDescriptor<NDimSpatial + 3> wei_desc(arg.weight_.mDesc);
+            const StaticRankHostTensorDescriptor<NDimSpatial + 3> out_desc(arg.output_.mDesc);
+
+            auto input = [&](auto... is) -> const InDataType& {
+                return arg.input_.mData[in_desc.GetOffsetFromMultiIndex(is...)];
+            };
+
+            auto weight = [&](auto... is) -> const WeiDataType& {
+                return arg.weight_.mData[wei_desc.GetOffsetFromMultiIndex(is...)];
+            };
+
+            auto output = [&](auto... is) -> OutDataType& {
+                return arg.output_.mData[out_desc.GetOffsetFromMultiIndex(is...)];
+            };
+
             if constexpr(NDimSpatial == 1)
             {
                 auto func = [&](auto g, auto n, auto k, auto wo) {
                     float v_acc = 0;
 
-                    for(std::size_t c = 0; c < arg.weight_.GetLengths()[2]; ++c)
+                    for(std::size_t c = 0; c < wei_desc.GetLengths()[2]; ++c)
                     {
-                        for(std::size_t x = 0; x < arg.weight_.GetLengths()[3]; ++x)
+                        for(std::size_t x = 0; x < wei_desc.GetLengths()[3]; ++x)
                         {
                             auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[0]) +
                                       static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]) -
                                       static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
 
                             if(wi >= 0 &&
-                               ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[3])
+                               ck::type_convert<std::size_t>(wi) < in_desc.GetLengths()[3])
                             {
                                 float v_in;
                                 float v_wei;
 
                                 arg.in_element_op_(
-                                    v_in, ck::type_convert<float>(arg.input_(g, n, c, wi)));
+                                    v_in, ck::type_convert<float>(input(g, n, c, wi)));
 
                                 arg.wei_element_op_(
-                                    v_wei, ck::type_convert<float>(arg.weight_(g, k, c, x)));
+                                    v_wei, ck::type_convert<float>(weight(g, k, c, x)));
 
                                 v_acc += v_in * v_wei;
                             }
@@ -132,7 +699,7 @@ struct ReferenceConvFwd : public device::BaseOperator
 
                     arg.out_element_op_(v_out, v_acc);
 
-                    arg.output_(g, n, k, wo) = ck::type_convert<OutDataType>(v_out);
+                    output(g, n, k, wo) = ck::type_convert<OutDataType>(v_out);
                 };
 
                 make_ParallelTensorFunctor(func,
@@ -149,15 +716,15 @@ struct ReferenceConvFwd : public device::BaseOperator
                 auto func = [&](auto g, auto n, auto k, auto ho, auto wo) {
                     float v_acc = 0;
 
-                    for(std::size_t c = 0; c < arg.weight_.GetLengths()[2]; ++c)
+                    for(std::size_t c = 0; c < wei_desc.GetLengths()[2]; ++c)
                     {
-                        for(std::size_t y = 0; y < arg.weight_.GetLengths()[3]; ++y)
+                        for(std::size_t y = 0; y < wei_desc.GetLengths()[3]; ++y)
                         {
                             auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[0]) +
                                       static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]) -
                                       static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
 
-                            for(std::size_t x = 0; x < arg.weight_.GetLengths()[4]; ++x)
+                            for(std::size_t x = 0; x < wei_desc.GetLengths()[4]; ++x)
                             {
                                 auto wi =
                                     static_cast<ck::long_index_t>(wo * arg.conv_strides_[1]) +
@@ -165,18 +732,18 @@ struct ReferenceConvFwd : public device::BaseOperator
                                     static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
 
                                 if(hi >= 0 &&
-                                   ck::type_convert<std::size_t>(hi) < arg.input_.GetLengths()[3] &&
+                                   ck::type_convert<std::size_t>(hi) < in_desc.GetLengths()[3] &&
                                    wi >= 0 &&
-                                   ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[4])
+                                   ck::type_convert<std::size_t>(wi) < in_desc.GetLengths()[4])
                                 {
                                     float v_in;
                                     float v_wei;
 
                                     arg.in_element_op_(
-                                        v_in, ck::type_convert<float>(arg.input_(g, n, c, hi, wi)));
+                                        v_in, ck::type_convert<float>(input(g, n, c, hi, wi)));
 
                                     arg.wei_element_op_(
-                                        v_wei, ck::type_convert<float>(arg.weight_(g, k, c, y, x)));
+                                        v_wei, ck::type_convert<float>(weight(g, k, c, y, x)));
 
                                     v_acc += v_in * v_wei;
                                 }
@@ -188,7 +755,7 @@ struct ReferenceConvFwd : public device::BaseOperator
 
                     arg.out_element_op_(v_out, v_acc);
 
-                    arg.output_(g, n, k, ho, wo) = ck::type_convert<OutDataType>(v_out);
+                    output(g, n, k, ho, wo) = ck::type_convert<OutDataType>(v_out);
                 };
 
                 make_ParallelTensorFunctor(func,
@@ -206,20 +773,20 @@ struct ReferenceConvFwd : public device::BaseOperator
                 auto func = [&](auto g, auto n, auto k, auto d_o, auto ho, auto wo) {
                     float v_acc = 0;
 
-                    for(std::size_t c = 0; c < arg.weight_.GetLengths()[2]; ++c)
+                    for(std::size_t c = 0; c < wei_desc.GetLengths()[2]; ++c)
                     {
-                        for(std::size_t z = 0; z < arg.weight_.GetLengths()[3]; ++z)
+                        for(std::size_t z = 0; z < wei_desc.GetLengths()[3]; ++z)
                         {
                             auto di = static_cast<ck::long_index_t>(d_o * arg.conv_strides_[0]) +
                                       static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]) -
                                       static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-                            for(std::size_t y = 0; y < arg.weight_.GetLengths()[4]; ++y)
+                            for(std::size_t y = 0; y < wei_desc.GetLengths()[4]; ++y)
                             {
                                 auto hi =
                                     static_cast<ck::long_index_t>(ho * arg.conv_strides_[1]) +
                                     static_cast<ck::long_index_t>(y * arg.conv_dilations_[1]) -
                                     static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-                                for(std::size_t x = 0; x < arg.weight_.GetLengths()[5]; ++x)
+                                for(std::size_t x = 0; x < wei_desc.GetLengths()[5]; ++x)
                                 {
                                     auto wi =
                                         static_cast<ck::long_index_t>(wo * arg.conv_strides_[2]) +
@@ -227,24 +794,24 @@ struct ReferenceConvFwd : public device::BaseOperator
                                         static_cast<ck::long_index_t>(arg.in_left_pads_[2]);
                                     if(di >= 0 &&
                                        ck::type_convert<std::size_t>(di) <
-                                           arg.input_.GetLengths()[3] &&
+                                           in_desc.GetLengths()[3] &&
                                        hi >= 0 &&
                                        ck::type_convert<std::size_t>(hi) <
-                                           arg.input_.GetLengths()[4] &&
+                                           in_desc.GetLengths()[4] &&
                                        wi >= 0 &&
                                        ck::type_convert<std::size_t>(wi) <
-                                           arg.input_.GetLengths()[5])
+                                           in_desc.GetLengths()[5])
                                     {
                                         float v_in;
                                         float v_wei;
 
-                                        arg.in_element_op_(v_in,
-                                                           ck::type_convert<float>(
-                                                               arg.input_(g, n, c, di, hi, wi)));
+                                        arg.in_element_op_(
+                                            v_in,
+                                            ck::type_convert<float>(input(g, n, c, di, hi, wi)));
 
                                         arg.wei_element_op_(
                                             v_wei,
-                                            ck::type_convert<float>(arg.weight_(g, k, c, z, y, x)));
+                                            ck::type_convert<float>(weight(g, k, c, z, y, x)));
 
                                         v_acc += v_in * v_wei;
                                     }
@@ -257,7 +824,7 @@ struct ReferenceConvFwd : public device::BaseOperator
 
                     arg.out_element_op_(v_out, v_acc);
 
-                    arg.output_(g, n, k, d_o, ho, wo) = ck::type_convert<OutDataType>(v_out);
+                    output(g, n, k, d_o, ho, wo) = ck::type_convert<OutDataType>(v_out);
                 };
 
                 make_ParallelTensorFunctor(func,
@@ -300,7 +867,9 @@ struct ReferenceConvFwd : public device::BaseOperator
                              std::vector<ck::index_t> input_right_pads,
                              InElementwiseOperation in_element_op,
                              WeiElementwiseOperation wei_element_op,
-                             OutElementwiseOperation out_element_op)
+                             OutElementwiseOperation out_element_op,
+                             ReferenceConvFwdAlgorithm algorithm =
+                                 ReferenceConvFwdAlgorithm::Default)
     {
         return Argument{input,
                         weight,
@@ -311,7 +880,8 @@ struct ReferenceConvFwd : public device::BaseOperator
                         input_right_pads,
                         in_element_op,
                         wei_element_op,
-                        out_element_op};
+                        out_element_op,
+                        algorithm};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
@@ -8,6 +8,8 @@
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_int8_gemm.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -25,9 +27,9 @@ struct ReferenceGemm : public device::BaseOperator
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const Tensor<ADataType>& a_m_k,
-                 const Tensor<BDataType>& b_k_n,
-                 Tensor<CDataType>& c_m_n,
+        Argument(TensorView<const ADataType> a_m_k,
+                 TensorView<const BDataType> b_k_n,
+                 TensorView<CDataType> c_m_n,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
                  CElementwiseOperation c_element_op)
@@ -40,9 +42,9 @@ struct ReferenceGemm : public device::BaseOperator
         {
         }
 
-        const Tensor<ADataType>& a_m_k_;
-        const Tensor<BDataType>& b_k_n_;
-        Tensor<CDataType>& c_m_n_;
+        TensorView<const ADataType> a_m_k_;
+        TensorView<const BDataType> b_k_n_;
+        TensorView<CDataType> c_m_n_;
 
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
@@ -56,33 +58,64 @@ struct ReferenceGemm : public device::BaseOperator
 
         float Run(const Argument& arg)
         {
-            auto f_mk_kn_mn = [&](auto m, auto n) {
-                const int K = arg.a_m_k_.mDesc.GetLengths()[1];
+            const index_t M = arg.c_m_n_.mDesc.GetLengths()[0];
+            const index_t N = arg.c_m_n_.mDesc.GetLengths()[1];
+            const index_t K = arg.a_m_k_.mDesc.GetLengths()[1];
 
-                AccDataType v_acc = 0;
+            const auto& a_strides = arg.a_m_k_.mDesc.GetStrides();
+            const auto& b_strides = arg.b_k_n_.mDesc.GetStrides();
+            const auto& c_strides = arg.c_m_n_.mDesc.GetStrides();
 
-                for(int k = 0; k < K; ++k)
-                {
-                    ADataType v_a;
-                    BDataType v_b;
+            // element ops and conversion to AccDataType are applied once per element, at pack time
+            auto get_a = [&](index_t m, index_t k) {
+                ADataType v_a;
 
-                    arg.a_element_op_(v_a, arg.a_m_k_(m, k));
-                    arg.b_element_op_(v_b, arg.b_k_n_(k, n));
+                arg.a_element_op_(v_a, arg.a_m_k_.mData[m * a_strides[0] + k * a_strides[1]]);
 
-                    v_acc +=
-                        ck::type_convert<AccDataType>(v_a) * ck::type_convert<AccDataType>(v_b);
-                }
+                return v_a;
+            };
+
+            auto get_b = [&](index_t k, index_t n) {
+                BDataType v_b;
+
+                arg.b_element_op_(v_b, arg.b_k_n_.mData[k * b_strides[0] + n * b_strides[1]]);
+
+                return v_b;
+            };
 
+            auto c_epilogue = [&](index_t m, index_t n, AccDataType v_acc) {
                 AccDataType v_c;
 
                 arg.c_element_op_(v_c, v_acc);
 
-                arg.c_m_n_(m, n) = ck::type_convert<CDataType>(v_c);
+                arg.c_m_n_.mData[m * c_strides[0] + n * c_strides[1]] =
+                    ck::type_convert<CDataType>(v_c);
             };
 
-            make_ParallelTensorFunctor(
-                f_mk_kn_mn, arg.c_m_n_.mDesc.GetLengths()[0], arg.c_m_n_.mDesc.GetLengths()[1])(
-                std::thread::hardware_concurrency());
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+
+            if constexpr(is_host_int8_gemm_v<ADataType, BDataType, AccDataType>)
+            {
+                HostInt8Gemm gemm{M, N, K};
+
+                gemm.PackB(get_b, num_thread);
+                gemm.Run(get_a, c_epilogue, num_thread);
+            }
+            else
+            {
+                auto a_getter = [&](index_t m, index_t k) {
+                    return ck::type_convert<AccDataType>(get_a(m, k));
+                };
+
+                auto b_getter = [&](index_t k, index_t n) {
+                    return ck::type_convert<AccDataType>(get_b(k, n));
+                };
+
+                HostBlockedGemm<AccDataType> gemm{M, N, K};
+
+                gemm.PackB(b_getter, num_thread);
+                gemm.Run(a_getter, c_epilogue, num_thread);
+            }
 
             return 0;
         }
@@ -102,9 +135,9 @@ struct ReferenceGemm : public device::BaseOperator
 
     bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
 
-    static auto MakeArgument(const Tensor<ADataType>& a_m_k,
-                             const Tensor<BDataType>& b_k_n,
-                             Tensor<CDataType>& c_m_n,
+    static auto MakeArgument(TensorView<const ADataType> a_m_k,
+                             TensorView<const BDataType> b_k_n,
+                             TensorView<CDataType> c_m_n,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
                              CElementwiseOperation c_element_op)
@@ -62,16 +62,13 @@ struct ReferenceGemmLayernorm : public device::BaseOperator
             avg_acc(i)    = sum_acc / N;
         }
 
-        // normalize
-        acc_layernorm.ForEach([&](auto& self, auto idx) {
-            self(idx[0], idx[1]) =
-                (self(idx[0], idx[1]) - avg_acc(idx[0])) /
-                sqrt(avg_acc_sq(idx[0]) - avg_acc(idx[0]) * avg_acc(idx[0]) + epsilon);
-        });
+        // normalize, affine
+        acc_layernorm.template ForEachIndex<2>([&](const auto& idx, std::size_t offset) {
+            ComputeDataType& v = acc_layernorm.mData[offset];
 
-        // affine
-        acc_layernorm.ForEach([&](auto& self, auto idx) {
-            self(idx[0], idx[1]) = self(idx[0], idx[1]) * gamma(idx[1]) + beta(idx[1]);
+            v = (v - avg_acc(idx[0])) /
+                sqrt(avg_acc_sq(idx[0]) - avg_acc(idx[0]) * avg_acc(idx[0]) + epsilon);
+            v = v * gamma(idx[1]) + beta(idx[1]);
         });
 
         // cast
@@ -146,24 +143,24 @@ struct ReferenceGemmLayernorm : public device::BaseOperator
             // gemm
             ref_invoker.Run(ref_argument);
 
-            // activation(acc + bias)
-            acc_m_n.ForEach([&](auto& self, auto idx) {
-                AccDataType out;
-                arg.acc_element_op_(out, acc_m_n(idx[0], idx[1]) + arg.c0_n_bias_(idx[1]));
-                self(idx[0], idx[1]) = out;
-            });
-
-            // add from other layers
-            acc_m_n.ForEach([&](auto& self, auto idx) {
-                self(idx[0], idx[1]) += arg.c0_m_n_add_(idx[0], idx[1]);
-            });
+            // activation(acc + bias), add from other layers
+            host_tensor_for_each<2, 2>(
+                [&](const auto& idx, const auto& offsets) {
+                    AccDataType out;
+                    arg.acc_element_op_(out, acc_m_n.mData[offsets[0]] + arg.c0_n_bias_(idx[1]));
+                    acc_m_n.mData[offsets[0]] = out;
+                    acc_m_n.mData[offsets[0]] += arg.c0_m_n_add_.mData[offsets[1]];
+                },
+                to_host_tensor_array<2>(acc_m_n.mDesc.GetLengths()),
+                {to_host_tensor_array<2>(acc_m_n.mDesc.GetStrides()),
+                 to_host_tensor_array<2>(arg.c0_m_n_add_.mDesc.GetStrides())});
 
             // layernorm
             RunLayernorm(arg.c_m_n_, acc_m_n, arg.c0_n_gamma_, arg.c0_n_beta_);
 
             // elementwise op
-            arg.c_m_n_.ForEach([&](auto& self, auto idx) {
-                arg.c_element_op_(self(idx[0], idx[1]), self(idx[0], idx[1]));
+            arg.c_m_n_.template ForEachIndex<2>([&](const auto&, std::size_t offset) {
+                arg.c_element_op_(arg.c_m_n_.mData[offset], arg.c_m_n_.mData[offset]);
             });
 
             return 0;
@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_blocked_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_int8_gemm.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+namespace detail {
+
+template <typename DsDataType>
+struct HostDsTensors;
+
+template <typename... DDataTypes>
+struct HostDsTensors<ck::Tuple<DDataTypes...>>
+{
+    using type = std::tuple<TensorView<const DDataTypes>...>;
+};
+
+} // namespace detail
+
+//
+// @brief      Reference implementation for GEMM with a fused elementwise epilogue on extra D
+//             tensors, E = cde_op(A * B, D0, D1, ...).
+//
+// @paragraph
+//             Every D is an [M, N] tensor; a per-channel vector (bias, requantization scale) is
+//             passed with a zero M stride. The epilogue runs in the store phase of the GEMM
+//             engine on the AccDataType result, so the quantization operations
+//             (Activation_Mul_Clamp, Add_Activation_Mul_Clamp, Add_Mul_Activation_Mul_Clamp and
+//             their per-channel Mul2 forms) see the int32 accumulator exactly as on the device.
+//             int8 x int8 -> int32 runs on HostInt8Gemm, anything else on HostBlockedGemm.
+//
+template <typename ADataType,
+          typename BDataType,
+          typename DsDataType,
+          typename EDataType,
+          typename AccDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CDEElementwiseOperation>
+struct ReferenceGemmMultipleD : public device::BaseOperator
+{
+    using DsTensors = typename detail::HostDsTensors<DsDataType>::type;
+
+    // Argument
+    struct Argument : public device::BaseArgument
+    {
+        Argument(TensorView<const ADataType> a_m_k,
+                 TensorView<const BDataType> b_k_n,
+                 DsTensors ds_m_n,
+                 TensorView<EDataType> e_m_n,
+                 AElementwiseOperation a_element_op,
+                 BElementwiseOperation b_element_op,
+                 CDEElementwiseOperation cde_element_op)
+            : a_m_k_{a_m_k},
+              b_k_n_{b_k_n},
+              ds_m_n_{ds_m_n},
+              e_m_n_{e_m_n},
+              a_element_op_{a_element_op},
+              b_element_op_{b_element_op},
+              cde_element_op_{cde_element_op}
+        {
+        }
+
+        TensorView<const ADataType> a_m_k_;
+        TensorView<const BDataType> b_k_n_;
+        DsTensors ds_m_n_;
+        TensorView<EDataType> e_m_n_;
+
+        AElementwiseOperation a_element_op_;
+        BElementwiseOperation b_element_op_;
+        CDEElementwiseOperation cde_element_op_;
+    };
+
+    static bool IsValidArgument(const Argument& arg)
+    {
+        const auto& e_lengths = arg.e_m_n_.mDesc.GetLengths();
+
+        if(arg.a_m_k_.mDesc.GetLengths()[0] != e_lengths[0] ||
+           arg.b_k_n_.mDesc.GetLengths()[1] != e_lengths[1] ||
+           arg.a_m_k_.mDesc.GetLengths()[1] != arg.b_k_n_.mDesc.GetLengths()[0])
+            return false;
+
+        return std::apply(
+            [&](const auto&... ds_m_n) {
+                return ((ds_m_n.mDesc.GetLengths() == e_lengths) && ...);
+            },
+            arg.ds_m_n_);
+    }
+
+    // Invoker
+    struct Invoker : public device::BaseInvoker
+    {
+        using Argument = ReferenceGemmMultipleD::Argument;
+
+        float Run(const Argument& arg)
+        {
+            if(!IsValidArgument(arg))
+            {
+                throw std::runtime_error("wrong! inconsistent dimension");
+            }
+
+            const index_t M = arg.e_m_n_.mDesc.GetLengths()[0];
+            const index_t N = arg.e_m_n_.mDesc.GetLengths()[1];
+            const index_t K = arg.a_m_k_.mDesc.GetLengths()[1];
+
+            const auto& a_strides = arg.a_m_k_.mDesc.GetStrides();
+            const auto& b_strides = arg.b_k_n_.mDesc.GetStrides();
+            const auto& e_strides = arg.e_m_n_.mDesc.GetStrides();
+
+            auto get_a = [&](index_t m, index_t k) {
+                ADataType v_a;
+
+                arg.a_element_op_(v_a, arg.a_m_k_.mData[m * a_strides[0] + k * a_strides[1]]);
+
+                return v_a;
+            };
+
+            auto get_b = [&](index_t k, index_t n) {
+                BDataType v_b;
+
+                arg.b_element_op_(v_b, arg.b_k_n_.mData[k * b_strides[0] + n * b_strides[1]]);
+
+                return v_b;
+            };
+
+            auto e_epilogue = [&](index_t m, index_t n, AccDataType v_acc) {
+                std::apply(
+                    [&](const auto&... ds_m_n) {
+                        arg.cde_element_op_(arg.e_m_n_.mData[m * e_strides[0] + n * e_strides[1]],
+                                            v_acc,
+                                            ds_m_n(m, n)...);
+                    },
+                    arg.ds_m_n_);
+            };
+
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+
+            if constexpr(is_host_int8_gemm_v<ADataType, BDataType, AccDataType>)
+            {
+                HostInt8Gemm gemm{M, N, K};
+
+                gemm.PackB(get_b, num_thread);
+                gemm.Run(get_a, e_epilogue, num_thread);
+            }
+            else
+            {
+                auto a_getter = [&](index_t m, index_t k) {
+                    return ck::type_convert<AccDataType>(get_a(m, k));
+                };
+
+                auto b_getter = [&](index_t k, index_t n) {
+                    return ck::type_convert<AccDataType>(get_b(k, n));
+                };
+
+                HostBlockedGemm<AccDataType> gemm{M, N, K};
+
+                gemm.PackB(b_getter, num_thread);
+                gemm.Run(a_getter, e_epilogue, num_thread);
+            }
+
+            return 0;
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter()
+    {
+        // TODO: properly implement this check
+        return true;
+    }
+
+    bool IsSupportedArgument(const device::BaseArgument* p_arg) override
+    {
+        return IsValidArgument(*dynamic_cast<const Argument*>(p_arg));
+    }
+
+    static auto MakeArgument(TensorView<const ADataType> a_m_k,
+                             TensorView<const BDataType> b_k_n,
+                             DsTensors ds_m_n,
+                             TensorView<EDataType> e_m_n,
+                             AElementwiseOperation a_element_op,
+                             BElementwiseOperation b_element_op,
+                             CDEElementwiseOperation cde_element_op)
+    {
+        return Argument{
+            a_m_k, b_k_n, ds_m_n, e_m_n, a_element_op, b_element_op, cde_element_op};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferenceGemmMultipleD"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
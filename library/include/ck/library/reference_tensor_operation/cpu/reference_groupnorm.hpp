@@ -5,12 +5,15 @@
 
 #include <iostream>
 #include <sstream>
+#include <thread>
 #include <vector>
 #include <algorithm>
 
+#include "ck/utility/math.hpp"
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_welford.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -24,8 +27,8 @@ template <typename XDataType,
           typename AccElementwiseOperation>
 struct ReferenceGroupnorm : public device::BaseOperator
 {
-    // x = [N, H, W, G, C]
-    // y = [N, H, W, G, C]
+    // x = [N, H, W, G, C], any strides
+    // y = [N, H, W, G, C], any strides
     // reduce dim [H, W, C], mean, var = [N, G]
     // gamma, beta = [G, C]
     // beta: [G, C]
@@ -48,9 +51,9 @@ struct ReferenceGroupnorm : public device::BaseOperator
         {
         }
 
-        const Tensor<XDataType> x_;
-        const Tensor<XDataType> gamma_;
-        const Tensor<XDataType> beta_;
+        const Tensor<XDataType>& x_;
+        const Tensor<GammaDataType>& gamma_;
+        const Tensor<BetaDataType>& beta_;
         Tensor<YDataType>& y_;
         AccElementwiseOperation acc_elementwise_op_;
         std::vector<index_t> lengths_;
@@ -60,75 +63,139 @@ struct ReferenceGroupnorm : public device::BaseOperator
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
+        // Number of H * W slices the statistics of one (n, g) are split into. It only depends
+        // on the problem shape, so results do not change with the number of host threads.
+        static index_t GetNumSplit(index_t H, index_t W, index_t C)
+        {
+            // shortest slice worth a task of its own, in elements
+            constexpr long_index_t min_split_size = 16384;
+            constexpr long_index_t max_num_split  = 64;
+
+            const long_index_t num_split = std::min<long_index_t>(
+                static_cast<long_index_t>(H) * W * C / min_split_size, max_num_split);
+
+            // at least one slice, also for an empty H * W, which the split length divides by
+            return static_cast<index_t>(
+                std::max<long_index_t>(std::min<long_index_t>(num_split, H * W), 1));
+        }
+
         float Run(const Argument& arg)
         {
-            int N = arg.lengths_[0];
-            int H = arg.lengths_[1];
-            int W = arg.lengths_[2];
-            int G = arg.lengths_[3];
-            int C = arg.lengths_[4];
-
-            Tensor<AccDataType> mean({N, G});
-            Tensor<AccDataType> var({N, G});
-
-            // Compute mean & var in [H, W, C] by Welford Algorithm
-            // TODO - parallel for each HWC
-            // TODO - address calculation
-            for(int n = 0; n < N; ++n)
-            {
-                for(int g = 0; g < G; ++g)
+            const index_t N = arg.lengths_[0];
+            const index_t H = arg.lengths_[1];
+            const index_t W = arg.lengths_[2];
+            const index_t G = arg.lengths_[3];
+            const index_t C = arg.lengths_[4];
+
+            const auto& x_strides     = arg.x_.mDesc.GetStrides();
+            const auto& y_strides     = arg.y_.mDesc.GetStrides();
+            const auto& gamma_strides = arg.gamma_.mDesc.GetStrides();
+            const auto& beta_strides  = arg.beta_.mDesc.GetStrides();
+
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+
+            // Welford partials of (n, g) over [H * W] slices, each slice streams contiguous C
+            const index_t num_split    = GetNumSplit(H, W, C);
+            const index_t split_length = math::integer_divide_ceil(H * W, num_split);
+
+            std::vector<HostWelford<AccDataType>> partials(static_cast<std::size_t>(N) * G *
+                                                           num_split);
+
+            auto f_partial = [&](index_t n, index_t g, index_t isplit) {
+                const index_t hw_begin = std::min(isplit * split_length, H * W);
+                const index_t hw_end   = std::min(hw_begin + split_length, H * W);
+
+                auto& welford =
+                    partials[(static_cast<std::size_t>(n) * G + g) * num_split + isplit];
+
+                for(index_t hw = hw_begin; hw < hw_end; ++hw)
                 {
-                    AccDataType mean_val = type_convert<AccDataType>(0.0f);
-                    AccDataType var_val  = type_convert<AccDataType>(0.0f);
-                    int32_t curr_count   = 0;
+                    const std::size_t offset = n * x_strides[0] + (hw / W) * x_strides[1] +
+                                               (hw % W) * x_strides[2] + g * x_strides[3];
 
-                    for(int h = 0; h < H; ++h)
-                    {
-                        for(int w = 0; w < W; ++w)
-                        {
-                            for(int c = 0; c < C; ++c)
-                            {
-                                curr_count++;
-                                AccDataType x = type_convert<AccDataType>(arg.x_(n, h, w, g, c));
-                                AccDataType delta = x - mean_val;
-                                mean_val += delta / curr_count;
-                                AccDataType delta2 = x - mean_val;
-                                var_val += delta * delta2;
-                            }
-                        }
-                    }
+                    host_welford_accumulate(welford, &arg.x_.mData[offset], C, x_strides[4]);
+                }
+            };
+
+            make_ParallelTensorFunctor(f_partial, N, G, num_split)(num_thread);
+
+            // merge the partials in slice order (Chan), then fold gamma and rstd into a per
+            // (n, g, c) scale: y = (x - mean) * scale + beta. Centering before the scale keeps
+            // the result accurate when |mean| is large against the standard deviation, which
+            // x * scale + (beta - mean * scale) is not
+            std::vector<AccDataType> mean(static_cast<std::size_t>(N) * G);
+            std::vector<AccDataType> scale(static_cast<std::size_t>(N) * G * C);
+
+            auto f_scale = [&](index_t n, index_t g) {
+                const std::size_t ng = static_cast<std::size_t>(n) * G + g;
 
-                    mean(n, g) = mean_val;
-                    var(n, g)  = var_val / curr_count;
+                HostWelford<AccDataType> welford;
+
+                for(index_t isplit = 0; isplit < num_split; ++isplit)
+                {
+                    welford.Merge(partials[ng * num_split + isplit]);
                 }
-            }
 
-            // Normalization
-            for(int n = 0; n < N; ++n)
-            {
-                for(int h = 0; h < H; ++h)
+                mean[ng] = welford.GetMean();
+
+                const AccDataType rstd =
+                    type_convert<AccDataType>(1.0f) /
+                    ck::math::sqrt(arg.epsilon_ + welford.GetVariance());
+
+                for(index_t c = 0; c < C; ++c)
                 {
-                    for(int w = 0; w < W; ++w)
-                    {
-                        for(int g = 0; g < G; ++g)
+                    const AccDataType gamma = type_convert<AccDataType>(
+                        arg.gamma_.mData[g * gamma_strides[0] + c * gamma_strides[1]]);
+
+                    scale[ng * C + c] = gamma * rstd;
+                }
+            };
+
+            make_ParallelTensorFunctor(f_scale, N, G)(num_thread);
+
+            // normalization: subtract, multiply-add sweep over contiguous C
+            auto f_normalize = [&](index_t n, index_t h, index_t w) {
+                for(index_t g = 0; g < G; ++g)
+                {
+                    const std::size_t x_offset = n * x_strides[0] + h * x_strides[1] +
+                                                 w * x_strides[2] + g * x_strides[3];
+                    const std::size_t y_offset = n * y_strides[0] + h * y_strides[1] +
+                                                 w * y_strides[2] + g * y_strides[3];
+
+                    const std::size_t ng = static_cast<std::size_t>(n) * G + g;
+
+                    const XDataType* p_x       = &arg.x_.mData[x_offset];
+                    YDataType* p_y             = &arg.y_.mData[y_offset];
+                    const AccDataType v_mean   = mean[ng];
+                    const AccDataType* p_scale = &scale[ng * C];
+                    const BetaDataType* p_beta = &arg.beta_.mData[g * beta_strides[0]];
+
+                    auto normalize = [&](auto x_stride, auto y_stride) {
+                        for(index_t c = 0; c < C; ++c)
                         {
-                            for(int c = 0; c < C; ++c)
-                            {
-                                AccDataType x = type_convert<AccDataType>(arg.x_(n, h, w, g, c));
-                                AccDataType gamma    = type_convert<AccDataType>(arg.gamma_(g, c));
-                                AccDataType beta     = type_convert<AccDataType>(arg.beta_(g, c));
-                                AccDataType mean_val = type_convert<AccDataType>(mean(n, g));
-                                AccDataType var_val  = type_convert<AccDataType>(var(n, g));
-                                AccDataType y        = gamma * (x - mean_val) /
-                                                    ck::math::sqrt(arg.epsilon_ + var_val) +
-                                                beta;
-                                arg.acc_elementwise_op_(y, y);
-                                arg.y_(n, h, w, g, c) = type_convert<YDataType>(y);
-                            }
+                            AccDataType y =
+                                (type_convert<AccDataType>(p_x[c * x_stride]) - v_mean) *
+                                    p_scale[c] +
+                                type_convert<AccDataType>(p_beta[c * beta_strides[1]]);
+
+                            arg.acc_elementwise_op_(y, y);
+
+                            p_y[c * y_stride] = type_convert<YDataType>(y);
                         }
+                    };
+
+                    if(x_strides[4] == 1 && y_strides[4] == 1)
+                    {
+                        normalize(Number<1>{}, Number<1>{});
+                    }
+                    else
+                    {
+                        normalize(x_strides[4], y_strides[4]);
                     }
                 }
-            }
+            };
+
+            make_ParallelTensorFunctor(f_normalize, N, H, W)(num_thread);
 
             return 0;
         }
@@ -3,19 +3,26 @@
 
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <sstream>
+#include <thread>
 #include <vector>
 #include <algorithm>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_welford.hpp"
 
 namespace ck {
 namespace tensor_operation {
 namespace host {
 
+// Normalizes x over its NumReduceDim trailing dims:
+//   y = acc_op((x - mean) / sqrt(var + epsilon) * gamma + beta)
+// gamma and beta are indexed by the reduce dims only; they are either NumReduceDim-dimensional
+// tensors or Rank-dimensional ones whose trailing NumReduceDim dims are used.
 template <typename XDataType,
           typename GammaDataType,
           typename BetaDataType,
@@ -26,16 +33,17 @@ template <typename XDataType,
           index_t NumReduceDim>
 struct ReferenceLayernorm : public device::BaseOperator
 {
-    // TODO - support generic layernorm
-    static_assert((Rank == 2 && NumReduceDim == 1), "Only support 2D version so far");
+    static_assert(NumReduceDim >= 1 && NumReduceDim <= Rank, "wrong! invalid NumReduceDim");
+
+    static constexpr index_t NumInvariantDim = Rank - NumReduceDim;
 
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const Tensor<XDataType>& x_m_n,
-                 const Tensor<GammaDataType>& gamma_n,
-                 const Tensor<BetaDataType>& beta_n,
-                 Tensor<YDataType>& y_m_n,
+        Argument(TensorView<const XDataType> x_m_n,
+                 TensorView<const GammaDataType> gamma_n,
+                 TensorView<const BetaDataType> beta_n,
+                 TensorView<YDataType> y_m_n,
                  AccElementwiseOperation acc_elementwise_op,
                  const std::vector<index_t> lengths,
                  const std::vector<index_t> reduceDims,
@@ -51,10 +59,10 @@ struct ReferenceLayernorm : public device::BaseOperator
         {
         }
 
-        const Tensor<XDataType> x_m_n_;
-        const Tensor<XDataType> gamma_n_;
-        const Tensor<XDataType> beta_n_;
-        Tensor<YDataType>& y_m_n_;
+        TensorView<const XDataType> x_m_n_;
+        TensorView<const GammaDataType> gamma_n_;
+        TensorView<const BetaDataType> beta_n_;
+        TensorView<YDataType> y_m_n_;
         AccElementwiseOperation acc_elementwise_op_;
         std::vector<index_t> lengths_;
         std::vector<index_t> reduceDims_;
@@ -64,44 +72,134 @@ struct ReferenceLayernorm : public device::BaseOperator
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
+        // Rows (indices of the invariant dims) are processed in parallel. Each row makes one
+        // Welford pass over x for mean and variance and one pass writing y.
         float Run(const Argument& arg)
         {
-            int M = arg.lengths_[0];
-            int N = arg.lengths_[1];
+            const auto& lengths   = arg.x_m_n_.mDesc.GetLengths();
+            const auto& x_strides = arg.x_m_n_.mDesc.GetStrides();
+            const auto& y_strides = arg.y_m_n_.mDesc.GetStrides();
 
-            Tensor<AccDataType> mean({M});
-            Tensor<AccDataType> var({M});
+            // gamma / beta strides in x's dimension order, zero along the invariant dims
+            auto get_param_strides = [](const auto& tensor) {
+                const auto& strides = tensor.mDesc.GetStrides();
 
-            for(int m = 0; m < M; ++m)
-            {
-                mean(m) = 0;
-                var(m)  = 0;
+                std::array<std::size_t, Rank> param_strides{};
+
+                for(index_t i = 0; i < NumReduceDim; ++i)
+                {
+                    param_strides[NumInvariantDim + i] = strides[strides.size() - NumReduceDim + i];
+                }
 
-                for(int n = 0; n < N; ++n)
+                return param_strides;
+            };
+
+            const auto gamma_strides = get_param_strides(arg.gamma_n_);
+            const auto beta_strides  = get_param_strides(arg.beta_n_);
+
+            // offset of the flat index i over dims [dim_begin, dim_end), last dim fastest
+            auto get_offset = [&](const auto& strides,
+                                  std::size_t i,
+                                  index_t dim_begin,
+                                  index_t dim_end) {
+                std::size_t offset = 0;
+
+                for(index_t dim = dim_end - 1; dim >= dim_begin; --dim)
                 {
-                    auto x_val = ck::type_convert<AccDataType>(arg.x_m_n_(m, n));
-                    mean(m) += x_val;
-                    var(m) += x_val * x_val;
+                    offset += (i % lengths[dim]) * strides[dim];
+                    i /= lengths[dim];
                 }
 
-                mean(m) = mean(m) / N;
-                var(m)  = (var(m) / N) - (mean(m) * mean(m));
+                return offset;
+            };
+
+            std::size_t num_row = 1;
+
+            for(index_t dim = 0; dim < NumInvariantDim; ++dim)
+            {
+                num_row *= lengths[dim];
             }
 
-            for(int m = 0; m < M; ++m)
+            // the last reduce dim is streamed; reduce dims that are packed in x are folded into
+            // it for the statistics pass
+            const index_t inner_length = lengths[Rank - 1];
+
+            index_t x_inner_length = inner_length;
+            index_t x_inner_dim    = Rank - 1;
+
+            while(x_inner_dim > NumInvariantDim &&
+                  x_strides[x_inner_dim - 1] == x_strides[x_inner_dim] * lengths[x_inner_dim])
             {
-                AccDataType divisor =
-                    static_cast<AccDataType>(1) / ck::math::sqrt(var(m) + arg.epsilon_);
+                --x_inner_dim;
+                x_inner_length *= lengths[x_inner_dim];
+            }
+
+            std::size_t num_x_outer = 1;
+            std::size_t num_outer   = 1;
+
+            for(index_t dim = NumInvariantDim; dim < Rank - 1; ++dim)
+            {
+                num_outer *= lengths[dim];
+
+                if(dim < x_inner_dim)
+                    num_x_outer *= lengths[dim];
+            }
 
-                for(int n = 0; n < N; ++n)
+            auto f_row = [&](std::size_t row) {
+                const std::size_t x_row_offset = get_offset(x_strides, row, 0, NumInvariantDim);
+                const std::size_t y_row_offset = get_offset(y_strides, row, 0, NumInvariantDim);
+
+                HostWelford<AccDataType> welford;
+
+                for(std::size_t outer = 0; outer < num_x_outer; ++outer)
                 {
-                    auto x_val = ck::type_convert<AccDataType>(arg.x_m_n_(m, n));
-                    auto y_val = (x_val - mean(m)) * divisor;
-                    y_val      = (y_val * arg.gamma_n_(n)) + arg.beta_n_(n);
-                    arg.acc_elementwise_op_(y_val, y_val);
-                    arg.y_m_n_(m, n) = ck::type_convert<YDataType>(y_val);
+                    const std::size_t x_offset =
+                        x_row_offset + get_offset(x_strides, outer, NumInvariantDim, x_inner_dim);
+
+                    host_welford_accumulate(welford,
+                                            &arg.x_m_n_.mData[x_offset],
+                                            x_inner_length,
+                                            x_strides[Rank - 1]);
                 }
-            }
+
+                const AccDataType mean = welford.GetMean();
+                const AccDataType divisor =
+                    static_cast<AccDataType>(1) /
+                    ck::math::sqrt(welford.GetVariance() + arg.epsilon_);
+
+                for(std::size_t outer = 0; outer < num_outer; ++outer)
+                {
+                    const std::size_t x_offset =
+                        x_row_offset + get_offset(x_strides, outer, NumInvariantDim, Rank - 1);
+                    const std::size_t y_offset =
+                        y_row_offset + get_offset(y_strides, outer, NumInvariantDim, Rank - 1);
+                    const std::size_t gamma_offset =
+                        get_offset(gamma_strides, outer, NumInvariantDim, Rank - 1);
+                    const std::size_t beta_offset =
+                        get_offset(beta_strides, outer, NumInvariantDim, Rank - 1);
+
+                    for(index_t i = 0; i < inner_length; ++i)
+                    {
+                        const auto x_val = ck::type_convert<AccDataType>(
+                            arg.x_m_n_.mData[x_offset + i * x_strides[Rank - 1]]);
+                        const auto gamma_val = ck::type_convert<AccDataType>(
+                            arg.gamma_n_.mData[gamma_offset + i * gamma_strides[Rank - 1]]);
+                        const auto beta_val = ck::type_convert<AccDataType>(
+                            arg.beta_n_.mData[beta_offset + i * beta_strides[Rank - 1]]);
+
+                        auto y_val = (x_val - mean) * divisor;
+
+                        y_val = (y_val * gamma_val) + beta_val;
+
+                        arg.acc_elementwise_op_(y_val, y_val);
+
+                        arg.y_m_n_.mData[y_offset + i * y_strides[Rank - 1]] =
+                            ck::type_convert<YDataType>(y_val);
+                    }
+                }
+            };
+
+            make_ParallelTensorFunctor(f_row, num_row)(std::thread::hardware_concurrency());
 
             return 0;
         }
@@ -123,23 +221,31 @@ struct ReferenceLayernorm : public device::BaseOperator
     {
         const Argument* p_arg_ = dynamic_cast<const Argument*>(p_arg);
 
-        // TODO - support generic layernorm
-        if(p_arg_->lengths_.size() != 2)
+        if(p_arg_->lengths_.size() != Rank || p_arg_->reduceDims_.size() != NumReduceDim)
             return false;
 
-        if(p_arg_->reduceDims_.size() != 1)
-            return false;
+        // the reduce dims have to be the trailing ones
+        std::vector<index_t> reduce_dims = p_arg_->reduceDims_;
+
+        std::sort(reduce_dims.begin(), reduce_dims.end());
+
+        for(index_t i = 0; i < NumReduceDim; ++i)
+        {
+            if(reduce_dims[i] != NumInvariantDim + i)
+                return false;
+        }
 
-        if(p_arg_->reduceDims_[0] != 1)
+        if(p_arg_->gamma_n_.mDesc.GetNumOfDimension() < NumReduceDim ||
+           p_arg_->beta_n_.mDesc.GetNumOfDimension() < NumReduceDim)
             return false;
 
         return true;
     }
 
-    static auto MakeArgument(const Tensor<XDataType>& x_m_n,
-                             const Tensor<GammaDataType>& gamma_n,
-                             const Tensor<BetaDataType>& beta_n,
-                             Tensor<YDataType>& y_m_n,
+    static auto MakeArgument(TensorView<const XDataType> x_m_n,
+                             TensorView<const GammaDataType> gamma_n,
+                             TensorView<const BetaDataType> beta_n,
+                             TensorView<YDataType> y_m_n,
                              AccElementwiseOperation acc_elementwise_op,
                              const std::vector<index_t> lengths,
                              const std::vector<index_t> reduceDims,
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_permute.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Reference implementation for permute.
+//
+// @paragraph
+//             out[i_axes[0], i_axes[1], ...] = element_op(in[i0, i1, ...]): dimension d of the
+//             output is dimension axes[d] of the input. With the identity axes, this converts
+//             between two layouts of the same lengths. Runs on host_permute().
+//
+template <typename InDataType, typename OutDataType, typename ElementwiseOperation>
+struct ReferencePermute : public device::BaseOperator
+{
+    // Argument
+    struct Argument : public device::BaseArgument
+    {
+        Argument(const Tensor<InDataType>& in,
+                 Tensor<OutDataType>& out,
+                 std::vector<index_t> axes,
+                 ElementwiseOperation element_op)
+            : in_{in}, out_{out}, axes_{axes}, element_op_{element_op}
+        {
+        }
+
+        const Tensor<InDataType>& in_;
+        Tensor<OutDataType>& out_;
+
+        std::vector<index_t> axes_;
+
+        ElementwiseOperation element_op_;
+    };
+
+    static bool IsValidArgument(const Argument& arg)
+    {
+        const auto& in_lengths  = arg.in_.mDesc.GetLengths();
+        const auto& out_lengths = arg.out_.mDesc.GetLengths();
+
+        if(in_lengths.size() != out_lengths.size() || arg.axes_.size() != in_lengths.size())
+            return false;
+
+        std::vector<bool> is_used(in_lengths.size(), false);
+
+        for(std::size_t d = 0; d < arg.axes_.size(); ++d)
+        {
+            const index_t axis = arg.axes_[d];
+
+            if(axis < 0 || axis >= static_cast<index_t>(in_lengths.size()) || is_used[axis] ||
+               out_lengths[d] != in_lengths[axis])
+                return false;
+
+            is_used[axis] = true;
+        }
+
+        return true;
+    }
+
+    // Invoker
+    struct Invoker : public device::BaseInvoker
+    {
+        using Argument = ReferencePermute::Argument;
+
+        float Run(const Argument& arg)
+        {
+            if(!IsValidArgument(arg))
+            {
+                throw std::runtime_error("wrong! inconsistent dimension");
+            }
+
+            const auto& in_lengths  = arg.in_.mDesc.GetLengths();
+            const auto& out_strides = arg.out_.mDesc.GetStrides();
+
+            // output strides in input dimension order
+            std::vector<std::size_t> out_strides_in_order(out_strides.size());
+
+            for(std::size_t d = 0; d < arg.axes_.size(); ++d)
+                out_strides_in_order[arg.axes_[d]] = out_strides[d];
+
+            const HostPermuteDescriptor desc{
+                std::vector<index_t>(in_lengths.begin(), in_lengths.end()),
+                arg.in_.mDesc.GetStrides(),
+                out_strides_in_order};
+
+            host_permute(desc,
+                         arg.in_.mData.data(),
+                         arg.out_.mData.data(),
+                         arg.element_op_,
+                         std::thread::hardware_concurrency());
+
+            return 0;
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter()
+    {
+        // TODO: properly implement this check
+        return true;
+    }
+
+    bool IsSupportedArgument(const device::BaseArgument* p_arg) override
+    {
+        return IsValidArgument(*dynamic_cast<const Argument*>(p_arg));
+    }
+
+    static auto MakeArgument(const Tensor<InDataType>& in,
+                             Tensor<OutDataType>& out,
+                             std::vector<index_t> axes,
+                             ElementwiseOperation element_op)
+    {
+        return Argument{in, out, axes, element_op};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferencePermute"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Reference implementation for backward max pooling.
+//
+// @paragraph
+//             Scatters dout through the indices output by ReferencePoolFwd (the position within
+//             the window, z * Y * X + y * X + x): din[n, c, di, hi, wi] is the sum of dout over
+//             the windows whose selected element it is, zero elsewhere. Windows with a negative
+//             index selected no element and pass no gradient on. Descriptors are in
+//             [N, C, Di, Hi, Wi] / [N, C, Do, Ho, Wo] order, the physical layout is irrelevant.
+//
+// @paragraph
+//             Each (n, c) plane is owned by one task and accumulated in AccDataType in output
+//             order, so overlapping windows need no atomics and the result is deterministic.
+//
+template <ck::index_t NDimSpatial,
+          typename DOutDataType,
+          typename IndexDataType,
+          typename AccDataType,
+          typename DInDataType,
+          typename std::enable_if<NDimSpatial >= 1 && NDimSpatial <= 3, bool>::type = false>
+struct ReferencePoolBwd : public device::BaseOperator
+{
+    // Argument
+    struct Argument : public device::BaseArgument
+    {
+        Argument(const Tensor<DOutDataType>& dout,
+                 const Tensor<IndexDataType>& indices,
+                 Tensor<DInDataType>& din,
+                 std::vector<ck::index_t> window_spatial_lengths,
+                 std::vector<ck::index_t> window_strides,
+                 std::vector<ck::index_t> input_left_pads,
+                 std::vector<ck::index_t> input_right_pads)
+            : dout_{dout},
+              indices_{indices},
+              din_{din},
+              window_spatial_lengths_{window_spatial_lengths},
+              window_strides_{window_strides},
+              in_left_pads_{input_left_pads},
+              in_right_pads_{input_right_pads}
+        {
+        }
+
+        const Tensor<DOutDataType>& dout_;
+        const Tensor<IndexDataType>& indices_;
+        Tensor<DInDataType>& din_;
+
+        std::vector<index_t> window_spatial_lengths_;
+        std::vector<index_t> window_strides_;
+        std::vector<index_t> in_left_pads_;
+        std::vector<index_t> in_right_pads_;
+    };
+
+    struct Invoker : public device::BaseInvoker
+    {
+        using Argument = ReferencePoolBwd::Argument;
+
+        float Run(const Argument& arg)
+        {
+            if(!(arg.dout_.GetNumOfDimension() == NDimSpatial + 2 &&
+                 arg.indices_.GetNumOfDimension() == NDimSpatial + 2 &&
+                 arg.din_.GetNumOfDimension() == NDimSpatial + 2 &&
+                 arg.window_spatial_lengths_.size() == NDimSpatial &&
+                 arg.window_strides_.size() == NDimSpatial &&
+                 arg.in_left_pads_.size() == NDimSpatial))
+            {
+                throw std::runtime_error("wrong! inconsistent dimension");
+            }
+
+            const auto& din_lengths     = arg.din_.mDesc.GetLengths();
+            const auto& din_strides     = arg.din_.mDesc.GetStrides();
+            const auto& dout_lengths    = arg.dout_.mDesc.GetLengths();
+            const auto& dout_strides    = arg.dout_.mDesc.GetStrides();
+            const auto& indices_strides = arg.indices_.mDesc.GetStrides();
+
+            // the spatial dimensions as (D, H, W), the missing leading ones of length 1
+            std::array<index_t, 3> in_lengths{1, 1, 1};
+            std::array<index_t, 3> out_lengths{1, 1, 1};
+            std::array<index_t, 3> window_lengths{1, 1, 1};
+            std::array<index_t, 3> window_strides{1, 1, 1};
+            std::array<index_t, 3> left_pads{0, 0, 0};
+            std::array<std::size_t, 3> din_spatial_strides{0, 0, 0};
+            std::array<std::size_t, 3> dout_spatial_strides{0, 0, 0};
+            std::array<std::size_t, 3> indices_spatial_strides{0, 0, 0};
+
+            for(index_t j = 0; j < NDimSpatial; ++j)
+            {
+                const index_t i = j + (3 - NDimSpatial);
+
+                in_lengths[i]              = din_lengths[j + 2];
+                out_lengths[i]             = dout_lengths[j + 2];
+                window_lengths[i]          = arg.window_spatial_lengths_[j];
+                window_strides[i]          = arg.window_strides_[j];
+                left_pads[i]               = arg.in_left_pads_[j];
+                din_spatial_strides[i]     = din_strides[j + 2];
+                dout_spatial_strides[i]    = dout_strides[j + 2];
+                indices_spatial_strides[i] = indices_strides[j + 2];
+            }
+
+            auto f_plane = [&](std::size_t n, std::size_t c) {
+                std::vector<AccDataType> din_plane(
+                    static_cast<std::size_t>(in_lengths[0]) * in_lengths[1] * in_lengths[2]);
+
+                const DOutDataType* p_dout =
+                    &arg.dout_.mData[n * dout_strides[0] + c * dout_strides[1]];
+                const IndexDataType* p_indices =
+                    &arg.indices_.mData[n * indices_strides[0] + c * indices_strides[1]];
+
+                for(index_t d = 0; d < out_lengths[0]; ++d)
+                    for(index_t h = 0; h < out_lengths[1]; ++h)
+                        for(index_t w = 0; w < out_lengths[2]; ++w)
+                        {
+                            const index_t index = static_cast<index_t>(
+                                p_indices[d * indices_spatial_strides[0] +
+                                          h * indices_spatial_strides[1] +
+                                          w * indices_spatial_strides[2]]);
+
+                            if(index < 0)
+                                continue;
+
+                            const index_t z = index / (window_lengths[1] * window_lengths[2]);
+                            const index_t y = index / window_lengths[2] % window_lengths[1];
+                            const index_t x = index % window_lengths[2];
+
+                            const index_t di = d * window_strides[0] - left_pads[0] + z;
+                            const index_t hi = h * window_strides[1] - left_pads[1] + y;
+                            const index_t wi = w * window_strides[2] - left_pads[2] + x;
+
+                            // an index that does not point into the input is not one of
+                            // ReferencePoolFwd, ignore it as well
+                            if(di < 0 || di >= in_lengths[0] || hi < 0 || hi >= in_lengths[1] ||
+                               wi < 0 || wi >= in_lengths[2])
+                                continue;
+
+                            din_plane[(di * in_lengths[1] + hi) * in_lengths[2] + wi] +=
+                                type_convert<AccDataType>(
+                                    p_dout[d * dout_spatial_strides[0] +
+                                           h * dout_spatial_strides[1] +
+                                           w * dout_spatial_strides[2]]);
+                        }
+
+                DInDataType* p_din = &arg.din_.mData[n * din_strides[0] + c * din_strides[1]];
+
+                std::size_t i = 0;
+
+                for(index_t d = 0; d < in_lengths[0]; ++d)
+                    for(index_t h = 0; h < in_lengths[1]; ++h)
+                        for(index_t w = 0; w < in_lengths[2]; ++w)
+                        {
+                            p_din[d * din_spatial_strides[0] + h * din_spatial_strides[1] +
+                                  w * din_spatial_strides[2]] =
+                                type_convert<DInDataType>(din_plane[i++]);
+                        }
+            };
+
+            make_ParallelTensorFunctor(f_plane, din_lengths[0], din_lengths[1])(
+                std::thread::hardware_concurrency());
+
+            return 0;
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter()
+    {
+        // TODO: properly implement this check
+        return true;
+    }
+
+    bool IsSupportedArgument(const device::BaseArgument*) override
+    {
+        return NDimSpatial >= 1 && NDimSpatial <= 3;
+    }
+
+    static auto MakeArgument(const Tensor<DOutDataType>& dout,
+                             const Tensor<IndexDataType>& indices,
+                             Tensor<DInDataType>& din,
+                             std::vector<ck::index_t> window_spatial_lengths,
+                             std::vector<ck::index_t> window_strides,
+                             std::vector<ck::index_t> input_left_pads,
+                             std::vector<ck::index_t> input_right_pads)
+    {
+        return Argument{dout,
+                        indices,
+                        din,
+                        window_spatial_lengths,
+                        window_strides,
+                        input_left_pads,
+                        input_right_pads};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferencePoolBwd"
+            << "<"
+            << NDimSpatial
+            << ">"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,402 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/reduction_enums.hpp"
+#include "ck/utility/reduction_functions_accumulate.hpp"
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/tensor_operation/gpu/device/reduction_operator_mapping.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_sliding_window.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Reference implementation for forward pooling.
+//
+// @paragraph
+//             Tensor descriptors in [N, C, Di, Hi, Wi] / [N, C, Do, Ho, Wo] order, for 1, 2 or 3
+//             spatial dimensions; the physical layout is irrelevant. Windows are clamped to the
+//             input, padding elements take no part, and the average divides by the full window
+//             size.
+//
+// @paragraph
+//             Each (n, c) plane is reduced with separable sliding-window passes, W first, then H
+//             and D: a monotonic deque for MAX / MIN / AMAX and block running sums for AVG, so the
+//             cost per output does not depend on the window size. The output index is the
+//             position within the window, z * Y * X + y * X + x, of the first maximum in scan
+//             order (of the last NaN with PropagateNan), as a sequential scan would report it.
+//             A window without an eligible element, all padding or all NaN without PropagateNan,
+//             outputs the identity value and index -1, which ReferencePoolBwd skips. The device
+//             kernels leave the index of such a window at 0, so comparisons against them have to
+//             mask it.
+//
+template <ck::index_t NDimSpatial,
+          typename InDataType,
+          typename OutDataType,
+          typename AccDataType,
+          typename IndexDataType,
+          ReduceTensorOp ReduceOpId,
+          bool PropagateNan,
+          bool OutputIndex,
+          typename std::enable_if<NDimSpatial >= 1 && NDimSpatial <= 3, bool>::type = false>
+struct ReferencePoolFwd : public device::BaseOperator
+{
+    using ReduceOperation = typename reduce_binary_operator<ReduceOpId>::opType;
+
+    // MAX, MIN and AMAX select an input element, the others add them up
+    static constexpr bool IsSelection = reduce_binary_operator<ReduceOpId>::indexable;
+
+    static_assert(IsSelection || ReduceOpId == ReduceTensorOp::AVG,
+                  "wrong! only MAX, MIN, AMAX and AVG pooling are supported");
+    static_assert(IsSelection || !OutputIndex, "wrong! indices are only output by MAX, MIN, AMAX");
+
+    // Argument
+    struct Argument : public device::BaseArgument
+    {
+        Argument(const Tensor<InDataType>& input,
+                 Tensor<OutDataType>& output,
+                 Tensor<IndexDataType>& output_indices,
+                 std::vector<ck::index_t> window_spatial_lengths,
+                 std::vector<ck::index_t> window_strides,
+                 std::vector<ck::index_t> input_left_pads,
+                 std::vector<ck::index_t> input_right_pads)
+            : input_{input},
+              output_{output},
+              output_indices_{output_indices},
+              window_spatial_lengths_{window_spatial_lengths},
+              window_strides_{window_strides},
+              in_left_pads_{input_left_pads},
+              in_right_pads_{input_right_pads}
+        {
+        }
+
+        const Tensor<InDataType>& input_;
+        Tensor<OutDataType>& output_;
+        Tensor<IndexDataType>& output_indices_;
+
+        std::vector<index_t> window_spatial_lengths_;
+        std::vector<index_t> window_strides_;
+        std::vector<index_t> in_left_pads_;
+        std::vector<index_t> in_right_pads_;
+    };
+
+    struct Invoker : public device::BaseInvoker
+    {
+        using Argument = ReferencePoolFwd::Argument;
+
+        // the sliding-window passes advance by the window length and the stride
+        static bool IsValidWindow(const Argument& arg)
+        {
+            for(index_t i = 0; i < NDimSpatial; ++i)
+            {
+                if(arg.window_spatial_lengths_[i] <= 0 || arg.window_strides_[i] <= 0)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        float Run(const Argument& arg)
+        {
+            if(!(arg.input_.GetNumOfDimension() == NDimSpatial + 2 &&
+                 arg.output_.GetNumOfDimension() == NDimSpatial + 2 &&
+                 arg.window_spatial_lengths_.size() == NDimSpatial &&
+                 arg.window_strides_.size() == NDimSpatial &&
+                 arg.in_left_pads_.size() == NDimSpatial))
+            {
+                throw std::runtime_error("wrong! inconsistent dimension");
+            }
+
+            if(!IsValidWindow(arg))
+            {
+                throw std::runtime_error("wrong! window lengths and strides must be positive");
+            }
+
+            using InAccumulation =
+                ck::detail::AccumulateWithNanCheck<PropagateNan, ReduceOperation, AccDataType>;
+            using IndexAccumulation = ck::detail::AccumulateWithIndexAndNanCheck<PropagateNan,
+                                                                                  ReduceOperation,
+                                                                                  AccDataType,
+                                                                                  IndexDataType>;
+
+            const auto& in_lengths  = arg.input_.mDesc.GetLengths();
+            const auto& in_strides  = arg.input_.mDesc.GetStrides();
+            const auto& out_lengths = arg.output_.mDesc.GetLengths();
+            const auto& out_strides = arg.output_.mDesc.GetStrides();
+
+            // only read when OutputIndex, the index tensor may be left empty otherwise
+            const auto& index_tensor_strides = arg.output_indices_.mDesc.GetStrides();
+
+            // the spatial dimensions as (D, H, W), the missing leading ones of length 1
+            std::array<HostSlidingWindow, 3> windows;
+            std::array<std::size_t, 3> in_spatial_strides;
+            std::array<std::size_t, 3> out_spatial_strides;
+            std::array<std::size_t, 3> index_strides;
+
+            int32_t reduceLength = 1;
+
+            for(index_t i = 0; i < 3; ++i)
+            {
+                const index_t j = i - (3 - NDimSpatial);
+
+                if(j < 0)
+                {
+                    windows[i]             = HostSlidingWindow{1, 1, 1, 1, 0};
+                    in_spatial_strides[i]  = 0;
+                    out_spatial_strides[i] = 0;
+                    index_strides[i]       = 0;
+                    continue;
+                }
+
+                windows[i] = HostSlidingWindow{static_cast<index_t>(in_lengths[j + 2]),
+                                               static_cast<index_t>(out_lengths[j + 2]),
+                                               arg.window_spatial_lengths_[j],
+                                               arg.window_strides_[j],
+                                               arg.in_left_pads_[j]};
+
+                in_spatial_strides[i]  = in_strides[j + 2];
+                out_spatial_strides[i] = out_strides[j + 2];
+                index_strides[i]       = OutputIndex ? index_tensor_strides[j + 2] : 0;
+
+                reduceLength *= arg.window_spatial_lengths_[j];
+            }
+
+            const auto elementwise_ops =
+                reduce_unary_operator<ReduceOpId, true, true>::GetElementwiseOperator(
+                    reduceLength);
+
+            const auto in_elementwise_op  = std::get<0>(elementwise_ops);
+            const auto acc_elementwise_op = std::get<1>(elementwise_ops);
+
+            // large enough for the plane before, after and between the passes, the pads can
+            // make an axis longer
+            std::size_t buffer_size = 1;
+
+            for(const auto& window : windows)
+                buffer_size *= std::max(window.in_length_, window.out_length_);
+
+            auto f_plane = [&](std::size_t n, std::size_t c) {
+                std::vector<AccDataType> src(buffer_size);
+                std::vector<AccDataType> dst(buffer_size);
+                std::vector<index_t> src_index;
+                std::vector<index_t> dst_index;
+
+                std::vector<index_t> deque;
+                std::vector<AccDataType> prefix;
+                std::vector<AccDataType> suffix;
+
+                if constexpr(IsSelection)
+                {
+                    src_index.resize(buffer_size);
+                    dst_index.resize(buffer_size);
+                }
+
+                // gather the plane into a packed [D, H, W] buffer
+                const InDataType* p_in = &arg.input_.mData[n * in_strides[0] + c * in_strides[1]];
+
+                std::size_t i = 0;
+
+                for(index_t d = 0; d < windows[0].in_length_; ++d)
+                    for(index_t h = 0; h < windows[1].in_length_; ++h)
+                        for(index_t w = 0; w < windows[2].in_length_; ++w)
+                        {
+                            AccDataType v = type_convert<AccDataType>(
+                                p_in[d * in_spatial_strides[0] + h * in_spatial_strides[1] +
+                                     w * in_spatial_strides[2]]);
+
+                            in_elementwise_op(v, v);
+
+                            src[i++] = v;
+                        }
+
+                // one window pass per axis, W first, each shrinks its axis to the output length
+                std::array<index_t, 3> lengths{
+                    windows[0].in_length_, windows[1].in_length_, windows[2].in_length_};
+
+                bool has_index    = false;
+                index_t index_scale = 1;
+
+                for(index_t axis = 2; axis >= 0; --axis)
+                {
+                    const auto& window = windows[axis];
+
+                    index_t outer = 1;
+                    index_t inner = 1;
+
+                    for(index_t a = 0; a < axis; ++a)
+                        outer *= lengths[a];
+
+                    for(index_t a = axis + 1; a < 3; ++a)
+                        inner *= lengths[a];
+
+                    for(index_t io = 0; io < outer; ++io)
+                        for(index_t ii = 0; ii < inner; ++ii)
+                        {
+                            const std::size_t in_line  = io * window.in_length_ * inner + ii;
+                            const std::size_t out_line = io * window.out_length_ * inner + ii;
+
+                            if constexpr(IsSelection)
+                            {
+                                host_sliding_window_select<ReduceOperation, PropagateNan>(
+                                    window,
+                                    &src[in_line],
+                                    has_index ? &src_index[in_line] : nullptr,
+                                    inner,
+                                    &dst[out_line],
+                                    &dst_index[out_line],
+                                    inner,
+                                    index_scale,
+                                    deque);
+                            }
+                            else
+                            {
+                                host_sliding_window_sum(window,
+                                                        &src[in_line],
+                                                        inner,
+                                                        &dst[out_line],
+                                                        inner,
+                                                        prefix,
+                                                        suffix);
+                            }
+                        }
+
+                    lengths[axis] = window.out_length_;
+                    has_index     = true;
+                    index_scale *= window.window_length_;
+
+                    std::swap(src, dst);
+                    std::swap(src_index, dst_index);
+                }
+
+                // the window results are folded into the identity as a sequential scan would
+                OutDataType* p_out = &arg.output_.mData[n * out_strides[0] + c * out_strides[1]];
+
+                i = 0;
+
+                for(index_t d = 0; d < lengths[0]; ++d)
+                    for(index_t h = 0; h < lengths[1]; ++h)
+                        for(index_t w = 0; w < lengths[2]; ++w, ++i)
+                        {
+                            auto accuVal =
+                                ReduceOperation::template GetIdentityValue<AccDataType>();
+
+                            const std::size_t out_offset = d * out_spatial_strides[0] +
+                                                           h * out_spatial_strides[1] +
+                                                           w * out_spatial_strides[2];
+
+                            if constexpr(OutputIndex)
+                            {
+                                IndexDataType accuIndex = 0;
+
+                                const auto currIndex = static_cast<IndexDataType>(src_index[i]);
+
+                                IndexAccumulation::Calculate(accuVal, src[i], accuIndex, currIndex);
+
+                                if(src_index[i] < 0)
+                                    accuIndex = static_cast<IndexDataType>(-1);
+
+                                arg.output_indices_.mData[n * index_tensor_strides[0] +
+                                                          c * index_tensor_strides[1] +
+                                                          d * index_strides[0] +
+                                                          h * index_strides[1] +
+                                                          w * index_strides[2]] = accuIndex;
+                            }
+                            else
+                            {
+                                InAccumulation::Calculate(accuVal, src[i]);
+                            }
+
+                            acc_elementwise_op(accuVal, accuVal);
+
+                            p_out[out_offset] = type_convert<OutDataType>(accuVal);
+                        }
+            };
+
+            make_ParallelTensorFunctor(f_plane, out_lengths[0], out_lengths[1])(
+                std::thread::hardware_concurrency());
+
+            return 0;
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter()
+    {
+        // TODO: properly implement this check
+        return true;
+    }
+
+    bool IsSupportedArgument(const device::BaseArgument* p_arg) override
+    {
+        const Argument& arg = *dynamic_cast<const Argument*>(p_arg);
+
+        return NDimSpatial >= 1 && NDimSpatial <= 3 &&
+               arg.window_spatial_lengths_.size() == NDimSpatial &&
+               arg.window_strides_.size() == NDimSpatial && Invoker::IsValidWindow(arg);
+    }
+
+    static auto MakeArgument(const Tensor<InDataType>& input,
+                             Tensor<OutDataType>& output,
+                             Tensor<IndexDataType>& output_indices,
+                             std::vector<ck::index_t> window_spatial_lengths,
+                             std::vector<ck::index_t> window_strides,
+                             std::vector<ck::index_t> input_left_pads,
+                             std::vector<ck::index_t> input_right_pads)
+    {
+        return Argument{input,
+                        output,
+                        output_indices,
+                        window_spatial_lengths,
+                        window_strides,
+                        input_left_pads,
+                        input_right_pads};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferencePoolFwd"
+            << "<"
+            << NDimSpatial << ", "
+            << static_cast<int>(ReduceOpId)
+            << ">"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -14,6 +14,7 @@
 #include "ck/utility/reduction_functions_accumulate.hpp"
 #include "ck/library/utility/host_common_util.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_reduction.hpp"
 #include "ck/tensor_operation/gpu/device/device_reduce.hpp"
 
 namespace ck {
@@ -126,7 +127,22 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
             if constexpr(NumInvariantDim > 0)
                 invariant_index_set_ = get_index_set<NumInvariantDim>(invariant_lengths_);
 
-            reduce_index_set_ = get_index_set<NumReduceDim>(reduce_lengths_);
+            // the reduced elements of each output form one packed run when the reduce dims,
+            // taken in order, are row-major with a unit inner stride; Run() then reads them
+            // straight from in_host_ and reduce_index_set_ is not needed
+            reduce_contiguous_ = in_reduce_strides_[NumReduceDim - 1] == 1;
+
+            for(int j = 0; j + 1 < NumReduceDim; j++)
+                if(in_reduce_strides_[j] != in_reduce_strides_[j + 1] * reduce_lengths_[j + 1])
+                    reduce_contiguous_ = false;
+
+            reduce_total_length_ = 1;
+
+            for(int j = 0; j < NumReduceDim; j++)
+                reduce_total_length_ *= static_cast<std::size_t>(reduce_lengths_[j]);
+
+            if(!reduce_contiguous_)
+                reduce_index_set_ = get_index_set<NumReduceDim>(reduce_lengths_);
 
             alpha_ = type_convert<AccDataType>(alpha);
             beta_  = type_convert<AccDataType>(beta);
@@ -154,6 +170,9 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
 
         std::vector<std::array<index_t, NumInvariantDim>> invariant_index_set_;
         std::vector<std::array<index_t, NumReduceDim>> reduce_index_set_;
+
+        bool reduce_contiguous_;
+        std::size_t reduce_total_length_;
     };
 
     struct Invoker : public device::BaseInvoker
@@ -165,206 +184,129 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
             using ck::float_equal_one;
             using ck::float_equal_zero;
             using ck::type_convert;
-            using ck::host_common::get_index_set;
             using ck::host_common::get_offset_from_index;
 
-            if constexpr(OutputIndex)
-            {
-                using Accumulation = ck::detail::AccumulateWithIndexAndNanCheck<PropagateNan,
-                                                                                ReduceOperation,
-                                                                                AccDataType,
-                                                                                IndexDataType>;
-
-                if constexpr(NumInvariantDim == 0)
-                {
-                    AccDataType accuVal = ReduceOperation::template GetIdentityValue<AccDataType>();
-                    IndexDataType accuIndex = 0;
-
-                    for(std::size_t i = 0; i < arg.reduce_index_set_.size(); i++)
-                    {
-                        auto in_offset = get_offset_from_index<NumReduceDim>(
-                            arg.in_reduce_strides_, arg.reduce_index_set_[i]);
-
-                        auto currVal = type_convert<AccDataType>(arg.in_host_[in_offset]);
-
-                        arg.in_elementwise_op_(currVal, currVal);
-
-                        auto currIndex = static_cast<IndexDataType>(i);
-
-                        Accumulation::Calculate(accuVal, currVal, accuIndex, currIndex);
-                    };
+            using Accumulation =
+                ck::detail::AccumulateWithNanCheck<PropagateNan, ReduceOperation, AccDataType>;
+            using AccumulationWithIndex =
+                ck::detail::AccumulateWithIndexAndNanCheck<PropagateNan,
+                                                           ReduceOperation,
+                                                           AccDataType,
+                                                           IndexDataType>;
 
-                    arg.acc_elementwise_op_(accuVal, accuVal);
-
-                    if(!float_equal_one{}(arg.alpha_))
-                        accuVal *= type_convert<AccDataType>(arg.alpha_);
+            // reduced value and, with OutputIndex, the index of the reduced element it came from
+            struct Partial
+            {
+                AccDataType value_;
+                IndexDataType index_;
+            };
 
-                    if(!float_equal_zero{}(arg.beta_))
-                        accuVal += type_convert<AccDataType>(arg.out_host_[0]) *
-                                   type_convert<AccDataType>(arg.beta_);
+            const std::size_t num_invariant =
+                reduceAllDim ? std::size_t{1} : arg.invariant_index_set_.size();
 
-                    arg.out_host_[0]       = type_convert<OutDataType>(accuVal);
-                    arg.out_index_host_[0] = accuIndex;
-                }
+            auto get_in_invariant_offset = [&](std::size_t iinv) -> std::size_t {
+                if constexpr(reduceAllDim)
+                    return 0;
                 else
-                {
-                    auto thread_reduce_func = [&](auto invariant_index) {
-                        AccDataType accuVal =
-                            ReduceOperation::template GetIdentityValue<AccDataType>();
-                        IndexDataType accuIndex = 0;
-
-                        auto in_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                            arg.in_invariant_strides_, invariant_index);
-
-                        for(std::size_t i = 0; i < arg.reduce_index_set_.size(); i++)
-                        {
-                            auto in_reduce_offset = get_offset_from_index<NumReduceDim>(
-                                arg.in_reduce_strides_, arg.reduce_index_set_[i]);
-
-                            auto currVal = type_convert<AccDataType>(
-                                arg.in_host_[in_invariant_offset + in_reduce_offset]);
-
-                            arg.in_elementwise_op_(currVal, currVal);
-
-                            auto currIndex = static_cast<IndexDataType>(i);
-
-                            Accumulation::Calculate(accuVal, currVal, accuIndex, currIndex);
-                        };
-
-                        arg.acc_elementwise_op_(accuVal, accuVal);
-
-                        if(!float_equal_one{}(arg.alpha_))
-                            accuVal *= type_convert<AccDataType>(arg.alpha_);
-
-                        auto dst_offset = get_offset_from_index<NumInvariantDim>(arg.outStrides_,
-                                                                                 invariant_index);
-
-                        if(!float_equal_zero{}(arg.beta_))
-                            accuVal += type_convert<AccDataType>(arg.out_host_[dst_offset]) *
-                                       type_convert<AccDataType>(arg.beta_);
+                    return get_offset_from_index<NumInvariantDim>(arg.in_invariant_strides_,
+                                                                  arg.invariant_index_set_[iinv]);
+            };
 
-                        arg.out_host_[dst_offset]       = type_convert<OutDataType>(accuVal);
-                        arg.out_index_host_[dst_offset] = accuIndex;
-                    };
+            auto get_dst_offset = [&](std::size_t iinv) -> std::size_t {
+                if constexpr(reduceAllDim)
+                    return 0;
+                else
+                    return get_offset_from_index<NumInvariantDim>(arg.outStrides_,
+                                                                  arg.invariant_index_set_[iinv]);
+            };
 
-                    std::size_t num_thread = std::thread::hardware_concurrency();
+            auto reduce_split = [&](std::size_t iinv, std::size_t begin, std::size_t end) {
+                Partial partial{ReduceOperation::template GetIdentityValue<AccDataType>(), 0};
 
-                    std::size_t work_per_thread =
-                        (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
+                const std::size_t in_invariant_offset = get_in_invariant_offset(iinv);
 
-                    std::vector<joinable_thread> threads(num_thread);
+                if(arg.reduce_contiguous_)
+                {
+                    const InDataType* p_in = arg.in_host_ + in_invariant_offset + begin;
 
-                    for(std::size_t it = 0; it < num_thread; ++it)
+                    if constexpr(OutputIndex)
                     {
-                        std::size_t i_begin = it * work_per_thread;
-                        std::size_t i_end =
-                            std::min((it + 1) * work_per_thread, arg.invariant_index_set_.size());
-
-                        auto f = [=] {
-                            for(std::size_t i = i_begin; i < i_end; i++)
-                            {
-                                thread_reduce_func(arg.invariant_index_set_[i]);
-                            }
-                        };
-
-                        threads[it] = joinable_thread(f);
+                        host_reduce_contiguous_with_index<PropagateNan, ReduceOperation>(
+                            p_in,
+                            end - begin,
+                            arg.in_elementwise_op_,
+                            partial.value_,
+                            partial.index_);
+
+                        partial.index_ += static_cast<IndexDataType>(begin);
                     }
-                };
-            }
-            else
-            {
-                using Accumulation =
-                    ck::detail::AccumulateWithNanCheck<PropagateNan, ReduceOperation, AccDataType>;
-
-                if constexpr(NumInvariantDim == 0)
-                {
-                    AccDataType accuVal = ReduceOperation::template GetIdentityValue<AccDataType>();
-
-                    for(const auto& reduce_index : arg.reduce_index_set_)
+                    else
                     {
-                        auto in_offset = get_offset_from_index<NumReduceDim>(arg.in_reduce_strides_,
-                                                                             reduce_index);
-
-                        auto currVal = type_convert<AccDataType>(arg.in_host_[in_offset]);
-
-                        arg.in_elementwise_op_(currVal, currVal);
-
-                        Accumulation::Calculate(accuVal, currVal);
-                    };
-
-                    arg.acc_elementwise_op_(accuVal, accuVal);
-
-                    if(!float_equal_one{}(arg.alpha_))
-                        accuVal *= type_convert<AccDataType>(arg.alpha_);
-
-                    if(!float_equal_zero{}(arg.beta_))
-                        accuVal += type_convert<AccDataType>(arg.out_host_[0]) *
-                                   type_convert<AccDataType>(arg.beta_);
+                        partial.value_ =
+                            host_reduce_contiguous<PropagateNan, ReduceOperation, AccDataType>(
+                                p_in, end - begin, arg.in_elementwise_op_);
+                    }
 
-                    arg.out_host_[0] = type_convert<OutDataType>(accuVal);
+                    return partial;
                 }
-                else
-                {
-                    auto thread_reduce_func = [&](auto invariant_index) {
-                        AccDataType accuVal =
-                            ReduceOperation::template GetIdentityValue<AccDataType>();
 
-                        auto in_invariant_offset = get_offset_from_index<NumInvariantDim>(
-                            arg.in_invariant_strides_, invariant_index);
+                partial.index_ = static_cast<IndexDataType>(begin);
 
-                        for(const auto& reduce_index : arg.reduce_index_set_)
-                        {
-                            auto in_reduce_offset = get_offset_from_index<NumReduceDim>(
-                                arg.in_reduce_strides_, reduce_index);
+                for(std::size_t i = begin; i < end; i++)
+                {
+                    auto in_reduce_offset = get_offset_from_index<NumReduceDim>(
+                        arg.in_reduce_strides_, arg.reduce_index_set_[i]);
 
-                            auto currVal = type_convert<AccDataType>(
-                                arg.in_host_[in_invariant_offset + in_reduce_offset]);
+                    auto currVal = type_convert<AccDataType>(
+                        arg.in_host_[in_invariant_offset + in_reduce_offset]);
 
-                            arg.in_elementwise_op_(currVal, currVal);
+                    arg.in_elementwise_op_(currVal, currVal);
 
-                            Accumulation::Calculate(accuVal, currVal);
-                        };
+                    if constexpr(OutputIndex)
+                        AccumulationWithIndex::Calculate(
+                            partial.value_, currVal, partial.index_, static_cast<IndexDataType>(i));
+                    else
+                        Accumulation::Calculate(partial.value_, currVal);
+                };
 
-                        arg.acc_elementwise_op_(accuVal, accuVal);
+                return partial;
+            };
 
-                        if(!float_equal_one{}(arg.alpha_))
-                            accuVal *= type_convert<AccDataType>(arg.alpha_);
+            // the right partial covers later elements, so the sequential tie and NaN rules apply
+            auto merge_partial = [](Partial& left, const Partial& right) {
+                if constexpr(OutputIndex)
+                    AccumulationWithIndex::Calculate(
+                        left.value_, right.value_, left.index_, right.index_);
+                else
+                    Accumulation::Calculate(left.value_, right.value_);
+            };
 
-                        auto dst_offset = get_offset_from_index<NumInvariantDim>(arg.outStrides_,
-                                                                                 invariant_index);
+            auto finalize = [&](std::size_t iinv, Partial& partial) {
+                AccDataType accuVal = partial.value_;
 
-                        if(!float_equal_zero{}(arg.beta_))
-                            accuVal += type_convert<AccDataType>(arg.out_host_[dst_offset]) *
-                                       type_convert<AccDataType>(arg.beta_);
+                arg.acc_elementwise_op_(accuVal, accuVal);
 
-                        arg.out_host_[dst_offset] = type_convert<OutDataType>(accuVal);
-                    };
+                if(!float_equal_one{}(arg.alpha_))
+                    accuVal *= type_convert<AccDataType>(arg.alpha_);
 
-                    std::size_t num_thread = std::thread::hardware_concurrency();
+                const std::size_t dst_offset = get_dst_offset(iinv);
 
-                    std::size_t work_per_thread =
-                        (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
+                if(!float_equal_zero{}(arg.beta_))
+                    accuVal += type_convert<AccDataType>(arg.out_host_[dst_offset]) *
+                               type_convert<AccDataType>(arg.beta_);
 
-                    std::vector<joinable_thread> threads(num_thread);
+                arg.out_host_[dst_offset] = type_convert<OutDataType>(accuVal);
 
-                    for(std::size_t it = 0; it < num_thread; ++it)
-                    {
-                        std::size_t i_begin = it * work_per_thread;
-                        std::size_t i_end =
-                            std::min((it + 1) * work_per_thread, arg.invariant_index_set_.size());
-
-                        auto f = [=] {
-                            for(std::size_t i = i_begin; i < i_end; i++)
-                            {
-                                thread_reduce_func(arg.invariant_index_set_[i]);
-                            }
-                        };
-
-                        threads[it] = joinable_thread(f);
-                    }
-                };
+                if constexpr(OutputIndex)
+                    arg.out_index_host_[dst_offset] = partial.index_;
             };
 
+            host_reduction_run<Partial>(
+                HostReductionPartition(num_invariant, arg.reduce_total_length_),
+                reduce_split,
+                merge_partial,
+                finalize);
+
             return (0.0f);
         };
 
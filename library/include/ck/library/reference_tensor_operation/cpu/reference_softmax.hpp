@@ -7,10 +7,13 @@
 #include <sstream>
 #include <vector>
 #include <algorithm>
+#include <thread>
+#include <utility>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_online_softmax.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -56,75 +59,96 @@ struct ReferenceSoftmax : public device::BaseOperator
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
+        // One streaming pass per softmax group computes max and sum with the online
+        // recurrence, a second pass writes the normalized output; groups (indices of the
+        // non-reduced dims) are processed in parallel.
         float Run(const Argument& arg)
         {
-            std::vector<size_t> scalar_lengths;
-            for(index_t dim : arg.sm_scalar_dims_)
+            const auto& lengths     = arg.in_.mDesc.GetLengths();
+            const auto& in_strides  = arg.in_.mDesc.GetStrides();
+            const auto& out_strides = arg.out_.mDesc.GetStrides();
+
+            std::vector<index_t> reduce_dims = arg.sm_reduce_dims_;
+
+            std::sort(reduce_dims.begin(), reduce_dims.end());
+
+            // the last reduce dim is streamed as a strided row
+            index_t row_length     = 1;
+            index_t row_in_stride  = 0;
+            index_t row_out_stride = 0;
+
+            if(!reduce_dims.empty())
+            {
+                row_length     = lengths[reduce_dims.back()];
+                row_in_stride  = in_strides[reduce_dims.back()];
+                row_out_stride = out_strides[reduce_dims.back()];
+
+                reduce_dims.pop_back();
+            }
+
+            std::size_t num_row = 1;
+
+            for(index_t dim : reduce_dims)
             {
-                scalar_lengths.push_back(arg.in_.mDesc.GetLengths()[dim]);
+                num_row *= lengths[dim];
             }
-            // max and sum reduction with final reduced values of dim=0 is a scalar so give it
-            // appropriate lengths of {1}
-            if(arg.sm_scalar_dims_.size() == 0)
+
+            std::size_t num_group = 1;
+
+            for(index_t dim : arg.sm_scalar_dims_)
             {
-                scalar_lengths.push_back(1);
+                num_group *= lengths[dim];
             }
 
-            Tensor<AccDataType> reduce_max(scalar_lengths);
-            reduce_max.GenerateTensorValue(
-                GeneratorTensor_1<AccDataType>{std::numeric_limits<AccDataType>::lowest()});
-            Tensor<AccDataType> reduce_sum(scalar_lengths);
-            reduce_sum.GenerateTensorValue(GeneratorTensor_1<AccDataType>{0});
-
-            // when final reduced values is of dim=0, the index will be transformed into empty
-            // std::vector which is actually a valid input for Tensor::operator(std::vector) and
-            // internally accesses 0'th element
-            auto to_sm_scalar_idx = [&](auto idx) {
-                std::vector<size_t> sm_scalar_idx;
-                for(index_t dim : arg.sm_scalar_dims_)
+            // offsets of a flat index over the given dims, last dim fastest
+            auto get_offsets = [&](const std::vector<index_t>& dims, std::size_t i) {
+                std::size_t in_offset  = 0;
+                std::size_t out_offset = 0;
+
+                for(auto dim = dims.rbegin(); dim != dims.rend(); ++dim)
+                {
+                    const std::size_t idx = i % lengths[*dim];
+
+                    i /= lengths[*dim];
+
+                    in_offset += idx * in_strides[*dim];
+                    out_offset += idx * out_strides[*dim];
+                }
+
+                return std::make_pair(in_offset, out_offset);
+            };
+
+            auto f_group = [&](std::size_t group) {
+                const auto [in_offset, out_offset] = get_offsets(arg.sm_scalar_dims_, group);
+
+                HostSoftmaxState<AccDataType> state;
+
+                for(std::size_t row = 0; row < num_row; ++row)
+                {
+                    const auto row_offsets = get_offsets(reduce_dims, row);
+
+                    host_softmax_accumulate(state,
+                                            &arg.in_.mData[in_offset + row_offsets.first],
+                                            row_length,
+                                            row_in_stride);
+                }
+
+                for(std::size_t row = 0; row < num_row; ++row)
                 {
-                    sm_scalar_idx.push_back(idx[dim]);
+                    const auto row_offsets = get_offsets(reduce_dims, row);
+
+                    host_softmax_normalize(state,
+                                           &arg.in_.mData[in_offset + row_offsets.first],
+                                           &arg.out_.mData[out_offset + row_offsets.second],
+                                           row_length,
+                                           row_in_stride,
+                                           row_out_stride,
+                                           arg.alpha_,
+                                           arg.beta_);
                 }
-                return sm_scalar_idx;
             };
 
-            arg.in_.ForEach([&](auto& self, auto idx) {
-                reduce_max(to_sm_scalar_idx(idx)) = std::max(
-                    reduce_max(to_sm_scalar_idx(idx)), ck::type_convert<AccDataType>(self(idx)));
-            });
-
-            // LogRangeAsType<float>(std::cout << "reduce_max: ", reduce_max.mData, ",") <<
-            // std::endl;
-
-            Tensor<AccDataType> in_stable(arg.in_.mDesc);
-            in_stable.ForEach([&](auto& self, auto idx) {
-                // numerator = exp(x - max(x))
-                self(idx) = std::exp(ck::type_convert<AccDataType>(arg.in_(idx)) -
-                                     reduce_max(to_sm_scalar_idx(idx)));
-            });
-
-            // LogRangeAsType<float>(std::cout << "in_stable: ", in_stable.mData, ",") << std::endl;
-
-            in_stable.ForEach([&](auto& self, auto idx) {
-                // denominator = sum(exp(x - max(x)))
-                reduce_sum(to_sm_scalar_idx(idx)) += self(idx);
-            });
-
-            // LogRangeAsType<float>(std::cout << "reduce_sum: ", reduce_sum.mData, ",") <<
-            // std::endl;
-
-            arg.out_.ForEach([&](auto& self, auto idx) {
-                AccDataType temp_result =
-                    arg.alpha_ * in_stable(idx) / reduce_sum(to_sm_scalar_idx(idx)) +
-                    arg.beta_ * self(idx);
-                self(idx) = ck::type_convert<OutDataType>(temp_result);
-            });
-
-            // LogRangeAsType<float>(std::cout << "out: ", arg.out_.mData, ",") << std::endl;
-            // reduction along reduce dims
-            // LogRangeAsType<float>(std::cout << "reduce_max: ", reduce_max.mData, ",") <<
-            // std::endl; LogRangeAsType<float>(std::cout << "reduce_sum: ", reduce_sum.mData, ",")
-            // << std::endl;
+            make_ParallelTensorFunctor(f_group, num_group)(std::thread::hardware_concurrency());
 
             return 0;
         }
@@ -0,0 +1,343 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ck/utility/math.hpp"
+#include "ck/utility/math_v2.hpp"
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_welford.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+
+//
+// @brief      Host reference of DeviceSparseEmbeddingsForwardLayernorm, for any number of tables.
+//
+// @paragraph
+//             out[l, :] = LayerNorm(emb_op(emb_0[index_0[l], :], ..., emb_n[index_n[l], :]))
+//             Output rows are processed in parallel over L. Each row is gathered into an
+//             AccDataType buffer, its Welford statistics are taken while the row is still in L1
+//             and it is normalized straight into the output, so no [L, D] temporary exists. The
+//             rows gathered a few iterations ahead are prefetched, since the gather is bound by
+//             the latency of random accesses into large tables.
+//
+// @paragraph
+//             Shapes and indices are validated up front, on the calling thread: Run() throws
+//             std::runtime_error on a shape mismatch or an out-of-range index,
+//             IsSupportedArgument() returns false.
+//
+template <typename EmbType,
+          typename IndexType,
+          typename GammaDataType,
+          typename BetaDataType,
+          typename AccDataType,
+          typename OutType,
+          typename EmbElementwiseOperation,
+          index_t NumEmbeddings>
+struct ReferenceSparseEmbeddingsForwardLayernorm : public device::BaseOperator
+{
+    static_assert(NumEmbeddings >= 1, "wrong! at least one embedding table is needed");
+
+    // Argument
+    struct Argument : public device::BaseArgument
+    {
+        Argument(TensorView<OutType> output,
+                 const std::array<TensorView<const EmbType>, NumEmbeddings>& embs,
+                 const std::array<TensorView<const IndexType>, NumEmbeddings>& indexes,
+                 TensorView<const GammaDataType> gamma,
+                 TensorView<const BetaDataType> beta,
+                 AccDataType epsilon,
+                 EmbElementwiseOperation emb_elementwise_op)
+            : output_(output),
+              embs_(embs),
+              indexes_(indexes),
+              gamma_(gamma),
+              beta_(beta),
+              epsilon_(epsilon),
+              emb_elementwise_op_(emb_elementwise_op)
+        {
+        }
+
+        TensorView<OutType> output_;
+        std::array<TensorView<const EmbType>, NumEmbeddings> embs_;
+        std::array<TensorView<const IndexType>, NumEmbeddings> indexes_;
+        TensorView<const GammaDataType> gamma_;
+        TensorView<const BetaDataType> beta_;
+        AccDataType epsilon_;
+        EmbElementwiseOperation emb_elementwise_op_;
+    };
+
+    // [L, D] output, [num_row, D] tables, [D] gamma and beta, L indices per table
+    static bool IsValidShape(const Argument& arg)
+    {
+        const auto& out_lengths = arg.output_.mDesc.GetLengths();
+
+        if(out_lengths.size() != 2)
+        {
+            return false;
+        }
+
+        for(const auto& desc : {arg.gamma_.mDesc, arg.beta_.mDesc})
+        {
+            if(desc.GetNumOfDimension() != 1 || desc.GetLengths()[0] != out_lengths[1])
+            {
+                return false;
+            }
+        }
+
+        for(index_t i = 0; i < NumEmbeddings; ++i)
+        {
+            const auto& emb_lengths   = arg.embs_[i].mDesc.GetLengths();
+            const auto& index_lengths = arg.indexes_[i].mDesc.GetLengths();
+
+            if(emb_lengths.size() != 2 || emb_lengths[1] != out_lengths[1] ||
+               index_lengths.size() != 1 || index_lengths[0] != out_lengths[0])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // checks every index against the number of rows of its table
+    static bool IsValidIndex(const Argument& arg)
+    {
+        for(index_t i = 0; i < NumEmbeddings; ++i)
+        {
+            const auto num_row = static_cast<long_index_t>(arg.embs_[i].mDesc.GetLengths()[0]);
+
+            const auto& indexes = arg.indexes_[i];
+
+            if(indexes.mDesc.GetNumOfDimension() != 1)
+                return false;
+
+            for(std::size_t l = 0; l < indexes.mDesc.GetElementSize(); ++l)
+            {
+                const auto index =
+                    static_cast<long_index_t>(indexes.mData[l * indexes.mDesc.GetStrides()[0]]);
+
+                if(index < 0 || index >= num_row)
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Invoker
+    struct Invoker : public device::BaseInvoker
+    {
+        using Argument = ReferenceSparseEmbeddingsForwardLayernorm::Argument;
+
+        // output rows per task, and how many rows ahead of the current one are prefetched
+        static constexpr index_t RowPerTask       = 256;
+        static constexpr index_t PrefetchDistance = 4;
+
+        template <std::size_t... Is>
+        static void ApplyEmbElementwise(const EmbElementwiseOperation& op,
+                                        AccDataType& y,
+                                        const std::array<AccDataType, NumEmbeddings>& x,
+                                        std::index_sequence<Is...>)
+        {
+            op(y, x[Is]...);
+        }
+
+        float Run(const Argument& arg)
+        {
+            if(!IsValidShape(arg))
+            {
+                throw std::runtime_error("wrong! inconsistent embedding, index or output shape");
+            }
+
+            if(!IsValidIndex(arg))
+            {
+                throw std::runtime_error("wrong! embedding index out of range");
+            }
+
+            const index_t L = arg.output_.mDesc.GetLengths()[0];
+            const index_t D = arg.output_.mDesc.GetLengths()[1];
+
+            const auto& out_strides = arg.output_.mDesc.GetStrides();
+
+            std::array<const EmbType*, NumEmbeddings> p_embs;
+            std::array<std::size_t, NumEmbeddings> emb_row_strides;
+            std::array<std::size_t, NumEmbeddings> emb_col_strides;
+            std::array<const IndexType*, NumEmbeddings> p_indexes;
+            std::array<std::size_t, NumEmbeddings> index_strides;
+
+            for(index_t i = 0; i < NumEmbeddings; ++i)
+            {
+                p_embs[i]          = arg.embs_[i].data();
+                emb_row_strides[i] = arg.embs_[i].mDesc.GetStrides()[0];
+                emb_col_strides[i] = arg.embs_[i].mDesc.GetStrides()[1];
+                p_indexes[i]       = arg.indexes_[i].data();
+                index_strides[i]   = arg.indexes_[i].mDesc.GetStrides()[0];
+            }
+
+            // gamma and beta converted once, instead of once per row
+            std::vector<AccDataType> gamma(D);
+            std::vector<AccDataType> beta(D);
+
+            for(index_t d = 0; d < D; ++d)
+            {
+                gamma[d] = ck::type_convert<AccDataType>(arg.gamma_(d));
+                beta[d]  = ck::type_convert<AccDataType>(arg.beta_(d));
+            }
+
+            auto get_row = [&](index_t i, index_t l) {
+                const auto index = static_cast<std::size_t>(p_indexes[i][l * index_strides[i]]);
+
+                return p_embs[i] + index * emb_row_strides[i];
+            };
+
+            auto prefetch_row = [&](index_t l) {
+                for(index_t i = 0; i < NumEmbeddings; ++i)
+                {
+                    const char* p_row = reinterpret_cast<const char*>(get_row(i, l));
+
+                    const std::size_t row_bytes = D * emb_col_strides[i] * sizeof(EmbType);
+
+                    for(std::size_t offset = 0; offset < row_bytes; offset += 64)
+                    {
+                        __builtin_prefetch(p_row + offset);
+                    }
+                }
+            };
+
+            const index_t num_task = math::integer_divide_ceil(L, RowPerTask);
+
+            auto f_task = [&](auto it) {
+                const index_t l_begin = it * RowPerTask;
+                const index_t l_end   = std::min(l_begin + RowPerTask, L);
+
+                std::vector<AccDataType> acc(D);
+
+                for(index_t l = l_begin; l < std::min(l_begin + PrefetchDistance, l_end); ++l)
+                {
+                    prefetch_row(l);
+                }
+
+                for(index_t l = l_begin; l < l_end; ++l)
+                {
+                    if(l + PrefetchDistance < l_end)
+                    {
+                        prefetch_row(l + PrefetchDistance);
+                    }
+
+                    std::array<const EmbType*, NumEmbeddings> p_rows;
+
+                    for(index_t i = 0; i < NumEmbeddings; ++i)
+                    {
+                        p_rows[i] = get_row(i, l);
+                    }
+
+                    for(index_t d = 0; d < D; ++d)
+                    {
+                        std::array<AccDataType, NumEmbeddings> v_embs;
+
+                        for(index_t i = 0; i < NumEmbeddings; ++i)
+                        {
+                            v_embs[i] =
+                                ck::type_convert<AccDataType>(p_rows[i][d * emb_col_strides[i]]);
+                        }
+
+                        ApplyEmbElementwise(arg.emb_elementwise_op_,
+                                            acc[d],
+                                            v_embs,
+                                            std::make_index_sequence<NumEmbeddings>{});
+                    }
+
+                    HostWelford<AccDataType> welford;
+
+                    host_welford_accumulate(welford, acc.data(), D, 1);
+
+                    const AccDataType mean = welford.GetMean();
+                    const AccDataType rstd =
+                        AccDataType{1} / ck::math::sqrt(welford.GetVariance() + arg.epsilon_);
+
+                    OutType* p_out = &arg.output_.mData[l * out_strides[0]];
+
+                    for(index_t d = 0; d < D; ++d)
+                    {
+                        const AccDataType v_y = (acc[d] - mean) * rstd * gamma[d] + beta[d];
+
+                        p_out[d * out_strides[1]] = ck::type_convert<OutType>(v_y);
+                    }
+                }
+            };
+
+            make_ParallelTensorFunctor(f_task, num_task)(std::thread::hardware_concurrency());
+
+            return 0;
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter()
+    {
+        // TODO: properly implement this check
+        return true;
+    }
+
+    bool IsSupportedArgument(const device::BaseArgument* p_arg) override
+    {
+        const Argument& arg = *dynamic_cast<const Argument*>(p_arg);
+
+        return IsValidShape(arg) && IsValidIndex(arg);
+    }
+
+    static auto MakeArgument(TensorView<OutType> output,
+                             const std::array<TensorView<const EmbType>, NumEmbeddings>& embs,
+                             const std::array<TensorView<const IndexType>, NumEmbeddings>& indexes,
+                             TensorView<const GammaDataType> gamma,
+                             TensorView<const BetaDataType> beta,
+                             AccDataType epsilon,
+                             EmbElementwiseOperation emb_elementwise_op)
+    {
+        return Argument(output, embs, indexes, gamma, beta, epsilon, emb_elementwise_op);
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferenceSparseEmbeddingsForwardLayernorm"
+            << "<"
+            << NumEmbeddings
+            << ">"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -18,11 +19,50 @@
 #include "ck/utility/type.hpp"
 #include "ck/host_utility/io.hpp"
 
+#include "ck/library/utility/host_type_convert.hpp"
 #include "ck/library/utility/ranges.hpp"
 
 namespace ck {
 namespace utils {
 
+namespace detail {
+
+// f(i, out[i], ref[i]) over the elements converted to float, in bulk
+template <typename Range, typename RefRange, typename F>
+void for_each_as_float(const Range& out, const RefRange& ref, F f)
+{
+    using T = ranges::range_value_t<Range>;
+
+    constexpr std::size_t chunk_size = 1024;
+
+    std::array<T, chunk_size> chunk_out;
+    std::array<T, chunk_size> chunk_ref;
+    std::array<float, chunk_size> chunk_out_float;
+    std::array<float, chunk_size> chunk_ref_float;
+
+    auto it_out = std::begin(out);
+    auto it_ref = std::begin(ref);
+
+    for(std::size_t i0 = 0; i0 < ref.size(); i0 += chunk_size)
+    {
+        const std::size_t n = std::min(chunk_size, ref.size() - i0);
+
+        for(std::size_t j = 0; j < n; ++j, ++it_out, ++it_ref)
+        {
+            chunk_out[j] = *it_out;
+            chunk_ref[j] = *it_ref;
+        }
+
+        bulk_type_convert(chunk_out.data(), chunk_out_float.data(), n);
+        bulk_type_convert(chunk_ref.data(), chunk_ref_float.data(), n);
+
+        for(std::size_t j = 0; j < n; ++j)
+            f(i0 + j, chunk_out_float[j], chunk_ref_float[j]);
+    }
+}
+
+} // namespace detail
+
 template <typename Range, typename RefRange>
 typename std::enable_if<
     std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
@@ -93,11 +133,8 @@ check_err(const Range& out,
     double err    = 0;
     // TODO: This is a hack. We should have proper specialization for bhalf_t data type.
     double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
+    detail::for_each_as_float(out, ref, [&](std::size_t i, double o, double r) {
+        err = std::abs(o - r);
         if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
         {
             max_err = err > max_err ? err : max_err;
@@ -109,7 +146,7 @@ check_err(const Range& out,
             }
             res = false;
         }
-    }
+    });
     if(!res)
     {
         std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
@@ -139,11 +176,8 @@ check_err(const Range& out,
     int err_count  = 0;
     double err     = 0;
     double max_err = std::numeric_limits<ranges::range_value_t<Range>>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
+    detail::for_each_as_float(out, ref, [&](std::size_t i, double o, double r) {
+        err = std::abs(o - r);
         if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
         {
             max_err = err > max_err ? err : max_err;
@@ -155,7 +189,7 @@ check_err(const Range& out,
             }
             res = false;
         }
-    }
+    });
     if(!res)
     {
         std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
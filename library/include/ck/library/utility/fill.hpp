@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iterator>
 #include <random>
@@ -11,10 +12,40 @@
 #include <utility>
 
 #include "ck/utility/data_type.hpp"
+#include "ck/library/utility/host_type_convert.hpp"
 
 namespace ck {
 namespace utils {
 
+namespace detail {
+
+// std::generate(first, last, [&] { return ck::type_convert<T>(gen()); }), with the floats from
+// gen() converted to T in bulk
+template <typename T, typename ForwardIter, typename Generator>
+void generate_as_type(ForwardIter first, ForwardIter last, Generator gen)
+{
+    constexpr std::size_t chunk_size = 1024;
+
+    std::array<float, chunk_size> chunk_float;
+    std::array<T, chunk_size> chunk;
+
+    while(first != last)
+    {
+        const ForwardIter chunk_first = first;
+
+        std::size_t n = 0;
+
+        for(; n < chunk_size && first != last; ++n, ++first)
+            chunk_float[n] = gen();
+
+        bulk_type_convert(chunk_float.data(), chunk.data(), n);
+
+        std::copy_n(chunk.begin(), n, chunk_first);
+    }
+}
+
+} // namespace detail
+
 template <typename T>
 struct FillUniformDistribution
 {
@@ -26,7 +57,7 @@ struct FillUniformDistribution
     {
         std::mt19937 gen(11939);
         std::uniform_real_distribution<float> dis(a_, b_);
-        std::generate(first, last, [&dis, &gen]() { return ck::type_convert<T>(dis(gen)); });
+        detail::generate_as_type<T>(first, last, [&dis, &gen]() { return dis(gen); });
     }
 
     template <typename ForwardRange>
@@ -70,8 +101,7 @@ struct FillUniformDistributionIntegerValue
     {
         std::mt19937 gen(11939);
         std::uniform_real_distribution<float> dis(a_, b_);
-        std::generate(
-            first, last, [&dis, &gen]() { return ck::type_convert<T>(std::round(dis(gen))); });
+        detail::generate_as_type<T>(first, last, [&dis, &gen]() { return std::round(dis(gen)); });
     }
 
     template <typename ForwardRange>
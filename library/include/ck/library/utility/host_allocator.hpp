@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <new>
+
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace utils {
+
+enum struct HostMemoryPolicy
+{
+    // cache line aligned operator new
+    Aligned,
+    // anonymous mapping on 2 MiB boundaries, madvise(MADV_HUGEPAGE)
+    HugePage,
+    // HugePage, with the pages interleaved over the NUMA nodes the process may use
+    NumaInterleave,
+    // HugePage, with the pages first touched by the host thread pool
+    ParallelFirstTouch,
+};
+
+namespace detail {
+
+inline constexpr std::size_t HostCacheLineSize = 64;
+inline constexpr std::size_t HostHugePageSize  = std::size_t{2} << 20;
+
+inline std::size_t host_round_up(std::size_t x, std::size_t align)
+{
+    return (x + align - 1) / align * align;
+}
+
+inline void* host_map_huge_pages(std::size_t bytes)
+{
+    const std::size_t size = host_round_up(bytes, HostHugePageSize);
+
+    // over-allocate by one huge page, then trim to a huge page boundary
+    void* p_map = mmap(nullptr,
+                       size + HostHugePageSize,
+                       PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS,
+                       -1,
+                       0);
+
+    if(p_map == MAP_FAILED)
+        throw std::bad_alloc();
+
+    const auto map_begin = reinterpret_cast<std::uintptr_t>(p_map);
+    const auto map_end   = map_begin + size + HostHugePageSize;
+    const auto begin     = host_round_up(map_begin, HostHugePageSize);
+    const auto end       = begin + size;
+
+    if(begin > map_begin)
+        munmap(p_map, begin - map_begin);
+
+    if(map_end > end)
+        munmap(reinterpret_cast<void*>(end), map_end - end);
+
+    // best effort: without transparent huge pages this is a mapping of 4 KiB pages
+    madvise(reinterpret_cast<void*>(begin), size, MADV_HUGEPAGE);
+
+    return reinterpret_cast<void*>(begin);
+}
+
+inline void host_unmap_huge_pages(void* p, std::size_t bytes)
+{
+    munmap(p, host_round_up(bytes, HostHugePageSize));
+}
+
+inline constexpr std::size_t HostMaxNumNumaNode  = 1024;
+inline constexpr std::size_t HostNumNumaMaskWord = HostMaxNumNumaNode / (8 * sizeof(unsigned long));
+
+// the NUMA nodes the process may allocate from, as a bit mask; false where the memory policy
+// syscalls are unavailable
+inline bool host_get_allowed_numa_nodes(unsigned long (&node_mask)[HostNumNumaMaskWord])
+{
+    // MPOL_F_MEMS_ALLOWED of <numaif.h>, spelled out to not need libnuma
+    constexpr unsigned MpolFMemsAllowed = 1u << 2;
+
+    std::fill(std::begin(node_mask), std::end(node_mask), 0ul);
+
+    return syscall(SYS_get_mempolicy,
+                   nullptr,
+                   node_mask,
+                   HostMaxNumNumaNode,
+                   nullptr,
+                   MpolFMemsAllowed) == 0;
+}
+
+// best effort: a no-op on a single node, or where the memory policy syscalls are unavailable
+inline void host_interleave_numa_nodes(void* p, std::size_t bytes)
+{
+    // MPOL_INTERLEAVE of <numaif.h>
+    constexpr int MpolInterleave = 3;
+
+    unsigned long node_mask[HostNumNumaMaskWord];
+
+    if(!host_get_allowed_numa_nodes(node_mask))
+        return;
+
+    // the kernel takes maxnode as one past the last node bit
+    syscall(SYS_mbind,
+            p,
+            host_round_up(bytes, HostHugePageSize),
+            MpolInterleave,
+            node_mask,
+            HostMaxNumNumaNode,
+            0u);
+}
+
+// writes one byte of every page from the pool, so that each page is placed on the node of the
+// thread that will process that part of the buffer in a parallel loop over it
+inline void host_first_touch_parallel(void* p, std::size_t bytes)
+{
+    const std::size_t page_size = sysconf(_SC_PAGESIZE);
+    const std::size_t num_page  = host_round_up(bytes, page_size) / page_size;
+
+    auto& pool = HostThreadPool::GetInstance();
+
+    pool.ParallelFor(
+        num_page,
+        [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i)
+                static_cast<volatile char*>(p)[i * page_size] = 0;
+        },
+        pool.GetNumThread());
+}
+
+} // namespace detail
+
+// number of NUMA nodes the process may allocate from, 1 where it cannot be queried
+inline std::size_t get_host_num_numa_node()
+{
+    unsigned long node_mask[detail::HostNumNumaMaskWord];
+
+    if(!detail::host_get_allowed_numa_nodes(node_mask))
+        return 1;
+
+    std::size_t num_node = 0;
+
+    for(unsigned long word : node_mask)
+        num_node += __builtin_popcountl(word);
+
+    return std::max<std::size_t>(num_node, 1);
+}
+
+//
+// @brief      Allocator for host tensor storage, with a page placement policy.
+//
+// @paragraph
+//             Use it as the Allocator of a Tensor, e.g. Tensor<float, HostTensorDynamicRank,
+//             HostAllocator<float, HostMemoryPolicy::HugePage>>. Every policy returns memory
+//             aligned to at least a cache line. Allocations of 2 MiB or more under the other
+//             policies are anonymous mappings on huge page boundaries; smaller ones fall back to
+//             Aligned. What the system does not support (transparent huge pages, more than one
+//             NUMA node) quietly has no effect.
+//
+// @paragraph
+//             ParallelFirstTouch spreads the first touch of the pages over the pool threads, so
+//             the pages land on the NUMA nodes those threads run on. The pool steals work, so
+//             which thread touches a given page, and hence its node, is not deterministic. It
+//             pays off together with HostThreadPool::PinThreads(), which keeps every thread on
+//             the same node.
+//
+template <typename T, HostMemoryPolicy Policy = HostMemoryPolicy::Aligned>
+struct HostAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = HostAllocator<U, Policy>;
+    };
+
+    HostAllocator() = default;
+
+    template <typename U>
+    HostAllocator(const HostAllocator<U, Policy>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_array_new_length();
+
+        const std::size_t bytes = n * sizeof(T);
+
+        if(IsMapped(bytes))
+        {
+            void* p = detail::host_map_huge_pages(bytes);
+
+            if constexpr(Policy == HostMemoryPolicy::NumaInterleave)
+                detail::host_interleave_numa_nodes(p, bytes);
+            else if constexpr(Policy == HostMemoryPolicy::ParallelFirstTouch)
+                detail::host_first_touch_parallel(p, bytes);
+
+            return static_cast<T*>(p);
+        }
+
+        return static_cast<T*>(::operator new(bytes, std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        const std::size_t bytes = n * sizeof(T);
+
+        if(IsMapped(bytes))
+            detail::host_unmap_huge_pages(p, bytes);
+        else
+            ::operator delete(p, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    bool operator==(const HostAllocator<U, Policy>&) const noexcept
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const HostAllocator<U, Policy>&) const noexcept
+    {
+        return false;
+    }
+
+    private:
+    static constexpr std::size_t Alignment = std::max(detail::HostCacheLineSize, alignof(T));
+
+    static bool IsMapped(std::size_t bytes)
+    {
+        return Policy != HostMemoryPolicy::Aligned && bytes >= detail::HostHugePageSize;
+    }
+};
+
+} // namespace utils
+} // namespace ck
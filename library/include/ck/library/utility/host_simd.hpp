@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+// Explicit x86 SIMD for host reference code. Kernels are compiled with function-level target
+// attributes and selected at run time with __builtin_cpu_supports(), so the translation unit
+// itself does not need to be built for a particular ISA.
+#if defined(__x86_64__) && !defined(__HIP_DEVICE_COMPILE__)
+#include <immintrin.h>
+#define CK_HOST_X86_SIMD 1
+#else
+#define CK_HOST_X86_SIMD 0
+#endif
+
+// AVX-VNNI (the "avxvnni" target, _mm256_dpbusd_avx_epi32 and its __builtin_cpu_supports name)
+// is only known to GCC 11 and clang 12 onwards; older compilers get the other kernels only
+#if CK_HOST_X86_SIMD && ((defined(__clang__) && __clang_major__ >= 12) || \
+                         (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 11))
+#define CK_HOST_X86_AVXVNNI 1
+#else
+#define CK_HOST_X86_AVXVNNI 0
+#endif
+
+namespace ck {
+namespace host_simd {
+
+#if CK_HOST_X86_SIMD
+
+// expf on 8 lanes, Cephes polynomial (max. relative error ~2 ulp); NaN propagates, inputs below
+// the normal range flush to zero
+__attribute__((target("avx2"))) inline __m256 exp_f32x8(__m256 x)
+{
+    const __m256 v_zero_below = _mm256_set1_ps(-87.33654f);
+
+    const __m256 v_x_in = x;
+
+    // operand order keeps NaN
+    x = _mm256_min_ps(_mm256_set1_ps(88.37626f), x);
+    x = _mm256_max_ps(_mm256_set1_ps(-88.37626f), x);
+
+    __m256 fx = _mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f)),
+                              _mm256_set1_ps(0.5f));
+    fx        = _mm256_floor_ps(fx);
+
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(0.693359375f)));
+    x = _mm256_sub_ps(x, _mm256_mul_ps(fx, _mm256_set1_ps(-2.12194440e-4f)));
+
+    __m256 y = _mm256_set1_ps(1.9875691500E-4f);
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.3981999507E-3f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(8.3334519073E-3f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(4.1665795894E-2f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(1.6666665459E-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, x), _mm256_set1_ps(5.0000001201E-1f));
+    y = _mm256_add_ps(_mm256_mul_ps(y, _mm256_mul_ps(x, x)), x);
+    y = _mm256_add_ps(y, _mm256_set1_ps(1.f));
+
+    // 2^fx
+    __m256i e = _mm256_cvttps_epi32(fx);
+    e         = _mm256_slli_epi32(_mm256_add_epi32(e, _mm256_set1_epi32(127)), 23);
+
+    y = _mm256_mul_ps(y, _mm256_castsi256_ps(e));
+
+    return _mm256_andnot_ps(_mm256_cmp_ps(v_x_in, v_zero_below, _CMP_LT_OQ), y);
+}
+
+// expf on 16 lanes, same polynomial as exp_f32x8()
+__attribute__((target("avx512f"))) inline __m512 exp_f32x16(__m512 x)
+{
+    const __mmask16 zero_below = _mm512_cmp_ps_mask(x, _mm512_set1_ps(-87.33654f), _CMP_LT_OQ);
+
+    x = _mm512_min_ps(_mm512_set1_ps(88.37626f), x);
+    x = _mm512_max_ps(_mm512_set1_ps(-88.37626f), x);
+
+    __m512 fx = _mm512_add_ps(_mm512_mul_ps(x, _mm512_set1_ps(1.44269504088896341f)),
+                              _mm512_set1_ps(0.5f));
+    fx        = _mm512_roundscale_ps(fx, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+
+    x = _mm512_sub_ps(x, _mm512_mul_ps(fx, _mm512_set1_ps(0.693359375f)));
+    x = _mm512_sub_ps(x, _mm512_mul_ps(fx, _mm512_set1_ps(-2.12194440e-4f)));
+
+    __m512 y = _mm512_set1_ps(1.9875691500E-4f);
+    y = _mm512_add_ps(_mm512_mul_ps(y, x), _mm512_set1_ps(1.3981999507E-3f));
+    y = _mm512_add_ps(_mm512_mul_ps(y, x), _mm512_set1_ps(8.3334519073E-3f));
+    y = _mm512_add_ps(_mm512_mul_ps(y, x), _mm512_set1_ps(4.1665795894E-2f));
+    y = _mm512_add_ps(_mm512_mul_ps(y, x), _mm512_set1_ps(1.6666665459E-1f));
+    y = _mm512_add_ps(_mm512_mul_ps(y, x), _mm512_set1_ps(5.0000001201E-1f));
+    y = _mm512_add_ps(_mm512_mul_ps(y, _mm512_mul_ps(x, x)), x);
+    y = _mm512_add_ps(y, _mm512_set1_ps(1.f));
+
+    // 2^fx
+    __m512i e = _mm512_cvttps_epi32(fx);
+    e         = _mm512_slli_epi32(_mm512_add_epi32(e, _mm512_set1_epi32(127)), 23);
+
+    y = _mm512_mul_ps(y, _mm512_castsi512_ps(e));
+
+    return _mm512_mask_mov_ps(y, zero_below, _mm512_setzero_ps());
+}
+
+#endif // CK_HOST_X86_SIMD
+
+} // namespace host_simd
+} // namespace ck
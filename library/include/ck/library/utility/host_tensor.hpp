@@ -4,10 +4,15 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <stdexcept>
 #include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -15,6 +20,8 @@
 #include "ck/utility/span.hpp"
 
 #include "ck/library/utility/algorithm.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+#include "ck/library/utility/host_type_convert.hpp"
 #include "ck/library/utility/ranges.hpp"
 
 template <typename Range>
@@ -130,7 +137,7 @@ struct HostTensorDescriptor
         return std::inner_product(iss.begin(), iss.end(), mStrides.begin(), std::size_t{0});
     }
 
-    std::size_t GetOffsetFromMultiIndex(std::vector<std::size_t> iss) const
+    std::size_t GetOffsetFromMultiIndex(const std::vector<std::size_t>& iss) const
     {
         return std::inner_product(iss.begin(), iss.end(), mStrides.begin(), std::size_t{0});
     }
@@ -158,6 +165,121 @@ HostTensorDescriptor transpose_host_tensor_descriptor_given_new2old(const HostTe
     return HostTensorDescriptor(new_lengths, new_strides);
 }
 
+//
+// @brief      Host tensor descriptor of compile-time rank NDim.
+//
+// @paragraph
+//             Lengths and strides are kept in std::array and GetOffsetFromMultiIndex is unrolled
+//             over the dimensions, so indexing a tensor in the innermost loop of a reference
+//             kernel does not walk heap data. It converts to and from HostTensorDescriptor; the
+//             conversion from it throws if the rank does not match.
+//
+template <std::size_t NDim>
+struct StaticRankHostTensorDescriptor
+{
+    StaticRankHostTensorDescriptor() = default;
+
+    template <typename X, typename = std::enable_if_t<std::is_convertible_v<X, std::size_t>>>
+    StaticRankHostTensorDescriptor(const std::initializer_list<X>& lens)
+        : StaticRankHostTensorDescriptor(HostTensorDescriptor(lens))
+    {
+    }
+
+    template <typename Lengths,
+              typename = std::enable_if_t<
+                  std::is_convertible_v<ck::ranges::range_value_t<Lengths>, std::size_t>>>
+    StaticRankHostTensorDescriptor(const Lengths& lens)
+        : StaticRankHostTensorDescriptor(HostTensorDescriptor(lens))
+    {
+    }
+
+    template <typename X,
+              typename Y,
+              typename = std::enable_if_t<std::is_convertible_v<X, std::size_t> &&
+                                          std::is_convertible_v<Y, std::size_t>>>
+    StaticRankHostTensorDescriptor(const std::initializer_list<X>& lens,
+                                   const std::initializer_list<Y>& strides)
+        : StaticRankHostTensorDescriptor(HostTensorDescriptor(lens, strides))
+    {
+    }
+
+    template <typename Lengths,
+              typename Strides,
+              typename = std::enable_if_t<
+                  std::is_convertible_v<ck::ranges::range_value_t<Lengths>, std::size_t> &&
+                  std::is_convertible_v<ck::ranges::range_value_t<Strides>, std::size_t>>>
+    StaticRankHostTensorDescriptor(const Lengths& lens, const Strides& strides)
+        : StaticRankHostTensorDescriptor(HostTensorDescriptor(lens, strides))
+    {
+    }
+
+    explicit StaticRankHostTensorDescriptor(const HostTensorDescriptor& desc)
+    {
+        if(desc.GetNumOfDimension() != NDim || desc.GetStrides().size() != NDim)
+            throw std::runtime_error("wrong! inconsistent dimension");
+
+        std::copy(desc.GetLengths().begin(), desc.GetLengths().end(), mLens.begin());
+        std::copy(desc.GetStrides().begin(), desc.GetStrides().end(), mStrides.begin());
+    }
+
+    operator HostTensorDescriptor() const { return HostTensorDescriptor(mLens, mStrides); }
+
+    static constexpr std::size_t GetNumOfDimension() { return NDim; }
+
+    std::size_t GetElementSize() const
+    {
+        return std::accumulate(
+            mLens.begin(), mLens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    }
+
+    std::size_t GetElementSpaceSize() const
+    {
+        std::size_t space = 1;
+
+        for(std::size_t i = 0; i < NDim; ++i)
+        {
+            if(mLens[i] == 0)
+                continue;
+
+            space += (mLens[i] - 1) * mStrides[i];
+        }
+
+        return space;
+    }
+
+    const std::array<std::size_t, NDim>& GetLengths() const { return mLens; }
+    const std::array<std::size_t, NDim>& GetStrides() const { return mStrides; }
+
+    template <typename... Is>
+    std::size_t GetOffsetFromMultiIndex(Is... is) const
+    {
+        static_assert(sizeof...(Is) == NDim, "wrong! inconsistent dimension");
+
+        return GetOffsetFromMultiIndex_impl(std::make_index_sequence<NDim>{},
+                                            static_cast<std::size_t>(is)...);
+    }
+
+    std::size_t GetOffsetFromMultiIndex(const std::array<std::size_t, NDim>& iss) const
+    {
+        return std::apply([&](auto... is) { return GetOffsetFromMultiIndex(is...); }, iss);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const StaticRankHostTensorDescriptor& desc)
+    {
+        return os << HostTensorDescriptor(desc);
+    }
+
+    private:
+    template <std::size_t... IDims, typename... Is>
+    std::size_t GetOffsetFromMultiIndex_impl(std::index_sequence<IDims...>, Is... is) const
+    {
+        return (std::size_t{0} + ... + (is * mStrides[IDims]));
+    }
+
+    std::array<std::size_t, NDim> mLens{};
+    std::array<std::size_t, NDim> mStrides{};
+};
+
 struct joinable_thread : std::thread
 {
     template <typename... Xs>
@@ -175,58 +297,142 @@ struct joinable_thread : std::thread
     }
 };
 
-template <typename F, typename... Xs>
-struct ParallelTensorFunctor
+//
+// @brief      Row-major walk over the multi-indices of NDim lengths, carrying the linear offset
+//             of each of NTensor tensors.
+//
+// @paragraph
+//             The starting multi-index is decoded once, with NDim divisions; Next() then advances
+//             it odometer-style, so the innermost dimension costs an increment and a compare and
+//             every offset an addition.
+//
+template <std::size_t NDim, std::size_t NTensor>
+struct HostTensorOdometer
 {
-    F mF;
-    static constexpr std::size_t NDIM = sizeof...(Xs);
-    std::array<std::size_t, NDIM> mLens;
-    std::array<std::size_t, NDIM> mStrides;
-    std::size_t mN1d;
+    using Index   = std::array<std::size_t, NDim>;
+    using Offsets = std::array<std::size_t, NTensor>;
+    using Strides = std::array<Index, NTensor>;
 
-    ParallelTensorFunctor(F f, Xs... xs) : mF(f), mLens({static_cast<std::size_t>(xs)...})
+    HostTensorOdometer(const Index& lengths, const Strides& strides, std::size_t i)
+        : mLens(lengths), mStrides(strides), mOffsets{}
     {
-        mStrides.back() = 1;
-        std::partial_sum(mLens.rbegin(),
-                         mLens.rend() - 1,
-                         mStrides.rbegin() + 1,
-                         std::multiplies<std::size_t>());
-        mN1d = mStrides[0] * mLens[0];
+        for(std::size_t idim = NDim; idim-- > 0;)
+        {
+            mIdx[idim] = i % mLens[idim];
+            i /= mLens[idim];
+
+            for(std::size_t t = 0; t < NTensor; ++t)
+                mOffsets[t] += mIdx[idim] * mStrides[t][idim];
+        }
     }
 
-    std::array<std::size_t, NDIM> GetNdIndices(std::size_t i) const
-    {
-        std::array<std::size_t, NDIM> indices;
+    void Next() { Next_impl<NDim>(); }
 
-        for(std::size_t idim = 0; idim < NDIM; ++idim)
+    // unrolled over the dimensions, so the index can live in registers
+    template <std::size_t IDimEnd>
+    void Next_impl()
+    {
+        if constexpr(IDimEnd > 0)
         {
-            indices[idim] = i / mStrides[idim];
-            i -= indices[idim] * mStrides[idim];
-        }
+            constexpr std::size_t idim = IDimEnd - 1;
 
-        return indices;
-    }
+            ++mIdx[idim];
 
-    void operator()(std::size_t num_thread = 1) const
-    {
-        std::size_t work_per_thread = (mN1d + num_thread - 1) / num_thread;
+            for(std::size_t t = 0; t < NTensor; ++t)
+                mOffsets[t] += mStrides[t][idim];
 
-        std::vector<joinable_thread> threads(num_thread);
+            if(mIdx[idim] < mLens[idim])
+                return;
 
-        for(std::size_t it = 0; it < num_thread; ++it)
-        {
-            std::size_t iw_begin = it * work_per_thread;
-            std::size_t iw_end   = std::min((it + 1) * work_per_thread, mN1d);
-
-            auto f = [=] {
-                for(std::size_t iw = iw_begin; iw < iw_end; ++iw)
-                {
-                    call_f_unpack_args(mF, GetNdIndices(iw));
-                }
-            };
-            threads[it] = joinable_thread(f);
+            for(std::size_t t = 0; t < NTensor; ++t)
+                mOffsets[t] -= mLens[idim] * mStrides[t][idim];
+
+            mIdx[idim] = 0;
+
+            Next_impl<idim>();
         }
     }
+
+    Index mLens;
+    Strides mStrides;
+
+    Index mIdx;
+    Offsets mOffsets;
+};
+
+//
+// @brief      f(idx, offsets) for every multi-index idx of lengths, in row-major chunks on the
+//             host thread pool; offsets[t] is the linear offset of idx in tensor t.
+//
+template <std::size_t NDim, std::size_t NTensor, typename F>
+void host_tensor_for_each(F f,
+                          const std::array<std::size_t, NDim>& lengths,
+                          const std::array<std::array<std::size_t, NDim>, NTensor>& strides,
+                          std::size_t num_thread = 1,
+                          std::size_t grain_size = 0)
+{
+    const std::size_t n = std::accumulate(
+        lengths.begin(), lengths.end(), std::size_t{1}, std::multiplies<std::size_t>());
+
+    ck::utils::HostThreadPool::GetInstance().ParallelFor(
+        n,
+        [&](std::size_t i_begin, std::size_t i_end) {
+            HostTensorOdometer<NDim, NTensor> odometer(lengths, strides, i_begin);
+
+            for(std::size_t i = i_begin; i < i_end; ++i, odometer.Next())
+                f(std::as_const(odometer.mIdx), std::as_const(odometer.mOffsets));
+        },
+        num_thread,
+        grain_size);
+}
+
+// lengths or strides of a descriptor of rank NDim, as a fixed-rank array
+template <std::size_t NDim>
+std::array<std::size_t, NDim> to_host_tensor_array(const std::vector<std::size_t>& v)
+{
+    if(v.size() != NDim)
+        throw std::runtime_error("wrong! inconsistent dimension");
+
+    std::array<std::size_t, NDim> a{};
+
+    std::copy(v.begin(), v.end(), a.begin());
+
+    return a;
+}
+
+template <typename F, typename... Xs>
+struct ParallelTensorFunctor
+{
+    F mF;
+    static constexpr std::size_t NDIM = sizeof...(Xs);
+    std::array<std::size_t, NDIM> mLens;
+    std::size_t mN1d;
+
+    ParallelTensorFunctor(F f, Xs... xs)
+        : mF(f),
+          mLens({static_cast<std::size_t>(xs)...}),
+          mN1d(std::accumulate(
+              mLens.begin(), mLens.end(), std::size_t{1}, std::multiplies<std::size_t>()))
+    {
+    }
+
+    // runs on the persistent host thread pool; grain_size 0 lets the pool pick the chunk size
+    void operator()(std::size_t num_thread = 1, std::size_t grain_size = 0) const
+    {
+        ck::utils::HostThreadPool::GetInstance().ParallelFor(
+            mN1d,
+            [&](std::size_t i_begin, std::size_t i_end) {
+                HostTensorOdometer<NDIM, 0> odometer(mLens, {}, i_begin);
+
+                // mF(i_0, ..., i_NDIM-1): the multi-index is passed as NDIM separate arguments;
+                // mF is shared by all chunks and called through its const call operator, so a
+                // functor that captures tensors by value is never copied
+                for(std::size_t i = i_begin; i < i_end; ++i, odometer.Next())
+                    std::apply(mF, std::as_const(odometer.mIdx));
+            },
+            num_thread,
+            grain_size);
+    }
 };
 
 template <typename F, typename... Xs>
@@ -235,11 +441,24 @@ auto make_ParallelTensorFunctor(F f, Xs... xs)
     return ParallelTensorFunctor<F, Xs...>(f, xs...);
 }
 
-template <typename T>
-struct Tensor
+// rank of a Tensor whose rank is only known at run time
+inline constexpr std::size_t HostTensorDynamicRank = static_cast<std::size_t>(-1);
+
+// Allocator is the allocator of the std::vector storage, see HostAllocator for ones with a
+// page placement policy
+template <typename T,
+          std::size_t NDim   = HostTensorDynamicRank,
+          typename Allocator = std::allocator<T>>
+struct Tensor;
+
+template <typename T, typename Allocator>
+struct Tensor<T, HostTensorDynamicRank, Allocator>
 {
     using Descriptor = HostTensorDescriptor;
-    using Data       = std::vector<T>;
+    using Data       = std::vector<T, Allocator>;
+
+    template <typename U>
+    using RebindAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
 
     template <typename X>
     Tensor(std::initializer_list<X> lens) : mDesc(lens), mData(mDesc.GetElementSpaceSize())
@@ -252,12 +471,18 @@ struct Tensor
     {
     }
 
-    template <typename Lengths>
+    template <typename Lengths,
+              typename = std::enable_if_t<
+                  std::is_convertible_v<ck::ranges::range_value_t<Lengths>, std::size_t>>>
     Tensor(const Lengths& lens) : mDesc(lens), mData(mDesc.GetElementSpaceSize())
     {
     }
 
-    template <typename Lengths, typename Strides>
+    template <typename Lengths,
+              typename Strides,
+              typename = std::enable_if_t<
+                  std::is_convertible_v<ck::ranges::range_value_t<Lengths>, std::size_t> &&
+                  std::is_convertible_v<ck::ranges::range_value_t<Strides>, std::size_t>>>
     Tensor(const Lengths& lens, const Strides& strides)
         : mDesc(lens, strides), mData(GetElementSpaceSize())
     {
@@ -265,13 +490,18 @@ struct Tensor
 
     Tensor(const Descriptor& desc) : mDesc(desc), mData(mDesc.GetElementSpaceSize()) {}
 
+    template <std::size_t NDim, typename OtherAllocator>
+    explicit Tensor(const Tensor<T, NDim, OtherAllocator>& other)
+        : mDesc(other.mDesc), mData(other.mData.begin(), other.mData.end())
+    {
+    }
+
     template <typename OutT>
-    Tensor<OutT> CopyAsType() const
+    Tensor<OutT, HostTensorDynamicRank, RebindAllocator<OutT>> CopyAsType() const
     {
-        Tensor<OutT> ret(mDesc);
+        Tensor<OutT, HostTensorDynamicRank, RebindAllocator<OutT>> ret(mDesc);
 
-        ck::ranges::transform(
-            mData, ret.mData.begin(), [](auto value) { return ck::type_convert<OutT>(value); });
+        ck::utils::bulk_type_convert(mData.data(), ret.mData.data(), mData.size());
 
         return ret;
     }
@@ -285,7 +515,7 @@ struct Tensor
     Tensor& operator=(const Tensor&) = default;
     Tensor& operator=(Tensor&&) = default;
 
-    template <typename FromT>
+    template <typename FromT, typename = std::enable_if_t<!std::is_same_v<FromT, T>>>
     explicit Tensor(const Tensor<FromT>& other) : Tensor(other.template CopyAsType<T>())
     {
     }
@@ -304,50 +534,29 @@ struct Tensor
 
     void SetZero() { ck::ranges::fill<T>(mData, 0); }
 
-    template <typename F>
-    void ForEach_impl(F&& f, std::vector<size_t>& idx, size_t rank)
-    {
-        if(rank == mDesc.GetNumOfDimension())
-        {
-            f(*this, idx);
-            return;
-        }
-        // else
-        for(size_t i = 0; i < mDesc.GetLengths()[rank]; i++)
-        {
-            idx[rank] = i;
-            ForEach_impl(std::forward<F>(f), idx, rank + 1);
-        }
-    }
-
+    // f(*this, idx) for every multi-index idx, in row-major order
     template <typename F>
     void ForEach(F&& f)
     {
-        std::vector<size_t> idx(mDesc.GetNumOfDimension(), 0);
-        ForEach_impl(std::forward<F>(f), idx, size_t(0));
+        ForEach_impl(*this, std::forward<F>(f));
     }
 
     template <typename F>
-    void ForEach_impl(const F&& f, std::vector<size_t>& idx, size_t rank) const
+    void ForEach(const F&& f) const
     {
-        if(rank == mDesc.GetNumOfDimension())
-        {
-            f(*this, idx);
-            return;
-        }
-        // else
-        for(size_t i = 0; i < mDesc.GetLengths()[rank]; i++)
-        {
-            idx[rank] = i;
-            ForEach_impl(std::forward<const F>(f), idx, rank + 1);
-        }
+        ForEach_impl(*this, std::forward<const F>(f));
     }
 
-    template <typename F>
-    void ForEach(const F&& f) const
+    // f(idx, offset) for every multi-index idx, idx a std::array of rank NDim and offset its
+    // position in mData, on num_thread threads
+    template <std::size_t NDim, typename F>
+    void ForEachIndex(F f, std::size_t num_thread = 1) const
     {
-        std::vector<size_t> idx(mDesc.GetNumOfDimension(), 0);
-        ForEach_impl(std::forward<const F>(f), idx, size_t(0));
+        host_tensor_for_each<NDim, 1>(
+            [&](const auto& idx, const auto& offsets) { f(idx, offsets[0]); },
+            to_host_tensor_array<NDim>(mDesc.GetLengths()),
+            {to_host_tensor_array<NDim>(mDesc.GetStrides())},
+            num_thread);
     }
 
     template <typename G>
@@ -355,58 +564,12 @@ struct Tensor
     {
         switch(mDesc.GetNumOfDimension())
         {
-        case 1: {
-            auto f = [&](auto i) { (*this)(i) = g(i); };
-            make_ParallelTensorFunctor(f, mDesc.GetLengths()[0])(num_thread);
-            break;
-        }
-        case 2: {
-            auto f = [&](auto i0, auto i1) { (*this)(i0, i1) = g(i0, i1); };
-            make_ParallelTensorFunctor(f, mDesc.GetLengths()[0], mDesc.GetLengths()[1])(num_thread);
-            break;
-        }
-        case 3: {
-            auto f = [&](auto i0, auto i1, auto i2) { (*this)(i0, i1, i2) = g(i0, i1, i2); };
-            make_ParallelTensorFunctor(
-                f, mDesc.GetLengths()[0], mDesc.GetLengths()[1], mDesc.GetLengths()[2])(num_thread);
-            break;
-        }
-        case 4: {
-            auto f = [&](auto i0, auto i1, auto i2, auto i3) {
-                (*this)(i0, i1, i2, i3) = g(i0, i1, i2, i3);
-            };
-            make_ParallelTensorFunctor(f,
-                                       mDesc.GetLengths()[0],
-                                       mDesc.GetLengths()[1],
-                                       mDesc.GetLengths()[2],
-                                       mDesc.GetLengths()[3])(num_thread);
-            break;
-        }
-        case 5: {
-            auto f = [&](auto i0, auto i1, auto i2, auto i3, auto i4) {
-                (*this)(i0, i1, i2, i3, i4) = g(i0, i1, i2, i3, i4);
-            };
-            make_ParallelTensorFunctor(f,
-                                       mDesc.GetLengths()[0],
-                                       mDesc.GetLengths()[1],
-                                       mDesc.GetLengths()[2],
-                                       mDesc.GetLengths()[3],
-                                       mDesc.GetLengths()[4])(num_thread);
-            break;
-        }
-        case 6: {
-            auto f = [&](auto i0, auto i1, auto i2, auto i3, auto i4, auto i5) {
-                (*this)(i0, i1, i2, i3, i4, i5) = g(i0, i1, i2, i3, i4, i5);
-            };
-            make_ParallelTensorFunctor(f,
-                                       mDesc.GetLengths()[0],
-                                       mDesc.GetLengths()[1],
-                                       mDesc.GetLengths()[2],
-                                       mDesc.GetLengths()[3],
-                                       mDesc.GetLengths()[4],
-                                       mDesc.GetLengths()[5])(num_thread);
-            break;
-        }
+        case 1: GenerateTensorValue_impl<1>(g, num_thread); break;
+        case 2: GenerateTensorValue_impl<2>(g, num_thread); break;
+        case 3: GenerateTensorValue_impl<3>(g, num_thread); break;
+        case 4: GenerateTensorValue_impl<4>(g, num_thread); break;
+        case 5: GenerateTensorValue_impl<5>(g, num_thread); break;
+        case 6: GenerateTensorValue_impl<6>(g, num_thread); break;
         default: throw std::runtime_error("unspported dimension");
         }
     }
@@ -423,12 +586,12 @@ struct Tensor
         return mData[mDesc.GetOffsetFromMultiIndex(is...)];
     }
 
-    T& operator()(std::vector<std::size_t> idx)
+    T& operator()(const std::vector<std::size_t>& idx)
     {
         return mData[mDesc.GetOffsetFromMultiIndex(idx)];
     }
 
-    const T& operator()(std::vector<std::size_t> idx) const
+    const T& operator()(const std::vector<std::size_t>& idx) const
     {
         return mData[mDesc.GetOffsetFromMultiIndex(idx)];
     }
@@ -469,4 +632,277 @@ struct Tensor
 
     Descriptor mDesc;
     Data mData;
+
+    private:
+    template <typename Self, typename F>
+    static void ForEach_impl(Self& self, F&& f)
+    {
+        const auto& lengths = self.mDesc.GetLengths();
+
+        if(std::find(lengths.begin(), lengths.end(), 0) != lengths.end())
+            return;
+
+        std::vector<size_t> idx(lengths.size(), 0);
+
+        for(;;)
+        {
+            f(self, idx);
+
+            // odometer: bump the innermost index, carry into the outer ones
+            std::size_t idim = idx.size();
+
+            for(; idim-- > 0;)
+            {
+                if(++idx[idim] < lengths[idim])
+                    break;
+
+                idx[idim] = 0;
+            }
+
+            if(idim == std::size_t(-1))
+                return;
+        }
+    }
+
+    template <std::size_t NDim, typename G>
+    void GenerateTensorValue_impl(G& g, std::size_t num_thread)
+    {
+        ForEachIndex<NDim>(
+            [&](const auto& idx, std::size_t offset) {
+                mData[offset] = std::apply(g, idx);
+            },
+            num_thread);
+    }
+};
+
+//
+// @brief      Tensor of compile-time rank NDim, on StaticRankHostTensorDescriptor.
+//
+// @paragraph
+//             Same storage as Tensor<T>, explicitly convertible both ways; use it where the
+//             rank is fixed and the tensor is indexed element by element in a hot loop.
+//
+template <typename T, std::size_t NDim, typename Allocator>
+struct Tensor
+{
+    using Descriptor = StaticRankHostTensorDescriptor<NDim>;
+    using Data       = std::vector<T, Allocator>;
+
+    template <typename U>
+    using RebindAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+    template <typename X>
+    Tensor(std::initializer_list<X> lens) : mDesc(lens), mData(mDesc.GetElementSpaceSize())
+    {
+    }
+
+    template <typename X, typename Y>
+    Tensor(std::initializer_list<X> lens, std::initializer_list<Y> strides)
+        : mDesc(lens, strides), mData(mDesc.GetElementSpaceSize())
+    {
+    }
+
+    Tensor(const Descriptor& desc) : mDesc(desc), mData(mDesc.GetElementSpaceSize()) {}
+
+    template <typename OtherAllocator>
+    explicit Tensor(const Tensor<T, HostTensorDynamicRank, OtherAllocator>& other)
+        : mDesc(other.mDesc), mData(other.mData.begin(), other.mData.end())
+    {
+    }
+
+    template <typename OutT>
+    Tensor<OutT, NDim, RebindAllocator<OutT>> CopyAsType() const
+    {
+        Tensor<OutT, NDim, RebindAllocator<OutT>> ret(mDesc);
+
+        ck::utils::bulk_type_convert(mData.data(), ret.mData.data(), mData.size());
+
+        return ret;
+    }
+
+    decltype(auto) GetLengths() const { return mDesc.GetLengths(); }
+
+    decltype(auto) GetStrides() const { return mDesc.GetStrides(); }
+
+    static constexpr std::size_t GetNumOfDimension() { return NDim; }
+
+    std::size_t GetElementSize() const { return mDesc.GetElementSize(); }
+
+    std::size_t GetElementSpaceSize() const { return mDesc.GetElementSpaceSize(); }
+
+    std::size_t GetElementSpaceSizeInBytes() const { return sizeof(T) * GetElementSpaceSize(); }
+
+    void SetZero() { ck::ranges::fill<T>(mData, 0); }
+
+    // f(idx, offset) for every multi-index idx, offset its position in mData
+    template <typename F>
+    void ForEachIndex(F f, std::size_t num_thread = 1) const
+    {
+        host_tensor_for_each<NDim, 1>(
+            [&](const auto& idx, const auto& offsets) { f(idx, offsets[0]); },
+            mDesc.GetLengths(),
+            {mDesc.GetStrides()},
+            num_thread);
+    }
+
+    template <typename G>
+    void GenerateTensorValue(G g, std::size_t num_thread = 1)
+    {
+        ForEachIndex(
+            [&](const auto& idx, std::size_t offset) { mData[offset] = std::apply(g, idx); },
+            num_thread);
+    }
+
+    template <typename... Is>
+    T& operator()(Is... is)
+    {
+        return mData[mDesc.GetOffsetFromMultiIndex(is...)];
+    }
+
+    template <typename... Is>
+    const T& operator()(Is... is) const
+    {
+        return mData[mDesc.GetOffsetFromMultiIndex(is...)];
+    }
+
+    T& operator()(const std::array<std::size_t, NDim>& idx)
+    {
+        return mData[mDesc.GetOffsetFromMultiIndex(idx)];
+    }
+
+    const T& operator()(const std::array<std::size_t, NDim>& idx) const
+    {
+        return mData[mDesc.GetOffsetFromMultiIndex(idx)];
+    }
+
+    typename Data::iterator begin() { return mData.begin(); }
+
+    typename Data::iterator end() { return mData.end(); }
+
+    typename Data::pointer data() { return mData.data(); }
+
+    typename Data::const_iterator begin() const { return mData.begin(); }
+
+    typename Data::const_iterator end() const { return mData.end(); }
+
+    typename Data::const_pointer data() const { return mData.data(); }
+
+    typename Data::size_type size() const { return mData.size(); }
+
+    Descriptor mDesc;
+    Data mData;
+};
+
+//
+// @brief      Non-owning strided view of host memory: a pointer and a HostTensorDescriptor.
+//
+// @paragraph
+//             Any Tensor converts to it implicitly, a const one only to a view of const T, so
+//             reference operators taking views are called with tensors as before; a view can also
+//             wrap any other buffer (an mmap'd file, a pinned staging buffer) without a copy.
+//             mData is the pointer, so the mDesc/mData indexing written for Tensor works as is.
+//
+// @paragraph
+//             Slice(dim, begin, end) narrows one dimension, Select(dim, i) removes one and
+//             Transpose(new2old) permutes them; all three return a view of the same memory. The
+//             viewed memory must outlive the view.
+//
+template <typename T>
+struct TensorView
+{
+    using Descriptor = HostTensorDescriptor;
+    using value_type = std::remove_const_t<T>;
+
+    TensorView(T* p_data, const Descriptor& desc) : mDesc(desc), mData(p_data) {}
+
+    template <typename U,
+              std::size_t NDim,
+              typename Allocator,
+              typename = std::enable_if_t<std::is_same_v<std::remove_const_t<T>, U>>>
+    TensorView(Tensor<U, NDim, Allocator>& tensor)
+        : mDesc(tensor.mDesc), mData(tensor.mData.data())
+    {
+    }
+
+    template <typename U,
+              std::size_t NDim,
+              typename Allocator,
+              typename = std::enable_if_t<std::is_const_v<T> &&
+                                          std::is_same_v<std::remove_const_t<T>, U>>>
+    TensorView(const Tensor<U, NDim, Allocator>& tensor)
+        : mDesc(tensor.mDesc), mData(tensor.mData.data())
+    {
+    }
+
+    // view of T -> view of const T
+    template <typename U,
+              typename = std::enable_if_t<std::is_const_v<T> &&
+                                          std::is_same_v<std::remove_const_t<T>, U>>>
+    TensorView(const TensorView<U>& other) : mDesc(other.mDesc), mData(other.mData)
+    {
+    }
+
+    decltype(auto) GetLengths() const { return mDesc.GetLengths(); }
+
+    decltype(auto) GetStrides() const { return mDesc.GetStrides(); }
+
+    std::size_t GetNumOfDimension() const { return mDesc.GetNumOfDimension(); }
+
+    std::size_t GetElementSize() const { return mDesc.GetElementSize(); }
+
+    std::size_t GetElementSpaceSize() const { return mDesc.GetElementSpaceSize(); }
+
+    // elements [begin, end) of dimension dim
+    TensorView Slice(std::size_t dim, std::size_t begin, std::size_t end) const
+    {
+        if(dim >= GetNumOfDimension() || begin > end || end > GetLengths()[dim])
+        {
+            throw std::runtime_error("wrong! slice out of range");
+        }
+
+        std::vector<std::size_t> lengths = GetLengths();
+
+        lengths[dim] = end - begin;
+
+        return TensorView(mData + begin * GetStrides()[dim], Descriptor(lengths, GetStrides()));
+    }
+
+    // element i of dimension dim, with that dimension removed
+    TensorView Select(std::size_t dim, std::size_t i) const
+    {
+        if(dim >= GetNumOfDimension() || i >= GetLengths()[dim])
+        {
+            throw std::runtime_error("wrong! select out of range");
+        }
+
+        std::vector<std::size_t> lengths = GetLengths();
+        std::vector<std::size_t> strides = GetStrides();
+
+        lengths.erase(lengths.begin() + dim);
+        strides.erase(strides.begin() + dim);
+
+        return TensorView(mData + i * GetStrides()[dim], Descriptor(lengths, strides));
+    }
+
+    template <typename New2Old>
+    TensorView Transpose(const New2Old& new2old) const
+    {
+        return TensorView(mData, transpose_host_tensor_descriptor_given_new2old(mDesc, new2old));
+    }
+
+    template <typename... Is>
+    T& operator()(Is... is) const
+    {
+        return mData[mDesc.GetOffsetFromMultiIndex(is...)];
+    }
+
+    T& operator()(const std::vector<std::size_t>& idx) const
+    {
+        return mData[mDesc.GetOffsetFromMultiIndex(idx)];
+    }
+
+    T* data() const { return mData; }
+
+    Descriptor mDesc;
+    T* mData;
 };
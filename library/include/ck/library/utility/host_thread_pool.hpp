@@ -0,0 +1,402 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ck {
+namespace utils {
+
+//
+// @brief      Process-wide pool of persistent worker threads for host code.
+//
+// @paragraph
+//             ParallelFor(n, f, num_thread, grain_size) calls f(begin, end) on chunks of
+//             grain_size consecutive indices covering [0, n), on up to num_thread threads, the
+//             calling one included, and returns when all chunks are done. The workers are started
+//             once, on first use, so a small problem costs a wake-up instead of a thread spawn.
+//
+// @paragraph
+//             Every participating thread starts on its own contiguous range of chunks, taken from
+//             the front. A thread that runs out steals chunks from the back of the other ranges,
+//             so irregular work balances itself while each thread still walks memory in order.
+//             grain_size 0 picks about 4 chunks per thread. A serial run (one thread, or one
+//             chunk) is a single f(0, n) call on the calling thread.
+//
+// @paragraph
+//             A ParallelFor issued from inside a running one (e.g. a GEMM run per batch entry of
+//             a parallel loop) runs serially on the calling thread instead of oversubscribing the
+//             machine. ParallelFor calls from different outside threads take turns. The first
+//             exception thrown by f stops the remaining chunks and is rethrown to the caller.
+//
+// @paragraph
+//             Threads float over the CPUs by default. PinThreads() pins them one per CPU, so the
+//             same part of every parallel loop runs on the same core, and on the same NUMA node
+//             as the pages it first touched (see HostMemoryPolicy::ParallelFirstTouch).
+//
+class HostThreadPool
+{
+    public:
+    static HostThreadPool& GetInstance()
+    {
+        static HostThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+
+        return pool;
+    }
+
+    explicit HostThreadPool(std::size_t num_worker)
+    {
+        for(std::size_t w = 0; w < num_worker; ++w)
+            workers_.emplace_back([this, w] { WorkerLoop(w); });
+    }
+
+    HostThreadPool(const HostThreadPool&) = delete;
+    HostThreadPool& operator=(const HostThreadPool&) = delete;
+
+    ~HostThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            is_stopped_ = true;
+        }
+
+        cv_work_.notify_all();
+
+        for(auto& worker : workers_)
+            worker.join();
+    }
+
+    // the workers and the calling thread
+    std::size_t GetNumThread() const { return workers_.size() + 1; }
+
+    // true on a worker, or on a thread currently running a ParallelFor
+    static bool IsInParallelRegion() { return GetInParallelRegion(); }
+
+    // pins participant p of a ParallelFor to the p-th CPU the calling thread may run on:
+    // participant 0 is the calling thread, which should be the one issuing the ParallelFor
+    // calls, participant p > 0 is worker p - 1; returns false if a thread could not be pinned
+    bool PinThreads()
+    {
+        std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+
+        if(!is_pinned_)
+        {
+            if(sched_getaffinity(0, sizeof(cpu_set_t), &unpinned_cpus_) != 0)
+                return false;
+
+            unpinned_thread_ = pthread_self();
+            is_pinned_       = true;
+        }
+
+        std::vector<int> cpus;
+
+        for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if(CPU_ISSET(cpu, &unpinned_cpus_))
+                cpus.push_back(cpu);
+        }
+
+        if(cpus.empty())
+            return false;
+
+        bool is_pinned = SetAffinity(pthread_self(), cpus[0]);
+
+        for(std::size_t w = 0; w < workers_.size(); ++w)
+        {
+            is_pinned = SetAffinity(workers_[w].native_handle(), cpus[(w + 1) % cpus.size()]) &&
+                        is_pinned;
+        }
+
+        return is_pinned;
+    }
+
+    // lets the threads PinThreads() pinned float over the CPUs they had before again
+    void UnpinThreads()
+    {
+        std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+
+        if(!is_pinned_)
+            return;
+
+        pthread_setaffinity_np(unpinned_thread_, sizeof(cpu_set_t), &unpinned_cpus_);
+
+        for(auto& worker : workers_)
+            pthread_setaffinity_np(worker.native_handle(), sizeof(cpu_set_t), &unpinned_cpus_);
+
+        is_pinned_ = false;
+    }
+
+    template <typename F>
+    void ParallelFor(std::size_t n, F f, std::size_t num_thread, std::size_t grain_size = 0)
+    {
+        if(n == 0)
+            return;
+
+        const std::size_t max_num_thread = std::max<std::size_t>(
+            1, IsInParallelRegion() ? 1 : std::min(num_thread, GetNumThread()));
+
+        if(grain_size == 0)
+            grain_size = std::max<std::size_t>(1, n / (4 * max_num_thread));
+
+        // chunk indices are packed in 32 bits
+        grain_size = std::max(grain_size, n / std::numeric_limits<uint32_t>::max() + 1);
+
+        const std::size_t num_chunk       = (n + grain_size - 1) / grain_size;
+        const std::size_t num_participant = std::min(max_num_thread, num_chunk);
+
+        if(num_participant <= 1)
+        {
+            f(std::size_t{0}, n);
+
+            return;
+        }
+
+        auto run = [](const void* p_f, std::size_t begin, std::size_t end) {
+            (*static_cast<const F*>(p_f))(begin, end);
+        };
+
+        Job job(run, &f, n, grain_size, num_chunk, num_participant);
+
+        std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            job_                 = &job;
+            job_num_participant_ = num_participant;
+
+            ++generation_;
+        }
+
+        cv_work_.notify_all();
+
+        RunParticipant(job, 0);
+
+        job.num_done_.fetch_add(1);
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            cv_done_.wait(lock, [&] { return job.num_done_.load() == num_participant; });
+
+            job_ = nullptr;
+        }
+
+        if(job.exception_)
+            std::rethrow_exception(job.exception_);
+    }
+
+    private:
+    // [front, back) of the chunks of one participant, packed to be updated in one atomic step
+    struct alignas(64) ChunkRange
+    {
+        std::atomic<uint64_t> front_back_;
+    };
+
+    struct Job
+    {
+        using RunFunc = void (*)(const void*, std::size_t, std::size_t);
+
+        Job(RunFunc run,
+            const void* p_f,
+            std::size_t n,
+            std::size_t grain_size,
+            std::size_t num_chunk,
+            std::size_t num_participant)
+            : run_{run},
+              p_f_{p_f},
+              n_{n},
+              grain_size_{grain_size},
+              num_participant_{num_participant},
+              ranges_{new ChunkRange[num_participant]}
+        {
+            for(std::size_t p = 0; p < num_participant; ++p)
+            {
+                const uint64_t front = p * num_chunk / num_participant;
+                const uint64_t back  = (p + 1) * num_chunk / num_participant;
+
+                ranges_[p].front_back_.store(front | (back << 32), std::memory_order_relaxed);
+            }
+        }
+
+        RunFunc run_;
+        const void* p_f_;
+
+        std::size_t n_;
+        std::size_t grain_size_;
+        std::size_t num_participant_;
+
+        std::unique_ptr<ChunkRange[]> ranges_;
+
+        std::atomic<std::size_t> num_done_{0};
+        std::atomic<bool> is_cancelled_{false};
+
+        std::mutex exception_mutex_;
+        std::exception_ptr exception_;
+    };
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    static bool SetAffinity(pthread_t thread, int cpu)
+    {
+        cpu_set_t cpus;
+
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+
+        return pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpus) == 0;
+    }
+
+    static bool& GetInParallelRegion()
+    {
+        thread_local bool is_in_parallel_region = false;
+
+        return is_in_parallel_region;
+    }
+
+    // the owner takes from the front, thieves from the back
+    static std::size_t TakeChunk(ChunkRange& range, bool is_owner)
+    {
+        uint64_t front_back = range.front_back_.load(std::memory_order_relaxed);
+
+        for(;;)
+        {
+            const uint64_t front = front_back & 0xffffffff;
+            const uint64_t back  = front_back >> 32;
+
+            if(front >= back)
+                return npos;
+
+            const uint64_t next =
+                is_owner ? (front + 1) | (back << 32) : front | ((back - 1) << 32);
+
+            if(range.front_back_.compare_exchange_weak(front_back, next))
+                return is_owner ? front : back - 1;
+        }
+    }
+
+    static void RunParticipant(Job& job, std::size_t p)
+    {
+        bool& is_in_parallel_region = GetInParallelRegion();
+
+        const bool was_in_parallel_region = is_in_parallel_region;
+
+        is_in_parallel_region = true;
+
+        for(std::size_t i = 0; i < job.num_participant_; ++i)
+        {
+            const std::size_t victim = (p + i) % job.num_participant_;
+
+            for(;;)
+            {
+                if(job.is_cancelled_.load(std::memory_order_relaxed))
+                    break;
+
+                const std::size_t chunk = TakeChunk(job.ranges_[victim], victim == p);
+
+                if(chunk == npos)
+                    break;
+
+                const std::size_t begin = chunk * job.grain_size_;
+                const std::size_t end   = std::min(begin + job.grain_size_, job.n_);
+
+                try
+                {
+                    job.run_(job.p_f_, begin, end);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(job.exception_mutex_);
+
+                    if(!job.exception_)
+                        job.exception_ = std::current_exception();
+
+                    job.is_cancelled_.store(true);
+                }
+            }
+        }
+
+        is_in_parallel_region = was_in_parallel_region;
+    }
+
+    void WorkerLoop(std::size_t w)
+    {
+        GetInParallelRegion() = true;
+
+        std::size_t generation = 0;
+
+        for(;;)
+        {
+            Job* job = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+
+                cv_work_.wait(lock, [&] { return is_stopped_ || generation_ != generation; });
+
+                if(is_stopped_)
+                    return;
+
+                generation = generation_;
+
+                // the caller is participant 0
+                if(w + 1 < job_num_participant_)
+                    job = job_;
+            }
+
+            if(job == nullptr)
+                continue;
+
+            RunParticipant(*job, w + 1);
+
+            // job lives on the stack of the caller, which may return as soon as the last
+            // participant is counted: nothing of it is read after the fetch_add
+            const std::size_t num_participant = job->num_participant_;
+
+            if(job->num_done_.fetch_add(1) + 1 == num_participant)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                cv_done_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+
+    // serializes ParallelFor calls from different threads, and pinning
+    std::mutex submit_mutex_;
+
+    // the CPUs and the calling thread of the first PinThreads() since the last UnpinThreads()
+    bool is_pinned_ = false;
+    cpu_set_t unpinned_cpus_{};
+    pthread_t unpinned_thread_{};
+
+    // guards the fields below
+    std::mutex mutex_;
+    std::condition_variable cv_work_;
+    std::condition_variable cv_done_;
+
+    Job* job_                        = nullptr;
+    std::size_t job_num_participant_ = 0;
+    std::size_t generation_          = 0;
+    bool is_stopped_                 = false;
+};
+
+} // namespace utils
+} // namespace ck
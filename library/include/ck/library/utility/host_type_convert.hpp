@@ -0,0 +1,225 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/span.hpp"
+#include "ck/library/utility/host_simd.hpp"
+
+namespace ck {
+namespace utils {
+
+namespace detail {
+
+template <typename Y, typename X>
+void bulk_type_convert_scalar(const X* p_in, Y* p_out, std::size_t n)
+{
+    for(std::size_t i = 0; i < n; ++i)
+        p_out[i] = ck::type_convert<Y>(p_in[i]);
+}
+
+#if CK_HOST_X86_SIMD
+__attribute__((target("avx2,f16c"))) inline std::size_t
+bulk_type_convert_f16_to_f32_avx2(const half_t* p_in, float* p_out, std::size_t n)
+{
+    std::size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m128i v_in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_in + i));
+
+        _mm256_storeu_ps(p_out + i, _mm256_cvtph_ps(v_in));
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2,f16c"))) inline std::size_t
+bulk_type_convert_f32_to_f16_avx2(const float* p_in, half_t* p_out, std::size_t n)
+{
+    std::size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m128i v_out = _mm256_cvtps_ph(_mm256_loadu_ps(p_in + i),
+                                              _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p_out + i), v_out);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) inline std::size_t
+bulk_type_convert_bf16_to_f32_avx2(const bhalf_t* p_in, float* p_out, std::size_t n)
+{
+    std::size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m128i v_in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p_in + i));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_out + i),
+                            _mm256_slli_epi32(_mm256_cvtepu16_epi32(v_in), 16));
+    }
+
+    return i;
+}
+
+// round to nearest even, NaN kept NaN; same bits as type_convert<bhalf_t>(float)
+__attribute__((target("avx2"))) inline __m256i bulk_type_convert_f32_to_bf16_avx2(__m256i u)
+{
+    const __m256i v_exp_mask = _mm256_set1_epi32(0x7f800000);
+    const __m256i v_one      = _mm256_set1_epi32(1);
+
+    const __m256i is_inf_nan = _mm256_cmpeq_epi32(_mm256_and_si256(u, v_exp_mask), v_exp_mask);
+
+    const __m256i v_round = _mm256_add_epi32(
+        _mm256_set1_epi32(0x7fff), _mm256_and_si256(_mm256_srli_epi32(u, 16), v_one));
+
+    const __m256i v_rounded = _mm256_add_epi32(u, v_round);
+
+    // set the lowest bf16 mantissa bit of a NaN whose payload would be truncated away
+    const __m256i is_low_zero = _mm256_cmpeq_epi32(
+        _mm256_and_si256(u, _mm256_set1_epi32(0xffff)), _mm256_setzero_si256());
+    const __m256i v_inf_nan =
+        _mm256_or_si256(u, _mm256_andnot_si256(is_low_zero, _mm256_set1_epi32(0x10000)));
+
+    return _mm256_srli_epi32(_mm256_blendv_epi8(v_rounded, v_inf_nan, is_inf_nan), 16);
+}
+
+__attribute__((target("avx2"))) inline std::size_t
+bulk_type_convert_f32_to_bf16_avx2(const float* p_in, bhalf_t* p_out, std::size_t n)
+{
+    std::size_t i = 0;
+
+    for(; i + 16 <= n; i += 16)
+    {
+        const __m256i v_lo = bulk_type_convert_f32_to_bf16_avx2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_in + i)));
+        const __m256i v_hi = bulk_type_convert_f32_to_bf16_avx2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p_in + i + 8)));
+
+        // packus works per 128-bit lane: [lo0-3 hi0-3 | lo4-7 hi4-7] -> [lo0-7 | hi0-7]
+        const __m256i v_out = _mm256_permute4x64_epi64(_mm256_packus_epi32(v_lo, v_hi), 0xD8);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_out + i), v_out);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) inline std::size_t
+bulk_type_convert_i8_to_f32_avx2(const int8_t* p_in, float* p_out, std::size_t n)
+{
+    std::size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m128i v_in = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p_in + i));
+
+        _mm256_storeu_ps(p_out + i, _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(v_in)));
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2"))) inline std::size_t
+bulk_type_convert_i8_to_i32_avx2(const int8_t* p_in, int32_t* p_out, std::size_t n)
+{
+    std::size_t i = 0;
+
+    for(; i + 8 <= n; i += 8)
+    {
+        const __m128i v_in = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p_in + i));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_out + i), _mm256_cvtepi8_epi32(v_in));
+    }
+
+    return i;
+}
+#endif // CK_HOST_X86_SIMD
+
+// converts the longest prefix a SIMD kernel handles, returns its length
+template <typename Y, typename X>
+std::size_t bulk_type_convert_simd([[maybe_unused]] const X* p_in,
+                                   [[maybe_unused]] Y* p_out,
+                                   [[maybe_unused]] std::size_t n)
+{
+#if CK_HOST_X86_SIMD
+    if(!__builtin_cpu_supports("avx2"))
+        return 0;
+
+    if constexpr(is_same_v<X, half_t> && is_same_v<Y, float>)
+    {
+        if(__builtin_cpu_supports("f16c"))
+            return bulk_type_convert_f16_to_f32_avx2(p_in, p_out, n);
+    }
+    else if constexpr(is_same_v<X, float> && is_same_v<Y, half_t>)
+    {
+        if(__builtin_cpu_supports("f16c"))
+            return bulk_type_convert_f32_to_f16_avx2(p_in, p_out, n);
+    }
+    else if constexpr(is_same_v<X, bhalf_t> && is_same_v<Y, float>)
+    {
+        return bulk_type_convert_bf16_to_f32_avx2(p_in, p_out, n);
+    }
+    else if constexpr(is_same_v<X, float> && is_same_v<Y, bhalf_t>)
+    {
+        return bulk_type_convert_f32_to_bf16_avx2(p_in, p_out, n);
+    }
+    else if constexpr(is_same_v<X, int8_t> && is_same_v<Y, float>)
+    {
+        return bulk_type_convert_i8_to_f32_avx2(p_in, p_out, n);
+    }
+    else if constexpr(is_same_v<X, int8_t> && is_same_v<Y, int32_t>)
+    {
+        return bulk_type_convert_i8_to_i32_avx2(p_in, p_out, n);
+    }
+#endif
+
+    return 0;
+}
+
+} // namespace detail
+
+//
+// @brief      p_out[i] = ck::type_convert<Y>(p_in[i]) for i in [0, n), in bulk.
+//
+// @paragraph
+//             Produces exactly the bits of the element-wise type_convert. fp16 <-> fp32 runs on
+//             F16C, bf16 <-> fp32 and int8 widening on AVX2 integer SIMD; other pairs (int4
+//             included) are a plain loop the compiler is free to vectorize. The ranges must not
+//             overlap.
+//
+template <typename Y, typename X>
+void bulk_type_convert(const X* p_in, Y* p_out, std::size_t n)
+{
+    if constexpr(is_same_v<X, Y>)
+    {
+        std::copy(p_in, p_in + n, p_out);
+    }
+    else
+    {
+        const std::size_t n_simd = detail::bulk_type_convert_simd(p_in, p_out, n);
+
+        detail::bulk_type_convert_scalar(p_in + n_simd, p_out + n_simd, n - n_simd);
+    }
+}
+
+// converts the first min(in.size(), out.size()) elements
+template <typename Y, typename X>
+void bulk_type_convert(span<const X> in, span<Y> out)
+{
+    bulk_type_convert(in.data(), out.data(), std::min(in.size(), out.size()));
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_type_convert.hpp"
+
+namespace {
+
+using ck::bhalf_t;
+using ck::half_t;
+
+template <typename T>
+bool is_nan(T x)
+{
+    return std::isnan(ck::type_convert<float>(x));
+}
+
+// bulk conversion against the element-wise type_convert, bit for bit; a NaN only has to stay
+// NaN, the payload may be quieted differently
+template <typename Y, typename X>
+void test_bulk_type_convert(const std::vector<X>& in)
+{
+    std::vector<Y> out(in.size());
+
+    ck::utils::bulk_type_convert(in.data(), out.data(), in.size());
+
+    for(std::size_t i = 0; i < in.size(); ++i)
+    {
+        const Y expected = ck::type_convert<Y>(in[i]);
+
+        if constexpr(std::is_integral_v<Y>)
+        {
+            ASSERT_EQ(out[i], expected) << "element " << i;
+        }
+        else if(is_nan(expected))
+        {
+            ASSERT_TRUE(is_nan(out[i])) << "element " << i;
+        }
+        else
+        {
+            ASSERT_EQ(std::memcmp(&out[i], &expected, sizeof(Y)), 0) << "element " << i;
+        }
+    }
+}
+
+// every 16-bit pattern, plus a tail the SIMD loop does not cover
+template <typename T>
+std::vector<T> get_all_16bit_values()
+{
+    std::vector<T> values(65536 + 5);
+
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        const uint16_t bits = static_cast<uint16_t>(i);
+
+        std::memcpy(&values[i], &bits, sizeof(bits));
+    }
+
+    return values;
+}
+
+// random bit patterns, with the special values and the bf16 rounding ties spelled out
+std::vector<float> get_f32_values()
+{
+    std::vector<float> values = {0.f,
+                                 -0.f,
+                                 1.f,
+                                 std::numeric_limits<float>::denorm_min(),
+                                 std::numeric_limits<float>::min(),
+                                 std::numeric_limits<float>::max(),
+                                 -std::numeric_limits<float>::max(),
+                                 std::numeric_limits<float>::infinity(),
+                                 -std::numeric_limits<float>::infinity(),
+                                 std::numeric_limits<float>::quiet_NaN(),
+                                 std::numeric_limits<float>::signaling_NaN(),
+                                 65504.f,
+                                 65520.f,
+                                 1e-8f};
+
+    // 1 + 2^-8 and 1 + 3 * 2^-8 are bf16 ties, 0x7f800001 a NaN with only low payload bits
+    for(uint32_t bits : {0x3f808000u, 0x3f818000u, 0x7f800001u, 0xff800001u, 0x7f7fffffu})
+    {
+        float value;
+
+        std::memcpy(&value, &bits, sizeof(bits));
+
+        values.push_back(value);
+    }
+
+    std::mt19937 gen(11939);
+
+    while(values.size() < 100003)
+    {
+        const uint32_t bits = gen();
+
+        float value;
+
+        std::memcpy(&value, &bits, sizeof(bits));
+
+        values.push_back(value);
+    }
+
+    return values;
+}
+
+} // namespace
+
+TEST(BulkTypeConvert, F16ToF32) { test_bulk_type_convert<float>(get_all_16bit_values<half_t>()); }
+
+TEST(BulkTypeConvert, F32ToF16) { test_bulk_type_convert<half_t>(get_f32_values()); }
+
+TEST(BulkTypeConvert, BF16ToF32)
+{
+    test_bulk_type_convert<float>(get_all_16bit_values<bhalf_t>());
+}
+
+TEST(BulkTypeConvert, F32ToBF16) { test_bulk_type_convert<bhalf_t>(get_f32_values()); }
+
+TEST(BulkTypeConvert, I8Widening)
+{
+    std::vector<int8_t> values;
+
+    for(int i = 0; i < 1000; ++i)
+        values.push_back(static_cast<int8_t>(i % 256 - 128));
+
+    test_bulk_type_convert<float>(values);
+    test_bulk_type_convert<int32_t>(values);
+}
+
+TEST(BulkTypeConvert, Generic)
+{
+    test_bulk_type_convert<double>(get_f32_values());
+    test_bulk_type_convert<int8_t>(std::vector<int32_t>{-128, -1, 0, 1, 127});
+}
+
+TEST(BulkTypeConvert, CopyAsType)
+{
+    Tensor<float> x(std::vector<std::size_t>{37, 129});
+
+    ck::utils::FillUniformDistribution<float>{-3.f, 3.f}(x);
+
+    const auto y = x.CopyAsType<bhalf_t>();
+
+    for(std::size_t i = 0; i < x.mData.size(); ++i)
+        ASSERT_EQ(y.mData[i], ck::type_convert<bhalf_t>(x.mData[i])) << "element " << i;
+}
+
+TEST(BulkTypeConvert, FillUniformDistribution)
+{
+    // the generated values do not depend on the conversion being done in bulk
+    std::vector<bhalf_t> x(5000);
+    std::vector<bhalf_t> x_ref(x.size());
+
+    ck::utils::FillUniformDistribution<bhalf_t>{-3.f, 3.f}(x);
+
+    std::mt19937 gen(11939);
+    std::uniform_real_distribution<float> dis(-3.f, 3.f);
+
+    for(auto& v : x_ref)
+        v = ck::type_convert<bhalf_t>(dis(gen));
+
+    EXPECT_EQ(x, x_ref);
+
+    EXPECT_TRUE(ck::utils::check_err(x, x_ref));
+
+    x[4321] = ck::type_convert<bhalf_t>(100.f);
+
+    EXPECT_FALSE(ck::utils::check_err(x, x_ref));
+}
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_allocator.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+using ck::utils::HostAllocator;
+using ck::utils::HostMemoryPolicy;
+
+namespace {
+
+template <HostMemoryPolicy Policy>
+void test_host_allocator()
+{
+    using Allocator = HostAllocator<float, Policy>;
+
+    using DoubleAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<double>;
+
+    static_assert(std::is_same_v<DoubleAllocator, HostAllocator<double, Policy>>);
+
+    // below, at and above the 2 MiB mapping threshold
+    for(std::size_t n : {1, 1000, 512 * 1024, 3 * 1000 * 1000 + 7})
+    {
+        std::vector<float, Allocator> v(n);
+
+        const auto address = reinterpret_cast<std::uintptr_t>(v.data());
+
+        EXPECT_EQ(address % 64, 0);
+
+        if(Policy != HostMemoryPolicy::Aligned && n * sizeof(float) >= (std::size_t{2} << 20))
+            EXPECT_EQ(address % (std::size_t{2} << 20), 0);
+
+        bool is_zero = true;
+
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            is_zero = is_zero && v[i] == 0.f;
+
+            v[i] = static_cast<float>(i);
+        }
+
+        EXPECT_TRUE(is_zero);
+
+        // grow through a reallocation
+        v.resize(2 * n + 1, 1.f);
+
+        bool is_kept = true;
+
+        for(std::size_t i = 0; i < n; ++i)
+            is_kept = is_kept && v[i] == static_cast<float>(i);
+
+        EXPECT_TRUE(is_kept);
+        EXPECT_EQ(v.back(), 1.f);
+    }
+}
+
+} // anonymous namespace
+
+TEST(HostAllocator, Aligned) { test_host_allocator<HostMemoryPolicy::Aligned>(); }
+
+TEST(HostAllocator, HugePage) { test_host_allocator<HostMemoryPolicy::HugePage>(); }
+
+TEST(HostAllocator, NumaInterleave) { test_host_allocator<HostMemoryPolicy::NumaInterleave>(); }
+
+TEST(HostAllocator, ParallelFirstTouch)
+{
+    test_host_allocator<HostMemoryPolicy::ParallelFirstTouch>();
+}
+
+TEST(HostAllocator, Tensor)
+{
+    using Allocator   = HostAllocator<float, HostMemoryPolicy::ParallelFirstTouch>;
+    using HostTensor  = Tensor<float, HostTensorDynamicRank, Allocator>;
+    using HostTensor3 = Tensor<float, 3, Allocator>;
+
+    HostTensor t({64, 128, 128});
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(t.data()) % (std::size_t{2} << 20), 0);
+
+    t.GenerateTensorValue([](auto... is) { return static_cast<float>((is + ...)); }, 4);
+
+    // the allocator is kept by a type conversion
+    const auto t_f16 = t.CopyAsType<ck::half_t>();
+
+    static_assert(std::is_same_v<decltype(t_f16.mData)::allocator_type,
+                                 HostAllocator<ck::half_t, HostMemoryPolicy::ParallelFirstTouch>>);
+
+    EXPECT_EQ(ck::type_convert<float>(t_f16(1, 2, 3)), 6.f);
+
+    // to and from plain tensors and static rank tensors
+    const Tensor<float> plain(t);
+    const HostTensor round_trip(plain);
+    const HostTensor3 static_rank(plain);
+
+    EXPECT_TRUE(round_trip.mData == t.mData);
+    EXPECT_EQ(static_rank(63, 127, 127), 317.f);
+
+    // and into reference operators through a view
+    const TensorView<const float> view = t;
+
+    EXPECT_EQ(view(10, 20, 30), 60.f);
+}
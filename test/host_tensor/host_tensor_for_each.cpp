@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_tensor.hpp"
+
+TEST(HostTensorOdometer, MatchesDivision)
+{
+    const std::array<std::size_t, 3> lengths{3, 1, 5};
+    const std::array<std::array<std::size_t, 3>, 2> strides{{{5, 5, 1}, {1, 7, 3}}};
+
+    // every start, every following index
+    for(std::size_t start = 0; start < 15; ++start)
+    {
+        HostTensorOdometer<3, 2> odometer(lengths, strides, start);
+
+        for(std::size_t i = start; i < 15; ++i, odometer.Next())
+        {
+            const std::array<std::size_t, 3> idx{i / 5, 0, i % 5};
+
+            ASSERT_TRUE(odometer.mIdx == idx);
+            ASSERT_EQ(odometer.mOffsets[0], idx[0] * 5 + idx[2]);
+            ASSERT_EQ(odometer.mOffsets[1], idx[0] * 1 + idx[2] * 3);
+        }
+    }
+}
+
+TEST(HostTensorForEach, Offsets)
+{
+    const std::array<std::size_t, 4> lengths{2, 3, 4, 5};
+    const std::array<std::array<std::size_t, 4>, 2> strides{{{60, 20, 5, 1}, {1, 2, 6, 24}}};
+
+    for(std::size_t num_thread : {1, 4})
+        for(std::size_t grain_size : {0, 1, 7, 1000})
+        {
+            std::vector<std::atomic<int>> counts(120);
+
+            host_tensor_for_each<4, 2>(
+                [&](const auto& idx, const auto& offsets) {
+                    std::size_t offset_0 = 0;
+                    std::size_t offset_1 = 0;
+
+                    for(std::size_t d = 0; d < 4; ++d)
+                    {
+                        offset_0 += idx[d] * strides[0][d];
+                        offset_1 += idx[d] * strides[1][d];
+                    }
+
+                    EXPECT_EQ(offsets[0], offset_0);
+                    EXPECT_EQ(offsets[1], offset_1);
+
+                    counts[offsets[0]].fetch_add(1);
+                },
+                lengths,
+                strides,
+                num_thread,
+                grain_size);
+
+            for(const auto& count : counts)
+                ASSERT_EQ(count.load(), 1);
+        }
+}
+
+TEST(HostTensorForEach, ForEachOrder)
+{
+    Tensor<int> t({2, 3, 4}, {1, 2, 6});
+
+    std::vector<std::vector<std::size_t>> visited;
+
+    t.ForEach([&](auto& self, const auto& idx) {
+        self(idx) = static_cast<int>(visited.size());
+        visited.push_back(idx);
+    });
+
+    ASSERT_EQ(visited.size(), 24);
+
+    for(std::size_t i = 0; i < visited.size(); ++i)
+    {
+        const std::vector<std::size_t> idx{i / 12, i / 4 % 3, i % 4};
+
+        ASSERT_TRUE(visited[i] == idx);
+        ASSERT_EQ(t(idx[0], idx[1], idx[2]), static_cast<int>(i));
+    }
+
+    // a zero length has no element
+    Tensor<int> empty({2, 0, 3});
+
+    std::size_t num_visited = 0;
+
+    empty.ForEach([&](auto&, const auto&) { ++num_visited; });
+
+    EXPECT_EQ(num_visited, 0);
+}
+
+TEST(HostTensorForEach, ForEachIndex)
+{
+    Tensor<int> t({4, 5, 6}, {1, 4, 20});
+
+    // generators take any rank, as those of host_tensor_generator.hpp
+    auto digits = [](auto... is) {
+        int v = 0;
+        ((v = v * 10 + static_cast<int>(is)), ...);
+        return v;
+    };
+
+    t.GenerateTensorValue(digits, 4);
+
+    for(std::size_t i0 = 0; i0 < 4; ++i0)
+        for(std::size_t i1 = 0; i1 < 5; ++i1)
+            for(std::size_t i2 = 0; i2 < 6; ++i2)
+                ASSERT_EQ(t(i0, i1, i2), static_cast<int>(i0 * 100 + i1 * 10 + i2));
+
+    std::atomic<int> sum{0};
+
+    t.ForEachIndex<3>(
+        [&](const std::array<std::size_t, 3>& idx, std::size_t offset) {
+            EXPECT_EQ(t.mData[offset], t(idx[0], idx[1], idx[2]));
+
+            sum.fetch_add(t.mData[offset]);
+        },
+        4);
+
+    // sums of i0, i1 and i2 times the number of values of the other two
+    EXPECT_EQ(sum.load(), 100 * 6 * 30 + 10 * 10 * 24 + 15 * 20);
+
+    EXPECT_THROW(t.ForEachIndex<2>([](const auto&, std::size_t) {}), std::runtime_error);
+}
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_tensor.hpp"
+
+TEST(StaticRankHostTensorDescriptor, MatchesDynamic)
+{
+    const HostTensorDescriptor dynamic_desc({2, 3, 4, 5}, {1, 2, 6, 24});
+
+    const StaticRankHostTensorDescriptor<4> static_desc(dynamic_desc);
+
+    EXPECT_EQ(static_desc.GetNumOfDimension(), 4);
+    EXPECT_EQ(static_desc.GetElementSize(), dynamic_desc.GetElementSize());
+    EXPECT_EQ(static_desc.GetElementSpaceSize(), dynamic_desc.GetElementSpaceSize());
+
+    for(std::size_t i0 = 0; i0 < 2; ++i0)
+        for(std::size_t i1 = 0; i1 < 3; ++i1)
+            for(std::size_t i2 = 0; i2 < 4; ++i2)
+                for(std::size_t i3 = 0; i3 < 5; ++i3)
+                {
+                    const std::size_t offset =
+                        dynamic_desc.GetOffsetFromMultiIndex(i0, i1, i2, i3);
+
+                    ASSERT_EQ(static_desc.GetOffsetFromMultiIndex(i0, i1, i2, i3), offset);
+                    ASSERT_EQ(static_desc.GetOffsetFromMultiIndex({i0, i1, i2, i3}), offset);
+                }
+
+    // back to the dynamic descriptor
+    const HostTensorDescriptor round_trip = static_desc;
+
+    EXPECT_TRUE(round_trip.GetLengths() == dynamic_desc.GetLengths());
+    EXPECT_TRUE(round_trip.GetStrides() == dynamic_desc.GetStrides());
+
+    // packed strides from lengths alone
+    const StaticRankHostTensorDescriptor<3> packed_desc({2, 3, 4});
+
+    EXPECT_TRUE(packed_desc.GetStrides() == (std::array<std::size_t, 3>{12, 4, 1}));
+
+    using Descriptor3 = StaticRankHostTensorDescriptor<3>;
+
+    EXPECT_THROW(static_cast<void>(Descriptor3(dynamic_desc)), std::runtime_error);
+}
+
+TEST(StaticRankTensor, Conversion)
+{
+    Tensor<float, 3> t({3, 4, 5}, {1, 3, 12});
+
+    auto digits = [](auto... is) {
+        int v = 0;
+        ((v = v * 10 + static_cast<int>(is)), ...);
+        return static_cast<float>(v);
+    };
+
+    t.GenerateTensorValue(digits, 4);
+
+    for(std::size_t i0 = 0; i0 < 3; ++i0)
+        for(std::size_t i1 = 0; i1 < 4; ++i1)
+            for(std::size_t i2 = 0; i2 < 5; ++i2)
+                ASSERT_EQ(t(i0, i1, i2), digits(i0, i1, i2));
+
+    // to and from Tensor<T>, same elements at the same offsets
+    const Tensor<float> dynamic_t(t);
+
+    EXPECT_TRUE(dynamic_t.mData == t.mData);
+    EXPECT_EQ(dynamic_t(2, 3, 4), t(2, 3, 4));
+
+    const Tensor<float, 3> static_t(dynamic_t);
+
+    EXPECT_TRUE(static_t.mData == t.mData);
+    EXPECT_TRUE(static_t.GetStrides() == t.GetStrides());
+
+    using Tensor2 = Tensor<float, 2>;
+
+    EXPECT_THROW(static_cast<void>(Tensor2(dynamic_t)), std::runtime_error);
+
+    const auto t_int = t.CopyAsType<int>();
+
+    t.ForEachIndex([&](const std::array<std::size_t, 3>& idx, std::size_t offset) {
+        EXPECT_EQ(t_int(idx), static_cast<int>(t.mData[offset]));
+    });
+}
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace {
+
+// value 100 * i0 + 10 * i1 + i2 at (i0, i1, i2)
+Tensor<float> make_digit_tensor()
+{
+    Tensor<float> t({3, 4, 5});
+
+    t.GenerateTensorValue([](auto... is) {
+        int v = 0;
+        ((v = v * 10 + static_cast<int>(is)), ...);
+        return static_cast<float>(v);
+    });
+
+    return t;
+}
+
+} // anonymous namespace
+
+TEST(TensorView, FromTensor)
+{
+    Tensor<float> t = make_digit_tensor();
+
+    TensorView<float> view = t;
+
+    EXPECT_EQ(view.data(), t.mData.data());
+    EXPECT_EQ(view.GetNumOfDimension(), 3);
+    EXPECT_EQ(view.GetElementSize(), t.GetElementSize());
+    EXPECT_TRUE(view.GetLengths() == t.GetLengths());
+    EXPECT_TRUE(view.GetStrides() == t.GetStrides());
+    EXPECT_EQ(view(2, 3, 4), 234.f);
+    EXPECT_EQ(view(std::vector<std::size_t>{1, 2, 3}), 123.f);
+
+    // writes go to the tensor
+    view(0, 0, 0) = -1.f;
+
+    EXPECT_EQ(t(0, 0, 0), -1.f);
+
+    // a const tensor only gives a view of const elements
+    const Tensor<float>& const_t = t;
+
+    TensorView<const float> const_view = const_t;
+
+    EXPECT_EQ(const_view(1, 1, 1), 111.f);
+
+    static_assert(std::is_convertible_v<Tensor<float>&, TensorView<const float>>);
+    static_assert(std::is_convertible_v<TensorView<float>, TensorView<const float>>);
+    static_assert(!std::is_convertible_v<const Tensor<float>&, TensorView<float>>);
+    static_assert(!std::is_convertible_v<TensorView<const float>, TensorView<float>>);
+    static_assert(!std::is_convertible_v<Tensor<double>&, TensorView<const float>>);
+
+    // a static rank tensor too
+    Tensor<float, 2> t2({2, 3});
+
+    TensorView<float> view2 = t2;
+
+    view2(1, 2) = 7.f;
+
+    EXPECT_EQ(t2(1, 2), 7.f);
+}
+
+TEST(TensorView, ExternalBuffer)
+{
+    // column-major 2 x 3 in a plain buffer
+    std::vector<int> buffer{0, 1, 2, 3, 4, 5};
+
+    const TensorView<const int> view(buffer.data(), HostTensorDescriptor({2, 3}, {1, 2}));
+
+    EXPECT_EQ(view(0, 0), 0);
+    EXPECT_EQ(view(1, 0), 1);
+    EXPECT_EQ(view(0, 2), 4);
+    EXPECT_EQ(view(1, 2), 5);
+}
+
+TEST(TensorView, Slicing)
+{
+    Tensor<float> t = make_digit_tensor();
+
+    TensorView<float> view = t;
+
+    const auto slice = view.Slice(1, 1, 3);
+
+    EXPECT_TRUE(slice.GetLengths() == (std::vector<std::size_t>{3, 2, 5}));
+    EXPECT_TRUE(slice.GetStrides() == t.GetStrides());
+
+    for(std::size_t i0 = 0; i0 < 3; ++i0)
+        for(std::size_t i1 = 0; i1 < 2; ++i1)
+            for(std::size_t i2 = 0; i2 < 5; ++i2)
+                ASSERT_EQ(slice(i0, i1, i2), t(i0, i1 + 1, i2));
+
+    const auto row = view.Select(0, 2).Select(0, 1);
+
+    EXPECT_EQ(row.GetNumOfDimension(), 1);
+    EXPECT_EQ(row.GetElementSize(), 5);
+
+    for(std::size_t i2 = 0; i2 < 5; ++i2)
+        ASSERT_EQ(row(i2), 210.f + i2);
+
+    const auto column = view.Select(2, 3);
+
+    EXPECT_TRUE(column.GetLengths() == (std::vector<std::size_t>{3, 4}));
+    EXPECT_EQ(column(2, 1), 213.f);
+
+    const auto transposed = view.Transpose(std::vector<std::size_t>{2, 0, 1});
+
+    EXPECT_TRUE(transposed.GetLengths() == (std::vector<std::size_t>{5, 3, 4}));
+    EXPECT_EQ(transposed(4, 1, 2), 124.f);
+
+    // all of them alias the tensor
+    column(0, 0) = -1.f;
+
+    EXPECT_EQ(t(0, 0, 3), -1.f);
+
+    // an empty slice is allowed
+    EXPECT_EQ(view.Slice(0, 3, 3).GetElementSize(), 0);
+
+    EXPECT_THROW(static_cast<void>(view.Slice(3, 0, 1)), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(view.Slice(1, 2, 5)), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(view.Slice(1, 3, 2)), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(view.Select(2, 5)), std::runtime_error);
+}
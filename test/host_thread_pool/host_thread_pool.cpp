@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+using ck::utils::HostThreadPool;
+
+namespace {
+
+// every index visited exactly once, whatever the chunking; a serial run is a single call
+void test_parallel_for(HostThreadPool& pool,
+                       std::size_t n,
+                       std::size_t num_thread,
+                       std::size_t grain_size)
+{
+    std::vector<std::atomic<int>> counts(n);
+
+    pool.ParallelFor(
+        n,
+        [&](std::size_t begin, std::size_t end) {
+            EXPECT_LT(begin, end);
+            EXPECT_LE(end, n);
+
+            if(num_thread > 1 && grain_size != 0)
+            {
+                EXPECT_LE(end - begin, grain_size);
+            }
+
+            for(std::size_t i = begin; i < end; ++i)
+                counts[i].fetch_add(1);
+        },
+        num_thread,
+        grain_size);
+
+    for(std::size_t i = 0; i < n; ++i)
+        ASSERT_EQ(counts[i].load(), 1) << "n " << n << " i " << i;
+}
+
+} // namespace
+
+TEST(HostThreadPool, Coverage)
+{
+    // more threads than cores on purpose: the steal paths run even on a single core
+    HostThreadPool pool(3);
+
+    EXPECT_EQ(pool.GetNumThread(), 4);
+
+    for(std::size_t n : {0, 1, 2, 7, 64, 1000, 12345})
+        for(std::size_t num_thread : {1, 2, 4, 16})
+            for(std::size_t grain_size : {0, 1, 3, 100})
+                test_parallel_for(pool, n, num_thread, grain_size);
+}
+
+TEST(HostThreadPool, IrregularWork)
+{
+    HostThreadPool pool(3);
+
+    std::atomic<std::size_t> sum{0};
+
+    // the first chunks are much more expensive, the others have to steal them
+    pool.ParallelFor(
+        256,
+        [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                if(i < 16)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+                sum.fetch_add(i);
+            }
+        },
+        4,
+        1);
+
+    EXPECT_EQ(sum.load(), 256 * 255 / 2);
+}
+
+TEST(HostThreadPool, Nested)
+{
+    HostThreadPool pool(3);
+
+    std::vector<std::atomic<int>> counts(64 * 64);
+
+    pool.ParallelFor(
+        64,
+        [&](std::size_t begin, std::size_t end) {
+            EXPECT_TRUE(HostThreadPool::IsInParallelRegion());
+
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                // runs inline on the calling thread
+                const auto thread_id = std::this_thread::get_id();
+
+                pool.ParallelFor(
+                    64,
+                    [&](std::size_t inner_begin, std::size_t inner_end) {
+                        EXPECT_EQ(std::this_thread::get_id(), thread_id);
+
+                        for(std::size_t j = inner_begin; j < inner_end; ++j)
+                            counts[i * 64 + j].fetch_add(1);
+                    },
+                    4);
+            }
+        },
+        4,
+        1);
+
+    EXPECT_FALSE(HostThreadPool::IsInParallelRegion());
+
+    for(const auto& count : counts)
+        ASSERT_EQ(count.load(), 1);
+}
+
+TEST(HostThreadPool, Exception)
+{
+    HostThreadPool pool(3);
+
+    auto throw_at_42 = [](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i)
+            if(i == 42)
+                throw std::runtime_error("wrong! 42");
+    };
+
+    EXPECT_THROW(pool.ParallelFor(100, throw_at_42, 4, 1), std::runtime_error);
+    EXPECT_THROW(pool.ParallelFor(100, throw_at_42, 1), std::runtime_error);
+
+    // the pool is still usable
+    test_parallel_for(pool, 1000, 4, 7);
+}
+
+TEST(HostThreadPool, BackToBack)
+{
+    HostThreadPool pool(3);
+
+    // short jobs one right after another: every Job lives on the stack of ParallelFor, at the
+    // same address each time, and must not be touched by a worker once the call returned
+    for(int r = 0; r < 20000; ++r)
+    {
+        std::atomic<std::size_t> sum{0};
+
+        pool.ParallelFor(
+            8,
+            [&](std::size_t begin, std::size_t end) {
+                for(std::size_t i = begin; i < end; ++i)
+                    sum.fetch_add(i + 1);
+            },
+            4,
+            1);
+
+        ASSERT_EQ(sum.load(), 36);
+    }
+}
+
+TEST(HostThreadPool, ConcurrentCallers)
+{
+    HostThreadPool pool(3);
+
+    std::vector<std::thread> callers;
+
+    for(int t = 0; t < 4; ++t)
+        callers.emplace_back([&] {
+            for(int r = 0; r < 50; ++r)
+                test_parallel_for(pool, 333, 4, 0);
+        });
+
+    for(auto& caller : callers)
+        caller.join();
+}
+
+TEST(HostThreadPool, Pinning)
+{
+    cpu_set_t cpus_before;
+
+    ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set_t), &cpus_before), 0);
+
+    std::vector<int> cpus;
+
+    for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if(CPU_ISSET(cpu, &cpus_before))
+            cpus.push_back(cpu);
+
+    HostThreadPool pool(3);
+
+    ASSERT_TRUE(pool.PinThreads());
+
+    // the calling thread is participant 0
+    EXPECT_EQ(sched_getcpu(), cpus[0]);
+
+    std::vector<std::atomic<int>> num_run_on_cpu(CPU_SETSIZE);
+
+    pool.ParallelFor(
+        1000,
+        [&](std::size_t, std::size_t) { num_run_on_cpu[sched_getcpu()].fetch_add(1); },
+        4,
+        1);
+
+    // only the CPUs of the 4 participants are used
+    cpus.resize(std::min<std::size_t>(4, cpus.size()));
+
+    int num_run = 0;
+
+    for(int cpu : cpus)
+        num_run += num_run_on_cpu[cpu].load();
+
+    EXPECT_EQ(num_run, 1000);
+
+    // pinning again is harmless, unpinning restores the CPU set of the calling thread
+    EXPECT_TRUE(pool.PinThreads());
+
+    pool.UnpinThreads();
+
+    cpu_set_t cpus_after;
+
+    ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set_t), &cpus_after), 0);
+
+    EXPECT_TRUE(CPU_EQUAL(&cpus_before, &cpus_after));
+
+    test_parallel_for(pool, 1000, 4, 7);
+}
+
+TEST(HostThreadPool, ParallelTensorFunctor)
+{
+    Tensor<int> t({5, 7, 11});
+
+    auto f = [&](auto i0, auto i1, auto i2) { t(i0, i1, i2) += i0 * 100 + i1 * 10 + i2 + 1; };
+
+    make_ParallelTensorFunctor(f, 5, 7, 11)(4);
+    make_ParallelTensorFunctor(f, 5, 7, 11)(4, 3);
+
+    for(std::size_t i0 = 0; i0 < 5; ++i0)
+        for(std::size_t i1 = 0; i1 < 7; ++i1)
+            for(std::size_t i2 = 0; i2 < 11; ++i2)
+                ASSERT_EQ(t(i0, i1, i2), static_cast<int>(2 * (i0 * 100 + i1 * 10 + i2 + 1)));
+}
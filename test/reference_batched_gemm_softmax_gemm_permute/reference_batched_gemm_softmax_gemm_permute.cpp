@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/masking_specialization.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm_softmax_gemm_permute.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_softmax.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Scale       = ck::tensor_operation::element_wise::Scale;
+
+using ck::tensor_operation::device::MaskingSpecialization;
+
+// the unfused chain the fused reference replaces: gemm, mask, softmax, gemm on permuted copies
+template <typename DataType, MaskingSpecialization MaskingSpec>
+void unfused_attention(const Tensor<DataType>& a_gs_ms_ks,
+                       const Tensor<DataType>& b0_gs_ns_ks,
+                       const Tensor<DataType>& b1_gs_os_ns,
+                       Tensor<DataType>& c_gs_ms_os,
+                       float alpha)
+{
+    const std::size_t G0 = a_gs_ms_ks.mDesc.GetLengths()[0];
+    const std::size_t G1 = a_gs_ms_ks.mDesc.GetLengths()[1];
+    const std::size_t M  = a_gs_ms_ks.mDesc.GetLengths()[2];
+    const std::size_t K  = a_gs_ms_ks.mDesc.GetLengths()[3];
+    const std::size_t N  = b0_gs_ns_ks.mDesc.GetLengths()[2];
+    const std::size_t O  = b1_gs_os_ns.mDesc.GetLengths()[2];
+
+    Tensor<DataType> a_g_m_k({G0 * G1, M, K});
+    Tensor<DataType> b0_g_k_n({G0 * G1, K, N});
+    Tensor<DataType> b1_g_n_o({G0 * G1, N, O});
+    Tensor<float> acc0_g_m_n({G0 * G1, M, N});
+    Tensor<DataType> a1_g_m_n({G0 * G1, M, N});
+    Tensor<DataType> c_g_m_o({G0 * G1, M, O});
+
+    a_gs_ms_ks.ForEach([&](auto& self, auto idx) {
+        a_g_m_k(idx[0] * G1 + idx[1], idx[2], idx[3]) = self(idx);
+    });
+    b0_gs_ns_ks.ForEach([&](auto& self, auto idx) {
+        b0_g_k_n(idx[0] * G1 + idx[1], idx[3], idx[2]) = self(idx);
+    });
+    b1_gs_os_ns.ForEach([&](auto& self, auto idx) {
+        b1_g_n_o(idx[0] * G1 + idx[1], idx[3], idx[2]) = self(idx);
+    });
+
+    using namespace ck::tensor_operation::host;
+
+    auto gemm0 =
+        ReferenceBatchedGemm<DataType, DataType, float, float, PassThrough, PassThrough, Scale>{};
+    auto gemm0_argument = gemm0.MakeArgument(
+        a_g_m_k, b0_g_k_n, acc0_g_m_n, PassThrough{}, PassThrough{}, Scale{alpha});
+
+    gemm0.MakeInvoker().Run(gemm0_argument);
+
+    acc0_g_m_n.ForEach([&](auto& self, auto idx) {
+        if(MaskingSpec == MaskingSpecialization::MaskOutUpperTriangle && idx[1] < idx[2])
+            self(idx) = -ck::NumericLimits<float>::Infinity();
+    });
+
+    auto softmax          = ReferenceSoftmax<float, DataType, float>{};
+    auto softmax_argument = softmax.MakeArgument(acc0_g_m_n, a1_g_m_n, 1, 0, {2});
+
+    softmax.MakeInvoker().Run(softmax_argument);
+
+    auto gemm1 = ReferenceBatchedGemm<DataType,
+                                      DataType,
+                                      DataType,
+                                      float,
+                                      PassThrough,
+                                      PassThrough,
+                                      PassThrough>{};
+    auto gemm1_argument = gemm1.MakeArgument(
+        a1_g_m_n, b1_g_n_o, c_g_m_o, PassThrough{}, PassThrough{}, PassThrough{});
+
+    gemm1.MakeInvoker().Run(gemm1_argument);
+
+    c_gs_ms_os.ForEach(
+        [&](auto& self, auto idx) { self(idx) = c_g_m_o(idx[0] * G1 + idx[1], idx[2], idx[3]); });
+}
+
+template <typename DataType, MaskingSpecialization MaskingSpec>
+bool fused_attention(const Tensor<DataType>& a_gs_ms_ks,
+                     const Tensor<DataType>& b0_gs_ns_ks,
+                     const Tensor<DataType>& b1_gs_os_ns,
+                     Tensor<DataType>& c_gs_ms_os,
+                     float alpha)
+{
+    auto ref_attention =
+        ck::tensor_operation::host::ReferenceBatchedGemmSoftmaxGemmPermute<2,
+                                                                           DataType,
+                                                                           DataType,
+                                                                           DataType,
+                                                                           DataType,
+                                                                           float,
+                                                                           PassThrough,
+                                                                           PassThrough,
+                                                                           Scale,
+                                                                           PassThrough,
+                                                                           PassThrough,
+                                                                           MaskingSpec>{};
+    auto ref_argument = ref_attention.MakeArgument(a_gs_ms_ks,
+                                                   b0_gs_ns_ks,
+                                                   b1_gs_os_ns,
+                                                   c_gs_ms_os,
+                                                   PassThrough{},
+                                                   PassThrough{},
+                                                   Scale{alpha},
+                                                   PassThrough{},
+                                                   PassThrough{});
+
+    if(!ref_attention.IsSupportedArgument(&ref_argument))
+        return false;
+
+    ref_attention.MakeInvoker().Run(ref_argument);
+
+    return true;
+}
+
+// same [G0, M, G1, K] / [G0, M, G1, O] layouts as the device tests, permuted output included
+template <typename DataType, MaskingSpecialization MaskingSpec>
+bool run_reference_attention(std::size_t M,
+                             std::size_t N,
+                             std::size_t K,
+                             std::size_t O,
+                             std::size_t G0,
+                             std::size_t G1,
+                             double tol)
+{
+    const std::vector<std::size_t> a_lengths{G0, G1, M, K};
+    const std::vector<std::size_t> a_strides{M * G1 * K, K, G1 * K, 1};
+    const std::vector<std::size_t> b0_lengths{G0, G1, N, K};
+    const std::vector<std::size_t> b0_strides{N * G1 * K, K, G1 * K, 1};
+    const std::vector<std::size_t> b1_lengths{G0, G1, O, N};
+    const std::vector<std::size_t> b1_strides{N * G1 * O, O, 1, G1 * O};
+    const std::vector<std::size_t> c_lengths{G0, G1, M, O};
+    const std::vector<std::size_t> c_strides{M * G1 * O, O, G1 * O, 1};
+
+    Tensor<DataType> a_gs_ms_ks(a_lengths, a_strides);
+    Tensor<DataType> b0_gs_ns_ks(b0_lengths, b0_strides);
+    Tensor<DataType> b1_gs_os_ns(b1_lengths, b1_strides);
+    Tensor<DataType> c_gs_ms_os_unfused(c_lengths, c_strides);
+    Tensor<DataType> c_gs_ms_os_fused(c_lengths, c_strides);
+
+    ck::utils::FillUniformDistribution<DataType>{-2.f, 2.f}(a_gs_ms_ks);
+    ck::utils::FillUniformDistribution<DataType>{-2.f, 2.f}(b0_gs_ns_ks);
+    ck::utils::FillUniformDistribution<DataType>{-2.f, 2.f}(b1_gs_os_ns);
+
+    const float alpha = 1.f / std::sqrt(K);
+
+    unfused_attention<DataType, MaskingSpec>(
+        a_gs_ms_ks, b0_gs_ns_ks, b1_gs_os_ns, c_gs_ms_os_unfused, alpha);
+
+    if(!fused_attention<DataType, MaskingSpec>(
+           a_gs_ms_ks, b0_gs_ns_ks, b1_gs_os_ns, c_gs_ms_os_fused, alpha))
+        return false;
+
+    return ck::utils::check_err(
+        c_gs_ms_os_fused, c_gs_ms_os_unfused, "Error: incorrect results!", tol, tol);
+}
+
+} // anonymous namespace
+
+TEST(ReferenceBatchedGemmSoftmaxGemmPermute, F32)
+{
+    // N spans several score tiles, M several row blocks, both with remainders
+    for(std::size_t N : {1, 100, 256, 700})
+    {
+        EXPECT_TRUE((run_reference_attention<float, MaskingSpecialization::MaskDisabled>(
+            200, N, 64, 40, 2, 3, 1e-5)));
+    }
+}
+
+TEST(ReferenceBatchedGemmSoftmaxGemmPermute, F32MaskOutUpperTriangle)
+{
+    for(std::size_t M : {1, 97, 600})
+    {
+        EXPECT_TRUE((run_reference_attention<float, MaskingSpecialization::MaskOutUpperTriangle>(
+            M, 600, 32, 64, 1, 2, 1e-5)));
+    }
+}
+
+TEST(ReferenceBatchedGemmSoftmaxGemmPermute, F16)
+{
+    // probabilities are rounded to fp16 against the running instead of the final row sum
+    EXPECT_TRUE((run_reference_attention<ck::half_t, MaskingSpecialization::MaskDisabled>(
+        256, 512, 64, 64, 2, 2, 1e-2)));
+    EXPECT_TRUE((run_reference_attention<ck::half_t, MaskingSpecialization::MaskOutUpperTriangle>(
+        256, 512, 64, 64, 2, 2, 1e-2)));
+}
+
+TEST(ReferenceBatchedGemmSoftmaxGemmPermute, F32FullyMaskedRow)
+{
+    const std::size_t G0 = 1, G1 = 2, M = 70, N = 300, K = 16, O = 24;
+
+    Tensor<float> a_gs_ms_ks({G0, G1, M, K});
+    Tensor<float> b0_gs_ns_ks({G0, G1, N, K});
+    Tensor<float> b1_gs_os_ns({G0, G1, O, N});
+    Tensor<float> c_gs_ms_os_unfused({G0, G1, M, O});
+    Tensor<float> c_gs_ms_os_fused({G0, G1, M, O});
+
+    ck::utils::FillUniformDistribution<float>{-2.f, 2.f}(a_gs_ms_ks);
+    ck::utils::FillUniformDistribution<float>{0.5f, 2.f}(b0_gs_ns_ks);
+    ck::utils::FillUniformDistribution<float>{-2.f, 2.f}(b1_gs_os_ns);
+
+    // with a positive B0, every score of these rows is -inf, as if the row were masked out
+    const std::vector<std::size_t> masked_rows{0, 33, 69};
+
+    for(std::size_t g1 = 0; g1 < G1; ++g1)
+        for(std::size_t m : masked_rows)
+            for(std::size_t k = 0; k < K; ++k)
+                a_gs_ms_ks(0, g1, m, k) = -std::numeric_limits<float>::infinity();
+
+    const float alpha = 1.f / std::sqrt(K);
+
+    unfused_attention<float, MaskingSpecialization::MaskOutUpperTriangle>(
+        a_gs_ms_ks, b0_gs_ns_ks, b1_gs_os_ns, c_gs_ms_os_unfused, alpha);
+
+    ASSERT_TRUE((fused_attention<float, MaskingSpecialization::MaskOutUpperTriangle>(
+        a_gs_ms_ks, b0_gs_ns_ks, b1_gs_os_ns, c_gs_ms_os_fused, alpha)));
+
+    // both give NaN for the fully masked rows; the other rows are compared once those are cleared
+    for(std::size_t g1 = 0; g1 < G1; ++g1)
+        for(std::size_t m : masked_rows)
+            for(std::size_t o = 0; o < O; ++o)
+            {
+                EXPECT_TRUE(std::isnan(c_gs_ms_os_unfused(0, g1, m, o)));
+                EXPECT_TRUE(std::isnan(c_gs_ms_os_fused(0, g1, m, o)));
+
+                c_gs_ms_os_unfused(0, g1, m, o) = 0;
+                c_gs_ms_os_fused(0, g1, m, o)   = 0;
+            }
+
+    EXPECT_TRUE(ck::utils::check_err(
+        c_gs_ms_os_fused, c_gs_ms_os_unfused, "Error: incorrect results!", 1e-5, 1e-5));
+}
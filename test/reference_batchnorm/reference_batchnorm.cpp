@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/reference_tensor_operation/cpu/reference_batchnorm_backward.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batchnorm_forward.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batchnorm_infer.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+constexpr ck::index_t Rank         = 4;
+constexpr ck::index_t NumReduceDim = 3;
+
+using Lengths = std::array<ck::index_t, Rank>;
+
+// NHWC runs the channel-last engine, NCHW the generic per-channel path
+Lengths get_strides(const Lengths& lengths, bool is_channel_last)
+{
+    const ck::index_t H = lengths[1];
+    const ck::index_t W = lengths[2];
+    const ck::index_t C = lengths[3];
+
+    return is_channel_last ? Lengths{H * W * C, W * C, C, 1} : Lengths{C * H * W, W, 1, H * W};
+}
+
+// scatters the packed NHWC tensor x to the tested layout
+std::vector<float> to_layout(const std::vector<float>& x, const Lengths& lengths, bool is_nhwc)
+{
+    const auto strides = get_strides(lengths, is_nhwc);
+
+    std::vector<float> out(x.size());
+
+    std::size_t i = 0;
+
+    for(ck::index_t n = 0; n < lengths[0]; ++n)
+        for(ck::index_t h = 0; h < lengths[1]; ++h)
+            for(ck::index_t w = 0; w < lengths[2]; ++w)
+                for(ck::index_t c = 0; c < lengths[3]; ++c)
+                    out[n * strides[0] + h * strides[1] + w * strides[2] + c * strides[3]] =
+                        x[i++];
+
+    return out;
+}
+
+// gathers y, stored in the layout given by is_nhwc, back to packed NHWC
+std::vector<float> from_layout(const std::vector<float>& y, const Lengths& lengths, bool is_nhwc)
+{
+    const auto strides = get_strides(lengths, is_nhwc);
+
+    std::vector<float> out(y.size());
+
+    std::size_t i = 0;
+
+    for(ck::index_t n = 0; n < lengths[0]; ++n)
+        for(ck::index_t h = 0; h < lengths[1]; ++h)
+            for(ck::index_t w = 0; w < lengths[2]; ++w)
+                for(ck::index_t c = 0; c < lengths[3]; ++c)
+                    out[i++] =
+                        y[n * strides[0] + h * strides[1] + w * strides[2] + c * strides[3]];
+
+    return out;
+}
+
+std::vector<float> make_input(std::size_t size, float offset)
+{
+    std::vector<float> x(size);
+
+    for(auto& v : x)
+        v = static_cast<float>(std::rand() % 1000) / 100.0f + offset;
+
+    return x;
+}
+
+void expect_near(const std::vector<float>& result, const std::vector<float>& expected, float tol)
+{
+    ASSERT_TRUE(result.size() == expected.size());
+
+    for(std::size_t i = 0; i < result.size(); ++i)
+    {
+        EXPECT_NEAR(result[i], expected[i], tol * std::max(1.0f, std::abs(expected[i])))
+            << "element " << i;
+    }
+}
+
+struct ForwardResult
+{
+    std::vector<float> y;
+    std::vector<float> save_mean;
+    std::vector<float> save_inv_variance;
+    std::vector<float> running_mean;
+    std::vector<float> running_variance;
+};
+
+ForwardResult run_forward(const std::vector<float>& x,
+                          const std::vector<float>& scale,
+                          const std::vector<float>& bias,
+                          const Lengths& lengths,
+                          bool is_nhwc)
+{
+    using ReferenceInstance = ck::tensor_operation::host::
+        ReferenceBatchNormFwd<float, float, float, float, float, float, PassThrough, Rank, NumReduceDim>;
+
+    const ck::index_t C = lengths[3];
+    const auto strides  = get_strides(lengths, is_nhwc);
+    const auto in       = to_layout(x, lengths, is_nhwc);
+
+    ForwardResult result{std::vector<float>(x.size()),
+                         std::vector<float>(C),
+                         std::vector<float>(C),
+                         std::vector<float>(C, 0.5f),
+                         std::vector<float>(C, 1.0f)};
+
+    ReferenceInstance ref_batchnorm;
+
+    auto argument = ref_batchnorm.MakeArgumentPointer(lengths,
+                                                      strides,
+                                                      strides,
+                                                      {0, 1, 2},
+                                                      {C},
+                                                      {1},
+                                                      {1},
+                                                      {1},
+                                                      in.data(),
+                                                      scale.data(),
+                                                      bias.data(),
+                                                      1e-5,
+                                                      PassThrough{},
+                                                      result.y.data(),
+                                                      result.save_mean.data(),
+                                                      result.save_inv_variance.data(),
+                                                      0.1,
+                                                      result.running_mean.data(),
+                                                      result.running_variance.data());
+
+    ref_batchnorm.MakeInvokerPointer()->Run(argument.get());
+
+    return result;
+}
+
+std::vector<float> run_infer(const std::vector<float>& x,
+                             const std::vector<float>& scale,
+                             const std::vector<float>& bias,
+                             const std::vector<float>& mean,
+                             const std::vector<float>& variance,
+                             const Lengths& lengths,
+                             bool is_nhwc)
+{
+    using ReferenceInstance = ck::tensor_operation::host::
+        ReferenceBatchNormInfer<float, float, float, float, float, float, PassThrough, Rank, NumReduceDim>;
+
+    const ck::index_t C = lengths[3];
+    const auto strides  = get_strides(lengths, is_nhwc);
+    const auto in       = to_layout(x, lengths, is_nhwc);
+
+    std::vector<float> y(x.size());
+
+    ReferenceInstance ref_batchnorm;
+
+    auto argument = ref_batchnorm.MakeArgumentPointer(lengths,
+                                                      strides,
+                                                      strides,
+                                                      {0, 1, 2},
+                                                      {C},
+                                                      {1},
+                                                      {1},
+                                                      {1},
+                                                      in.data(),
+                                                      scale.data(),
+                                                      bias.data(),
+                                                      1e-5,
+                                                      PassThrough{},
+                                                      mean.data(),
+                                                      variance.data(),
+                                                      y.data());
+
+    ref_batchnorm.MakeInvokerPointer()->Run(argument.get());
+
+    return y;
+}
+
+struct BackwardResult
+{
+    std::vector<float> dx;
+    std::vector<float> dscale;
+    std::vector<float> dbias;
+};
+
+BackwardResult run_backward(const std::vector<float>& x,
+                            const std::vector<float>& dy,
+                            const std::vector<float>& scale,
+                            const std::vector<float>* p_saved_mean,
+                            const std::vector<float>* p_saved_inv_variance,
+                            const Lengths& lengths,
+                            bool is_nhwc)
+{
+    using ReferenceInstance = ck::tensor_operation::host::ReferenceBatchNormBwd<float,
+                                                                                 float,
+                                                                                 float,
+                                                                                 float,
+                                                                                 float,
+                                                                                 float,
+                                                                                 float,
+                                                                                 PassThrough,
+                                                                                 Rank,
+                                                                                 NumReduceDim>;
+
+    const ck::index_t C = lengths[3];
+    const auto strides  = get_strides(lengths, is_nhwc);
+    const auto x_in     = to_layout(x, lengths, is_nhwc);
+    const auto dy_in    = to_layout(dy, lengths, is_nhwc);
+
+    BackwardResult result{
+        std::vector<float>(x.size()), std::vector<float>(C), std::vector<float>(C)};
+
+    ReferenceInstance ref_batchnorm;
+
+    auto argument = ref_batchnorm.MakeArgumentPointer(
+        lengths,
+        strides,
+        strides,
+        strides,
+        {0, 1, 2},
+        {C},
+        {1},
+        {1},
+        {1},
+        x_in.data(),
+        dy_in.data(),
+        scale.data(),
+        p_saved_mean != nullptr ? p_saved_mean->data() : nullptr,
+        p_saved_inv_variance != nullptr ? p_saved_inv_variance->data() : nullptr,
+        1e-5,
+        PassThrough{},
+        result.dx.data(),
+        result.dscale.data(),
+        result.dbias.data());
+
+    ref_batchnorm.MakeInvokerPointer()->Run(argument.get());
+
+    return result;
+}
+
+void test_channel_last(const Lengths& lengths)
+{
+    const std::size_t size = static_cast<std::size_t>(lengths[0]) * lengths[1] * lengths[2] *
+                             lengths[3];
+
+    std::srand(0);
+
+    // an offset far from zero checks the statistics against cancellation
+    const auto x     = make_input(size, 100.0f);
+    const auto dy    = make_input(size, -5.0f);
+    const auto scale = make_input(lengths[3], 0.5f);
+    const auto bias  = make_input(lengths[3], -5.0f);
+
+    const auto fwd_nhwc = run_forward(x, scale, bias, lengths, true);
+    const auto fwd_nchw = run_forward(x, scale, bias, lengths, false);
+
+    expect_near(fwd_nhwc.y, from_layout(fwd_nchw.y, lengths, false), 1e-3f);
+    expect_near(fwd_nhwc.save_mean, fwd_nchw.save_mean, 1e-5f);
+    expect_near(fwd_nhwc.save_inv_variance, fwd_nchw.save_inv_variance, 1e-4f);
+    expect_near(fwd_nhwc.running_mean, fwd_nchw.running_mean, 1e-5f);
+    expect_near(fwd_nhwc.running_variance, fwd_nchw.running_variance, 1e-4f);
+
+    const auto variance = make_input(lengths[3], 0.1f);
+
+    const auto infer_nhwc =
+        run_infer(x, scale, bias, fwd_nchw.save_mean, variance, lengths, true);
+    const auto infer_nchw =
+        run_infer(x, scale, bias, fwd_nchw.save_mean, variance, lengths, false);
+
+    expect_near(infer_nhwc, from_layout(infer_nchw, lengths, false), 1e-5f);
+
+    for(bool use_saved : {false, true})
+    {
+        const auto* p_mean = use_saved ? &fwd_nchw.save_mean : nullptr;
+        const auto* p_inv  = use_saved ? &fwd_nchw.save_inv_variance : nullptr;
+
+        const auto bwd_nhwc = run_backward(x, dy, scale, p_mean, p_inv, lengths, true);
+        const auto bwd_nchw = run_backward(x, dy, scale, p_mean, p_inv, lengths, false);
+
+        expect_near(bwd_nhwc.dx, from_layout(bwd_nchw.dx, lengths, false), 1e-3f);
+        expect_near(bwd_nhwc.dscale, bwd_nchw.dscale, 1e-3f);
+        expect_near(bwd_nhwc.dbias, bwd_nchw.dbias, 1e-3f);
+    }
+}
+
+} // namespace
+
+TEST(ReferenceBatchNorm, ChannelLastMatchesGeneric)
+{
+    test_channel_last({2, 8, 8, 16});
+    test_channel_last({3, 5, 7, 61});
+}
+
+TEST(ReferenceBatchNorm, ChannelLastSplitRows)
+{
+    // few channels over many rows, the rows are split into several partials
+    test_channel_last({16, 64, 64, 3});
+}
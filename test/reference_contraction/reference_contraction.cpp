@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_contraction.hpp"
+
+namespace {
+
+using ck::index_t;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Scale       = ck::tensor_operation::element_wise::Scale;
+using Bilinear    = ck::tensor_operation::element_wise::Bilinear;
+
+// packed descriptor whose dimensions are laid out in memory in the given order, outermost first
+HostTensorDescriptor make_descriptor(const std::vector<index_t>& lengths,
+                                     const std::vector<index_t>& order)
+{
+    std::vector<std::size_t> strides(lengths.size());
+
+    std::size_t stride = 1;
+
+    for(auto it = order.rbegin(); it != order.rend(); ++it)
+    {
+        strides[*it] = stride;
+        stride *= lengths[*it];
+    }
+
+    return HostTensorDescriptor(std::vector<std::size_t>(lengths.begin(), lengths.end()), strides);
+}
+
+std::vector<index_t> concat(const std::vector<index_t>& x, const std::vector<index_t>& y)
+{
+    std::vector<index_t> z(x);
+
+    z.insert(z.end(), y.begin(), y.end());
+
+    return z;
+}
+
+// offset of the linear index i of the dimensions [begin, begin + lengths.size()) of desc
+std::size_t get_offset(const HostTensorDescriptor& desc,
+                       std::size_t begin,
+                       const std::vector<index_t>& lengths,
+                       index_t i)
+{
+    std::size_t offset = 0;
+
+    for(std::size_t d = lengths.size(); d-- > 0;)
+    {
+        offset += (i % lengths[d]) * desc.GetStrides()[begin + d];
+        i /= lengths[d];
+    }
+
+    return offset;
+}
+
+index_t get_size(const std::vector<index_t>& lengths)
+{
+    return std::accumulate(lengths.begin(), lengths.end(), index_t{1}, std::multiplies<>{});
+}
+
+struct ContractionProblem
+{
+    std::vector<index_t> m_lengths;
+    std::vector<index_t> n_lengths;
+    std::vector<index_t> k_lengths;
+
+    // memory order of the dimensions of A [M.., K..], B [N.., K..] and E / D [M.., N..]
+    std::vector<index_t> a_order;
+    std::vector<index_t> b_order;
+    std::vector<index_t> e_order;
+};
+
+template <index_t NumDimM, index_t NumDimN, index_t NumDimK, bool UseD>
+void test_contraction(const ContractionProblem& problem)
+{
+    Tensor<float> a(make_descriptor(concat(problem.m_lengths, problem.k_lengths), problem.a_order));
+    Tensor<float> b(make_descriptor(concat(problem.n_lengths, problem.k_lengths), problem.b_order));
+    Tensor<float> d(make_descriptor(concat(problem.m_lengths, problem.n_lengths), problem.e_order));
+    Tensor<float> e(make_descriptor(concat(problem.m_lengths, problem.n_lengths), problem.e_order));
+
+    std::srand(0);
+
+    for(auto& v : a.mData)
+        v = static_cast<float>(std::rand() % 11 - 5) / 4.0f;
+    for(auto& v : b.mData)
+        v = static_cast<float>(std::rand() % 11 - 5) / 4.0f;
+    for(auto& v : d.mData)
+        v = static_cast<float>(std::rand() % 11 - 5) / 4.0f;
+
+    const float alpha = 0.5f;
+    const float beta  = -1.5f;
+
+    if constexpr(UseD)
+    {
+        using ReferenceInstance = ck::tensor_operation::host::ReferenceContraction<NumDimM,
+                                                                                    NumDimN,
+                                                                                    NumDimK,
+                                                                                    float,
+                                                                                    float,
+                                                                                    float,
+                                                                                    float,
+                                                                                    PassThrough,
+                                                                                    PassThrough,
+                                                                                    Bilinear>;
+
+        ReferenceInstance ref;
+
+        auto argument =
+            ref.MakeArgument(a, b, d, e, PassThrough{}, PassThrough{}, Bilinear{alpha, beta});
+
+        EXPECT_TRUE(ref.IsSupportedArgument(&argument));
+
+        ref.MakeInvoker().Run(argument);
+    }
+    else
+    {
+        using ReferenceInstance = ck::tensor_operation::host::ReferenceContraction<NumDimM,
+                                                                                    NumDimN,
+                                                                                    NumDimK,
+                                                                                    float,
+                                                                                    float,
+                                                                                    float,
+                                                                                    float,
+                                                                                    PassThrough,
+                                                                                    PassThrough,
+                                                                                    Scale>;
+
+        ReferenceInstance ref;
+
+        auto argument = ref.MakeArgument(a, b, e, PassThrough{}, PassThrough{}, Scale{alpha});
+
+        EXPECT_TRUE(ref.IsSupportedArgument(&argument));
+
+        ref.MakeInvoker().Run(argument);
+    }
+
+    const index_t M = get_size(problem.m_lengths);
+    const index_t N = get_size(problem.n_lengths);
+    const index_t K = get_size(problem.k_lengths);
+
+    for(index_t m = 0; m < M; ++m)
+    {
+        for(index_t n = 0; n < N; ++n)
+        {
+            double acc = 0;
+
+            for(index_t k = 0; k < K; ++k)
+            {
+                const float v_a = a.mData[get_offset(a.mDesc, 0, problem.m_lengths, m) +
+                                          get_offset(a.mDesc, NumDimM, problem.k_lengths, k)];
+                const float v_b = b.mData[get_offset(b.mDesc, 0, problem.n_lengths, n) +
+                                          get_offset(b.mDesc, NumDimN, problem.k_lengths, k)];
+
+                acc += static_cast<double>(v_a) * v_b;
+            }
+
+            const std::size_t e_offset = get_offset(e.mDesc, 0, problem.m_lengths, m) +
+                                         get_offset(e.mDesc, NumDimM, problem.n_lengths, n);
+
+            const double expected = UseD ? alpha * acc + beta * d.mData[e_offset] : alpha * acc;
+
+            // the products are exact in float, only the accumulation order differs
+            ASSERT_NEAR(e.mData[e_offset], expected, 1e-3 * std::max(1.0, std::abs(expected)))
+                << "m " << m << ", n " << n;
+        }
+    }
+}
+
+} // namespace
+
+TEST(ReferenceContraction, PackedScale)
+{
+    test_contraction<2, 2, 2, false>(
+        {{30, 12}, {8, 16}, {9, 20}, {0, 1, 2, 3}, {0, 1, 2, 3}, {0, 1, 2, 3}});
+}
+
+TEST(ReferenceContraction, PackedBilinear)
+{
+    test_contraction<3, 3, 3, true>({{3, 5, 7},
+                                     {4, 2, 9},
+                                     {6, 3, 5},
+                                     {0, 1, 2, 3, 4, 5},
+                                     {0, 1, 2, 3, 4, 5},
+                                     {0, 1, 2, 3, 4, 5}});
+}
+
+TEST(ReferenceContraction, PermutedLayouts)
+{
+    // every tensor interleaves its modes in memory, the K dimensions are ordered differently
+    // in A and B
+    test_contraction<3, 4, 3, true>({{4, 3, 5},
+                                     {2, 3, 2, 5},
+                                     {3, 7, 4},
+                                     {5, 0, 3, 1, 4, 2},
+                                     {6, 0, 5, 1, 4, 2, 3},
+                                     {2, 6, 0, 3, 1, 5, 4}});
+
+    test_contraction<4, 3, 4, false>({{3, 2, 5, 3},
+                                      {7, 2, 3},
+                                      {2, 5, 3, 2},
+                                      {4, 0, 7, 1, 5, 2, 6, 3},
+                                      {2, 3, 6, 0, 5, 4, 1},
+                                      {4, 5, 0, 6, 1, 2, 3}});
+}
+
+TEST(ReferenceContraction, ColumnMajorE)
+{
+    // E is contiguous along M, the GEMM runs transposed
+    test_contraction<2, 2, 2, true>(
+        {{17, 9}, {13, 5}, {11, 7}, {0, 1, 2, 3}, {0, 1, 2, 3}, {2, 3, 0, 1}});
+}
+
+TEST(ReferenceContraction, UnitDimensions)
+{
+    test_contraction<3, 3, 3, true>({{1, 37, 1},
+                                     {1, 1, 1},
+                                     {4, 1, 25},
+                                     {0, 1, 2, 3, 4, 5},
+                                     {0, 1, 2, 3, 4, 5},
+                                     {0, 1, 2, 3, 4, 5}});
+}
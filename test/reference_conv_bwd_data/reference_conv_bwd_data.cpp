@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+
+#include "ck/library/utility/algorithm.hpp"
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_data.hpp"
+
+namespace {
+
+using ck::index_t;
+
+using InElementOp  = ck::tensor_operation::element_wise::PassThrough;
+using WeiElementOp = ck::tensor_operation::element_wise::PassThrough;
+using OutElementOp = ck::tensor_operation::element_wise::PassThrough;
+
+namespace ctl = ck::tensor_layout::convolution;
+
+// channel-last layouts of [in, wei, out] per number of spatial dimensions
+template <index_t NDimSpatial>
+using Layouts = std::tuple_element_t<NDimSpatial - 1,
+                                     std::tuple<std::tuple<ctl::GNWC, ctl::GKXC, ctl::GNWK>,
+                                                std::tuple<ctl::GNHWC, ctl::GKYXC, ctl::GNHWK>,
+                                                std::tuple<ctl::GNDHWC, ctl::GKZYXC, ctl::GNDHWK>>>;
+
+// runs the stride-decomposed path and the direct loop on the same problem, the input gradient
+// prefilled with NaN so that every input pixel has to be written by both; returns the number of
+// input gradient values that are zero. With non_finite_weights, two weights are +Inf and -Inf.
+template <index_t NDimSpatial>
+std::size_t test_stride_decomposed_matches_direct(const ck::utils::conv::ConvParam& conv_param,
+                                                  bool non_finite_weights = false)
+{
+    using InLayout  = std::tuple_element_t<0, Layouts<NDimSpatial>>;
+    using WeiLayout = std::tuple_element_t<1, Layouts<NDimSpatial>>;
+    using OutLayout = std::tuple_element_t<2, Layouts<NDimSpatial>>;
+
+    Tensor<float> in_direct(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(conv_param));
+    Tensor<float> in_decomposed(in_direct.mDesc);
+    Tensor<float> weights(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(
+            conv_param));
+    Tensor<float> output(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+            conv_param));
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(weights);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(output);
+    ck::ranges::fill<float>(in_direct, std::numeric_limits<float>::quiet_NaN());
+    ck::ranges::fill<float>(in_decomposed, std::numeric_limits<float>::quiet_NaN());
+
+    if(non_finite_weights)
+    {
+        weights.mData[3]                        = std::numeric_limits<float>::infinity();
+        weights.mData[weights.mData.size() / 2] = -std::numeric_limits<float>::infinity();
+    }
+
+    auto ref_conv    = ck::tensor_operation::host::ReferenceConvBwdData<NDimSpatial,
+                                                                     float,
+                                                                     float,
+                                                                     float,
+                                                                     InElementOp,
+                                                                     WeiElementOp,
+                                                                     OutElementOp>();
+    auto ref_invoker = ref_conv.MakeInvoker();
+
+    auto make_argument = [&](Tensor<float>& input) {
+        return ref_conv.MakeArgument(input,
+                                     weights,
+                                     output,
+                                     conv_param.conv_filter_strides_,
+                                     conv_param.conv_filter_dilations_,
+                                     conv_param.input_left_pads_,
+                                     conv_param.input_right_pads_,
+                                     InElementOp{},
+                                     WeiElementOp{},
+                                     OutElementOp{});
+    };
+
+    auto arg_direct     = make_argument(in_direct);
+    auto arg_decomposed = make_argument(in_decomposed);
+
+    EXPECT_TRUE(ref_invoker.IsStrideDecomposedApplicable(arg_decomposed));
+
+    ref_invoker.RunDirect(arg_direct);
+    ref_invoker.RunStrideDecomposed(arg_decomposed);
+
+    // same accumulation order, so the results have to match exactly
+    if(non_finite_weights)
+    {
+        for(std::size_t i = 0; i < in_direct.mData.size(); ++i)
+        {
+            if(std::isnan(in_direct.mData[i]))
+            {
+                EXPECT_TRUE(std::isnan(in_decomposed.mData[i])) << "element " << i;
+            }
+            else
+            {
+                EXPECT_EQ(in_decomposed.mData[i], in_direct.mData[i]) << "element " << i;
+            }
+        }
+    }
+    else
+    {
+        EXPECT_TRUE(ck::utils::check_err(
+            in_decomposed, in_direct, "Error: incorrect results!", 0.f, 0.f));
+    }
+
+    return std::count(in_decomposed.mData.begin(), in_decomposed.mData.end(), 0.f);
+}
+
+} // namespace
+
+TEST(ReferenceConvBwdData, Conv1DStridesDilationsAsymmetricPads)
+{
+    // stride 3 and dilation 2: the phases of the 5 taps at 0, 2, 4, 6, 8 are uneven
+    test_stride_decomposed_matches_direct<1>(
+        ck::utils::conv::ConvParam(1, 2, 3, 7, 5, {5}, {29}, {3}, {2}, {3}, {1}));
+}
+
+TEST(ReferenceConvBwdData, Conv2DStridesAsymmetricPads)
+{
+    test_stride_decomposed_matches_direct<2>(ck::utils::conv::ConvParam(
+        2, 2, 2, 9, 6, {3, 4}, {17, 13}, {2, 3}, {1, 1}, {1, 0}, {0, 2}));
+}
+
+TEST(ReferenceConvBwdData, Conv2DStridesDilations)
+{
+    test_stride_decomposed_matches_direct<2>(ck::utils::conv::ConvParam(
+        2, 1, 3, 8, 5, {3, 3}, {15, 16}, {2, 3}, {3, 2}, {2, 1}, {1, 2}));
+}
+
+TEST(ReferenceConvBwdData, Conv2DPixelsWithoutTaps)
+{
+    // dilation 2 under stride 2 puts every tap on the even phase, stride 3 over a 1-wide
+    // filter leaves two phases in three empty: those input pixels get no tap and are zero
+    const ck::utils::conv::ConvParam conv_param(
+        2, 1, 2, 4, 3, {3, 1}, {14, 16}, {2, 3}, {2, 1}, {1, 0}, {2, 0});
+
+    const std::size_t num_zero = test_stride_decomposed_matches_direct<2>(conv_param);
+
+    EXPECT_LT(0, num_zero);
+}
+
+TEST(ReferenceConvBwdData, Conv2DNonFiniteWeights)
+{
+    // an Inf weight reaches the border pixels through in-bounds and out-of-bounds taps alike,
+    // only the former may contribute
+    test_stride_decomposed_matches_direct<2>(
+        ck::utils::conv::ConvParam(
+            2, 2, 2, 9, 6, {3, 4}, {17, 13}, {2, 3}, {1, 1}, {1, 0}, {0, 2}),
+        true);
+    test_stride_decomposed_matches_direct<1>(
+        ck::utils::conv::ConvParam(1, 2, 3, 7, 5, {5}, {29}, {3}, {2}, {3}, {1}), true);
+}
+
+TEST(ReferenceConvBwdData, Conv3DStridesDilationsAsymmetricPads)
+{
+    test_stride_decomposed_matches_direct<3>(ck::utils::conv::ConvParam(
+        3, 2, 2, 4, 3, {3, 2, 3}, {9, 10, 11}, {2, 3, 1}, {1, 2, 2}, {0, 1, 2}, {1, 0, 1}));
+}
@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+
+#include "ck/library/utility/algorithm.hpp"
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_weight.hpp"
+
+namespace {
+
+using ck::index_t;
+using ck::long_index_t;
+
+using InElementOp  = ck::tensor_operation::element_wise::PassThrough;
+using WeiElementOp = ck::tensor_operation::element_wise::PassThrough;
+using OutElementOp = ck::tensor_operation::element_wise::PassThrough;
+
+namespace ctl = ck::tensor_layout::convolution;
+
+// channel-last layouts of [in, wei, out] per number of spatial dimensions
+template <index_t NDimSpatial>
+using Layouts = std::tuple_element_t<NDimSpatial - 1,
+                                     std::tuple<std::tuple<ctl::GNWC, ctl::GKXC, ctl::GNWK>,
+                                                std::tuple<ctl::GNHWC, ctl::GKYXC, ctl::GNHWK>,
+                                                std::tuple<ctl::GNDHWC, ctl::GKZYXC, ctl::GNDHWK>>>;
+
+template <index_t NDimSpatial>
+using ReferenceConvBwdWeightInstance =
+    ck::tensor_operation::host::ReferenceConvBwdWeight<NDimSpatial,
+                                                       float,
+                                                       float,
+                                                       float,
+                                                       InElementOp,
+                                                       WeiElementOp,
+                                                       OutElementOp>;
+
+// N * output spatial size, the reduction length of the weight gradient
+long_index_t get_reduce_length(const ck::utils::conv::ConvParam& conv_param)
+{
+    long_index_t reduce_length = conv_param.N_;
+
+    for(auto length : conv_param.GetOutputSpatialLengths())
+        reduce_length *= length;
+
+    return reduce_length;
+}
+
+// runs RunSplitReduce with num_split slices (GetNumSplit() if num_split is 0) and RunDirect on
+// the same problem, the weight gradient prefilled with NaN so that all of it has to be written.
+// With non_finite_output, two output gradient values are +Inf and NaN.
+template <index_t NDimSpatial>
+void test_split_reduce_matches_direct(const ck::utils::conv::ConvParam& conv_param,
+                                      index_t num_split,
+                                      bool non_finite_output = false)
+{
+    using InLayout  = std::tuple_element_t<0, Layouts<NDimSpatial>>;
+    using WeiLayout = std::tuple_element_t<1, Layouts<NDimSpatial>>;
+    using OutLayout = std::tuple_element_t<2, Layouts<NDimSpatial>>;
+
+    Tensor<float> input(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(conv_param));
+    Tensor<float> wei_direct(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(
+            conv_param));
+    Tensor<float> wei_split(wei_direct.mDesc);
+    Tensor<float> output(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+            conv_param));
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(input);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(output);
+    ck::ranges::fill<float>(wei_direct, std::numeric_limits<float>::quiet_NaN());
+    ck::ranges::fill<float>(wei_split, std::numeric_limits<float>::quiet_NaN());
+
+    if(non_finite_output)
+    {
+        output.mData[0]                       = std::numeric_limits<float>::infinity();
+        output.mData[output.mData.size() / 2] = std::numeric_limits<float>::quiet_NaN();
+    }
+
+    auto ref_conv    = ReferenceConvBwdWeightInstance<NDimSpatial>{};
+    auto ref_invoker = ref_conv.MakeInvoker();
+
+    auto make_argument = [&](Tensor<float>& weight) {
+        return ref_conv.MakeArgument(input,
+                                     weight,
+                                     output,
+                                     conv_param.conv_filter_strides_,
+                                     conv_param.conv_filter_dilations_,
+                                     conv_param.input_left_pads_,
+                                     conv_param.input_right_pads_,
+                                     InElementOp{},
+                                     WeiElementOp{},
+                                     OutElementOp{});
+    };
+
+    auto arg_direct = make_argument(wei_direct);
+    auto arg_split  = make_argument(wei_split);
+
+    EXPECT_TRUE(ref_invoker.IsSplitReduceApplicable(arg_split));
+
+    if(num_split == 0)
+        num_split = ref_invoker.GetNumSplit(arg_split);
+
+    ref_invoker.RunDirect(arg_direct);
+    ref_invoker.RunSplitReduce(arg_split, num_split);
+
+    if(non_finite_output)
+    {
+        // the non-finite gradients must not reach the taps that only see them through padding
+        const float atol = num_split == 1 ? 0.f : 1e-6f * get_reduce_length(conv_param);
+
+        std::size_t num_finite = 0;
+
+        for(std::size_t i = 0; i < wei_direct.mData.size(); ++i)
+        {
+            const float expected = wei_direct.mData[i];
+
+            if(std::isnan(expected))
+            {
+                EXPECT_TRUE(std::isnan(wei_split.mData[i])) << "element " << i;
+            }
+            else if(std::isinf(expected))
+            {
+                EXPECT_EQ(wei_split.mData[i], expected) << "element " << i;
+            }
+            else
+            {
+                EXPECT_LE(std::abs(wei_split.mData[i] - expected), atol) << "element " << i;
+
+                ++num_finite;
+            }
+        }
+
+        EXPECT_LT(0, num_finite);
+    }
+    else if(num_split == 1)
+    {
+        // a single slice keeps the accumulation order of the direct loop
+        EXPECT_TRUE(
+            ck::utils::check_err(wei_split, wei_direct, "Error: incorrect results!", 0.f, 0.f));
+    }
+    else
+    {
+        // the slices change the summation order of up to get_reduce_length() products
+        const double atol = 1e-6 * get_reduce_length(conv_param);
+
+        EXPECT_TRUE(
+            ck::utils::check_err(wei_split, wei_direct, "Error: incorrect results!", 1e-5, atol));
+    }
+}
+
+} // namespace
+
+TEST(ReferenceConvBwdWeight, GetNumSplitUnevenLastSplit)
+{
+    // reduction length 1 * 47 * 45 = 2115: GetNumSplit() picks 2 slices of 1058 and 1057
+    const ck::utils::conv::ConvParam conv_param(
+        2, 2, 1, 4, 3, {3, 3}, {49, 47}, {1, 1}, {1, 1}, {0, 0}, {0, 0});
+
+    Tensor<float> input(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<ctl::GNHWC>(
+            conv_param));
+    Tensor<float> weight(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<ctl::GKYXC>(
+            conv_param));
+    Tensor<float> output(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<ctl::GNHWK>(
+            conv_param));
+
+    auto arg = ReferenceConvBwdWeightInstance<2>::MakeArgument(input,
+                                                              weight,
+                                                              output,
+                                                              conv_param.conv_filter_strides_,
+                                                              conv_param.conv_filter_dilations_,
+                                                              conv_param.input_left_pads_,
+                                                              conv_param.input_right_pads_,
+                                                              InElementOp{},
+                                                              WeiElementOp{},
+                                                              OutElementOp{});
+
+    const index_t num_split = ReferenceConvBwdWeightInstance<2>::Invoker::GetNumSplit(arg);
+
+    EXPECT_LT(1, num_split);
+    EXPECT_TRUE(get_reduce_length(conv_param) % num_split != 0);
+
+    test_split_reduce_matches_direct<2>(conv_param, 0);
+}
+
+TEST(ReferenceConvBwdWeight, ZeroStrideOrDilationNotSplitReduceApplicable)
+{
+    const ck::utils::conv::ConvParam conv_param(
+        2, 1, 1, 4, 3, {3, 3}, {9, 9}, {1, 1}, {1, 1}, {1, 1}, {1, 1});
+
+    Tensor<float> input(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<ctl::GNHWC>(
+            conv_param));
+    Tensor<float> weight(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<ctl::GKYXC>(
+            conv_param));
+    Tensor<float> output(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<ctl::GNHWK>(
+            conv_param));
+
+    auto make_argument = [&](std::vector<index_t> strides, std::vector<index_t> dilations) {
+        return ReferenceConvBwdWeightInstance<2>::MakeArgument(input,
+                                                               weight,
+                                                               output,
+                                                               strides,
+                                                               dilations,
+                                                               conv_param.input_left_pads_,
+                                                               conv_param.input_right_pads_,
+                                                               InElementOp{},
+                                                               WeiElementOp{},
+                                                               OutElementOp{});
+    };
+
+    using Invoker = ReferenceConvBwdWeightInstance<2>::Invoker;
+
+    // the split-reduce index math divides by the stride and the dilation
+    EXPECT_TRUE(Invoker::IsSplitReduceApplicable(make_argument({1, 1}, {1, 1})));
+    EXPECT_FALSE(Invoker::IsSplitReduceApplicable(make_argument({0, 1}, {1, 1})));
+    EXPECT_FALSE(Invoker::IsSplitReduceApplicable(make_argument({1, 1}, {1, 0})));
+}
+
+TEST(ReferenceConvBwdWeight, Conv1DForcedSplits)
+{
+    // reduction length 3 * 31 = 93 for the inner taps: 2 slices of 47 and 46, 5 of 19 and 17,
+    // 7 of 14 and 9; the taps that reach into the padding have 3 * 30 = 90
+    const ck::utils::conv::ConvParam conv_param(1, 2, 3, 5, 4, {3}, {32}, {1}, {1}, {1}, {0});
+
+    for(index_t num_split : {1, 2, 5, 7})
+        test_split_reduce_matches_direct<1>(conv_param, num_split);
+}
+
+TEST(ReferenceConvBwdWeight, Conv2DForcedSplitsStridesDilationsPads)
+{
+    // reduction length up to 2 * 10 * 13 = 260 per tap: with 64 slices of 5 or less the last
+    // slices are empty
+    for(index_t num_split : {1, 3, 6, 64})
+        test_split_reduce_matches_direct<2>(
+            ck::utils::conv::ConvParam(
+                2, 1, 2, 6, 5, {3, 2}, {19, 14}, {2, 1}, {1, 2}, {1, 0}, {2, 1}),
+            num_split);
+}
+
+TEST(ReferenceConvBwdWeight, Conv2DNonFiniteOutputGradient)
+{
+    // the +Inf is at the first output pixel, which reads padding with the first filter row
+    for(index_t num_split : {1, 3})
+        test_split_reduce_matches_direct<2>(
+            ck::utils::conv::ConvParam(
+                2, 1, 2, 6, 5, {3, 2}, {19, 14}, {2, 1}, {1, 2}, {1, 0}, {2, 1}),
+            num_split,
+            true);
+}
+
+TEST(ReferenceConvBwdWeight, Conv3DForcedSplits)
+{
+    for(index_t num_split : {1, 4, 9})
+        test_split_reduce_matches_direct<3>(
+            ck::utils::conv::ConvParam(
+                3, 2, 2, 3, 2, {2, 3, 3}, {5, 7, 6}, {1, 2, 1}, {1, 1, 2}, {1, 0, 1}, {0, 1, 1}),
+            num_split);
+}
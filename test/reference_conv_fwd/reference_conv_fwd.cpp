@@ -3,6 +3,7 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <numeric>
 #include <type_traits>
 #include <vector>
@@ -80,6 +81,99 @@ run_reference_convolution_forward(const ck::utils::conv::ConvParam& conv_param,
     return host_output;
 }
 
+using ck::tensor_operation::host::ReferenceConvFwdAlgorithm;
+
+// float GNHWC problem shared by the tests comparing the algorithms of ReferenceConvFwd: input and
+// weights are filled uniformly in [-1, 1], the tests patch or refill them before running
+struct ReferenceConv2DFwdProblem
+{
+    using InLayout  = ck::tensor_layout::convolution::GNHWC;
+    using WeiLayout = ck::tensor_layout::convolution::GKYXC;
+    using OutLayout = ck::tensor_layout::convolution::GNHWK;
+
+    using ReferenceConv = ck::tensor_operation::host::
+        ReferenceConvFwd<2, float, float, float, InElementOp, WeiElementOp, OutElementOp>;
+
+    explicit ReferenceConv2DFwdProblem(const ck::utils::conv::ConvParam& param)
+        : conv_param{param},
+          input{ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(
+              param)},
+          weights{ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(
+              param)},
+          out_desc{ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+              param)}
+    {
+        ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(input);
+        ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(weights);
+    }
+
+    auto MakeArgument(Tensor<float>& output, ReferenceConvFwdAlgorithm algorithm) const
+    {
+        return ReferenceConv::MakeArgument(input,
+                                           weights,
+                                           output,
+                                           conv_param.conv_filter_strides_,
+                                           conv_param.conv_filter_dilations_,
+                                           conv_param.input_left_pads_,
+                                           conv_param.input_right_pads_,
+                                           InElementOp{},
+                                           WeiElementOp{},
+                                           OutElementOp{},
+                                           algorithm);
+    }
+
+    Tensor<float> Run(ReferenceConvFwdAlgorithm algorithm)
+    {
+        Tensor<float> output(out_desc);
+
+        auto argument = MakeArgument(output, algorithm);
+
+        invoker.Run(argument);
+
+        return output;
+    }
+
+    ck::utils::conv::ConvParam conv_param;
+    Tensor<float> input;
+    Tensor<float> weights;
+    HostTensorDescriptor out_desc;
+    ReferenceConv::Invoker invoker;
+};
+
+// shape of the implicit GEMM tests: strides, dilations and asymmetric padding in both dimensions
+ck::utils::conv::ConvParam make_implicit_gemm_conv_param()
+{
+    return ck::utils::conv::ConvParam(2,
+                                      2,
+                                      3,
+                                      21,
+                                      5,
+                                      std::vector<ck::index_t>{3, 2},
+                                      std::vector<ck::index_t>{13, 11},
+                                      std::vector<ck::index_t>{2, 1},
+                                      std::vector<ck::index_t>{1, 3},
+                                      std::vector<ck::index_t>{1, 0},
+                                      std::vector<ck::index_t>{2, 1});
+}
+
+// same values element by element, where any NaN matches any NaN
+void expect_equal_or_nan(const Tensor<float>& result, const Tensor<float>& expected)
+{
+    ASSERT_EQ(result.mData.size(), expected.mData.size());
+
+    for(std::size_t i = 0; i < expected.mData.size(); ++i)
+    {
+        if(std::isnan(expected.mData[i]))
+        {
+            EXPECT_TRUE(std::isnan(result.mData[i])) << "element " << i;
+        }
+        else
+        {
+            EXPECT_EQ(result.mData[i], expected.mData[i]) << "element " << i;
+        }
+    }
+}
+
 } // anonymous namespace
 
 // Eeference convolution assume dimensions of tensor descriptors are in GNCDHW/GKCZYX/GNKDHW order,
@@ -390,3 +484,229 @@ TEST(ReferenceConvolutionFWD, Conv3DGNCDHWStridesDilations)
     EXPECT_TRUE(ck::utils::check_err(
         out_tensor, ref_data, "Error [case 2]: incorrect results!", 1e-4f, 1e-6f));
 }
+
+TEST(ReferenceConvolutionFWD, Conv2DGNHWCImplicitGemmMatchesDirect)
+{
+    ReferenceConv2DFwdProblem problem(make_implicit_gemm_conv_param());
+
+    Tensor<float> out_implicit_gemm(problem.out_desc);
+
+    auto arg_implicit_gemm =
+        problem.MakeArgument(out_implicit_gemm, ReferenceConvFwdAlgorithm::Default);
+
+    EXPECT_TRUE(problem.invoker.IsImplicitGemmApplicable(arg_implicit_gemm));
+
+    problem.invoker.Run(arg_implicit_gemm);
+
+    const auto out_direct = problem.Run(ReferenceConvFwdAlgorithm::Direct);
+
+    // same accumulation order, so the results have to match exactly
+    EXPECT_TRUE(ck::utils::check_err(
+        out_implicit_gemm, out_direct, "Error: incorrect results!", 0.f, 0.f));
+}
+
+TEST(ReferenceConvolutionFWD, Conv2DGNHWCImplicitGemmNonFiniteWeightMatchesDirect)
+{
+    ReferenceConv2DFwdProblem problem(make_implicit_gemm_conv_param());
+
+    // the first tap is in the padding for the first output row, the second one for the last
+    // output row and column, the third one is never in the padding
+    problem.weights(0, 3, 2, 0, 0) = std::numeric_limits<float>::quiet_NaN();
+    problem.weights(1, 7, 0, 2, 1) = std::numeric_limits<float>::infinity();
+    problem.weights(1, 8, 4, 1, 0) = -std::numeric_limits<float>::infinity();
+
+    // the Inf weight of k = 7 meets the first Inf input at output (3, 4); the second Inf input
+    // is read by output (6, 2), for which that weight falls into the padding
+    problem.input(1, 1, 0, 7, 7)  = std::numeric_limits<float>::infinity();
+    problem.input(1, 1, 0, 12, 2) = -std::numeric_limits<float>::infinity();
+
+    const auto out_direct        = problem.Run(ReferenceConvFwdAlgorithm::Direct);
+    const auto out_implicit_gemm = problem.Run(ReferenceConvFwdAlgorithm::Default);
+
+    // same accumulation order, Inf products included
+    expect_equal_or_nan(out_implicit_gemm, out_direct);
+
+    // a tap in the padding leaves the output finite, one inside the input does not
+    EXPECT_TRUE(std::isfinite(out_direct(0, 0, 3, 0, 4)));
+    EXPECT_TRUE(std::isnan(out_direct(0, 0, 3, 1, 4)));
+    EXPECT_TRUE(std::isfinite(out_direct(1, 1, 7, 6, 4)));
+    EXPECT_TRUE(std::isfinite(out_direct(1, 1, 7, 3, 8)));
+    EXPECT_EQ(out_direct(1, 1, 7, 3, 4), std::numeric_limits<float>::infinity());
+    EXPECT_TRUE(std::isinf(out_direct(1, 1, 7, 6, 2)));
+    EXPECT_TRUE(std::isinf(out_direct(1, 1, 8, 0, 0)));
+}
+
+TEST(ReferenceConvolutionFWD, Conv2DGNHWCWinogradMatchesDirect)
+{
+    ReferenceConv2DFwdProblem problem(
+        ck::utils::conv::ConvParam(2,
+                                   2,
+                                   3,
+                                   33,
+                                   70,
+                                   std::vector<ck::index_t>{3, 3},
+                                   std::vector<ck::index_t>{17, 10},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 0},
+                                   std::vector<ck::index_t>{2, 1}));
+
+    const auto out_direct = problem.Run(ReferenceConvFwdAlgorithm::Direct);
+
+    for(auto algorithm :
+        {ReferenceConvFwdAlgorithm::WinogradF2x2, ReferenceConvFwdAlgorithm::WinogradF4x4})
+    {
+        Tensor<float> out_winograd(problem.out_desc);
+
+        auto arg_winograd = problem.MakeArgument(out_winograd, algorithm);
+
+        EXPECT_TRUE(problem.invoker.IsWinogradApplicable(arg_winograd));
+
+        problem.invoker.Run(arg_winograd);
+
+        EXPECT_TRUE(ck::utils::check_err(
+            out_winograd, out_direct, "Error: incorrect results!", 1e-3f, 1e-3f));
+    }
+}
+
+TEST(ReferenceConvolutionFWD, Conv2DGNHWCWinogradReusesFilterTransform)
+{
+    ReferenceConv2DFwdProblem problem(
+        ck::utils::conv::ConvParam(2,
+                                   1,
+                                   2,
+                                   9,
+                                   5,
+                                   std::vector<ck::index_t>{3, 3},
+                                   std::vector<ck::index_t>{11, 14},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 1}));
+
+    for(auto algorithm :
+        {ReferenceConvFwdAlgorithm::WinogradF2x2, ReferenceConvFwdAlgorithm::WinogradF4x4})
+    {
+        Tensor<float> out_reused(problem.out_desc);
+
+        auto arg_reused = problem.MakeArgument(out_reused, algorithm);
+
+        // new inputs reuse the filter transform of the first Run(); weights refilled in place
+        // are picked up by the next Run() of the same Argument
+        for(float range : {1.f, 2.f, 4.f, 8.f})
+        {
+            ck::utils::FillUniformDistribution<float>{-range, range}(problem.input);
+
+            if(range >= 4.f)
+            {
+                ck::utils::FillUniformDistribution<float>{-range, range}(problem.weights);
+            }
+
+            problem.invoker.Run(arg_reused);
+
+            EXPECT_TRUE(ck::utils::check_err(
+                out_reused, problem.Run(algorithm), "Error: incorrect results!", 0.f, 0.f));
+        }
+
+        // a single weight changed in place is enough to invalidate the transform
+        problem.weights(0, 4, 1, 2, 0) += 1.f;
+
+        problem.invoker.Run(arg_reused);
+
+        EXPECT_TRUE(ck::utils::check_err(
+            out_reused, problem.Run(algorithm), "Error: incorrect results!", 0.f, 0.f));
+    }
+}
+
+TEST(ReferenceConvolutionFWD, Conv2DGNHWCWinogradNonFiniteWeightMatchesDirect)
+{
+    ReferenceConv2DFwdProblem problem(
+        ck::utils::conv::ConvParam(2,
+                                   1,
+                                   2,
+                                   6,
+                                   4,
+                                   std::vector<ck::index_t>{3, 3},
+                                   std::vector<ck::index_t>{9, 8},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 1}));
+
+    // the first filter row is in the padding for the first output row
+    problem.weights(0, 2, 1, 0, 1) = std::numeric_limits<float>::infinity();
+    problem.weights(0, 4, 3, 0, 0) = std::numeric_limits<float>::quiet_NaN();
+
+    const auto out_direct = problem.Run(ReferenceConvFwdAlgorithm::Direct);
+
+    // a non-finite transformed filter makes Run() fall back to the default algorithm
+    expect_equal_or_nan(problem.Run(ReferenceConvFwdAlgorithm::WinogradF2x2), out_direct);
+    expect_equal_or_nan(problem.Run(ReferenceConvFwdAlgorithm::WinogradF4x4), out_direct);
+
+    EXPECT_TRUE(std::isfinite(out_direct(0, 0, 2, 0, 3)));
+    EXPECT_TRUE(std::isinf(out_direct(0, 0, 2, 1, 3)));
+}
+
+TEST(ReferenceConvolutionFWD, Conv2DGNHWCWinogradNonFiniteInputMatchesDirect)
+{
+    ReferenceConv2DFwdProblem problem(
+        ck::utils::conv::ConvParam(2,
+                                   1,
+                                   2,
+                                   6,
+                                   4,
+                                   std::vector<ck::index_t>{3, 3},
+                                   std::vector<ck::index_t>{12, 12},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 1},
+                                   std::vector<ck::index_t>{1, 1}));
+
+    // only the outputs (ho, wo) in [4, 6] x [4, 6] read the Inf input, and only those in
+    // [9, 11] x [0, 2] the NaN one; a Winograd tile would spread them over its neighbours
+    problem.input(0, 1, 3, 5, 5)  = std::numeric_limits<float>::infinity();
+    problem.input(0, 0, 0, 10, 1) = std::numeric_limits<float>::quiet_NaN();
+
+    const auto out_direct = problem.Run(ReferenceConvFwdAlgorithm::Direct);
+
+    // a non-finite input makes Run() fall back to the default algorithm
+    expect_equal_or_nan(problem.Run(ReferenceConvFwdAlgorithm::WinogradF2x2), out_direct);
+    expect_equal_or_nan(problem.Run(ReferenceConvFwdAlgorithm::WinogradF4x4), out_direct);
+
+    EXPECT_TRUE(std::isinf(out_direct(0, 1, 0, 5, 5)));
+    EXPECT_TRUE(std::isfinite(out_direct(0, 1, 0, 3, 5)));
+    EXPECT_TRUE(std::isfinite(out_direct(0, 1, 0, 7, 7)));
+    EXPECT_TRUE(std::isnan(out_direct(0, 0, 0, 10, 1)));
+    EXPECT_TRUE(std::isfinite(out_direct(0, 0, 0, 8, 1)));
+}
+
+TEST(ReferenceConvolutionFWD, Conv2DGNHWCZeroStrideMatchesDirect)
+{
+    ReferenceConv2DFwdProblem problem(make_implicit_gemm_conv_param());
+
+    // the output lengths stay those of the original strides; a zero stride makes every output
+    // row read the same input window
+    problem.conv_param.conv_filter_strides_ = {0, 1};
+
+    Tensor<float> out_default(problem.out_desc);
+
+    auto arg_default = problem.MakeArgument(out_default, ReferenceConvFwdAlgorithm::Default);
+
+    // the inner output range of the implicit GEMM divides by the stride
+    EXPECT_FALSE(problem.invoker.IsImplicitGemmApplicable(arg_default));
+
+    problem.invoker.Run(arg_default);
+
+    const auto out_direct = problem.Run(ReferenceConvFwdAlgorithm::Direct);
+
+    EXPECT_TRUE(
+        ck::utils::check_err(out_default, out_direct, "Error: incorrect results!", 0.f, 0.f));
+
+    EXPECT_EQ(out_default(1, 1, 4, 5, 3), out_default(1, 1, 4, 0, 3));
+
+    problem.conv_param.conv_filter_strides_   = {2, 1};
+    problem.conv_param.conv_filter_dilations_ = {1, -3};
+
+    EXPECT_FALSE(problem.invoker.IsImplicitGemmApplicable(
+        problem.MakeArgument(out_default, ReferenceConvFwdAlgorithm::Default)));
+}
@@ -0,0 +1,482 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_cgemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm_multiple_d.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Relu        = ck::tensor_operation::element_wise::Relu;
+
+// straightforward triple loop the blocked engine has to reproduce bit for bit
+template <typename ADataType, typename BDataType, typename CDataType, typename AccDataType>
+void naive_gemm(const Tensor<ADataType>& a_m_k,
+                const Tensor<BDataType>& b_k_n,
+                Tensor<CDataType>& c_m_n)
+{
+    const std::size_t M = c_m_n.mDesc.GetLengths()[0];
+    const std::size_t N = c_m_n.mDesc.GetLengths()[1];
+    const std::size_t K = a_m_k.mDesc.GetLengths()[1];
+
+    for(std::size_t m = 0; m < M; ++m)
+    {
+        for(std::size_t n = 0; n < N; ++n)
+        {
+            AccDataType v_acc = 0;
+
+            for(std::size_t k = 0; k < K; ++k)
+            {
+                v_acc += ck::type_convert<AccDataType>(a_m_k(m, k)) *
+                         ck::type_convert<AccDataType>(b_k_n(k, n));
+            }
+
+            c_m_n(m, n) = ck::type_convert<CDataType>(v_acc);
+        }
+    }
+}
+
+template <typename ADataType, typename BDataType, typename CDataType, typename AccDataType>
+bool run_reference_gemm(std::size_t M, std::size_t N, std::size_t K, bool b_col_major)
+{
+    Tensor<ADataType> a_m_k({M, K});
+    Tensor<BDataType> b_k_n = b_col_major
+                                  ? Tensor<BDataType>(std::vector<std::size_t>{K, N},
+                                                      std::vector<std::size_t>{1, K})
+                                  : Tensor<BDataType>(std::vector<std::size_t>{K, N});
+    Tensor<CDataType> c_m_n_naive({M, N});
+    Tensor<CDataType> c_m_n_blocked({M, N});
+
+    ck::utils::FillUniformDistribution<ADataType>{-3.f, 3.f}(a_m_k);
+    ck::utils::FillUniformDistribution<BDataType>{-3.f, 3.f}(b_k_n);
+
+    naive_gemm<ADataType, BDataType, CDataType, AccDataType>(a_m_k, b_k_n, c_m_n_naive);
+
+    auto ref_gemm     = ck::tensor_operation::host::ReferenceGemm<ADataType,
+                                                              BDataType,
+                                                              CDataType,
+                                                              AccDataType,
+                                                              PassThrough,
+                                                              PassThrough,
+                                                              PassThrough>{};
+    auto ref_invoker  = ref_gemm.MakeInvoker();
+    auto ref_argument = ref_gemm.MakeArgument(
+        a_m_k, b_k_n, c_m_n_blocked, PassThrough{}, PassThrough{}, PassThrough{});
+
+    ref_invoker.Run(ref_argument);
+
+    // exact comparison: blocking must not change the fp32 accumulation order
+    return ck::utils::check_err(c_m_n_blocked, c_m_n_naive, "Error: incorrect results!", 0, 0);
+}
+
+// batch by batch with the single GEMM reference; b_broadcast shares B[0] across the batch
+// through a zero batch stride
+template <typename ADataType, typename BDataType, typename CDataType, typename AccDataType>
+bool run_reference_batched_gemm(
+    std::size_t G, std::size_t M, std::size_t N, std::size_t K, bool b_broadcast)
+{
+    Tensor<ADataType> a_g_m_k({G, M, K});
+    Tensor<BDataType> b_g_k_n = b_broadcast
+                                    ? Tensor<BDataType>(std::vector<std::size_t>{G, K, N},
+                                                        std::vector<std::size_t>{0, N, 1})
+                                    : Tensor<BDataType>(std::vector<std::size_t>{G, K, N});
+    Tensor<CDataType> c_g_m_n_naive({G, M, N});
+    Tensor<CDataType> c_g_m_n_blocked({G, M, N});
+
+    ck::utils::FillUniformDistribution<ADataType>{-3.f, 3.f}(a_g_m_k);
+    ck::utils::FillUniformDistribution<BDataType>{-3.f, 3.f}(b_g_k_n);
+
+    for(std::size_t g = 0; g < G; ++g)
+    {
+        Tensor<ADataType> a_m_k({M, K});
+        Tensor<BDataType> b_k_n({K, N});
+        Tensor<CDataType> c_m_n({M, N});
+
+        a_m_k.ForEach([&](auto& self, auto idx) { self(idx) = a_g_m_k(g, idx[0], idx[1]); });
+        b_k_n.ForEach([&](auto& self, auto idx) { self(idx) = b_g_k_n(g, idx[0], idx[1]); });
+
+        naive_gemm<ADataType, BDataType, CDataType, AccDataType>(a_m_k, b_k_n, c_m_n);
+
+        c_m_n.ForEach(
+            [&](auto& self, auto idx) { c_g_m_n_naive(g, idx[0], idx[1]) = self(idx); });
+    }
+
+    auto ref_gemm     = ck::tensor_operation::host::ReferenceBatchedGemm<ADataType,
+                                                                     BDataType,
+                                                                     CDataType,
+                                                                     AccDataType,
+                                                                     PassThrough,
+                                                                     PassThrough,
+                                                                     PassThrough>{};
+    auto ref_invoker  = ref_gemm.MakeInvoker();
+    auto ref_argument = ref_gemm.MakeArgument(
+        a_g_m_k, b_g_k_n, c_g_m_n_blocked, PassThrough{}, PassThrough{}, PassThrough{});
+
+    ref_invoker.Run(ref_argument);
+
+    return ck::utils::check_err(c_g_m_n_blocked, c_g_m_n_naive, "Error: incorrect results!", 0, 0);
+}
+
+// 4M complex GEMM out of the naive real GEMMs, in float as ReferenceCGemm does; 3M is compared
+// to it with a tolerance, 4M bit for bit
+template <ck::tensor_operation::host::HostCGemmAlgorithm Algorithm>
+bool run_reference_cgemm(std::size_t M, std::size_t N, std::size_t K)
+{
+    Tensor<float> a_m_k_real({M, K});
+    Tensor<float> a_m_k_imag({M, K});
+    Tensor<float> b_k_n_real({K, N});
+    Tensor<float> b_k_n_imag({K, N});
+
+    ck::utils::FillUniformDistribution<float>{-3.f, 3.f}(a_m_k_real);
+    ck::utils::FillUniformDistribution<float>{-3.f, 3.f}(a_m_k_imag);
+    ck::utils::FillUniformDistribution<float>{-3.f, 3.f}(b_k_n_real);
+    ck::utils::FillUniformDistribution<float>{-3.f, 3.f}(b_k_n_imag);
+
+    Tensor<float> c_rr({M, N});
+    Tensor<float> c_ii({M, N});
+    Tensor<float> c_ri({M, N});
+    Tensor<float> c_ir({M, N});
+
+    naive_gemm<float, float, float, float>(a_m_k_real, b_k_n_real, c_rr);
+    naive_gemm<float, float, float, float>(a_m_k_imag, b_k_n_imag, c_ii);
+    naive_gemm<float, float, float, float>(a_m_k_real, b_k_n_imag, c_ri);
+    naive_gemm<float, float, float, float>(a_m_k_imag, b_k_n_real, c_ir);
+
+    Tensor<float> c_m_n_real_naive({M, N});
+    Tensor<float> c_m_n_imag_naive({M, N});
+
+    c_m_n_real_naive.ForEach(
+        [&](auto& self, auto idx) { self(idx) = c_rr(idx[0], idx[1]) - c_ii(idx[0], idx[1]); });
+    c_m_n_imag_naive.ForEach(
+        [&](auto& self, auto idx) { self(idx) = c_ri(idx[0], idx[1]) + c_ir(idx[0], idx[1]); });
+
+    Tensor<float> c_m_n_real({M, N});
+    Tensor<float> c_m_n_imag({M, N});
+
+    auto ref_cgemm    = ck::tensor_operation::host::ReferenceCGemm<float,
+                                                                float,
+                                                                float,
+                                                                PassThrough,
+                                                                PassThrough,
+                                                                PassThrough,
+                                                                Algorithm>{};
+    auto ref_invoker  = ref_cgemm.MakeInvoker();
+    auto ref_argument = ref_cgemm.MakeArgument(a_m_k_real,
+                                               a_m_k_imag,
+                                               b_k_n_real,
+                                               b_k_n_imag,
+                                               c_m_n_real,
+                                               c_m_n_imag,
+                                               PassThrough{},
+                                               PassThrough{},
+                                               PassThrough{});
+
+    ref_invoker.Run(ref_argument);
+
+    if constexpr(Algorithm == ck::tensor_operation::host::HostCGemmAlgorithm::Gemm4M)
+    {
+        return ck::utils::check_err(
+                   c_m_n_real, c_m_n_real_naive, "Error: incorrect results!", 0, 0) &&
+               ck::utils::check_err(
+                   c_m_n_imag, c_m_n_imag_naive, "Error: incorrect results!", 0, 0);
+    }
+    else
+    {
+        // the products are exact, the error comes from rounding the partial sums of magnitude
+        // up to about 36 * K
+        const double atol = 1e-6 * 36 * std::max<std::size_t>(K, 1);
+
+        return ck::utils::check_err(
+                   c_m_n_real, c_m_n_real_naive, "Error: incorrect results!", 0, atol) &&
+               ck::utils::check_err(
+                   c_m_n_imag, c_m_n_imag_naive, "Error: incorrect results!", 0, atol);
+    }
+}
+
+// every int8 micro-kernel the CPU supports, against the naive int32 loop
+bool run_host_int8_gemm(std::size_t M, std::size_t N, std::size_t K, bool b_col_major)
+{
+    Tensor<int8_t> a_m_k({M, K});
+    Tensor<int8_t> b_k_n = b_col_major ? Tensor<int8_t>(std::vector<std::size_t>{K, N},
+                                                        std::vector<std::size_t>{1, K})
+                                       : Tensor<int8_t>(std::vector<std::size_t>{K, N});
+    Tensor<int32_t> c_m_n_naive({M, N});
+    Tensor<int32_t> c_m_n({M, N});
+
+    // the full int8 range, -128 included
+    ck::utils::FillUniformDistributionIntegerValue<int8_t>{-128.f, 127.f}(a_m_k);
+    ck::utils::FillUniformDistributionIntegerValue<int8_t>{-128.f, 127.f}(b_k_n);
+
+    naive_gemm<int8_t, int8_t, int32_t, int32_t>(a_m_k, b_k_n, c_m_n_naive);
+
+    bool pass = true;
+
+    for(const auto& kernel : ck::tensor_operation::host::get_host_int8_gemm_micro_kernels())
+    {
+        ck::tensor_operation::host::HostInt8Gemm gemm{static_cast<ck::index_t>(M),
+                                                      static_cast<ck::index_t>(N),
+                                                      static_cast<ck::index_t>(K),
+                                                      kernel};
+
+        gemm.PackB([&](ck::index_t k, ck::index_t n) { return b_k_n(k, n); }, 2);
+        gemm.Run([&](ck::index_t m, ck::index_t k) { return a_m_k(m, k); },
+                 [&](ck::index_t m, ck::index_t n, int32_t v_acc) { c_m_n(m, n) = v_acc; },
+                 2);
+
+        pass &= ck::utils::check_err(c_m_n, c_m_n_naive, "Error: incorrect results!");
+    }
+
+    return pass;
+}
+
+// int8 GEMM with a fused requantization epilogue; ds_m_n are the epilogue inputs besides the
+// int32 accumulator
+template <typename DsDataType, typename CDEElementwiseOperation, typename... DDataTypes>
+bool run_reference_gemm_quantization(std::size_t M,
+                                     std::size_t N,
+                                     std::size_t K,
+                                     CDEElementwiseOperation cde_element_op,
+                                     const Tensor<DDataTypes>&... ds_m_n)
+{
+    Tensor<int8_t> a_m_k({M, K});
+    Tensor<int8_t> b_k_n(std::vector<std::size_t>{K, N}, std::vector<std::size_t>{1, K});
+    Tensor<int32_t> c_m_n({M, N});
+    Tensor<int8_t> e_m_n_naive({M, N});
+    Tensor<int8_t> e_m_n({M, N});
+
+    ck::utils::FillUniformDistributionIntegerValue<int8_t>{-128.f, 127.f}(a_m_k);
+    ck::utils::FillUniformDistributionIntegerValue<int8_t>{-128.f, 127.f}(b_k_n);
+
+    naive_gemm<int8_t, int8_t, int32_t, int32_t>(a_m_k, b_k_n, c_m_n);
+
+    e_m_n_naive.ForEach([&](auto& self, auto idx) {
+        cde_element_op(self(idx), c_m_n(idx), ds_m_n(idx)...);
+    });
+
+    auto ref_gemm     = ck::tensor_operation::host::ReferenceGemmMultipleD<int8_t,
+                                                                       int8_t,
+                                                                       DsDataType,
+                                                                       int8_t,
+                                                                       int32_t,
+                                                                       PassThrough,
+                                                                       PassThrough,
+                                                                       CDEElementwiseOperation>{};
+    auto ref_invoker  = ref_gemm.MakeInvoker();
+    auto ref_argument = ref_gemm.MakeArgument(
+        a_m_k, b_k_n, {ds_m_n...}, e_m_n, PassThrough{}, PassThrough{}, cde_element_op);
+
+    if(!ref_gemm.IsSupportedArgument(&ref_argument))
+        return false;
+
+    ref_invoker.Run(ref_argument);
+
+    return ck::utils::check_err(e_m_n, e_m_n_naive, "Error: incorrect results!", 0, 0);
+}
+
+// A, B and C are windows of larger tensors, passed as views; the result has to match copies of
+// the windows and C has to be left alone outside its window
+bool run_reference_gemm_on_views(std::size_t M, std::size_t N, std::size_t K)
+{
+    Tensor<float> a_big({M + 3, K + 2});
+    Tensor<float> b_big({std::size_t{2}, K, N + 5});
+    Tensor<float> c_big({M + 1, N + 4});
+
+    ck::utils::FillUniformDistribution<float>{-3.f, 3.f}(a_big);
+    ck::utils::FillUniformDistribution<float>{-3.f, 3.f}(b_big);
+    ck::ranges::fill<float>(c_big, -7.f);
+
+    const auto a_m_k = TensorView<const float>(a_big).Slice(0, 2, M + 2).Slice(1, 1, K + 1);
+    const auto b_k_n = TensorView<const float>(b_big).Select(0, 1).Slice(1, 5, N + 5);
+    const auto c_m_n = TensorView<float>(c_big).Slice(0, 1, M + 1).Slice(1, 0, N);
+
+    Tensor<float> a_copy({M, K});
+    Tensor<float> b_copy({K, N});
+    Tensor<float> c_naive({M, N});
+
+    a_copy.ForEach([&](auto& self, auto idx) { self(idx) = a_m_k(idx); });
+    b_copy.ForEach([&](auto& self, auto idx) { self(idx) = b_k_n(idx); });
+
+    naive_gemm<float, float, float, float>(a_copy, b_copy, c_naive);
+
+    using ReferenceGemmInstance = ck::tensor_operation::host::
+        ReferenceGemm<float, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+    auto ref_argument = ReferenceGemmInstance::MakeArgument(
+        a_m_k, b_k_n, c_m_n, PassThrough{}, PassThrough{}, PassThrough{});
+
+    ReferenceGemmInstance::MakeInvoker().Run(ref_argument);
+
+    bool pass = true;
+
+    c_big.ForEach([&](auto& self, auto idx) {
+        const bool is_in_window = idx[0] >= 1 && idx[1] < N;
+
+        const float expected = is_in_window ? c_naive(idx[0] - 1, idx[1]) : -7.f;
+
+        pass = pass && self(idx) == expected;
+    });
+
+    return pass;
+}
+
+} // anonymous namespace
+
+TEST(ReferenceGemm, F32Bitwise)
+{
+    for(std::size_t M : {1, 7, 96, 197})
+        for(std::size_t N : {1, 17, 33, 300})
+            for(std::size_t K : {0, 1, 255, 513})
+            {
+                EXPECT_TRUE((run_reference_gemm<float, float, float, float>(M, N, K, false)));
+                EXPECT_TRUE((run_reference_gemm<float, float, float, float>(M, N, K, true)));
+            }
+}
+
+TEST(ReferenceGemm, SubTensorView)
+{
+    EXPECT_TRUE(run_reference_gemm_on_views(1, 1, 1));
+    EXPECT_TRUE(run_reference_gemm_on_views(37, 65, 129));
+}
+
+TEST(ReferenceGemm, F16Bitwise)
+{
+    EXPECT_TRUE(
+        (run_reference_gemm<ck::half_t, ck::half_t, ck::half_t, float>(130, 70, 300, true)));
+}
+
+TEST(ReferenceGemm, F64Bitwise)
+{
+    EXPECT_TRUE((run_reference_gemm<double, double, double, double>(130, 70, 300, false)));
+}
+
+TEST(ReferenceGemm, I8I32Bitwise)
+{
+    EXPECT_TRUE((run_reference_gemm<int8_t, int8_t, int32_t, int32_t>(130, 70, 300, false)));
+    EXPECT_TRUE((run_reference_gemm<int8_t, int8_t, int32_t, int32_t>(130, 70, 0, false)));
+}
+
+TEST(ReferenceBatchedGemm, F32Bitwise)
+{
+    for(std::size_t G : {1, 5})
+        for(std::size_t M : {1, 97})
+            for(std::size_t N : {17, 300})
+                for(std::size_t K : {0, 64, 257})
+                {
+                    EXPECT_TRUE(
+                        (run_reference_batched_gemm<float, float, float, float>(G, M, N, K, false)));
+                    EXPECT_TRUE(
+                        (run_reference_batched_gemm<float, float, float, float>(G, M, N, K, true)));
+                }
+}
+
+TEST(ReferenceBatchedGemm, F16Bitwise)
+{
+    EXPECT_TRUE((run_reference_batched_gemm<ck::half_t, ck::half_t, ck::half_t, float>(
+        12, 64, 64, 40, false)));
+}
+
+TEST(ReferenceCGemm, F32Gemm4MBitwise)
+{
+    using ck::tensor_operation::host::HostCGemmAlgorithm;
+
+    for(std::size_t M : {1, 97})
+        for(std::size_t N : {17, 300})
+            for(std::size_t K : {0, 255})
+                EXPECT_TRUE(run_reference_cgemm<HostCGemmAlgorithm::Gemm4M>(M, N, K));
+}
+
+TEST(ReferenceCGemm, F32Gemm3M)
+{
+    using ck::tensor_operation::host::HostCGemmAlgorithm;
+    using ck::tensor_operation::host::ReferenceCGemm;
+
+    // Gemm3M is the default, Gemm4M is opt-in
+    static_assert(
+        std::is_same_v<
+            ReferenceCGemm<float, float, float, PassThrough, PassThrough, PassThrough>,
+            ReferenceCGemm<float,
+                           float,
+                           float,
+                           PassThrough,
+                           PassThrough,
+                           PassThrough,
+                           HostCGemmAlgorithm::Gemm3M>>);
+
+    for(std::size_t M : {1, 97})
+        for(std::size_t N : {17, 300})
+            for(std::size_t K : {0, 255})
+                EXPECT_TRUE(run_reference_cgemm<HostCGemmAlgorithm::Gemm3M>(M, N, K));
+}
+
+TEST(HostInt8Gemm, Bitwise)
+{
+    for(std::size_t M : {1, 7, 197})
+        for(std::size_t N : {1, 33, 300})
+            for(std::size_t K : {0, 1, 6, 513})
+            {
+                EXPECT_TRUE(run_host_int8_gemm(M, N, K, false));
+                EXPECT_TRUE(run_host_int8_gemm(M, N, K, true));
+            }
+}
+
+TEST(ReferenceGemmMultipleD, I8PerTensorQuantization)
+{
+    using namespace ck::tensor_operation::element_wise;
+
+    EXPECT_TRUE((run_reference_gemm_quantization<ck::Tuple<>>(
+        130, 70, 300, Activation_Mul_Clamp<Relu>{0.0005f, Relu{}})));
+}
+
+TEST(ReferenceGemmMultipleD, I8EmptyK)
+{
+    using namespace ck::tensor_operation::element_wise;
+
+    // K == 0: the epilogue runs on zero accumulators
+    EXPECT_TRUE((run_reference_gemm_quantization<ck::Tuple<>>(
+        130, 70, 0, Activation_Mul_Clamp<Relu>{0.0005f, Relu{}})));
+}
+
+TEST(ReferenceGemmMultipleD, I8BiasQuantization)
+{
+    using namespace ck::tensor_operation::element_wise;
+
+    // bias broadcast over M
+    Tensor<int32_t> bias_m_n(std::vector<std::size_t>{130, 70}, std::vector<std::size_t>{0, 1});
+
+    ck::utils::FillUniformDistributionIntegerValue<int32_t>{-128.f, 127.f}(bias_m_n);
+
+    EXPECT_TRUE((run_reference_gemm_quantization<ck::Tuple<int32_t>>(
+        130, 70, 300, Add_Activation_Mul_Clamp<Relu>{0.0005f, Relu{}}, bias_m_n)));
+    EXPECT_TRUE((run_reference_gemm_quantization<ck::Tuple<int32_t>>(
+        130, 70, 300, Add_Mul_Activation_Mul_Clamp<Relu>{0.001f, 0.5f, Relu{}}, bias_m_n)));
+}
+
+TEST(ReferenceGemmMultipleD, I8PerChannelQuantization)
+{
+    using namespace ck::tensor_operation::element_wise;
+
+    Tensor<int32_t> bias_m_n(std::vector<std::size_t>{130, 70}, std::vector<std::size_t>{0, 1});
+    Tensor<float> scale_m_n(std::vector<std::size_t>{130, 70}, std::vector<std::size_t>{0, 1});
+
+    ck::utils::FillUniformDistributionIntegerValue<int32_t>{-128.f, 127.f}(bias_m_n);
+    ck::utils::FillUniformDistribution<float>{0.0002f, 0.001f}(scale_m_n);
+
+    EXPECT_TRUE((run_reference_gemm_quantization<ck::Tuple<float>>(
+        130, 70, 300, Activation_Mul2_Clamp<Relu>{Relu{}}, scale_m_n)));
+    EXPECT_TRUE((run_reference_gemm_quantization<ck::Tuple<int32_t, float>>(
+        130, 70, 300, Add_Activation_Mul2_Clamp<Relu>{Relu{}}, bias_m_n, scale_m_n)));
+}
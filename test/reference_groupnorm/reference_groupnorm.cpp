@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_groupnorm.hpp"
+
+namespace {
+
+using ck::index_t;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+using ReferenceGroupnormInstance = ck::tensor_operation::host::
+    ReferenceGroupnorm<float, float, float, float, float, PassThrough>;
+
+// two-pass mean / variance in double and y = (x - mean) / sqrt(var + eps) * gamma + beta
+void naive_groupnorm(const Tensor<float>& x,
+                     const Tensor<float>& gamma,
+                     const Tensor<float>& beta,
+                     Tensor<double>& y,
+                     double epsilon)
+{
+    const auto& lengths = x.mDesc.GetLengths();
+
+    const std::size_t N = lengths[0], H = lengths[1], W = lengths[2], G = lengths[3],
+                      C = lengths[4];
+
+    for(std::size_t n = 0; n < N; ++n)
+        for(std::size_t g = 0; g < G; ++g)
+        {
+            double sum = 0;
+
+            for(std::size_t h = 0; h < H; ++h)
+                for(std::size_t w = 0; w < W; ++w)
+                    for(std::size_t c = 0; c < C; ++c)
+                        sum += x(n, h, w, g, c);
+
+            const double mean = sum / (H * W * C);
+
+            double sum_sq = 0;
+
+            for(std::size_t h = 0; h < H; ++h)
+                for(std::size_t w = 0; w < W; ++w)
+                    for(std::size_t c = 0; c < C; ++c)
+                        sum_sq += (x(n, h, w, g, c) - mean) * (x(n, h, w, g, c) - mean);
+
+            const double rstd = 1.0 / std::sqrt(sum_sq / (H * W * C) + epsilon);
+
+            for(std::size_t h = 0; h < H; ++h)
+                for(std::size_t w = 0; w < W; ++w)
+                    for(std::size_t c = 0; c < C; ++c)
+                        y(n, h, w, g, c) =
+                            (x(n, h, w, g, c) - mean) * rstd * gamma(g, c) + beta(g, c);
+        }
+}
+
+template <typename F>
+void test_groupnorm(const std::vector<index_t>& lengths, F f_x, double tolerance)
+{
+    const std::vector<std::size_t> x_lengths(lengths.begin(), lengths.end());
+
+    Tensor<float> x(x_lengths);
+    Tensor<float> y(x_lengths);
+    Tensor<double> y_naive(x_lengths);
+    Tensor<float> gamma({x_lengths[3], x_lengths[4]});
+    Tensor<float> beta({x_lengths[3], x_lengths[4]});
+
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dis(-1.f, 1.f);
+
+    x.ForEach([&](auto& self, auto idx) { self(idx) = f_x(gen, idx); });
+
+    for(auto& v : gamma.mData)
+        v = dis(gen);
+
+    for(auto& v : beta.mData)
+        v = dis(gen);
+
+    const float epsilon = 1e-5f;
+
+    auto ref      = ReferenceGroupnormInstance{};
+    auto argument = ref.MakeArgument(x, gamma, beta, y, PassThrough{}, lengths, epsilon);
+    auto invoker  = ref.MakeInvoker();
+
+    ASSERT_TRUE(ref.IsSupportedArgument(&argument));
+
+    invoker.Run(argument);
+
+    naive_groupnorm(x, gamma, beta, y_naive, epsilon);
+
+    double max_err = 0;
+
+    for(std::size_t i = 0; i < y.mData.size(); ++i)
+        max_err = std::max(max_err, std::abs(y.mData[i] - y_naive.mData[i]));
+
+    EXPECT_LE(max_err, tolerance);
+}
+
+// unit normal noise
+struct RandomX
+{
+    template <typename Gen>
+    float operator()(Gen& gen, const std::vector<std::size_t>&) const
+    {
+        return std::normal_distribution<float>{0.f, 1.f}(gen);
+    }
+};
+
+// 65536 + k / 8, k in [-8, 8), repeating over C with a period of 16. The mean is far larger
+// than the standard deviation, and every Welford lane and H * W slice sees the same values, so
+// the statistics are exact: what is left is the error of the normalization itself
+struct LargeMeanX
+{
+    template <typename Gen>
+    float operator()(Gen&, const std::vector<std::size_t>& idx) const
+    {
+        const std::size_t k = (idx[4] * 5 + idx[3] * 3 + idx[0]) % 16;
+
+        return 65536.f + (static_cast<float>(k) - 8.f) / 8.f;
+    }
+};
+
+} // namespace
+
+TEST(ReferenceGroupnorm, Random) { test_groupnorm({2, 5, 7, 3, 9}, RandomX{}, 1e-5); }
+
+TEST(ReferenceGroupnorm, SplitStatistics)
+{
+    // large enough for the statistics of one (n, g) to be split over H * W
+    test_groupnorm({1, 64, 64, 2, 16}, RandomX{}, 1e-4);
+}
+
+// folding the mean into a shift, x * scale + (beta - mean * scale), cancels two terms of about
+// 65536 * scale here and is off by more than 1e-3
+TEST(ReferenceGroupnorm, LargeMean) { test_groupnorm({2, 5, 7, 3, 32}, LargeMeanX{}, 1e-5); }
+
+TEST(ReferenceGroupnorm, LargeMeanSplitStatistics)
+{
+    test_groupnorm({1, 64, 64, 2, 32}, LargeMeanX{}, 1e-5);
+}
+
+TEST(ReferenceGroupnorm, EmptySpatialExtent)
+{
+    EXPECT_EQ(ReferenceGroupnormInstance::Invoker::GetNumSplit(0, 7, 9), 1);
+
+    test_groupnorm({2, 0, 7, 3, 9}, RandomX{}, 0);
+}
@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_welford.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_layernorm.hpp"
+
+namespace {
+
+using ck::index_t;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+// mean and biased variance in two passes, in double
+template <typename F>
+std::pair<double, double> two_pass_mean_variance(F f_x, std::size_t n)
+{
+    double sum = 0;
+
+    for(std::size_t i = 0; i < n; ++i)
+        sum += f_x(i);
+
+    const double mean = sum / n;
+
+    double sum_sq = 0;
+
+    for(std::size_t i = 0; i < n; ++i)
+        sum_sq += (f_x(i) - mean) * (f_x(i) - mean);
+
+    return {mean, sum_sq / n};
+}
+
+std::vector<float> make_values(std::size_t n, float offset, std::mt19937& gen)
+{
+    std::uniform_real_distribution<float> dis(-1.f, 1.f);
+
+    std::vector<float> x(n);
+
+    for(auto& v : x)
+        v = offset + dis(gen);
+
+    return x;
+}
+
+void expect_statistics(const ck::tensor_operation::host::HostWelford<float>& welford,
+                       const std::pair<double, double>& ref)
+{
+    EXPECT_LE(std::abs(welford.GetMean() - ref.first), 1e-5 * (1 + std::abs(ref.first)));
+    EXPECT_LE(std::abs(welford.GetVariance() - ref.second), 1e-5 * (1e-3 + ref.second));
+}
+
+// the logical multi-index of the flat index i, last dim fastest
+std::vector<std::size_t> get_index(const std::vector<std::size_t>& lengths, std::size_t i)
+{
+    std::vector<std::size_t> idx(lengths.size());
+
+    for(std::size_t dim = lengths.size(); dim-- > 0;)
+    {
+        idx[dim] = i % lengths[dim];
+        i /= lengths[dim];
+    }
+
+    return idx;
+}
+
+enum struct Layout
+{
+    Packed,     // row-major
+    Padded,     // row-major, inside a wider last dim
+    Transposed, // column-major: the last dim has the largest stride
+};
+
+// storage of a tensor and a view of it with the given logical lengths and layout
+struct LayoutTensor
+{
+    LayoutTensor(const std::vector<std::size_t>& lengths, Layout layout)
+        : storage_(GetStorageLengths(lengths, layout)), view_(storage_)
+    {
+        const std::size_t rank = lengths.size();
+
+        if(layout == Layout::Padded)
+        {
+            view_ = view_.Slice(rank - 1, 2, 2 + lengths[rank - 1]);
+        }
+        else if(layout == Layout::Transposed)
+        {
+            std::vector<std::size_t> new2old(rank);
+
+            for(std::size_t i = 0; i < rank; ++i)
+                new2old[i] = rank - 1 - i;
+
+            view_ = view_.Transpose(new2old);
+        }
+    }
+
+    static std::vector<std::size_t> GetStorageLengths(std::vector<std::size_t> lengths,
+                                                      Layout layout)
+    {
+        if(layout == Layout::Padded)
+            lengths.back() += 5;
+        else if(layout == Layout::Transposed)
+            std::reverse(lengths.begin(), lengths.end());
+
+        return lengths;
+    }
+
+    Tensor<float> storage_;
+    TensorView<float> view_;
+};
+
+// normalizes x over its NumReduceDim trailing dims and compares against two-pass statistics
+template <index_t Rank, index_t NumReduceDim>
+void test_layernorm(const std::vector<std::size_t>& lengths,
+                    Layout x_layout,
+                    Layout y_layout,
+                    float offset)
+{
+    using ReferenceLayernormInstance = ck::tensor_operation::host::
+        ReferenceLayernorm<float, float, float, float, float, PassThrough, Rank, NumReduceDim>;
+
+    const std::vector<std::size_t> reduce_lengths(lengths.end() - NumReduceDim, lengths.end());
+
+    std::size_t num_row    = 1;
+    std::size_t row_length = 1;
+
+    for(index_t dim = 0; dim < Rank; ++dim)
+        (dim < Rank - NumReduceDim ? num_row : row_length) *= lengths[dim];
+
+    LayoutTensor x(lengths, x_layout);
+    LayoutTensor y(lengths, y_layout);
+    Tensor<float> gamma(reduce_lengths);
+    Tensor<float> beta(reduce_lengths);
+
+    std::mt19937 gen(0);
+
+    const auto x_values     = make_values(num_row * row_length, offset, gen);
+    const auto gamma_values = make_values(row_length, 0.f, gen);
+    const auto beta_values  = make_values(row_length, 0.f, gen);
+
+    for(std::size_t i = 0; i < x_values.size(); ++i)
+        x.view_(get_index(lengths, i)) = x_values[i];
+
+    for(std::size_t i = 0; i < row_length; ++i)
+    {
+        gamma(get_index(reduce_lengths, i)) = gamma_values[i];
+        beta(get_index(reduce_lengths, i))  = beta_values[i];
+    }
+
+    std::vector<index_t> reduce_dims;
+
+    for(index_t dim = Rank - NumReduceDim; dim < Rank; ++dim)
+        reduce_dims.push_back(dim);
+
+    const float epsilon = 1e-5f;
+
+    auto ref      = ReferenceLayernormInstance{};
+    auto argument = ref.MakeArgument(x.view_,
+                                     gamma,
+                                     beta,
+                                     y.view_,
+                                     PassThrough{},
+                                     std::vector<index_t>(lengths.begin(), lengths.end()),
+                                     reduce_dims,
+                                     epsilon);
+    auto invoker  = ref.MakeInvoker();
+
+    ASSERT_TRUE(ref.IsSupportedArgument(&argument));
+
+    invoker.Run(argument);
+
+    for(std::size_t row = 0; row < num_row; ++row)
+    {
+        const float* p_x = &x_values[row * row_length];
+
+        const auto [mean, variance] =
+            two_pass_mean_variance([&](std::size_t i) { return double(p_x[i]); }, row_length);
+
+        const double rstd = 1. / std::sqrt(variance + epsilon);
+
+        for(std::size_t i = 0; i < row_length; ++i)
+        {
+            const double y_ref = (p_x[i] - mean) * rstd * gamma_values[i] + beta_values[i];
+
+            EXPECT_LE(std::abs(y.view_(get_index(lengths, row * row_length + i)) - y_ref), 2e-5);
+        }
+    }
+}
+
+const std::vector<Layout> layouts{Layout::Packed, Layout::Padded, Layout::Transposed};
+
+} // namespace
+
+// contiguous input takes the laned path from 32 elements on, strided input the scalar one
+TEST(HostWelford, AccumulateMatchesTwoPass)
+{
+    std::mt19937 gen(0);
+
+    for(float offset : {0.f, 50.f})
+        for(std::size_t n : {1, 2, 15, 31, 32, 33, 47, 64, 100, 1000, 4097})
+            for(index_t stride : {1, 3})
+            {
+                const auto x = make_values(n * stride, offset, gen);
+
+                ck::tensor_operation::host::HostWelford<float> welford;
+
+                ck::tensor_operation::host::host_welford_accumulate(welford, x.data(), n, stride);
+
+                const auto ref = two_pass_mean_variance(
+                    [&](std::size_t i) { return double(x[i * stride]); }, n);
+
+                expect_statistics(welford, ref);
+            }
+}
+
+// Chan's merge of the two parts [0, split) and [split, n) of one reduction
+TEST(HostWelford, MergeMatchesTwoPass)
+{
+    std::mt19937 gen(0);
+
+    const std::size_t n = 1000;
+
+    for(float offset : {0.f, 50.f})
+    {
+        // the two parts with different means
+        auto x = make_values(n, offset, gen);
+
+        for(std::size_t i = n / 3; i < n; ++i)
+            x[i] += 2.f;
+
+        const auto ref = two_pass_mean_variance([&](std::size_t i) { return double(x[i]); }, n);
+
+        for(std::size_t split : {0, 1, 31, 333, 500, 999, 1000})
+        {
+            ck::tensor_operation::host::HostWelford<float> welford_a;
+            ck::tensor_operation::host::HostWelford<float> welford_b;
+
+            ck::tensor_operation::host::host_welford_accumulate(welford_a, x.data(), split, 1);
+            ck::tensor_operation::host::host_welford_accumulate(
+                welford_b, x.data() + split, n - split, 1);
+
+            welford_a.Merge(welford_b);
+
+            EXPECT_EQ(welford_a.count_, static_cast<ck::long_index_t>(n));
+
+            expect_statistics(welford_a, ref);
+        }
+    }
+}
+
+TEST(ReferenceLayernorm, Rank2)
+{
+    for(Layout x_layout : layouts)
+        for(Layout y_layout : layouts)
+            for(std::size_t n : {1, 7, 33, 256})
+                test_layernorm<2, 1>({5, n}, x_layout, y_layout, 0.f);
+}
+
+TEST(ReferenceLayernorm, Rank3ReduceLastDim)
+{
+    for(Layout x_layout : layouts)
+        for(Layout y_layout : layouts)
+            test_layernorm<3, 1>({3, 4, 37}, x_layout, y_layout, 0.f);
+}
+
+TEST(ReferenceLayernorm, Rank3ReduceTwoDims)
+{
+    // packed reduce dims are folded into one Welford stream, strided ones are not
+    for(Layout x_layout : layouts)
+        for(Layout y_layout : layouts)
+            for(std::size_t n : {5, 16, 40})
+                test_layernorm<3, 2>({3, 6, n}, x_layout, y_layout, 0.f);
+}
+
+TEST(ReferenceLayernorm, Offset)
+{
+    for(Layout x_layout : layouts)
+    {
+        test_layernorm<2, 1>({4, 300}, x_layout, Layout::Packed, 20.f);
+        test_layernorm<3, 2>({2, 9, 40}, x_layout, Layout::Packed, 20.f);
+    }
+}
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdlib>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_permute.hpp"
+
+namespace {
+
+using ck::index_t;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Scale       = ck::tensor_operation::element_wise::Scale;
+
+std::vector<std::size_t> get_out_lengths(const std::vector<std::size_t>& in_lengths,
+                                         const std::vector<index_t>& axes)
+{
+    std::vector<std::size_t> out_lengths;
+
+    for(auto axis : axes)
+        out_lengths.push_back(in_lengths[axis]);
+
+    return out_lengths;
+}
+
+template <typename InDataType, typename OutDataType, typename ElementwiseOperation>
+void test_permute(const HostTensorDescriptor& in_desc,
+                  const HostTensorDescriptor& out_desc,
+                  const std::vector<index_t>& axes,
+                  ElementwiseOperation element_op)
+{
+    Tensor<InDataType> in(in_desc);
+    Tensor<OutDataType> out(out_desc);
+
+    std::srand(0);
+
+    for(auto& v : in.mData)
+        v = static_cast<InDataType>(std::rand() % 2001 - 1000);
+
+    using ReferenceInstance =
+        ck::tensor_operation::host::ReferencePermute<InDataType, OutDataType, ElementwiseOperation>;
+
+    ReferenceInstance ref;
+
+    auto argument = ref.MakeArgument(in, out, axes, element_op);
+
+    ASSERT_TRUE(ref.IsSupportedArgument(&argument));
+
+    ref.MakeInvoker().Run(argument);
+
+    const auto& in_lengths    = in.mDesc.GetLengths();
+    const std::size_t num_dim = in_lengths.size();
+
+    std::vector<std::size_t> in_idx(num_dim, 0);
+    std::vector<std::size_t> out_idx(num_dim);
+
+    for(std::size_t i = 0; i < in.mDesc.GetElementSize(); ++i)
+    {
+        for(std::size_t d = 0; d < num_dim; ++d)
+            out_idx[d] = in_idx[axes[d]];
+
+        OutDataType expected;
+
+        element_op(expected, in.mData[in.mDesc.GetOffsetFromMultiIndex(in_idx)]);
+
+        ASSERT_TRUE(out.mData[out.mDesc.GetOffsetFromMultiIndex(out_idx)] == expected)
+            << "element " << i;
+
+        for(std::size_t d = num_dim; d-- > 0;)
+        {
+            if(++in_idx[d] < in_lengths[d])
+                break;
+
+            in_idx[d] = 0;
+        }
+    }
+}
+
+template <typename DataType, typename ElementwiseOperation = PassThrough>
+void test_packed(const std::vector<std::size_t>& in_lengths,
+                 const std::vector<index_t>& axes,
+                 ElementwiseOperation element_op = {})
+{
+    test_permute<DataType, DataType>(HostTensorDescriptor(in_lengths),
+                                     HostTensorDescriptor(get_out_lengths(in_lengths, axes)),
+                                     axes,
+                                     element_op);
+}
+
+} // namespace
+
+TEST(ReferencePermute, Transpose2D)
+{
+    // the 2, 4 and 8 byte SSE2 tiles, with remainders
+    test_packed<ck::half_t>({77, 300}, {1, 0});
+    test_packed<float>({300, 77}, {1, 0});
+    test_packed<double>({129, 65}, {1, 0});
+    test_packed<int8_t>({70, 33}, {1, 0});
+}
+
+TEST(ReferencePermute, NCHWToNHWC)
+{
+    test_packed<ck::half_t>({3, 40, 9, 31}, {0, 2, 3, 1});
+    test_packed<float>({2, 3, 17, 300}, {0, 2, 3, 1});
+}
+
+TEST(ReferencePermute, Bundle)
+{
+    // [N, H, W, 4] -> [N, W, H, 4], the 4 halves move as one 8 byte unit
+    test_packed<ck::half_t>({2, 80, 321, 4}, {0, 2, 1, 3});
+
+    // a 3 element bundle takes the scalar path
+    test_packed<float>({2, 45, 67, 3}, {0, 2, 1, 3});
+}
+
+TEST(ReferencePermute, ElementwiseOperation)
+{
+    test_permute<float, float>(HostTensorDescriptor(std::vector<std::size_t>{5, 130, 70}),
+                               HostTensorDescriptor(std::vector<std::size_t>{70, 5, 130}),
+                               {2, 0, 1},
+                               Scale{0.5f});
+}
+
+TEST(ReferencePermute, Copy)
+{
+    test_packed<float>({3, 500, 7}, {0, 1, 2});
+    test_packed<float>({1, 1, 1}, {2, 0, 1});
+}
+
+TEST(ReferencePermute, StridedLayouts)
+{
+    // padded input rows, written to an output stored in the input dimension order
+    test_permute<float, float>(HostTensorDescriptor(std::vector<std::size_t>{4, 37, 53},
+                                                    std::vector<std::size_t>{37 * 64, 64, 1}),
+                               HostTensorDescriptor(std::vector<std::size_t>{53, 4, 37},
+                                                    std::vector<std::size_t>{1, 53 * 37, 53}),
+                               {2, 0, 1},
+                               PassThrough{});
+
+    test_packed<float>({2, 1, 33, 5, 1, 19}, {5, 1, 3, 0, 4, 2});
+}
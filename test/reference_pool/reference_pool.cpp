@@ -0,0 +1,474 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/utility/reduction_enums.hpp"
+#include "ck/utility/reduction_functions_accumulate.hpp"
+#include "ck/tensor_operation/gpu/device/reduction_operator_mapping.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_bwd.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_fwd.hpp"
+
+namespace {
+
+using ck::index_t;
+using ck::ReduceTensorOp;
+
+struct PoolProblem
+{
+    std::vector<index_t> in_lengths; // N, C, spatial
+    std::vector<index_t> window_lengths;
+    std::vector<index_t> window_strides;
+    std::vector<index_t> left_pads;
+    std::vector<index_t> right_pads;
+
+    std::vector<index_t> GetOutLengths() const
+    {
+        std::vector<index_t> out_lengths{in_lengths[0], in_lengths[1]};
+
+        for(std::size_t i = 0; i < window_lengths.size(); ++i)
+        {
+            out_lengths.push_back((in_lengths[i + 2] + left_pads[i] + right_pads[i] -
+                                   window_lengths[i]) /
+                                      window_strides[i] +
+                                  1);
+        }
+
+        return out_lengths;
+    }
+};
+
+// channel-last physical layout for [N, C, spatial...] lengths
+HostTensorDescriptor make_descriptor(const std::vector<index_t>& lengths)
+{
+    std::vector<std::size_t> strides(lengths.size());
+
+    std::size_t stride = lengths[1];
+
+    for(std::size_t i = lengths.size() - 1; i >= 2; --i)
+    {
+        strides[i] = stride;
+        stride *= lengths[i];
+    }
+
+    strides[1] = 1;
+    strides[0] = stride;
+
+    return HostTensorDescriptor(lengths, strides);
+}
+
+// small integers give many ties within a window
+Tensor<float> make_input(const std::vector<index_t>& lengths, bool with_nan)
+{
+    Tensor<float> in(make_descriptor(lengths));
+
+    std::srand(0);
+
+    for(auto& v : in.mData)
+        v = static_cast<float>(std::rand() % 9 - 4) * 0.5f;
+
+    if(with_nan)
+    {
+        for(std::size_t i = 0; i < in.mData.size(); i += 37)
+            in.mData[i] = std::numeric_limits<float>::quiet_NaN();
+    }
+
+    return in;
+}
+
+// offset of [n, c, d, h, w] in t, the spatial dimensions as (D, H, W) with the missing leading
+// ones of length 1
+template <typename T>
+std::size_t get_offset(const Tensor<T>& t, index_t n, index_t c, const index_t (&dhw)[3])
+{
+    const auto& strides = t.mDesc.GetStrides();
+    const std::size_t num_spatial = strides.size() - 2;
+
+    std::size_t offset = n * strides[0] + c * strides[1];
+
+    for(std::size_t i = 0; i < num_spatial; ++i)
+        offset += dhw[3 - num_spatial + i] * strides[i + 2];
+
+    return offset;
+}
+
+// the per-output window scan of the pooling example
+template <ReduceTensorOp ReduceOpId, bool PropagateNan, bool OutputIndex>
+void naive_pool_fwd(const Tensor<float>& in,
+                    Tensor<float>& out,
+                    Tensor<int32_t>& out_indices,
+                    const PoolProblem& problem)
+{
+    using ReduceOperation = typename ck::reduce_binary_operator<ReduceOpId>::opType;
+
+    const std::size_t num_spatial = problem.window_lengths.size();
+
+    index_t in_len[3] = {1, 1, 1}, out_len[3] = {1, 1, 1}, win[3] = {1, 1, 1},
+            stride[3] = {1, 1, 1}, pad[3] = {0, 0, 0};
+
+    const auto out_lengths = problem.GetOutLengths();
+
+    for(std::size_t i = 0; i < num_spatial; ++i)
+    {
+        const std::size_t j = 3 - num_spatial + i;
+
+        in_len[j]  = problem.in_lengths[i + 2];
+        out_len[j] = out_lengths[i + 2];
+        win[j]     = problem.window_lengths[i];
+        stride[j]  = problem.window_strides[i];
+        pad[j]     = problem.left_pads[i];
+    }
+
+    const auto elementwise_ops = ck::reduce_unary_operator<ReduceOpId, true, true>::
+        GetElementwiseOperator(win[0] * win[1] * win[2]);
+
+    const auto in_op  = std::get<0>(elementwise_ops);
+    const auto acc_op = std::get<1>(elementwise_ops);
+
+    for(index_t n = 0; n < problem.in_lengths[0]; ++n)
+        for(index_t c = 0; c < problem.in_lengths[1]; ++c)
+            for(index_t od = 0; od < out_len[0]; ++od)
+                for(index_t oh = 0; oh < out_len[1]; ++oh)
+                    for(index_t ow = 0; ow < out_len[2]; ++ow)
+                    {
+                        auto acc        = ReduceOperation::template GetIdentityValue<float>();
+                        int32_t acc_idx = 0;
+                        bool eligible   = false;
+
+                        for(index_t z = 0; z < win[0]; ++z)
+                            for(index_t y = 0; y < win[1]; ++y)
+                                for(index_t x = 0; x < win[2]; ++x)
+                                {
+                                    const index_t id = od * stride[0] - pad[0] + z;
+                                    const index_t ih = oh * stride[1] - pad[1] + y;
+                                    const index_t iw = ow * stride[2] - pad[2] + x;
+
+                                    if(id < 0 || id >= in_len[0] || ih < 0 || ih >= in_len[1] ||
+                                       iw < 0 || iw >= in_len[2])
+                                        continue;
+
+                                    float v = in.mData[get_offset(in, n, c, {id, ih, iw})];
+
+                                    in_op(v, v);
+
+                                    eligible = eligible || PropagateNan || !std::isnan(v);
+
+                                    if constexpr(OutputIndex)
+                                    {
+                                        ck::detail::AccumulateWithIndexAndNanCheck<
+                                            PropagateNan,
+                                            ReduceOperation,
+                                            float,
+                                            int32_t>::Calculate(acc,
+                                                                v,
+                                                                acc_idx,
+                                                                (z * win[1] + y) * win[2] + x);
+                                    }
+                                    else
+                                    {
+                                        ck::detail::AccumulateWithNanCheck<PropagateNan,
+                                                                           ReduceOperation,
+                                                                           float>::Calculate(acc,
+                                                                                             v);
+                                    }
+                                }
+
+                        acc_op(acc, acc);
+
+                        out.mData[get_offset(out, n, c, {od, oh, ow})] = acc;
+
+                        // a window without an eligible element selects none
+                        if constexpr(OutputIndex)
+                            out_indices.mData[get_offset(out_indices, n, c, {od, oh, ow})] =
+                                eligible ? acc_idx : -1;
+                    }
+}
+
+template <index_t NDimSpatial, ReduceTensorOp ReduceOpId, bool PropagateNan, bool OutputIndex>
+void test_pool_fwd(const PoolProblem& problem, bool with_nan)
+{
+    using ReferencePoolFwdInstance = ck::tensor_operation::host::ReferencePoolFwd<NDimSpatial,
+                                                                                   float,
+                                                                                   float,
+                                                                                   float,
+                                                                                   int32_t,
+                                                                                   ReduceOpId,
+                                                                                   PropagateNan,
+                                                                                   OutputIndex>;
+
+    const auto in          = make_input(problem.in_lengths, with_nan);
+    const auto out_lengths = problem.GetOutLengths();
+
+    Tensor<float> out(make_descriptor(out_lengths));
+    Tensor<int32_t> out_indices(make_descriptor(out_lengths));
+    Tensor<float> out_naive(make_descriptor(out_lengths));
+    Tensor<int32_t> out_indices_naive(make_descriptor(out_lengths));
+
+    auto ref_pool     = ReferencePoolFwdInstance{};
+    auto ref_invoker  = ref_pool.MakeInvoker();
+    auto ref_argument = ref_pool.MakeArgument(in,
+                                              out,
+                                              out_indices,
+                                              problem.window_lengths,
+                                              problem.window_strides,
+                                              problem.left_pads,
+                                              problem.right_pads);
+
+    ref_invoker.Run(ref_argument);
+
+    naive_pool_fwd<ReduceOpId, PropagateNan, OutputIndex>(
+        in, out_naive, out_indices_naive, problem);
+
+    for(std::size_t i = 0; i < out.mData.size(); ++i)
+    {
+        const float expected = out_naive.mData[i];
+
+        if(std::isnan(expected))
+        {
+            EXPECT_TRUE(std::isnan(out.mData[i])) << "element " << i;
+        }
+        else
+        {
+            EXPECT_NEAR(out.mData[i], expected, 1e-5f * std::max(1.0f, std::abs(expected)))
+                << "element " << i;
+        }
+
+        if(OutputIndex)
+        {
+            EXPECT_EQ(out_indices.mData[i], out_indices_naive.mData[i]) << "element " << i;
+        }
+    }
+}
+
+// windows overlap (stride < window), skip elements (stride > window) and reach into the padding
+const PoolProblem problem_2d{{2, 3, 17, 23}, {3, 4}, {2, 1}, {1, 2}, {1, 1}};
+const PoolProblem problem_2d_sparse{{2, 3, 17, 23}, {2, 2}, {3, 4}, {0, 1}, {0, 0}};
+const PoolProblem problem_3d{{2, 2, 7, 9, 11}, {3, 2, 3}, {2, 2, 1}, {1, 0, 1}, {1, 1, 1}};
+
+} // namespace
+
+TEST(ReferencePool, MaxFirstOccurrence)
+{
+    test_pool_fwd<2, ReduceTensorOp::MAX, false, true>(problem_2d, false);
+    test_pool_fwd<2, ReduceTensorOp::MAX, false, true>(problem_2d_sparse, false);
+    test_pool_fwd<3, ReduceTensorOp::MAX, false, true>(problem_3d, false);
+    test_pool_fwd<2, ReduceTensorOp::MIN, false, true>(problem_2d, false);
+    test_pool_fwd<2, ReduceTensorOp::AMAX, false, true>(problem_2d, false);
+}
+
+TEST(ReferencePool, MaxNan)
+{
+    test_pool_fwd<2, ReduceTensorOp::MAX, true, true>(problem_2d, true);
+    test_pool_fwd<2, ReduceTensorOp::MAX, false, true>(problem_2d, true);
+    test_pool_fwd<3, ReduceTensorOp::MAX, true, true>(problem_3d, true);
+    test_pool_fwd<2, ReduceTensorOp::MAX, true, false>(problem_2d, true);
+}
+
+TEST(ReferencePool, Average)
+{
+    test_pool_fwd<2, ReduceTensorOp::AVG, false, false>(problem_2d, false);
+    test_pool_fwd<2, ReduceTensorOp::AVG, false, false>(problem_2d_sparse, false);
+    test_pool_fwd<3, ReduceTensorOp::AVG, true, false>(problem_3d, true);
+}
+
+TEST(ReferencePool, BackwardScatter)
+{
+    using ReferencePoolFwdInstance = ck::tensor_operation::host::
+        ReferencePoolFwd<2, float, float, float, int32_t, ReduceTensorOp::MAX, false, true>;
+    using ReferencePoolBwdInstance =
+        ck::tensor_operation::host::ReferencePoolBwd<2, float, int32_t, float, float>;
+
+    const auto& problem    = problem_2d;
+    const auto in          = make_input(problem.in_lengths, false);
+    const auto out_lengths = problem.GetOutLengths();
+
+    Tensor<float> out(make_descriptor(out_lengths));
+    Tensor<int32_t> out_indices(make_descriptor(out_lengths));
+
+    auto ref_fwd = ReferencePoolFwdInstance{};
+    auto fwd_arg = ref_fwd.MakeArgument(in,
+                                        out,
+                                        out_indices,
+                                        problem.window_lengths,
+                                        problem.window_strides,
+                                        problem.left_pads,
+                                        problem.right_pads);
+
+    ref_fwd.MakeInvoker().Run(fwd_arg);
+
+    Tensor<float> dout(make_descriptor(out_lengths));
+
+    for(std::size_t i = 0; i < dout.mData.size(); ++i)
+        dout.mData[i] = static_cast<float>(i % 7) + 1.0f;
+
+    Tensor<float> din(make_descriptor(problem.in_lengths));
+
+    auto ref_bwd = ReferencePoolBwdInstance{};
+    auto bwd_arg = ref_bwd.MakeArgument(dout,
+                                        out_indices,
+                                        din,
+                                        problem.window_lengths,
+                                        problem.window_strides,
+                                        problem.left_pads,
+                                        problem.right_pads);
+
+    ref_bwd.MakeInvoker().Run(bwd_arg);
+
+    // every selected element receives the gradient of the windows that selected it
+    Tensor<float> din_naive(make_descriptor(problem.in_lengths));
+
+    for(index_t n = 0; n < out_lengths[0]; ++n)
+        for(index_t c = 0; c < out_lengths[1]; ++c)
+            for(index_t oh = 0; oh < out_lengths[2]; ++oh)
+                for(index_t ow = 0; ow < out_lengths[3]; ++ow)
+                {
+                    const std::size_t o = get_offset(out_indices, n, c, {0, oh, ow});
+                    const index_t index = out_indices.mData[o];
+
+                    const index_t ih = oh * problem.window_strides[0] - problem.left_pads[0] +
+                                       index / problem.window_lengths[1];
+                    const index_t iw = ow * problem.window_strides[1] - problem.left_pads[1] +
+                                       index % problem.window_lengths[1];
+
+                    // the selected element is the window maximum
+                    const std::size_t i = get_offset(in, n, c, {0, ih, iw});
+
+                    EXPECT_EQ(in.mData[i], out.mData[o]);
+
+                    din_naive.mData[i] += dout.mData[o];
+                }
+
+    for(std::size_t i = 0; i < din.mData.size(); ++i)
+    {
+        EXPECT_EQ(din.mData[i], din_naive.mData[i]) << "element " << i;
+    }
+}
+
+TEST(ReferencePool, BackwardSkipsEmptyWindows)
+{
+    using ReferencePoolFwdInstance = ck::tensor_operation::host::
+        ReferencePoolFwd<2, float, float, float, int32_t, ReduceTensorOp::MAX, false, true>;
+    using ReferencePoolBwdInstance =
+        ck::tensor_operation::host::ReferencePoolBwd<2, float, int32_t, float, float>;
+
+    // the first row of windows lies in the padding, and in channel 0 the window (1, 0) and half
+    // of the window (1, 1) are NaN
+    const PoolProblem problem{{1, 2, 6, 8}, {2, 2}, {2, 2}, {2, 0}, {0, 0}};
+    const auto out_lengths = problem.GetOutLengths();
+
+    auto in = make_input(problem.in_lengths, false);
+
+    for(index_t ih = 0; ih < 2; ++ih)
+        for(index_t iw = 0; iw < 3; ++iw)
+            in.mData[get_offset(in, 0, 0, {0, ih, iw})] = std::numeric_limits<float>::quiet_NaN();
+
+    // the windows in the padding against the window scan, which make_input fills without NaN
+    test_pool_fwd<2, ReduceTensorOp::MAX, false, true>(problem, false);
+
+    Tensor<float> out(make_descriptor(out_lengths));
+    Tensor<int32_t> out_indices(make_descriptor(out_lengths));
+
+    auto ref_fwd = ReferencePoolFwdInstance{};
+    auto fwd_arg = ref_fwd.MakeArgument(in,
+                                        out,
+                                        out_indices,
+                                        problem.window_lengths,
+                                        problem.window_strides,
+                                        problem.left_pads,
+                                        problem.right_pads);
+
+    ref_fwd.MakeInvoker().Run(fwd_arg);
+
+    for(index_t c = 0; c < out_lengths[1]; ++c)
+        for(index_t oh = 0; oh < out_lengths[2]; ++oh)
+            for(index_t ow = 0; ow < out_lengths[3]; ++ow)
+            {
+                const bool empty = oh == 0 || (c == 0 && oh == 1 && ow == 0);
+
+                EXPECT_EQ(out_indices.mData[get_offset(out_indices, 0, c, {0, oh, ow})] < 0,
+                          empty)
+                    << "window " << c << ", " << oh << ", " << ow;
+            }
+
+    Tensor<float> dout(make_descriptor(out_lengths));
+
+    for(std::size_t i = 0; i < dout.mData.size(); ++i)
+        dout.mData[i] = static_cast<float>(i % 7) + 1.0f;
+
+    Tensor<float> din(make_descriptor(problem.in_lengths));
+
+    auto ref_bwd = ReferencePoolBwdInstance{};
+    auto bwd_arg = ref_bwd.MakeArgument(dout,
+                                        out_indices,
+                                        din,
+                                        problem.window_lengths,
+                                        problem.window_strides,
+                                        problem.left_pads,
+                                        problem.right_pads);
+
+    ref_bwd.MakeInvoker().Run(bwd_arg);
+
+    // the windows do not overlap, every element gets the gradient of at most one window
+    for(index_t c = 0; c < out_lengths[1]; ++c)
+        for(index_t ih = 0; ih < problem.in_lengths[2]; ++ih)
+            for(index_t iw = 0; iw < problem.in_lengths[3]; ++iw)
+            {
+                const index_t oh = (ih + problem.left_pads[0]) / problem.window_strides[0];
+                const index_t ow = (iw + problem.left_pads[1]) / problem.window_strides[1];
+
+                const std::size_t o = get_offset(out_indices, 0, c, {0, oh, ow});
+                const index_t index = out_indices.mData[o];
+
+                const bool selected = index >= 0 &&
+                                      index == (ih + problem.left_pads[0]) % 2 * 2 +
+                                                   (iw + problem.left_pads[1]) % 2;
+
+                EXPECT_EQ(din.mData[get_offset(din, 0, c, {0, ih, iw})],
+                          selected ? dout.mData[o] : 0.0f)
+                    << "element " << c << ", " << ih << ", " << iw;
+            }
+}
+
+TEST(ReferencePool, NonPositiveWindowRejected)
+{
+    using ReferencePoolFwdInstance = ck::tensor_operation::host::
+        ReferencePoolFwd<2, float, float, float, int32_t, ReduceTensorOp::MAX, false, true>;
+
+    const auto& problem    = problem_2d;
+    const auto in          = make_input(problem.in_lengths, false);
+    const auto out_lengths = problem.GetOutLengths();
+
+    Tensor<float> out(make_descriptor(out_lengths));
+    Tensor<int32_t> out_indices(make_descriptor(out_lengths));
+
+    auto ref_fwd = ReferencePoolFwdInstance{};
+    auto invoker = ref_fwd.MakeInvoker();
+
+    // the sliding-window passes step by the window length and the stride
+    for(const auto& [window_lengths, window_strides] :
+        {std::pair<std::vector<index_t>, std::vector<index_t>>{{3, 0}, {2, 1}},
+         {{-3, 4}, {2, 1}},
+         {{3, 4}, {0, 1}},
+         {{3, 4}, {2, -1}}})
+    {
+        auto arg = ref_fwd.MakeArgument(in,
+                                        out,
+                                        out_indices,
+                                        window_lengths,
+                                        window_strides,
+                                        problem.left_pads,
+                                        problem.right_pads);
+
+        EXPECT_FALSE(ref_fwd.IsSupportedArgument(&arg));
+        EXPECT_THROW(invoker.Run(arg), std::runtime_error);
+    }
+}
@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/utility/reduction_operator.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/reference_tensor_operation/cpu/reference_reduce.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using UnaryAbs    = ck::tensor_operation::element_wise::UnaryAbs;
+using UnarySquare = ck::tensor_operation::element_wise::UnarySquare;
+
+constexpr ck::index_t Rank         = 3;
+constexpr ck::index_t NumReduceDim = 2;
+
+struct ReduceResult
+{
+    std::vector<float> out;
+    std::vector<int32_t> out_index;
+};
+
+// Reduces dims {1, 2} of the [d0, d1, d2] tensor x, stored either row-major (the reduced elements
+// of an output are one packed run, contiguous kernels) or column-major (generic path).
+template <typename ReduceOperation,
+          typename InElementwiseOperation,
+          bool PropagateNan,
+          bool OutputIndex>
+ReduceResult run_reduce(const std::vector<float>& x,
+                        const std::array<ck::index_t, Rank>& lengths,
+                        bool is_row_major)
+{
+    using ReferenceReduceInstance =
+        ck::tensor_operation::host::ReferenceReduce<float,
+                                                    float,
+                                                    float,
+                                                    Rank,
+                                                    NumReduceDim,
+                                                    ReduceOperation,
+                                                    InElementwiseOperation,
+                                                    PassThrough,
+                                                    PropagateNan,
+                                                    OutputIndex>;
+
+    const std::array<ck::index_t, Rank> row_major_strides{lengths[1] * lengths[2], lengths[2], 1};
+    const std::array<ck::index_t, Rank> col_major_strides{1, lengths[0], lengths[0] * lengths[1]};
+
+    const auto& strides = is_row_major ? row_major_strides : col_major_strides;
+
+    // x is given row-major, scatter it to the tested layout
+    std::vector<float> in(x.size());
+
+    for(ck::index_t i0 = 0; i0 < lengths[0]; ++i0)
+        for(ck::index_t i1 = 0; i1 < lengths[1]; ++i1)
+            for(ck::index_t i2 = 0; i2 < lengths[2]; ++i2)
+                in[i0 * strides[0] + i1 * strides[1] + i2 * strides[2]] =
+                    x[(i0 * lengths[1] + i1) * lengths[2] + i2];
+
+    ReduceResult result{std::vector<float>(lengths[0]), std::vector<int32_t>(lengths[0])};
+
+    ReferenceReduceInstance ref_reduce;
+
+    auto argument = ref_reduce.MakeArgumentPointer(lengths,
+                                                   strides,
+                                                   {lengths[0]},
+                                                   {1},
+                                                   {1, 2},
+                                                   1.0,
+                                                   0.0,
+                                                   in.data(),
+                                                   nullptr,
+                                                   result.out.data(),
+                                                   result.out_index.data(),
+                                                   InElementwiseOperation{},
+                                                   PassThrough{});
+
+    ref_reduce.MakeInvokerPointer()->Run(argument.get());
+
+    return result;
+}
+
+// small integers give many ties, every third row holds a NaN
+std::vector<float> make_input(const std::array<ck::index_t, Rank>& lengths)
+{
+    const ck::index_t row_length = lengths[1] * lengths[2];
+
+    std::vector<float> x(lengths[0] * row_length);
+
+    std::srand(0);
+
+    for(auto& v : x)
+        v = static_cast<float>(std::rand() % 9 - 4) * 0.5f;
+
+    for(ck::index_t r = 0; r < lengths[0]; r += 3)
+        x[r * row_length + std::rand() % row_length] = std::numeric_limits<float>::quiet_NaN();
+
+    return x;
+}
+
+template <typename ReduceOperation, typename InElementwiseOperation, bool PropagateNan>
+void test_indexed_reduce()
+{
+    const std::array<ck::index_t, Rank> lengths{7, 5, 61};
+
+    const auto x = make_input(lengths);
+
+    const auto contiguous =
+        run_reduce<ReduceOperation, InElementwiseOperation, PropagateNan, true>(x, lengths, true);
+    const auto generic =
+        run_reduce<ReduceOperation, InElementwiseOperation, PropagateNan, true>(x, lengths, false);
+
+    for(std::size_t r = 0; r < contiguous.out.size(); ++r)
+    {
+        EXPECT_EQ(contiguous.out_index[r], generic.out_index[r]) << "row " << r;
+
+        if(std::isnan(generic.out[r]))
+        {
+            EXPECT_TRUE(std::isnan(contiguous.out[r])) << "row " << r;
+        }
+        else
+        {
+            EXPECT_EQ(contiguous.out[r], generic.out[r]) << "row " << r;
+        }
+    }
+}
+
+template <typename ReduceOperation, typename InElementwiseOperation, bool PropagateNan>
+void test_reduce()
+{
+    const std::array<ck::index_t, Rank> lengths{7, 5, 61};
+
+    const auto x = make_input(lengths);
+
+    const auto contiguous =
+        run_reduce<ReduceOperation, InElementwiseOperation, PropagateNan, false>(x, lengths, true);
+    const auto generic =
+        run_reduce<ReduceOperation, InElementwiseOperation, PropagateNan, false>(x, lengths, false);
+
+    for(std::size_t r = 0; r < contiguous.out.size(); ++r)
+    {
+        if(std::isnan(generic.out[r]))
+        {
+            EXPECT_TRUE(std::isnan(contiguous.out[r])) << "row " << r;
+        }
+        else
+        {
+            EXPECT_NEAR(contiguous.out[r], generic.out[r], 1e-4f * std::abs(generic.out[r]))
+                << "row " << r;
+        }
+    }
+}
+
+} // namespace
+
+TEST(ReferenceReduce, IndexedMaxFirstOccurrence)
+{
+    test_indexed_reduce<ck::reduce::Max, PassThrough, false>();
+    test_indexed_reduce<ck::reduce::Max, PassThrough, true>();
+}
+
+TEST(ReferenceReduce, IndexedMinFirstOccurrence)
+{
+    test_indexed_reduce<ck::reduce::Min, PassThrough, false>();
+    test_indexed_reduce<ck::reduce::Min, PassThrough, true>();
+}
+
+TEST(ReferenceReduce, IndexedAMaxFirstOccurrence)
+{
+    test_indexed_reduce<ck::reduce::AMax, UnaryAbs, false>();
+    test_indexed_reduce<ck::reduce::AMax, UnaryAbs, true>();
+}
+
+TEST(ReferenceReduce, ContiguousMatchesStrided)
+{
+    test_reduce<ck::reduce::Add, PassThrough, false>();
+    test_reduce<ck::reduce::Add, UnarySquare, true>();
+    test_reduce<ck::reduce::Max, PassThrough, false>();
+    test_reduce<ck::reduce::Min, PassThrough, true>();
+    test_reduce<ck::reduce::AMax, UnaryAbs, true>();
+}
+
+TEST(ReferenceReduce, SplitReduceSpace)
+{
+    // two outputs of 60000 elements, the reduce space is split into several partials per output
+    const std::array<ck::index_t, Rank> lengths{2, 300, 200};
+
+    auto x = make_input(lengths);
+
+    const ck::index_t row_length = lengths[1] * lengths[2];
+
+    // the maximum of row 1 first shows up in a later split, and once more after that
+    x[row_length + 25123] = 8.0f;
+    x[row_length + 45678] = 8.0f;
+
+    for(bool is_row_major : {true, false})
+    {
+        const auto result =
+            run_reduce<ck::reduce::Max, PassThrough, false, true>(x, lengths, is_row_major);
+
+        for(ck::index_t r = 0; r < lengths[0]; ++r)
+        {
+            float max_value   = std::numeric_limits<float>::lowest();
+            int32_t max_index   = 0;
+
+            for(ck::index_t i = 0; i < row_length; ++i)
+            {
+                if(max_value < x[r * row_length + i])
+                {
+                    max_value = x[r * row_length + i];
+                    max_index = i;
+                }
+            }
+
+            EXPECT_EQ(result.out[r], max_value) << "row " << r;
+            EXPECT_EQ(result.out_index[r], max_index) << "row " << r;
+        }
+    }
+}
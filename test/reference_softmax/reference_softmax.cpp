@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+
+#include "ck/library/utility/host_simd.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/host_online_softmax.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_softmax.hpp"
+
+namespace {
+
+using ck::index_t;
+
+constexpr float inf = std::numeric_limits<float>::infinity();
+constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+// y = alpha * softmax(x) + beta * y, two passes with std::exp in double. A row holding a NaN or
+// a +inf, or only -inf, is NaN throughout.
+void naive_softmax(const std::vector<float>& x, std::vector<double>& y, double alpha, double beta)
+{
+    double max = -std::numeric_limits<double>::infinity();
+
+    for(float v : x)
+        max = std::max<double>(max, v);
+
+    double sum = 0;
+
+    for(float v : x)
+        sum += std::exp(v - max);
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+        y[i] = alpha * std::exp(x[i] - max) / sum + beta * y[i];
+}
+
+// NaN where the reference is NaN, relative error otherwise
+bool is_close(float out, double ref, double rtol, double atol)
+{
+    if(std::isnan(ref))
+        return std::isnan(out);
+
+    return std::abs(out - ref) <= atol + rtol * std::abs(ref);
+}
+
+// the lengths cover the scalar tail of the 8- and 16-lane kernels and of their 4-vector blocks
+const std::vector<index_t> row_lengths{1, 3, 8, 15, 31, 32, 33, 63, 64, 65, 100, 129, 1000};
+
+enum struct RowKind
+{
+    Uniform,     // [-4, 4]
+    Large,       // [-1e4, 1e4]
+    Huge,        // [-1e38, 1e38], differences overflow to -inf
+    SomeNegInf,  // every 3rd element -inf
+    AllNegInf,   // -inf throughout
+    OneNan,      // one NaN in the middle
+    LastNan,     // NaN in the scalar tail
+    OnePosInf,   // one +inf in the middle
+    LastPosInf,  // +inf in the scalar tail
+};
+
+std::vector<float> make_row(index_t length, RowKind kind, std::mt19937& gen)
+{
+    const float range = kind == RowKind::Large ? 1e4f : kind == RowKind::Huge ? 1e38f : 4.f;
+
+    std::uniform_real_distribution<float> dis(-range, range);
+
+    std::vector<float> row(length);
+
+    for(auto& v : row)
+        v = dis(gen);
+
+    if(kind == RowKind::SomeNegInf)
+        for(index_t i = 0; i < length; i += 3)
+            row[i] = -inf;
+
+    if(kind == RowKind::AllNegInf)
+        std::fill(row.begin(), row.end(), -inf);
+
+    if(kind == RowKind::OneNan)
+        row[length / 2] = nan;
+
+    if(kind == RowKind::LastNan)
+        row[length - 1] = nan;
+
+    if(kind == RowKind::OnePosInf)
+        row[length / 2] = inf;
+
+    if(kind == RowKind::LastPosInf)
+        row[length - 1] = inf;
+
+    return row;
+}
+
+const std::vector<RowKind> row_kinds{RowKind::Uniform,
+                                     RowKind::Large,
+                                     RowKind::Huge,
+                                     RowKind::SomeNegInf,
+                                     RowKind::AllNegInf,
+                                     RowKind::OneNan,
+                                     RowKind::LastNan,
+                                     RowKind::OnePosInf,
+                                     RowKind::LastPosInf};
+
+#if CK_HOST_X86_SIMD
+
+__attribute__((target("avx2"))) void exp_avx2(const float* p_x, float* p_y, std::size_t n)
+{
+    for(std::size_t i = 0; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(p_y + i, ck::host_simd::exp_f32x8(_mm256_loadu_ps(p_x + i)));
+}
+
+__attribute__((target("avx512f"))) void exp_avx512(const float* p_x, float* p_y, std::size_t n)
+{
+    for(std::size_t i = 0; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(p_y + i, ck::host_simd::exp_f32x16(_mm512_loadu_ps(p_x + i)));
+}
+
+// std::exp over the range in which the result is a normal float, special values at the ends
+template <typename F>
+void test_simd_exp(F f_exp)
+{
+    std::vector<float> x;
+
+    for(float v = -87.3f; v < 88.3f; v += 0.0137f)
+        x.push_back(v);
+
+    const std::size_t num_finite = x.size();
+
+    for(float v : {-inf, -1e30f, -100.f, -87.4f, nan, 0.f, -0.f, 1.f})
+        x.push_back(v);
+
+    x.resize((x.size() + 15) / 16 * 16, 0.f);
+
+    std::vector<float> y(x.size());
+
+    f_exp(x.data(), y.data(), x.size());
+
+    for(std::size_t i = 0; i < num_finite; ++i)
+        EXPECT_LE(std::abs(y[i] - std::exp(static_cast<double>(x[i]))),
+                  3e-7 * std::exp(static_cast<double>(x[i])));
+
+    // below the normal range the result flushes to zero, NaN propagates
+    EXPECT_EQ(y[num_finite + 0], 0.f);
+    EXPECT_EQ(y[num_finite + 1], 0.f);
+    EXPECT_EQ(y[num_finite + 2], 0.f);
+    EXPECT_EQ(y[num_finite + 3], 0.f);
+    EXPECT_TRUE(std::isnan(y[num_finite + 4]));
+    EXPECT_EQ(y[num_finite + 5], 1.f);
+    EXPECT_EQ(y[num_finite + 6], 1.f);
+    EXPECT_LE(std::abs(y[num_finite + 7] - std::exp(1.)), 3e-7 * std::exp(1.));
+}
+
+#endif // CK_HOST_X86_SIMD
+
+} // namespace
+
+#if CK_HOST_X86_SIMD
+
+TEST(HostSimd, ExpF32x8)
+{
+    if(!__builtin_cpu_supports("avx2"))
+        return;
+
+    test_simd_exp(exp_avx2);
+}
+
+TEST(HostSimd, ExpF32x16)
+{
+    if(!__builtin_cpu_supports("avx512f"))
+        return;
+
+    test_simd_exp(exp_avx512);
+}
+
+#endif // CK_HOST_X86_SIMD
+
+// contiguous rows take the SIMD kernels where the CPU has them, strided rows the scalar loop
+TEST(HostOnlineSoftmax, RowsMatchNaive)
+{
+    using ck::tensor_operation::host::HostSoftmaxState;
+
+    std::mt19937 gen(0);
+
+    for(index_t stride : {1, 3})
+        for(index_t length : row_lengths)
+            for(RowKind kind : row_kinds)
+            {
+                const auto row = make_row(length, kind, gen);
+
+                std::vector<float> in(length * stride, 0.f);
+                std::vector<float> out(length * stride, 0.5f);
+                std::vector<double> ref(length, 0.5);
+
+                for(index_t i = 0; i < length; ++i)
+                    in[i * stride] = row[i];
+
+                HostSoftmaxState<float> state;
+
+                ck::tensor_operation::host::host_softmax_accumulate(
+                    state, in.data(), length, stride);
+                ck::tensor_operation::host::host_softmax_normalize(
+                    state, in.data(), out.data(), length, stride, stride, 2.f, 0.5f);
+
+                naive_softmax(row, ref, 2., 0.5);
+
+                for(index_t i = 0; i < length; ++i)
+                    EXPECT_TRUE(is_close(out[i * stride], ref[i], 1e-5, 1e-7));
+            }
+}
+
+// [B, M, N] with the softmax over N, or over M and N
+TEST(ReferenceSoftmax, MatchesNaive)
+{
+    using ReferenceSoftmaxInstance =
+        ck::tensor_operation::host::ReferenceSoftmax<float, float, float>;
+
+    std::mt19937 gen(0);
+
+    const std::size_t B = row_kinds.size();
+    const std::size_t M = 3;
+
+    for(index_t N : {7, 64, 65})
+        for(bool reduce_m : {false, true})
+        {
+            Tensor<float> in({B, M, std::size_t(N)});
+            Tensor<float> out({B, M, std::size_t(N)});
+
+            // one kind of row per b
+            for(std::size_t b = 0; b < B; ++b)
+                for(std::size_t m = 0; m < M; ++m)
+                {
+                    const auto row = make_row(N, row_kinds[b], gen);
+
+                    for(index_t n = 0; n < N; ++n)
+                        in(b, m, n) = row[n];
+                }
+
+            for(auto& v : out.mData)
+                v = 1.f;
+
+            const std::vector<index_t> reduce_dims =
+                reduce_m ? std::vector<index_t>{1, 2} : std::vector<index_t>{2};
+
+            auto ref      = ReferenceSoftmaxInstance{};
+            auto argument = ref.MakeArgument(in, out, 1., 0.25, reduce_dims);
+            auto invoker  = ref.MakeInvoker();
+
+            invoker.Run(argument);
+
+            for(std::size_t b = 0; b < B; ++b)
+            {
+                const std::size_t num_group = reduce_m ? 1 : M;
+                const std::size_t group_m   = reduce_m ? M : 1;
+
+                for(std::size_t group = 0; group < num_group; ++group)
+                {
+                    std::vector<float> x;
+
+                    for(std::size_t m = group * group_m; m < (group + 1) * group_m; ++m)
+                        for(index_t n = 0; n < N; ++n)
+                            x.push_back(in(b, m, n));
+
+                    std::vector<double> y(x.size(), 1.);
+
+                    naive_softmax(x, y, 1., 0.25);
+
+                    for(std::size_t i = 0; i < x.size(); ++i)
+                        EXPECT_TRUE(is_close(
+                            out(b, group * group_m + i / N, i % N), y[i], 1e-5, 1e-7));
+                }
+            }
+        }
+}
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2018-2022, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_sparse_embeddings_forward_layernorm.hpp"
+
+namespace {
+
+using ck::index_t;
+
+// y = 1 * x_0 + 2 * x_1 + ..., so that a mix-up of the tables shows
+struct WeightedSum
+{
+    template <typename... X>
+    void operator()(float& y, const X&... x) const
+    {
+        float weight = 0.f;
+
+        y = 0.f;
+
+        ((y += (weight += 1.f) * x), ...);
+    }
+};
+
+template <index_t NumEmbeddings>
+using ReferenceInstance =
+    ck::tensor_operation::host::ReferenceSparseEmbeddingsForwardLayernorm<float,
+                                                                          int,
+                                                                          float,
+                                                                          float,
+                                                                          float,
+                                                                          float,
+                                                                          WeightedSum,
+                                                                          NumEmbeddings>;
+
+// NumEmbeddings tables of [num_row, D], rows padded to D + 3; L lookups into each, the indices
+// every other element of an [L, 2] tensor; an [L, D] output, rows padded to D + 1
+template <index_t NumEmbeddings>
+struct Problem
+{
+    Problem(index_t num_row, index_t D, index_t L)
+        : gamma_({std::size_t(D)}),
+          beta_({std::size_t(D)}),
+          out_(std::vector<std::size_t>{std::size_t(L), std::size_t(D + 1)})
+    {
+        std::mt19937 gen(0);
+        std::uniform_real_distribution<float> dis(-1.f, 1.f);
+        std::uniform_int_distribution<int> row_dis(0, num_row - 1);
+
+        for(index_t i = 0; i < NumEmbeddings; ++i)
+        {
+            embs_.emplace_back(std::vector<std::size_t>{std::size_t(num_row), std::size_t(D + 3)});
+            indexes_.emplace_back(std::vector<std::size_t>{std::size_t(L), std::size_t{2}});
+
+            for(auto& v : embs_.back().mData)
+                v = dis(gen);
+
+            for(auto& v : indexes_.back().mData)
+                v = row_dis(gen);
+        }
+
+        for(auto& v : gamma_.mData)
+            v = dis(gen);
+
+        for(auto& v : beta_.mData)
+            v = dis(gen);
+    }
+
+    template <std::size_t... Is>
+    std::array<TensorView<const float>, NumEmbeddings> GetEmbs(std::index_sequence<Is...>) const
+    {
+        return {TensorView<const float>(embs_[Is]).Slice(1, 0, GetD())...};
+    }
+
+    template <std::size_t... Is>
+    std::array<TensorView<const int>, NumEmbeddings> GetIndexes(std::index_sequence<Is...>) const
+    {
+        return {TensorView<const int>(indexes_[Is]).Select(1, 0)...};
+    }
+
+    auto GetEmbs() const { return GetEmbs(std::make_index_sequence<NumEmbeddings>{}); }
+
+    auto GetIndexes() const { return GetIndexes(std::make_index_sequence<NumEmbeddings>{}); }
+
+    TensorView<float> GetOut() { return TensorView<float>(out_).Slice(1, 0, GetD()); }
+
+    index_t GetD() const { return gamma_.mDesc.GetLengths()[0]; }
+
+    std::vector<Tensor<float>> embs_;
+    std::vector<Tensor<int>> indexes_;
+    Tensor<float> gamma_;
+    Tensor<float> beta_;
+    Tensor<float> out_;
+};
+
+// gather, weighted sum and layernorm of every output row, in double
+template <index_t NumEmbeddings>
+std::vector<double> naive_embedding_layernorm(const Problem<NumEmbeddings>& problem,
+                                              index_t L,
+                                              double epsilon)
+{
+    const index_t D = problem.GetD();
+
+    std::vector<double> out(static_cast<std::size_t>(L) * D);
+
+    for(index_t l = 0; l < L; ++l)
+    {
+        std::vector<double> row(D, 0.);
+
+        for(index_t i = 0; i < NumEmbeddings; ++i)
+        {
+            const int index = problem.indexes_[i](l, 0);
+
+            for(index_t d = 0; d < D; ++d)
+                row[d] += (i + 1) * double(problem.embs_[i](index, d));
+        }
+
+        double mean = 0;
+
+        for(double v : row)
+            mean += v / D;
+
+        double variance = 0;
+
+        for(double v : row)
+            variance += (v - mean) * (v - mean) / D;
+
+        for(index_t d = 0; d < D; ++d)
+            out[static_cast<std::size_t>(l) * D + d] =
+                (row[d] - mean) / std::sqrt(variance + epsilon) * problem.gamma_(d) +
+                problem.beta_(d);
+    }
+
+    return out;
+}
+
+template <index_t NumEmbeddings>
+void test_embedding(index_t num_row, index_t D, index_t L)
+{
+    Problem<NumEmbeddings> problem(num_row, D, L);
+
+    const float epsilon = 1e-5f;
+
+    auto ref      = ReferenceInstance<NumEmbeddings>{};
+    auto argument = ref.MakeArgument(problem.GetOut(),
+                                     problem.GetEmbs(),
+                                     problem.GetIndexes(),
+                                     problem.gamma_,
+                                     problem.beta_,
+                                     epsilon,
+                                     WeightedSum{});
+    auto invoker  = ref.MakeInvoker();
+
+    ASSERT_TRUE(ref.IsSupportedArgument(&argument));
+
+    // the padding of the output rows must not be written
+    for(auto& v : problem.out_.mData)
+        v = 123.f;
+
+    invoker.Run(argument);
+
+    const auto out_ref = naive_embedding_layernorm(problem, L, epsilon);
+
+    for(index_t l = 0; l < L; ++l)
+    {
+        for(index_t d = 0; d < D; ++d)
+            EXPECT_LE(std::abs(problem.out_(l, d) - out_ref[static_cast<std::size_t>(l) * D + d]),
+                      1e-4);
+
+        EXPECT_EQ(problem.out_(l, D), 123.f);
+    }
+}
+
+} // namespace
+
+TEST(ReferenceSparseEmbeddingsForwardLayernorm, OneTable) { test_embedding<1>(50, 17, 40); }
+
+TEST(ReferenceSparseEmbeddingsForwardLayernorm, ThreeTables)
+{
+    // more lookups than one task holds, a row length that is not a multiple of 16
+    test_embedding<3>(1000, 100, 600);
+}
+
+TEST(ReferenceSparseEmbeddingsForwardLayernorm, FiveTables)
+{
+    test_embedding<5>(7, 64, 300);
+    test_embedding<5>(3, 1, 5);
+}
+
+TEST(ReferenceSparseEmbeddingsForwardLayernorm, IndexOutOfRange)
+{
+    using Instance = ReferenceInstance<2>;
+
+    for(int bad_index : {-1, 20, 1 << 30})
+    {
+        Problem<2> problem(20, 8, 30);
+
+        // in the second table, at the last lookup
+        problem.indexes_[1](29, 0) = bad_index;
+
+        auto ref      = Instance{};
+        auto argument = ref.MakeArgument(problem.GetOut(),
+                                         problem.GetEmbs(),
+                                         problem.GetIndexes(),
+                                         problem.gamma_,
+                                         problem.beta_,
+                                         1e-5f,
+                                         WeightedSum{});
+        auto invoker  = ref.MakeInvoker();
+
+        EXPECT_TRUE(!ref.IsSupportedArgument(&argument));
+        EXPECT_THROW(invoker.Run(argument), std::runtime_error);
+    }
+}
+
+TEST(ReferenceSparseEmbeddingsForwardLayernorm, ShapeMismatch)
+{
+    using Instance = ReferenceInstance<2>;
+
+    Problem<2> problem(20, 8, 30);
+
+    const auto embs    = problem.GetEmbs();
+    const auto indexes = problem.GetIndexes();
+
+    const TensorView<const float> gamma(problem.gamma_);
+    const TensorView<const float> beta(problem.beta_);
+
+    auto ref     = Instance{};
+    auto invoker = ref.MakeInvoker();
+
+    // Run() must not read past any of the views
+    auto check_rejected = [&](const std::array<TensorView<const float>, 2>& arg_embs,
+                              const std::array<TensorView<const int>, 2>& arg_indexes,
+                              TensorView<const float> arg_gamma,
+                              TensorView<const float> arg_beta) {
+        auto argument = ref.MakeArgument(problem.GetOut(),
+                                         arg_embs,
+                                         arg_indexes,
+                                         arg_gamma,
+                                         arg_beta,
+                                         1e-5f,
+                                         WeightedSum{});
+
+        EXPECT_TRUE(!ref.IsSupportedArgument(&argument));
+        EXPECT_THROW(invoker.Run(argument), std::runtime_error);
+    };
+
+    // fewer indices than output rows
+    auto short_indexes = indexes;
+
+    short_indexes[1] = short_indexes[1].Slice(0, 0, 29);
+
+    check_rejected(embs, short_indexes, gamma, beta);
+
+    // a table narrower than the output
+    auto narrow_embs = embs;
+
+    narrow_embs[0] = narrow_embs[0].Slice(1, 0, 7);
+
+    check_rejected(narrow_embs, indexes, gamma, beta);
+
+    // gamma or beta shorter than the output rows
+    check_rejected(embs, indexes, gamma.Slice(0, 0, 7), beta);
+    check_rejected(embs, indexes, gamma, beta.Slice(0, 0, 7));
+}